@@ -0,0 +1,163 @@
+/*!
+ * @file Adafruit_BandRenderer.cpp
+ *
+ * Part of Adafruit's GFX graphics library. Band (strip) renderer that
+ * overlaps drawing of one band with the DMA transfer of another. See
+ * Adafruit_BandRenderer.h for usage.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_BandRenderer.h"
+
+/*!
+    @brief  Constructor. Buffers are not allocated until begin().
+    @param  tft         Display the bands will be pushed to.
+    @param  bandHeight  Height of each band in pixels. Band width is the
+                        display width at its rotation when begin() is
+                        called.
+    @param  numBands    Number of band buffers, 1 to BAND_MAX_BANDS.
+                        2 (default) is sufficient to overlap drawing with
+                        transfer; 1 serializes them but halves RAM use.
+*/
+Adafruit_BandRenderer::Adafruit_BandRenderer(Adafruit_SPITFT *tft,
+                                             uint16_t bandHeight,
+                                             uint8_t numBands)
+    : _tft(tft), _bandHeight(bandHeight ? bandHeight : 1),
+      _numBands(numBands), _bandIdx(0), _bandY(0), _bandRows(0),
+      _drawing(false), _inFrame(false) {
+  if (_numBands < 1)
+    _numBands = 1;
+  else if (_numBands > BAND_MAX_BANDS)
+    _numBands = BAND_MAX_BANDS;
+  for (uint8_t i = 0; i < BAND_MAX_BANDS; i++)
+    _band[i] = NULL;
+}
+
+/*!
+    @brief  Destructor, frees band buffers.
+*/
+Adafruit_BandRenderer::~Adafruit_BandRenderer(void) {
+  for (uint8_t i = 0; i < _numBands; i++)
+    delete _band[i];
+}
+
+/*!
+    @brief   Allocate band buffers. Call after the display's begin() and
+             setRotation(), since band width follows display width.
+    @return  true on success, false if any buffer couldn't be allocated
+             (all are freed in that case).
+*/
+bool Adafruit_BandRenderer::begin(void) {
+  for (uint8_t i = 0; i < _numBands; i++) {
+    delete _band[i];
+#if defined(SPITFT_PRESWAP)
+    _band[i] = new GFXcanvas16(_tft->width(), _bandHeight, true);
+#else
+    _band[i] = new GFXcanvas16(_tft->width(), _bandHeight);
+#endif
+    if (!_band[i] || !_band[i]->getBuffer()) {
+      for (uint8_t j = 0; j <= i; j++) {
+        delete _band[j];
+        _band[j] = NULL;
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+    @brief  Begin rendering a frame. Starts a display transaction that is
+            held until the last band has been issued. With the display's
+            setTearSync() on, the first band is drawn, then waits for the
+            tearing-effect pulse before it's pushed, so frames come at the
+            panel's refresh rate and are drawn no faster.
+*/
+void Adafruit_BandRenderer::startFrame(void) {
+  if (_inFrame)
+    endFrame();
+  _inFrame = true;
+  _drawing = false;
+  _bandY = -(int16_t)_bandHeight; // First nextBand() advances to 0
+  _bandRows = 0;
+  _tft->startWrite();
+}
+
+/*!
+    @brief   Issue the previously-returned band (if any) to the display and
+             return a buffer for the next one. Band canvas row 0
+             corresponds to display row bandY().
+    @return  Canvas to draw the next band into, or NULL once the whole
+             screen has been covered (the frame is then finished, as if
+             endFrame() had been called). Also NULL, ending the frame, if
+             the display's width no longer matches the bands (rotated
+             since begin(); call begin() again to reallocate them).
+*/
+GFXcanvas16 *Adafruit_BandRenderer::nextBand(void) {
+  if (!_inFrame || !_band[0])
+    return NULL;
+  if (_band[0]->width() != _tft->width()) {
+    _drawing = false; // Band doesn't fit this rotation, don't push it
+    endFrame();
+    return NULL;
+  }
+  if (_drawing) {
+    pushBand();
+    _bandIdx = (_bandIdx + 1) % _numBands;
+  }
+  _bandY += _bandHeight;
+  if (_bandY >= _tft->height()) {
+    endFrame();
+    return NULL;
+  }
+  _bandRows = _tft->height() - _bandY;
+  if (_bandRows > (int16_t)_bandHeight)
+    _bandRows = _bandHeight;
+  // With one buffer, it's still in flight from the prior push; with
+  // more, that buffer's transfer finished before the newest one began.
+  if (_numBands == 1)
+    _tft->dmaWait();
+  _drawing = true;
+  return _band[_bandIdx];
+}
+
+/*!
+    @brief  Finish the frame: issue any band not yet pushed, wait for the
+            last transfer to complete and end the display transaction.
+            Called automatically when nextBand() returns NULL; call
+            explicitly to abandon a frame early.
+*/
+void Adafruit_BandRenderer::endFrame(void) {
+  if (!_inFrame)
+    return;
+  if (_drawing && (_bandY < _tft->height()))
+    pushBand();
+  _drawing = false;
+  _inFrame = false;
+  _tft->dmaWait();
+  _tft->endWrite();
+}
+
+/*!
+    @brief  Issue the current band. Returns as soon as the transfer is
+            under way where DMA permits.
+*/
+void Adafruit_BandRenderer::pushBand(void) {
+  GFXcanvas16 *band = _band[_bandIdx];
+  int16_t w = band->width(); // What was allocated, whatever the display
+  _tft->dmaWait(); // Prior band must finish before addressing this one
+  if (!_bandY && _tft->getTearSync())
+    _tft->waitForTear(); // First band follows the scan from the top
+  _tft->writeAddrWindow(0, _bandY, w, _bandRows);
+  _tft->writePixels(band->getBuffer(), (uint32_t)w * _bandRows, false,
+                    band->getBigEndian());
+}
+
+#endif // end __AVR_ATtiny85__
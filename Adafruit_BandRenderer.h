@@ -0,0 +1,87 @@
+/*!
+ * @file Adafruit_BandRenderer.h
+ *
+ * Part of Adafruit's GFX graphics library. Renders a full screen as a
+ * series of horizontal bands, each drawn into a small GFXcanvas16 and
+ * then pushed to an Adafruit_SPITFT display. With two or more bands and
+ * DMA available, the next band is drawn while the prior one transfers.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_BANDRENDERER_H_
+#define _ADAFRUIT_BANDRENDERER_H_
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_SPITFT.h"
+
+#ifndef BAND_MAX_BANDS
+#define BAND_MAX_BANDS 4 ///< Max # of band buffers a renderer can own
+#endif
+
+/*!
+  @brief  Draws a frame in horizontal strips ("bands") through a small
+          set of GFXcanvas16 buffers, so a full-screen composited image
+          needs only a fraction of a full framebuffer's RAM. Typical use:
+
+              bands.startFrame();
+              GFXcanvas16 *band;
+              while ((band = bands.nextBand())) {
+                int16_t top = bands.bandY(); // Screen row of band's row 0
+                band->fillScreen(BLACK);
+                band->fillCircle(120, 160 - top, 50, RED); // Offset by top
+              }
+
+          Each call to nextBand() issues the previously-returned band to
+          the display (non-blocking where DMA allows) before handing back
+          another buffer, so drawing and bus transfer overlap. On DMA
+          platforms that can send big-endian pixels directly, bands are
+          big-endian canvases so the transfer reads straight from the band
+          buffer.
+*/
+class Adafruit_BandRenderer {
+public:
+  Adafruit_BandRenderer(Adafruit_SPITFT *tft, uint16_t bandHeight,
+                        uint8_t numBands = 2);
+  ~Adafruit_BandRenderer(void);
+  bool begin(void);
+  void startFrame(void);
+  GFXcanvas16 *nextBand(void);
+  void endFrame(void);
+
+  /*!
+    @brief   Get the display row corresponding to row 0 of the band most
+             recently returned by nextBand().
+    @return  Y coordinate on display (at its current rotation).
+  */
+  int16_t bandY(void) const { return _bandY; }
+
+  /*!
+    @brief   Get the number of display rows covered by the current band.
+             Same as the band height except possibly for the last band of
+             a frame, whose canvas may extend past the bottom of the screen.
+    @return  Row count.
+  */
+  int16_t bandRows(void) const { return _bandRows; }
+
+private:
+  void pushBand(void);
+
+  Adafruit_SPITFT *_tft;              ///< Display to push bands to
+  GFXcanvas16 *_band[BAND_MAX_BANDS]; ///< Band buffers
+  uint16_t _bandHeight;               ///< Rows per band
+  uint8_t _numBands;                  ///< # of band buffers
+  uint8_t _bandIdx;                   ///< Index of band being drawn
+  int16_t _bandY;                     ///< Display row of current band
+  int16_t _bandRows;                  ///< Display rows in current band
+  bool _drawing;                      ///< true if a band awaits pushing
+  bool _inFrame;                      ///< true between start/endFrame()
+};
+
+#endif // end __AVR_ATtiny85__
+#endif // end _ADAFRUIT_BANDRENDERER_H_
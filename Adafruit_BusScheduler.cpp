@@ -0,0 +1,205 @@
+/*!
+ * @file Adafruit_BusScheduler.cpp
+ *
+ * Part of Adafruit's GFX graphics library. Shared-bus push queue for
+ * several Adafruit_SPITFT displays. See Adafruit_BusScheduler.h for
+ * usage.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_BusScheduler.h"
+
+/*!
+    @brief  Constructor. The queue starts empty; displays need no setup
+            beyond their own begin().
+*/
+Adafruit_BusScheduler::Adafruit_BusScheduler(void) : _head(0), _count(0) {}
+
+/*!
+    @brief  Destructor, finishes any queued pushes (their buffers may be
+            freed right after).
+*/
+Adafruit_BusScheduler::~Adafruit_BusScheduler(void) { wait(); }
+
+/*!
+    @brief   Queue a rectangle of pixels to send to a display.
+    @param   tft        Display to send to.
+    @param   x          Display column of the rect's left edge. Like
+                        Adafruit_SPITFT::flushCanvas(), a display position,
+                        unaffected by setOrigin() or any clip rect.
+    @param   y          Display row of the rect's top edge.
+    @param   w          Width of rect in pixels.
+    @param   h          Height of rect in pixels.
+    @param   pixels     w * h 16-bit 5-6-5 pixels, row by row. Read until
+                        the push is finished, so must be left alone (and
+                        allocated) until then.
+    @param   bigEndian  true if pixels are already in display byte order,
+                        as in a big-endian GFXcanvas16.
+    @return  true if queued; false if the rect is entirely off screen.
+             If the queue is full, first waits for a slot.
+*/
+bool Adafruit_BusScheduler::push(Adafruit_SPITFT *tft, int16_t x, int16_t y,
+                                 int16_t w, int16_t h, uint16_t *pixels,
+                                 bool bigEndian) {
+  return add(tft, x, y, w, h, pixels, w, bigEndian);
+}
+
+/*!
+    @brief   Queue a GFXcanvas16 to send to a display: the areas changed
+             since it was last pushed if it tracks them (see
+             GFXcanvas16::setDirtyTracking()), each its own push, else the
+             whole canvas. The dirty list is cleared as they're queued.
+             Buffer is sent as-is (unrotated), as by flushCanvas().
+    @param   tft     Display to send to.
+    @param   x       Display column of the canvas's left edge.
+    @param   y       Display row of the canvas's top edge.
+    @param   canvas  Canvas to send. Don't draw into it again until wait()
+                     for this display.
+    @return  true if anything was queued.
+*/
+bool Adafruit_BusScheduler::push(Adafruit_SPITFT *tft, int16_t x, int16_t y,
+                                 GFXcanvas16 *canvas) {
+  uint16_t *buf = canvas->getBuffer();
+  if (!buf)
+    return false;
+  // Canvas buffer is always laid out at its rotation-0 dimensions
+  int16_t cw = canvas->width(), ch = canvas->height();
+  if (canvas->getRotation() & 1) {
+    int16_t t = cw;
+    cw = ch;
+    ch = t;
+  }
+  bool bigEndian = canvas->getBigEndian(), any = false;
+  if (!canvas->getDirtyTracking())
+    return add(tft, x, y, cw, ch, buf, cw, bigEndian);
+  int16_t rx, ry, rw, rh;
+  for (uint8_t i = 0; canvas->getDirtyRect(i, &rx, &ry, &rw, &rh); i++)
+    any |= add(tft, x + rx, y + ry, rw, rh, &buf[ry * cw + rx], cw,
+               bigEndian);
+  canvas->clearDirty();
+  return any;
+}
+
+/*!
+    @brief   Move the queue along without waiting: finish the push under
+             way if its transfer is done, and start the next. Called by
+             push() and wait(); call it from the main loop as well to
+             keep the bus busy while drawing takes a while.
+    @return  true if the queue is empty, false if a push is still under
+             way (or queued).
+*/
+bool Adafruit_BusScheduler::poll(void) {
+  while (_count) {
+    Job *job = &_job[_head];
+    if (!job->sent) { // Select display, set window, start sending
+      job->tft->startWrite();
+      job->tft->writeAddrWindow(job->x, job->y, job->w, job->h);
+      issue(job);
+      continue; // Maybe done already, if the platform blocks
+    }
+    if (job->tft->dmaBusy())
+      return false;
+    job->tft->dmaWait(); // Last few bytes; also required before any more
+    if (job->sent < job->h) {
+      issue(job);
+      continue;
+    }
+    job->tft->endWrite(); // Free the bus for the next display
+    _head = (_head + 1) % BUS_MAX_JOBS;
+    _count--;
+  }
+  return true;
+}
+
+/*!
+    @brief   Check for pushes not yet finished.
+    @param   tft  Display to check for, or NULL (default) for any.
+    @return  true if a push to that display is queued or under way (so
+             its pixels mustn't be changed yet).
+*/
+bool Adafruit_BusScheduler::busy(const Adafruit_SPITFT *tft) const {
+  for (uint8_t i = 0; i < _count; i++) {
+    if (!tft || (_job[(_head + i) % BUS_MAX_JOBS].tft == tft))
+      return true;
+  }
+  return false;
+}
+
+/*!
+    @brief  Wait for pushes to finish, sending any queued ahead of them.
+    @param  tft  Display whose pushes to wait for, or NULL (default) to
+                 empty the queue.
+*/
+void Adafruit_BusScheduler::wait(const Adafruit_SPITFT *tft) {
+  while (busy(tft))
+    poll();
+}
+
+/*!
+    @brief   Clip a push to its display's edges and queue it.
+    @param   tft        Display to send to.
+    @param   x          Display column of the rect's left edge.
+    @param   y          Display row of the rect's top edge.
+    @param   w          Width of rect in pixels.
+    @param   h          Height of rect in pixels.
+    @param   pixels     First pixel of the rect's top row.
+    @param   stride     Pixels from the start of one row to the next.
+    @param   bigEndian  true if pixels are in display byte order.
+    @return  true if queued, false if off screen.
+*/
+bool Adafruit_BusScheduler::add(Adafruit_SPITFT *tft, int16_t x, int16_t y,
+                                int16_t w, int16_t h, uint16_t *pixels,
+                                int16_t stride, bool bigEndian) {
+  if (x < 0) {
+    pixels -= x;
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    pixels -= (int32_t)y * stride;
+    h += y;
+    y = 0;
+  }
+  if (w > tft->width() - x)
+    w = tft->width() - x;
+  if (h > tft->height() - y)
+    h = tft->height() - y;
+  if ((w <= 0) || (h <= 0))
+    return false;
+  while (_count == BUS_MAX_JOBS)
+    poll(); // Wait for a free slot
+  Job *job = &_job[(_head + _count) % BUS_MAX_JOBS];
+  job->tft = tft;
+  job->pixels = pixels;
+  job->stride = stride;
+  job->x = x;
+  job->y = y;
+  job->w = w;
+  job->h = h;
+  job->sent = 0;
+  job->bigEndian = bigEndian;
+  _count++;
+  poll(); // Start it now if the bus is free
+  return true;
+}
+
+/*!
+    @brief  Start sending a push's next pixels, non-blocking: all its rows
+            at once if they're contiguous in memory, else the next row.
+    @param  job  Push under way, its window already set.
+*/
+void Adafruit_BusScheduler::issue(Job *job) {
+  int16_t rows = (job->w == job->stride) ? job->h - job->sent : 1;
+  job->tft->writePixels(&job->pixels[(int32_t)job->sent * job->stride],
+                        (uint32_t)job->w * rows, false, job->bigEndian);
+  job->sent += rows;
+}
+
+#endif // end __AVR_ATtiny85__
@@ -0,0 +1,95 @@
+/*!
+ * @file Adafruit_BusScheduler.h
+ *
+ * Part of Adafruit's GFX graphics library. Queues pixel pushes for
+ * several Adafruit_SPITFT displays sharing one SPI bus and issues them
+ * in turn, so drawing for one display overlaps the DMA transfer to
+ * another.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_BUSSCHEDULER_H_
+#define _ADAFRUIT_BUSSCHEDULER_H_
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_SPITFT.h"
+
+#ifndef BUS_MAX_JOBS
+#define BUS_MAX_JOBS 8 ///< Max # of pushes a scheduler holds queued
+#endif
+
+/*!
+  @brief  Owns the bus for displays that share one SPI bus (each with its
+          own chip select): pushes of pixels from memory, such as
+          finished canvases, are queued here rather than made directly,
+          then issued one after another, each in its display's own
+          transaction and address window. A push returns as soon as it
+          is queued (or, with the bus idle, under way), so the CPU can
+          draw a frame for the next display while DMA sends the last.
+          Typical use with one canvas per display:
+
+              bus.push(&tftA, 0, 0, &canvasA); // Starts sending A
+              bus.wait(&tftB);                 // canvasB out of use...
+              drawDial(&canvasB);              // ...drawn as A sends
+              bus.push(&tftB, 0, 0, &canvasB); // Sends B once A is done
+              bus.wait(&tftA);
+              drawGauge(&canvasA);             // Drawn as B sends
+              ...
+
+          A queued buffer is read until its push is finished: don't draw
+          into it before wait() for its display (or busy() is false).
+          While the scheduler has work, draw to the displays on its bus
+          only through it (or call wait() first), since a direct draw
+          would select a display mid-transfer.
+
+          Where transfers block regardless (no DMA, or a platform whose
+          writePixels() waits), pushes simply go in order.
+*/
+class Adafruit_BusScheduler {
+public:
+  Adafruit_BusScheduler(void);
+  ~Adafruit_BusScheduler(void);
+  bool push(Adafruit_SPITFT *tft, int16_t x, int16_t y, int16_t w, int16_t h,
+            uint16_t *pixels, bool bigEndian = false);
+  bool push(Adafruit_SPITFT *tft, int16_t x, int16_t y, GFXcanvas16 *canvas);
+  bool poll(void);
+  bool busy(const Adafruit_SPITFT *tft = NULL) const;
+  void wait(const Adafruit_SPITFT *tft = NULL);
+
+  /*!
+    @brief   Get the number of pushes queued, including one under way.
+    @return  0 thru BUS_MAX_JOBS.
+  */
+  uint8_t queued(void) const { return _count; }
+
+private:
+  /// One queued push: a rect of a display and where its pixels are
+  typedef struct {
+    Adafruit_SPITFT *tft; ///< Display to send to
+    uint16_t *pixels;     ///< First pixel of the rect's top row
+    int16_t stride;       ///< Pixels from one row's start to the next
+    int16_t x;            ///< Display column of rect's left edge
+    int16_t y;            ///< Display row of rect's top edge
+    int16_t w;            ///< Width of rect
+    int16_t h;            ///< Height of rect
+    int16_t sent;         ///< Rows issued, 0 if not started
+    bool bigEndian;       ///< If set, pixels are in display byte order
+  } Job;
+
+  bool add(Adafruit_SPITFT *tft, int16_t x, int16_t y, int16_t w, int16_t h,
+           uint16_t *pixels, int16_t stride, bool bigEndian);
+  void issue(Job *job);
+
+  Job _job[BUS_MAX_JOBS]; ///< Ring of queued pushes
+  uint8_t _head;          ///< Index of oldest (current) push
+  uint8_t _count;         ///< Pushes queued
+};
+
+#endif // end __AVR_ATtiny85__
+#endif // end _ADAFRUIT_BUSSCHEDULER_H_
@@ -0,0 +1,542 @@
+/*!
+ * @file Adafruit_Compositor.cpp
+ *
+ * Part of Adafruit's GFX graphics library. Scanline compositor for canvas
+ * and sprite layers. See Adafruit_Compositor.h for usage.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_Compositor.h"
+
+// Line buffers hold pixels in the order writePixels() sends fastest
+#if defined(SPITFT_PRESWAP)
+#define COMP_BIG_ENDIAN true ///< Line buffers are big-endian
+#else
+#define COMP_BIG_ENDIAN false ///< Line buffers are native order
+#endif
+
+/*!
+    @brief  Constructor. Nothing is allocated until begin().
+    @param  tft        Display to composite onto.
+    @param  maxLayers  Number of layers that can be added, up to 127.
+*/
+Adafruit_Compositor::Adafruit_Compositor(Adafruit_SPITFT *tft,
+                                         uint8_t maxLayers)
+    : _tft(tft), _layer(NULL), _order(NULL), _width(0), _height(0),
+      _background(0), _maxLayers((maxLayers > 127) ? 127 : maxLayers),
+      _numLayers(0), _numDirty(0) {
+  _line[0] = _line[1] = NULL;
+}
+
+/*!
+    @brief  Destructor, frees the layer table and line buffers. Canvases
+            and sprites belong to the caller and are left alone.
+*/
+Adafruit_Compositor::~Adafruit_Compositor(void) {
+  delete[] _layer;
+  free(_order);
+  free(_line[0]);
+  free(_line[1]);
+}
+
+/*!
+    @brief   Allocate the layer table and line buffers. Call after the
+             display's begin() and setRotation(), since layers are placed
+             in display coordinates at that rotation. Calling it again
+             (after a rotation change) keeps existing layers.
+    @return  true on success, false if anything couldn't be allocated.
+*/
+bool Adafruit_Compositor::begin(void) {
+  _width = _tft->width();
+  _height = _tft->height();
+  _numDirty = 0;
+  if (!_layer) {
+    _layer = new CompositorLayer[_maxLayers];
+    if (!_layer)
+      return false;
+    for (uint8_t i = 0; i < _maxLayers; i++)
+      _layer[i].used = false;
+  }
+  if (!_order && !(_order = (uint8_t *)malloc(_maxLayers)))
+    return false;
+  for (uint8_t i = 0; i < 2; i++) {
+    free(_line[i]);
+    _line[i] = (uint16_t *)malloc(_width * sizeof(uint16_t));
+  }
+  if (!_line[0] || !_line[1]) {
+    free(_line[0]); // update() won't run with either missing
+    _line[0] = NULL;
+    return false;
+  }
+  return true;
+}
+
+/*!
+    @brief   Add a canvas layer, initially opaque and visible.
+    @param   canvas  Canvas to composite, its buffer as drawn at rotation
+                     0. It must remain allocated while it is a layer.
+    @param   x       Screen column of canvas's left edge (may be < 0).
+    @param   y       Screen row of canvas's top edge (may be < 0).
+    @param   z       Stacking order; higher is in front, and among equal
+                     z the most recently added or restacked is in front.
+    @return  Layer id for the other calls, or -1 if no slot is free, the
+             canvas has no buffer, or begin() wasn't successful.
+*/
+int8_t Adafruit_Compositor::addLayer(GFXcanvas16 *canvas, int16_t x,
+                                     int16_t y, int8_t z) {
+  if (!_order || !canvas || !canvas->getBuffer())
+    return -1;
+  for (uint8_t i = 0; i < _maxLayers; i++) {
+    CompositorLayer *l = &_layer[i];
+    if (!l->used) {
+      bool odd = canvas->getRotation() & 1;
+      l->canvas = canvas;
+      l->sprite = NULL;
+      l->x = x;
+      l->y = y;
+      l->w = odd ? canvas->height() : canvas->width();
+      l->h = odd ? canvas->width() : canvas->height();
+      l->z = z;
+      l->used = l->visible = true;
+      l->keyed = false;
+      sortLayers();
+      markLayer(l);
+      return i;
+    }
+  }
+  return -1;
+}
+
+/*!
+    @brief   Add a compressed sprite layer, visible. Pixels the sprite
+             skips show the layers behind it.
+    @param   sprite  Sprite (PROGMEM) in drawSprite() format.
+    @param   x       Screen column of sprite's left edge (may be < 0).
+    @param   y       Screen row of sprite's top edge (may be < 0).
+    @param   z       Stacking order, as for a canvas layer.
+    @return  Layer id, or -1 if no slot is free or begin() wasn't
+             successful.
+*/
+int8_t Adafruit_Compositor::addLayer(const uint8_t *sprite, int16_t x,
+                                     int16_t y, int8_t z) {
+  if (!_order || !sprite)
+    return -1;
+  for (uint8_t i = 0; i < _maxLayers; i++) {
+    CompositorLayer *l = &_layer[i];
+    if (!l->used) {
+      l->canvas = NULL;
+      l->sprite = sprite;
+      l->x = x;
+      l->y = y;
+      l->w = GFXspriteReader::width(sprite);
+      l->h = GFXspriteReader::height(sprite);
+      l->z = z;
+      l->used = l->visible = true;
+      l->keyed = false;
+      sortLayers();
+      markLayer(l);
+      return i;
+    }
+  }
+  return -1;
+}
+
+/*!
+    @brief  Remove a layer. What it covered is recomposited next update().
+    @param  id  Layer id from addLayer().
+*/
+void Adafruit_Compositor::removeLayer(int8_t id) {
+  CompositorLayer *l = layer(id);
+  if (l) {
+    markLayer(l);
+    l->used = false;
+    sortLayers();
+  }
+}
+
+/*!
+    @brief  Move a layer. Only its old and new areas are recomposited.
+    @param  id  Layer id from addLayer().
+    @param  x   New screen column of layer's left edge.
+    @param  y   New screen row of layer's top edge.
+*/
+void Adafruit_Compositor::moveLayer(int8_t id, int16_t x, int16_t y) {
+  CompositorLayer *l = layer(id);
+  if (l && ((x != l->x) || (y != l->y))) {
+    markLayer(l);
+    l->x = x;
+    l->y = y;
+    markLayer(l);
+  }
+}
+
+/*!
+    @brief  Restack a layer, in front of any others of the same z.
+    @param  id  Layer id from addLayer().
+    @param  z   New stacking order, higher is in front.
+*/
+void Adafruit_Compositor::setLayerZ(int8_t id, int8_t z) {
+  CompositorLayer *l = layer(id);
+  if (l) {
+    l->z = z;
+    l->used = false; // Drop from the order and add back at the end
+    sortLayers();
+    l->used = true;
+    sortLayers();
+    markLayer(l);
+  }
+}
+
+/*!
+    @brief  Show or hide a layer. A hidden layer keeps its place.
+    @param  id       Layer id from addLayer().
+    @param  visible  true to show, false to hide.
+*/
+void Adafruit_Compositor::setLayerVisible(int8_t id, bool visible) {
+  CompositorLayer *l = layer(id);
+  if (l && (visible != l->visible)) {
+    markLayer(l); // One of these two is a no-op
+    l->visible = visible;
+    markLayer(l);
+  }
+}
+
+/*!
+    @brief  Make one color of a canvas layer transparent.
+    @param  id   Layer id of a canvas layer.
+    @param  key  16-bit color through which layers behind show.
+*/
+void Adafruit_Compositor::setLayerKey(int8_t id, uint16_t key) {
+  CompositorLayer *l = layer(id);
+  if (l && l->canvas) {
+    l->key = key;
+    l->keyed = true;
+    markLayer(l);
+  }
+}
+
+/*!
+    @brief  Make a canvas layer opaque again (the default).
+    @param  id  Layer id of a canvas layer.
+*/
+void Adafruit_Compositor::clearLayerKey(int8_t id) {
+  CompositorLayer *l = layer(id);
+  if (l && l->canvas && l->keyed) {
+    l->keyed = false;
+    markLayer(l);
+  }
+}
+
+/*!
+    @brief  Change a sprite layer's image, e.g. to the next frame of an
+            animation. The old and new sprite share a top-left corner.
+    @param  id      Layer id of a sprite layer.
+    @param  sprite  New sprite (PROGMEM).
+*/
+void Adafruit_Compositor::setSprite(int8_t id, const uint8_t *sprite) {
+  CompositorLayer *l = layer(id);
+  if (l && l->sprite && sprite && (sprite != l->sprite)) {
+    markLayer(l);
+    l->sprite = sprite;
+    l->w = GFXspriteReader::width(sprite);
+    l->h = GFXspriteReader::height(sprite);
+    markLayer(l);
+  }
+}
+
+/*!
+    @brief  Recomposite a whole layer next update(), e.g. after drawing
+            into its canvas.
+    @param  id  Layer id from addLayer().
+*/
+void Adafruit_Compositor::invalidate(int8_t id) {
+  CompositorLayer *l = layer(id);
+  if (l)
+    markLayer(l);
+}
+
+/*!
+    @brief  Recomposite a screen area next update(). Areas that overlap
+            are merged, and once COMPOSITOR_MAX_DIRTY are pending, a new
+            one is merged with whichever makes the smallest union.
+    @param  x  Left edge, in display coordinates at begin()'s rotation.
+    @param  y  Top edge.
+    @param  w  Width in pixels.
+    @param  h  Height in pixels.
+*/
+void Adafruit_Compositor::invalidate(int16_t x, int16_t y, int16_t w,
+                                     int16_t h) {
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (x + w > _width)
+    w = _width - x;
+  if (y + h > _height)
+    h = _height - y;
+  if ((w <= 0) || (h <= 0))
+    return;
+  int16_t x2 = x + w, y2 = y + h; // Exclusive
+  for (;;) {
+    uint8_t i;
+    for (i = 0; i < _numDirty; i++) {
+      int16_t *d = _dirty[i];
+      if ((d[0] < x2) && (d[0] + d[2] > x) && (d[1] < y2) &&
+          (d[1] + d[3] > y))
+        break;
+    }
+    if (i == _numDirty) { // Overlaps none
+      if (_numDirty < COMPOSITOR_MAX_DIRTY) {
+        int16_t *d = _dirty[_numDirty++];
+        d[0] = x;
+        d[1] = y;
+        d[2] = x2 - x;
+        d[3] = y2 - y;
+        return;
+      }
+      int32_t best = 0x7FFFFFFF;
+      for (uint8_t j = 0; j < _numDirty; j++) {
+        int16_t *d = _dirty[j];
+        int16_t dx2 = d[0] + d[2], dy2 = d[1] + d[3];
+        int32_t uw = ((x2 > dx2) ? x2 : dx2) - ((x < d[0]) ? x : d[0]);
+        int32_t uh = ((y2 > dy2) ? y2 : dy2) - ((y < d[1]) ? y : d[1]);
+        if (uw * uh < best) {
+          best = uw * uh;
+          i = j;
+        }
+      }
+    }
+    // Absorb area i, then look again, as the union may overlap others
+    int16_t *d = _dirty[i];
+    if (x2 < d[0] + d[2])
+      x2 = d[0] + d[2];
+    if (y2 < d[1] + d[3])
+      y2 = d[1] + d[3];
+    if (x > d[0])
+      x = d[0];
+    if (y > d[1])
+      y = d[1];
+    int16_t *last = _dirty[--_numDirty];
+    for (uint8_t j = 0; j < 4; j++)
+      d[j] = last[j];
+  }
+}
+
+/*!
+    @brief  Composite and push every area changed since the last update.
+*/
+void Adafruit_Compositor::update(void) {
+  if (!_line[0] || !_numDirty)
+    return;
+  _tft->startWrite();
+  for (uint8_t i = 0; i < _numDirty; i++)
+    composite(_dirty[i][0], _dirty[i][1], _dirty[i][2], _dirty[i][3]);
+  _tft->dmaWait();
+  _tft->endWrite();
+  _numDirty = 0;
+}
+
+/*!
+    @brief  Composite and push the whole screen.
+*/
+void Adafruit_Compositor::refresh(void) {
+  _numDirty = 0;
+  invalidate(0, 0, _width, _height);
+  update();
+}
+
+/*!
+    @brief   Look up a layer by id.
+    @param   id  Layer id from addLayer().
+    @return  The layer, or NULL if id isn't a current layer.
+*/
+CompositorLayer *Adafruit_Compositor::layer(int8_t id) {
+  if (!_layer || (id < 0) || (id >= _maxLayers) || !_layer[id].used)
+    return NULL;
+  return &_layer[id];
+}
+
+/*!
+    @brief  Mark a layer's screen area for the next update(), if visible.
+    @param  l  Layer.
+*/
+void Adafruit_Compositor::markLayer(CompositorLayer *l) {
+  if (l->visible)
+    invalidate(l->x, l->y, l->w, l->h);
+}
+
+/*!
+    @brief  Bring the back-to-front order up to date after a layer was
+            added or removed: stale entries are dropped, keeping the rest
+            in order, and new slots go after all others of equal or lower
+            z.
+*/
+void Adafruit_Compositor::sortLayers(void) {
+  uint8_t n = 0;
+  for (uint8_t k = 0; k < _numLayers; k++) {
+    if (_layer[_order[k]].used)
+      _order[n++] = _order[k];
+  }
+  for (uint8_t i = 0; i < _maxLayers; i++) {
+    if (!_layer[i].used)
+      continue;
+    uint8_t k;
+    for (k = 0; (k < n) && (_order[k] != i); k++)
+      ;
+    if (k < n)
+      continue; // Already in order
+    for (k = n; (k > 0) && (_layer[_order[k - 1]].z > _layer[i].z); k--)
+      _order[k] = _order[k - 1];
+    _order[k] = i;
+    n++;
+  }
+  _numLayers = n;
+}
+
+/*!
+    @brief  Composite one screen area into the line buffers and push it
+            as a single address window, one line at a time.
+    @param  x  Left edge on screen, clipped to the screen.
+    @param  y  Top edge on screen.
+    @param  w  Width in pixels.
+    @param  h  Height in pixels.
+*/
+void Adafruit_Compositor::composite(int16_t x, int16_t y, int16_t w,
+                                    int16_t h) {
+  // Layers behind the frontmost opaque canvas covering the whole area are
+  // hidden by it, so compositing starts there (or with background).
+  uint8_t first = 0;
+  bool covered = false;
+  for (uint8_t k = _numLayers; k--;) {
+    CompositorLayer *l = &_layer[_order[k]];
+    if (l->canvas && l->visible && !l->keyed && (l->x <= x) &&
+        (l->y <= y) && (l->x + l->w >= x + w) && (l->y + l->h >= y + h)) {
+      first = k;
+      covered = true;
+      break;
+    }
+  }
+  for (uint8_t k = first; k < _numLayers; k++) {
+    CompositorLayer *l = &_layer[_order[k]];
+    if (l->sprite) { // Rewind; rows are decoded top to bottom
+      l->reader = GFXspriteReader(l->sprite);
+      l->pos = 0;
+      l->left = 0;
+    }
+  }
+  uint16_t bg = COMP_BIG_ENDIAN ? __builtin_bswap16(_background) : _background;
+  uint8_t idx = 0;
+  _tft->dmaWait(); // Prior area must finish before addressing this one
+  _tft->writeAddrWindow(x, y, w, h);
+  for (int16_t row = y; row < y + h; row++) {
+    // The buffer last sent two lines ago; writePixels() waits for each
+    // transfer to finish before starting the next, so it's free again.
+    uint16_t *buf = _line[idx];
+    if (!covered) {
+      for (int16_t i = 0; i < w; i++)
+        buf[i] = bg;
+    }
+    for (uint8_t k = first; k < _numLayers; k++) {
+      CompositorLayer *l = &_layer[_order[k]];
+      if (!l->visible || (row < l->y) || (row >= l->y + l->h))
+        continue;
+      int16_t a = (l->x > x) ? l->x : x; // Columns [a,b) are in both
+      int16_t b = (l->x + l->w < x + w) ? l->x + l->w : x + w;
+      if (a >= b)
+        continue;
+      if (l->canvas)
+        paintCanvas(l, &buf[a - x], row - l->y, a - l->x, b - a);
+      else
+        paintSprite(l, &buf[a - x], row - l->y, a - l->x, b - a);
+    }
+    _tft->writePixels(buf, w, false, COMP_BIG_ENDIAN);
+    idx ^= 1;
+  }
+}
+
+/*!
+    @brief  Paint part of one row of a canvas layer into a line buffer.
+    @param  l    Canvas layer.
+    @param  dst  Line buffer position of the first pixel.
+    @param  row  Row within the canvas.
+    @param  i0   First column within the canvas.
+    @param  n    Number of pixels.
+*/
+void Adafruit_Compositor::paintCanvas(CompositorLayer *l, uint16_t *dst,
+                                      int16_t row, int16_t i0, int16_t n) {
+  bool big = l->canvas->getBigEndian(), swap = (big != COMP_BIG_ENDIAN);
+  const uint16_t *src = l->canvas->getBuffer() + (int32_t)row * l->w + i0;
+  if (!l->keyed) {
+    if (!swap) {
+      memcpy(dst, src, n * sizeof(uint16_t));
+    } else {
+      while (n--)
+        *dst++ = __builtin_bswap16(*src++);
+    }
+  } else { // Compare in the canvas's byte order
+    uint16_t key = big ? __builtin_bswap16(l->key) : l->key;
+    for (; n--; dst++) {
+      uint16_t c = *src++;
+      if (c != key)
+        *dst = swap ? __builtin_bswap16(c) : c;
+    }
+  }
+}
+
+/*!
+    @brief  Paint part of one row of a sprite layer into a line buffer.
+            Calls for a layer must be in increasing row order since the
+            last rewind; the decoder skips ahead to each row's pixels.
+    @param  l    Sprite layer.
+    @param  dst  Line buffer position of the first pixel.
+    @param  row  Row within the sprite.
+    @param  i0   First column within the sprite.
+    @param  n    Number of pixels.
+*/
+void Adafruit_Compositor::paintSprite(CompositorLayer *l, uint16_t *dst,
+                                      int16_t row, int16_t i0, int16_t n) {
+  uint32_t pos = (uint32_t)row * l->w + i0;
+  while (l->pos < pos) {
+    if (!l->left)
+      l->op = l->reader.next(&l->left);
+    uint16_t k = (pos - l->pos < l->left) ? pos - l->pos : l->left;
+    if (l->op == GFXSPRITE_LITERAL)
+      l->reader.skip(k);
+    l->left -= k;
+    l->pos += k;
+  }
+  while (n) {
+    if (!l->left)
+      l->op = l->reader.next(&l->left);
+    uint16_t k = ((uint16_t)n < l->left) ? n : l->left;
+    if (l->op == GFXSPRITE_RUN) {
+      uint16_t c = l->reader.runColor();
+      if (COMP_BIG_ENDIAN)
+        c = __builtin_bswap16(c);
+      for (uint16_t i = 0; i < k; i++)
+        dst[i] = c;
+    } else if (l->op == GFXSPRITE_LITERAL) {
+      for (uint16_t i = 0; i < k; i++) {
+        uint16_t c = l->reader.pixel();
+        dst[i] = COMP_BIG_ENDIAN ? __builtin_bswap16(c) : c;
+      }
+    }
+    dst += k;
+    l->left -= k;
+    l->pos += k;
+    n -= k;
+  }
+}
+
+#endif // end __AVR_ATtiny85__
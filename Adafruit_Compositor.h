@@ -0,0 +1,124 @@
+/*!
+ * @file Adafruit_Compositor.h
+ *
+ * Part of Adafruit's GFX graphics library. Stacks GFXcanvas16 and
+ * compressed sprite layers at arbitrary positions and z-order and
+ * composites whatever changed, a scanline at a time, straight to an
+ * Adafruit_SPITFT display, so moving things never flicker.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_COMPOSITOR_H_
+#define _ADAFRUIT_COMPOSITOR_H_
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_SPITFT.h"
+
+#ifndef COMPOSITOR_MAX_DIRTY
+#define COMPOSITOR_MAX_DIRTY 4 ///< Separate areas tracked for next update()
+#endif
+
+/// One layer of an Adafruit_Compositor, a canvas or a sprite, plus the
+/// state of decoding the sprite during a pass
+typedef struct {
+  GFXcanvas16 *canvas;    ///< Canvas of a canvas layer, else NULL
+  const uint8_t *sprite;  ///< Sprite (PROGMEM) of a sprite layer, else NULL
+  GFXspriteReader reader; ///< Sprite decoder
+  uint32_t pos;           ///< Sprite pixels decoded so far
+  uint16_t left;          ///< Pixels left in current sprite op
+  uint8_t op;             ///< Current sprite op, GFXSPRITE_*
+  int16_t x;              ///< Left edge on screen
+  int16_t y;              ///< Top edge on screen
+  int16_t w;              ///< Width in pixels
+  int16_t h;              ///< Height in pixels
+  uint16_t key;           ///< Transparent color of a keyed canvas
+  int8_t z;               ///< Stacking order, higher is in front
+  bool used;              ///< true if this slot holds a layer
+  bool visible;           ///< true if the layer is drawn
+  bool keyed;             ///< true if canvas pixels of key are transparent
+} CompositorLayer;
+
+/*!
+  @brief  A stack of layers composited onto the display: full or
+          partial-screen GFXcanvas16 buffers (optionally with a
+          transparent key color) and compressed sprites (transparent
+          wherever the sprite skips). Typical use:
+
+              Adafruit_Compositor comp(&tft);
+              comp.begin();          // After tft.setRotation()
+              int8_t dial = comp.addLayer(&dialCanvas, 40, 40);
+              int8_t hand = comp.addLayer(handSprite, 100, 60, 1);
+              comp.refresh();        // Whole screen once
+              ...
+              comp.moveLayer(hand, 104, 58);
+              comp.update();         // Just where the hand was and is
+
+          Changes to layers (moving, restacking, new sprite frames, or
+          invalidate() after drawing into a canvas) mark the affected
+          screen areas, and update() recomposites only those. Each area
+          is one address window, sent a line at a time from a line
+          buffer into which every layer touching that line is painted
+          back to front, so each screen pixel is written once, with its
+          final color. Pixels no layer covers get the background color.
+
+          Canvases are composited as their buffers are laid out, i.e. as
+          drawn at rotation 0. With DMA, the next line is composited
+          while the prior one transfers.
+*/
+class Adafruit_Compositor {
+public:
+  Adafruit_Compositor(Adafruit_SPITFT *tft, uint8_t maxLayers = 8);
+  ~Adafruit_Compositor(void);
+  bool begin(void);
+  int8_t addLayer(GFXcanvas16 *canvas, int16_t x, int16_t y, int8_t z = 0);
+  int8_t addLayer(const uint8_t *sprite, int16_t x, int16_t y, int8_t z = 0);
+  void removeLayer(int8_t id);
+  void moveLayer(int8_t id, int16_t x, int16_t y);
+  void setLayerZ(int8_t id, int8_t z);
+  void setLayerVisible(int8_t id, bool visible);
+  void setLayerKey(int8_t id, uint16_t key);
+  void clearLayerKey(int8_t id);
+  void setSprite(int8_t id, const uint8_t *sprite);
+  void invalidate(int8_t id);
+  void invalidate(int16_t x, int16_t y, int16_t w, int16_t h);
+  void update(void);
+  void refresh(void);
+
+  /*!
+    @brief  Set the color of pixels no layer covers. Takes effect where
+            the screen is next composited; refresh() to apply everywhere.
+    @param  color  16-bit color, default is 0 (black).
+  */
+  void setBackground(uint16_t color) { _background = color; }
+
+private:
+  void markLayer(CompositorLayer *l);
+  void sortLayers(void);
+  void composite(int16_t x, int16_t y, int16_t w, int16_t h);
+  void paintCanvas(CompositorLayer *l, uint16_t *dst, int16_t row,
+                   int16_t i0, int16_t n);
+  void paintSprite(CompositorLayer *l, uint16_t *dst, int16_t row,
+                   int16_t i0, int16_t n);
+  CompositorLayer *layer(int8_t id);
+
+  Adafruit_SPITFT *_tft;                   ///< Display composited onto
+  CompositorLayer *_layer;                 ///< Layer slots
+  uint8_t *_order;                         ///< Used slots, back to front
+  uint16_t *_line[2];                      ///< Line buffers
+  int16_t _dirty[COMPOSITOR_MAX_DIRTY][4]; ///< Areas to update, x,y,w,h
+  int16_t _width;                          ///< Display width at begin()
+  int16_t _height;                         ///< Display height at begin()
+  uint16_t _background;                    ///< Color where no layer is
+  uint8_t _maxLayers;                      ///< # of layer slots
+  uint8_t _numLayers;                      ///< # of slots in use
+  uint8_t _numDirty;                       ///< # of _dirty areas
+};
+
+#endif // end __AVR_ATtiny85__
+#endif // end _ADAFRUIT_COMPOSITOR_H_
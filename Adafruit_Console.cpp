@@ -0,0 +1,515 @@
+/*!
+ * @file Adafruit_Console.cpp
+ *
+ * Part of Adafruit's GFX graphics library. Character-cell text console
+ * with changed-cell redraw and hardware or canvas scroll. See
+ * Adafruit_Console.h for usage.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_Console.h"
+
+// MIPI DCS commands shared by most TFT controllers
+#define CONSOLE_VSCRDEF 0x33  ///< Vertical scrolling definition
+#define CONSOLE_VSCRSADD 0x37 ///< Vertical scrolling start address
+
+#define CONSOLE_ATTR 0x0F ///< Initial colors, white (15) on black (0)
+
+/// CGA colors in RGB565, ANSI order: black, red, green, brown, blue,
+/// magenta, cyan, light gray, then the bright versions of each
+static const uint16_t PROGMEM consolePalette[16] = {
+    0x0000, 0xA800, 0x0540, 0xAAA0, 0x0015, 0xA815, 0x0555, 0xAD55,
+    0x52AA, 0xFAAA, 0x57EA, 0xFFEA, 0x52BF, 0xFABF, 0x57FF, 0xFFFF};
+
+/*!
+    @brief  Scroll a canvas's clip rect, for consoles on canvas type C.
+    @param  gfx   Canvas, as its Adafruit_GFX base.
+    @param  dy    Rows to move the contents down (negative is up).
+    @param  fill  Color for the rows uncovered.
+*/
+template <class C>
+static void consoleScroll(Adafruit_GFX *gfx, int16_t dy, uint16_t fill) {
+  static_cast<C *>(gfx)->scroll(0, dy, fill);
+}
+
+/*!
+    @brief  Constructor for a console on a display. Nothing is drawn or
+            allocated until begin().
+    @param  tft   Display the console is on.
+    @param  x     Left edge of console, in the display's drawing
+                  coordinates (its origin and clip rect apply).
+    @param  y     Top edge of console.
+    @param  cols  Width in character cells, each 6 * size pixels.
+    @param  rows  Height in character cells, each 8 * size pixels.
+    @param  size  Font magnification, default 1.
+*/
+Adafruit_Console::Adafruit_Console(Adafruit_SPITFT *tft, int16_t x, int16_t y,
+                                   uint8_t cols, uint8_t rows, uint8_t size) {
+  init(tft, x, y, cols, rows, size);
+  _tft = tft;
+}
+
+/*!
+    @brief  Constructor for a console on a 16-bit canvas, which is
+            scrolled in place. Nothing is drawn or allocated until begin().
+    @param  canvas  Canvas the console is drawn in.
+    @param  x       Left edge of console, in the canvas's drawing
+                    coordinates (its origin and clip rect apply).
+    @param  y       Top edge of console.
+    @param  cols    Width in character cells, each 6 * size pixels.
+    @param  rows    Height in character cells, each 8 * size pixels.
+    @param  size    Font magnification, default 1.
+*/
+Adafruit_Console::Adafruit_Console(GFXcanvas16 *canvas, int16_t x, int16_t y,
+                                   uint8_t cols, uint8_t rows, uint8_t size) {
+  init(canvas, x, y, cols, rows, size);
+  _scroll = consoleScroll<GFXcanvas16>;
+}
+
+/*!
+    @brief  Constructor for a console on an 8-bit canvas, which is
+            scrolled in place. Nothing is drawn or allocated until begin().
+    @param  canvas  Canvas the console is drawn in.
+    @param  x       Left edge of console, in the canvas's drawing
+                    coordinates (its origin and clip rect apply).
+    @param  y       Top edge of console.
+    @param  cols    Width in character cells, each 6 * size pixels.
+    @param  rows    Height in character cells, each 8 * size pixels.
+    @param  size    Font magnification, default 1.
+*/
+Adafruit_Console::Adafruit_Console(GFXcanvas8 *canvas, int16_t x, int16_t y,
+                                   uint8_t cols, uint8_t rows, uint8_t size) {
+  init(canvas, x, y, cols, rows, size);
+  _scroll = consoleScroll<GFXcanvas8>;
+}
+
+/*!
+    @brief  Constructor for a console on a 2- or 4-bit canvas, which is
+            scrolled in place. Nothing is drawn or allocated until begin().
+    @param  canvas  Canvas the console is drawn in.
+    @param  x       Left edge of console, in the canvas's drawing
+                    coordinates (its origin and clip rect apply).
+    @param  y       Top edge of console.
+    @param  cols    Width in character cells, each 6 * size pixels.
+    @param  rows    Height in character cells, each 8 * size pixels.
+    @param  size    Font magnification, default 1.
+*/
+Adafruit_Console::Adafruit_Console(GFXcanvasPacked *canvas, int16_t x,
+                                   int16_t y, uint8_t cols, uint8_t rows,
+                                   uint8_t size) {
+  init(canvas, x, y, cols, rows, size);
+  _scroll = consoleScroll<GFXcanvasPacked>;
+}
+
+/*!
+    @brief  Constructor for a console on a 1-bit canvas, which is
+            scrolled in place. Nothing is drawn or allocated until begin().
+    @param  canvas  Canvas the console is drawn in.
+    @param  x       Left edge of console, in the canvas's drawing
+                    coordinates (its origin and clip rect apply).
+    @param  y       Top edge of console.
+    @param  cols    Width in character cells, each 6 * size pixels.
+    @param  rows    Height in character cells, each 8 * size pixels.
+    @param  size    Font magnification, default 1.
+*/
+Adafruit_Console::Adafruit_Console(GFXcanvas1 *canvas, int16_t x, int16_t y,
+                                   uint8_t cols, uint8_t rows, uint8_t size) {
+  init(canvas, x, y, cols, rows, size);
+  _scroll = consoleScroll<GFXcanvas1>;
+}
+
+/*!
+    @brief  Constructor for a console on any other Adafruit_GFX target,
+            which scrolls by redrawing changed cells. Nothing is drawn or
+            allocated until begin().
+    @param  gfx   Display the console is on.
+    @param  x     Left edge of console, in the display's drawing
+                  coordinates (its origin and clip rect apply).
+    @param  y     Top edge of console.
+    @param  cols  Width in character cells, each 6 * size pixels.
+    @param  rows  Height in character cells, each 8 * size pixels.
+    @param  size  Font magnification, default 1.
+*/
+Adafruit_Console::Adafruit_Console(Adafruit_GFX *gfx, int16_t x, int16_t y,
+                                   uint8_t cols, uint8_t rows, uint8_t size) {
+  init(gfx, x, y, cols, rows, size);
+}
+
+/*!
+    @brief  Destructor, frees the cell buffer. Hardware scroll, if used,
+            is left as it is; clear() the console first to put the screen
+            back in place.
+*/
+Adafruit_Console::~Adafruit_Console(void) { free(_chars); }
+
+/*!
+    @brief  Member setup shared by the constructors.
+    @param  gfx   Display or canvas the console is on.
+    @param  x     Left edge of console.
+    @param  y     Top edge of console.
+    @param  cols  Width in character cells.
+    @param  rows  Height in character cells.
+    @param  size  Font magnification.
+*/
+void Adafruit_Console::init(Adafruit_GFX *gfx, int16_t x, int16_t y,
+                            uint8_t cols, uint8_t rows, uint8_t size) {
+  _gfx = gfx;
+  _tft = NULL;
+  _scroll = NULL;
+  _chars = _attrs = _dirty = NULL;
+  _x = x;
+  _y = y;
+  _cols = cols;
+  _rows = rows;
+  _size = size;
+  _dirtyStride = (cols + 7) / 8;
+  _top = _col = _row = 0;
+  _attr = CONSOLE_ATTR;
+  _mode = CONSOLE_REDRAW;
+  for (uint8_t i = 0; i < 16; i++)
+    _palette[i] = pgm_read_word(&consolePalette[i]);
+}
+
+/*!
+    @brief   Allocate the cell buffer, pick how to scroll, then clear the
+             console to the background color. Call after the display's
+             begin() and setRotation().
+    @param   hardwareScroll  true to use the panel's vertical scroll if the
+                             console is on an Adafruit_SPITFT and placed
+                             to allow it (see class notes). Panels whose
+                             frame memory is taller than the screen (e.g.
+                             ST7789 240x240) don't scroll correctly.
+    @return  true on success, false if the console has no cells or the
+             buffer couldn't be allocated.
+*/
+bool Adafruit_Console::begin(bool hardwareScroll) {
+  if (!_cols || !_rows || !_size)
+    return false;
+  if (!_chars) {
+    uint16_t cells = _cols * _rows;
+    _chars = (uint8_t *)malloc(cells * 2 + _rows * _dirtyStride);
+    if (!_chars)
+      return false;
+    _attrs = &_chars[cells];
+    _dirty = &_attrs[cells];
+  }
+
+  _mode = _scroll ? CONSOLE_CANVAS : CONSOLE_REDRAW;
+  if (hardwareScroll && _tft && !_tft->getRotation()) {
+    // Panel rows run across the screen at rotation 0, so the console must
+    // span them all; the lines above and below it are the fixed areas.
+    int16_t top = _y + _tft->getOriginY(), h = _rows * 8 * _size;
+    if (!(_x + _tft->getOriginX()) && (_cols * 6 * _size == _tft->width()) &&
+        (top >= 0) && (top + h <= _tft->height())) {
+      uint16_t bottom = _tft->height() - top - h;
+      uint8_t def[] = {(uint8_t)(top >> 8),    (uint8_t)top,
+                       (uint8_t)(h >> 8),      (uint8_t)h,
+                       (uint8_t)(bottom >> 8), (uint8_t)bottom};
+      _tft->sendCommand(CONSOLE_VSCRDEF, def, sizeof def);
+      _mode = CONSOLE_SCROLL;
+    }
+  }
+  clear();
+  return true;
+}
+
+/*!
+    @brief  Blank every cell in the current background color, fill the
+            console area with it, and home the cursor. With hardware
+            scroll, the scroll is put back to 0.
+*/
+void Adafruit_Console::clear(void) {
+  if (!_chars)
+    return;
+  for (uint8_t r = 0; r < _rows; r++)
+    clearLine(r);
+  _top = _col = _row = 0;
+  _gfx->fillRect(_x, _y, _cols * 6 * _size, _rows * 8 * _size, bgColor());
+  if (_mode == CONSOLE_SCROLL)
+    setScroll();
+}
+
+/*!
+    @brief  Draw the cells that changed since the last update(). Glyphs
+            are drawn opaque and upright in the classic font whatever the
+            target's current font and text orientation; runs of blank
+            cells are filled as one rect.
+*/
+void Adafruit_Console::update(void) {
+  if (!_chars)
+    return;
+  const GFXfont *font = _gfx->getFont();
+  uint8_t turn = _gfx->getTextOrientation();
+  if (font)
+    _gfx->setFont(NULL);
+  _gfx->setTextOrientation(0);
+  int16_t cw = 6 * _size, ch = 8 * _size;
+  for (uint8_t r = 0; r < _rows; r++) {
+    uint8_t *dirty = &_dirty[r * _dirtyStride];
+    int16_t py = lineY(r);
+    uint8_t *chars = &_chars[r * _cols], *attrs = &_attrs[r * _cols];
+    for (uint16_t c = 0; c < _cols; c++) {
+      if (!dirty[c >> 3]) { // Skip 8 clean cells at a time
+        c |= 7;
+        continue;
+      }
+      if (!(dirty[c >> 3] & (1 << (c & 7))))
+        continue;
+      uint16_t fg = _palette[attrs[c] & 15], bg = _palette[attrs[c] >> 4];
+      if ((chars[c] != ' ') && (fg != bg)) {
+        _gfx->drawChar(_x + c * cw, py, chars[c], fg, bg, _size, _size);
+        dirty[c >> 3] &= ~(1 << (c & 7));
+        continue;
+      }
+      // Blank: extend through following dirty blanks of the same color
+      uint16_t e = c; // Last cell of the run
+      for (;;) {
+        dirty[e >> 3] &= ~(1 << (e & 7));
+        uint16_t n = e + 1;
+        if ((n >= _cols) || !(dirty[n >> 3] & (1 << (n & 7))) ||
+            (_palette[attrs[n] >> 4] != bg) ||
+            ((chars[n] != ' ') && (_palette[attrs[n] & 15] != bg)))
+          break;
+        e = n;
+      }
+      _gfx->fillRect(_x + c * cw, py, (e - c + 1) * cw, ch, bg);
+      c = e;
+    }
+  }
+  if (font)
+    _gfx->setFont(font);
+  _gfx->setTextOrientation(turn);
+}
+
+/*!
+    @brief  Redraw every cell, e.g. after something else drew over the
+            console.
+*/
+void Adafruit_Console::refresh(void) {
+  if (!_chars)
+    return;
+  for (uint8_t r = 0; r < _rows; r++)
+    markLine(r);
+  update();
+}
+
+/*!
+    @brief  Move the cursor. Out-of-range positions are clipped to the
+            last column and row.
+    @param  col  Column, 0 at left.
+    @param  row  Row, 0 at top.
+*/
+void Adafruit_Console::setCursor(uint8_t col, uint8_t row) {
+  _col = (col < _cols) ? col : _cols - 1;
+  _row = (row < _rows) ? row : _rows - 1;
+}
+
+/*!
+    @brief  Set the colors of characters written from now on, and of the
+            blank lines scrolled in and clear().
+    @param  fg  Text palette index, 0-15.
+    @param  bg  Background palette index, 0-15.
+*/
+void Adafruit_Console::setColors(uint8_t fg, uint8_t bg) {
+  _attr = (bg & 15) << 4 | (fg & 15);
+}
+
+/*!
+    @brief  Change a palette entry. Cells already drawn in it keep their
+            old color until refresh().
+    @param  index  Palette index, 0-15.
+    @param  color  Color in the target's format, RGB565 for a display.
+*/
+void Adafruit_Console::setPaletteColor(uint8_t index, uint16_t color) {
+  _palette[index & 15] = color;
+}
+
+/*!
+    @brief   Put a character in the console at the cursor and advance it,
+             wrapping to the next line past the right edge and scrolling
+             past the bottom. '\\n' starts a new line, '\\r' returns to
+             the left edge, '\\b' backs up a column and '\\t' advances to
+             the next multiple of 8 columns. Nothing is drawn until
+             update().
+    @param   c  Character, classic font code.
+    @return  1 if written, 0 if begin() hasn't succeeded.
+*/
+size_t Adafruit_Console::write(uint8_t c) {
+  if (!_chars)
+    return 0;
+  switch (c) {
+  case '\n':
+    newline();
+    break;
+  case '\r':
+    _col = 0;
+    break;
+  case '\b':
+    if (_col)
+      _col--;
+    break;
+  case '\t':
+    _col = (_col + 8) & ~7;
+    if (_col > _cols)
+      _col = _cols;
+    break;
+  default:
+    if (_col >= _cols)
+      newline();
+    uint8_t ring = (_top + _row) % _rows;
+    uint16_t i = ring * _cols + _col;
+    if ((_chars[i] != c) || (_attrs[i] != _attr)) {
+      _chars[i] = c;
+      _attrs[i] = _attr;
+      _dirty[ring * _dirtyStride + (_col >> 3)] |= 1 << (_col & 7);
+    }
+    _col++;
+  }
+  return 1;
+}
+
+/*!
+    @brief  Move the cursor to the start of the next line, scrolling if
+            it's on the last.
+*/
+void Adafruit_Console::newline(void) {
+  _col = 0;
+  if (_row + 1 < _rows)
+    _row++;
+  else
+    scrollUp();
+}
+
+/*!
+    @brief  Move the text up a line and blank the bottom one. The ring row
+            at the top becomes the bottom line.
+*/
+void Adafruit_Console::scrollUp(void) {
+  int16_t cw = 6 * _size, ch = 8 * _size;
+  if (_mode == CONSOLE_REDRAW) {
+    // The screen stays put while the text moves up through it, so a cell
+    // needs drawing where what's now there (or still waiting to be drawn
+    // there) differs from the cell moving in. Dirty bits belong to ring
+    // rows, i.e. to where each row is shown, so they're recomputed from
+    // the bottom up, before the row above is overwritten.
+    for (uint8_t c = 0; c < _cols; c++) {
+      uint8_t *dirty = &_dirty[c >> 3], bit = 1 << (c & 7);
+      uint8_t below = (_top + _rows - 1) % _rows; // Bottom line now
+      uint16_t i = below * _cols + c;
+      bool redraw = (dirty[below * _dirtyStride] & bit) ||
+                    (_chars[i] != ' ') || (_attrs[i] != _attr);
+      for (int16_t s = _rows - 2; s >= 0; s--) {
+        uint8_t a = (_top + s) % _rows, b = (a + 1) % _rows;
+        uint16_t ia = a * _cols + c, ib = b * _cols + c;
+        if ((dirty[a * _dirtyStride] & bit) || (_chars[ia] != _chars[ib]) ||
+            (_attrs[ia] != _attrs[ib]))
+          dirty[b * _dirtyStride] |= bit;
+        else
+          dirty[b * _dirtyStride] &= ~bit;
+      }
+      if (redraw) // New bottom line, where the old bottom is shown
+        dirty[_top * _dirtyStride] |= bit;
+      else
+        dirty[_top * _dirtyStride] &= ~bit;
+    }
+    memset(&_chars[_top * _cols], ' ', _cols);
+    memset(&_attrs[_top * _cols], _attr, _cols);
+    _top = (_top + 1) % _rows;
+    return;
+  }
+
+  // Screen content moves with the text, and the line scrolled in is
+  // filled here, so only it needs new (clean) cells
+  uint8_t ring = _top;
+  clearLine(ring);
+  _top = (_top + 1) % _rows;
+  if (_mode == CONSOLE_CANVAS) {
+    scrollCanvas();
+  } else {
+    _gfx->fillRect(_x, lineY(ring), _cols * cw, ch, bgColor());
+    setScroll();
+  }
+}
+
+/*!
+    @brief  Scroll the console area of a canvas up a line, within any clip
+            rect already set, and fill the line uncovered.
+*/
+void Adafruit_Console::scrollCanvas(void) {
+  int16_t ch = 8 * _size, cx, cy, cw, cht;
+  _gfx->getClipRect(&cx, &cy, &cw, &cht);
+  int16_t x0 = _x + _gfx->getOriginX(), y0 = _y + _gfx->getOriginY(),
+          x1 = x0 + _cols * 6 * _size, y1 = y0 + _rows * ch, top = y0;
+  if (x0 < cx)
+    x0 = cx;
+  if (y0 < cy)
+    y0 = cy;
+  if (x1 > cx + cw)
+    x1 = cx + cw;
+  if (y1 > cy + cht)
+    y1 = cy + cht;
+  if ((x1 <= x0) || (y1 <= y0))
+    return;
+  _gfx->setClipRect(x0, y0, x1 - x0, y1 - y0);
+  _scroll(_gfx, -ch, bgColor());
+  _gfx->setClipRect(cx, cy, cw, cht);
+  if (y1 < top + _rows * ch) {
+    // The clip cuts off the bottom of the console, so the rows filled at
+    // the clip's edge should have shown the cut-off part of the line
+    // below; redraw the lines there
+    int16_t s = (y1 - ch - top) / ch;
+    for (s = (s < 0) ? 0 : s; s <= (y1 - 1 - top) / ch; s++)
+      markLine((_top + s) % _rows);
+  }
+}
+
+/*!
+    @brief  Mark every cell of a ring row for update() to draw.
+    @param  ring  Ring row.
+*/
+void Adafruit_Console::markLine(uint8_t ring) {
+  uint8_t *dirty = &_dirty[ring * _dirtyStride];
+  memset(dirty, 0xFF, _dirtyStride);
+  if (_cols & 7)
+    dirty[_dirtyStride - 1] = (1 << (_cols & 7)) - 1;
+}
+
+/*!
+    @brief  Blank a ring row in the current colors, as already shown.
+    @param  ring  Ring row.
+*/
+void Adafruit_Console::clearLine(uint8_t ring) {
+  memset(&_chars[ring * _cols], ' ', _cols);
+  memset(&_attrs[ring * _cols], _attr, _cols);
+  memset(&_dirty[ring * _dirtyStride], 0, _dirtyStride);
+}
+
+/*!
+    @brief  Send the scroll offset, the top ring row, to the panel.
+*/
+void Adafruit_Console::setScroll(void) {
+  uint16_t start = _y + _tft->getOriginY() + _top * 8 * _size;
+  uint8_t addr[] = {(uint8_t)(start >> 8), (uint8_t)start};
+  _tft->sendCommand(CONSOLE_VSCRSADD, addr, sizeof addr);
+}
+
+/*!
+    @brief   Find where a ring row is drawn.
+    @param   ring  Ring row.
+    @return  Y coordinate of the row's top edge. With hardware scroll it's
+             the unscrolled position in frame memory.
+*/
+int16_t Adafruit_Console::lineY(uint8_t ring) const {
+  if (_mode != CONSOLE_SCROLL)
+    ring = (ring + _rows - _top) % _rows;
+  return _y + ring * 8 * _size;
+}
+
+#endif // end __AVR_ATtiny85__
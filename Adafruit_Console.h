@@ -0,0 +1,142 @@
+/*!
+ * @file Adafruit_Console.h
+ *
+ * Part of Adafruit's GFX graphics library. A character-cell text console
+ * in the classic 6x8 font that keeps what's on screen in a cell buffer,
+ * redraws only the cells that changed and scrolls without repainting,
+ * for serial log viewers and the like.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_CONSOLE_H_
+#define _ADAFRUIT_CONSOLE_H_
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_SPITFT.h"
+
+/// How an Adafruit_Console moves text up a line
+typedef enum {
+  CONSOLE_REDRAW, ///< Redraw the cells whose character or colors changed
+  CONSOLE_CANVAS, ///< Scroll the target canvas's buffer
+  CONSOLE_SCROLL, ///< Use the panel's vertical scroll
+} consoleMode;
+
+/*!
+  @brief  A text console of cols x rows cells in the classic 6x8 font (at
+          any integer scale) on a display or canvas. Typical use:
+
+              Adafruit_Console con(&tft, 0, 0, 40, 30);
+              con.begin(true);   // After tft.setRotation()
+              ...
+              con.print(line);   // Any Print output; only buffers text
+              con.update();      // Draw just the cells that changed
+
+          Text is written to a cell buffer, with the usual wrap at the
+          right edge and scroll at the bottom, and the cells that changed
+          are noted. update() draws only those, each glyph as one opaque
+          block, so printing a line costs about that line's worth of
+          glyphs. Batching several prints into one update() costs no more
+          than the cells that end up different.
+
+          Scrolling depends on the target and begin():
+          - An Adafruit_SPITFT with begin(true), the console at the left
+            edge and exactly as wide as the screen, at rotation 0: the
+            panel's vertical scroll (MIPI VSCRDEF/VSCRSADD) moves the text
+            and only the new line is cleared; no glyphs are redrawn.
+          - A canvas: the canvas buffer is scrolled, then the new line
+            cleared. Canvases don't send anything; push the canvas to the
+            screen after update() (a GFXcanvas16 tracks what changed).
+          - Anything else: scrolling is done in the cell buffer, and
+            update() redraws the cells now holding something different
+            from before, which for typical log text (short lines, mostly
+            blanks) is a fraction of the screen.
+
+          Cell colors are indices into a 16-entry palette, ANSI order,
+          preset to CGA colors in RGB565. Set the palette to suit canvases
+          of other depths.
+*/
+class Adafruit_Console : public Print {
+public:
+  Adafruit_Console(Adafruit_SPITFT *tft, int16_t x, int16_t y, uint8_t cols,
+                   uint8_t rows, uint8_t size = 1);
+  Adafruit_Console(GFXcanvas16 *canvas, int16_t x, int16_t y, uint8_t cols,
+                   uint8_t rows, uint8_t size = 1);
+  Adafruit_Console(GFXcanvas8 *canvas, int16_t x, int16_t y, uint8_t cols,
+                   uint8_t rows, uint8_t size = 1);
+  Adafruit_Console(GFXcanvasPacked *canvas, int16_t x, int16_t y,
+                   uint8_t cols, uint8_t rows, uint8_t size = 1);
+  Adafruit_Console(GFXcanvas1 *canvas, int16_t x, int16_t y, uint8_t cols,
+                   uint8_t rows, uint8_t size = 1);
+  Adafruit_Console(Adafruit_GFX *gfx, int16_t x, int16_t y, uint8_t cols,
+                   uint8_t rows, uint8_t size = 1);
+  ~Adafruit_Console(void);
+  bool begin(bool hardwareScroll = false);
+  void clear(void);
+  void update(void);
+  void refresh(void);
+  void setCursor(uint8_t col, uint8_t row);
+  void setColors(uint8_t fg, uint8_t bg);
+  void setPaletteColor(uint8_t index, uint16_t color);
+  using Print::write;
+  size_t write(uint8_t c);
+
+  /*!
+    @brief   Get how the console scrolls, as chosen by begin().
+    @return  CONSOLE_REDRAW, CONSOLE_CANVAS or CONSOLE_SCROLL.
+  */
+  consoleMode getMode(void) const { return _mode; }
+  /*!
+    @brief   Get the cursor column.
+    @return  Column where the next character goes, 0 to cols (cols means
+             the next printable character wraps first).
+  */
+  uint8_t getCursorX(void) const { return _col; }
+  /*!
+    @brief   Get the cursor row.
+    @return  Row where the next character goes, 0 at top.
+  */
+  uint8_t getCursorY(void) const { return _row; }
+
+private:
+  /// Scrolls a canvas of the type the console was constructed with
+  typedef void (*scrollFunc)(Adafruit_GFX *gfx, int16_t dy, uint16_t fill);
+
+  void init(Adafruit_GFX *gfx, int16_t x, int16_t y, uint8_t cols,
+            uint8_t rows, uint8_t size);
+  void newline(void);
+  void scrollUp(void);
+  void scrollCanvas(void);
+  void clearLine(uint8_t ring);
+  void markLine(uint8_t ring);
+  void setScroll(void);
+  int16_t lineY(uint8_t ring) const;
+  uint16_t bgColor(void) const { return _palette[_attr >> 4]; }
+
+  Adafruit_GFX *_gfx;    ///< Display or canvas drawn on
+  Adafruit_SPITFT *_tft; ///< _gfx if it's a display, for hardware scroll
+  scrollFunc _scroll;    ///< Canvas scroller, NULL if not a canvas
+  uint8_t *_chars;       ///< Character per cell, by ring row
+  uint8_t *_attrs;       ///< Colors per cell, bg << 4 | fg
+  uint8_t *_dirty;       ///< Bit per cell that update() must draw
+  uint16_t _palette[16]; ///< Colors of attribute indices
+  int16_t _x;            ///< Left edge in drawing coordinates
+  int16_t _y;            ///< Top edge in drawing coordinates
+  uint8_t _cols;         ///< Width in cells
+  uint8_t _rows;         ///< Height in cells
+  uint8_t _size;         ///< Font magnification
+  uint8_t _dirtyStride;  ///< Bytes of _dirty per row
+  uint8_t _top;          ///< Ring row at the top of the console
+  uint8_t _col;          ///< Cursor column
+  uint8_t _row;          ///< Cursor row on screen
+  uint8_t _attr;         ///< Colors given to newly written cells
+  consoleMode _mode;     ///< How the console scrolls
+};
+
+#endif // end __AVR_ATtiny85__
+#endif // end _ADAFRUIT_CONSOLE_H_
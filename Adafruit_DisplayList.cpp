@@ -0,0 +1,272 @@
+/*!
+ * @file Adafruit_DisplayList.cpp
+ *
+ * Part of Adafruit's GFX graphics library. Recording, coalescing display
+ * list. See Adafruit_DisplayList.h for usage.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_DisplayList.h"
+
+/*!
+    @brief  Constructor. The command buffer is not allocated until
+            begin().
+    @param  target       Device that flush() issues commands to.
+    @param  maxCommands  Capacity of the list, in commands (10 bytes
+                         each).
+*/
+Adafruit_DisplayList::Adafruit_DisplayList(Adafruit_GFX *target,
+                                           uint16_t maxCommands)
+    : Adafruit_GFX(target->width(), target->height()), _target(target),
+      _list(NULL), _max(maxCommands ? maxCommands : 1), _count(0) {}
+
+/*!
+    @brief  Destructor, frees command buffer. Anything not yet flushed
+            is discarded.
+*/
+Adafruit_DisplayList::~Adafruit_DisplayList(void) { free(_list); }
+
+/*!
+    @brief   Allocate the command buffer and match the list's dimensions
+             to the target at its current rotation.
+    @return  true on success, false if the buffer couldn't be allocated
+             (primitives then pass straight through to the target).
+*/
+bool Adafruit_DisplayList::begin(void) {
+  WIDTH = _width = _target->width();
+  HEIGHT = _height = _target->height();
+  rotation = 0;
+  _count = 0;
+  if (!_list)
+    _list = (DLcommand *)malloc(_max * sizeof(DLcommand));
+  return _list != NULL;
+}
+
+/*!
+    @brief  Issue all recorded commands to the target inside a single
+            startWrite() / endWrite() pair, then empty the list.
+*/
+void Adafruit_DisplayList::flush(void) {
+  if (!_count)
+    return;
+  _target->startWrite();
+  for (uint16_t i = 0; i < _count; i++) {
+    DLcommand *c = &_list[i];
+    if (!c->w)
+      continue; // Dropped by overdraw
+    if (c->h == 1) {
+      if (c->w == 1)
+        _target->writePixel(c->x, c->y, c->color);
+      else
+        _target->writeFastHLine(c->x, c->y, c->w, c->color);
+    } else if (c->w == 1) {
+      _target->writeFastVLine(c->x, c->y, c->h, c->color);
+    } else {
+      _target->writeFillRect(c->x, c->y, c->w, c->h, c->color);
+    }
+  }
+  _target->endWrite();
+  _count = 0;
+}
+
+/*!
+    @brief  Discard all recorded commands without issuing them.
+*/
+void Adafruit_DisplayList::clear(void) { _count = 0; }
+
+/*!
+    @brief  Squeeze dropped commands out of the list, preserving order.
+*/
+void Adafruit_DisplayList::compact(void) {
+  uint16_t n = 0;
+  for (uint16_t i = 0; i < _count; i++) {
+    if (_list[i].w)
+      _list[n++] = _list[i];
+  }
+  _count = n;
+}
+
+/*!
+    @brief  Called when the list is full and compacting freed nothing; must
+            leave room for at least one command. The default issues all
+            commands so far with flush().
+*/
+void Adafruit_DisplayList::overflow(void) { flush(); }
+
+/*!
+    @brief  Record a solid rect: translate and clip it (see
+            Adafruit_GFX::clipRect()), merge it into the previous command if
+            it extends it, else drop any earlier commands it hides and
+            append it, flushing first if the list is full.
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width in pixels, may be negative (extends left).
+    @param  h      Height in pixels, may be negative (extends up).
+    @param  color  16-bit color.
+*/
+void Adafruit_DisplayList::record(int16_t x, int16_t y, int16_t w, int16_t h,
+                                  uint16_t color) {
+  if (!clipRect(&x, &y, &w, &h))
+    return;
+  int16_t x2 = x + w - 1, y2 = y + h - 1;
+
+  if (_count) {
+    DLcommand *last = &_list[_count - 1];
+    if (last->color == color) {
+      if ((last->y == y) && (last->h == h) && (last->x + last->w == x)) {
+        last->w += w; // Continues previous span rightward
+        return;
+      }
+      if ((last->x == x) && (last->w == w) && (last->y + last->h == y)) {
+        last->h += h; // Continues previous span downward
+        return;
+      }
+    }
+  }
+
+  if ((int32_t)w * h >= DL_COVER_MIN) {
+    for (uint16_t i = 0; i < _count; i++) {
+      DLcommand *c = &_list[i];
+      if (c->w && (c->x >= x) && (c->y >= y) && (c->x + c->w - 1 <= x2) &&
+          (c->y + c->h - 1 <= y2))
+        c->w = 0; // Completely overdrawn by this rect
+    }
+    while (_count && !_list[_count - 1].w)
+      _count--;
+  }
+
+  if (_count >= _max) {
+    compact();
+    if (_count >= _max)
+      overflow();
+  }
+  DLcommand *c = &_list[_count++];
+  c->x = x;
+  c->y = y;
+  c->w = w;
+  c->h = h;
+  c->color = color;
+}
+
+/*!
+    @brief  Record a single pixel.
+    @param  x      Column.
+    @param  y      Row.
+    @param  color  16-bit color.
+*/
+void Adafruit_DisplayList::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (_list)
+    record(x, y, 1, 1, color);
+  else
+    _target->drawPixel(x, y, color);
+}
+
+/*!
+    @brief  Record a single pixel (same as drawPixel() while recording).
+    @param  x      Column.
+    @param  y      Row.
+    @param  color  16-bit color.
+*/
+void Adafruit_DisplayList::writePixel(int16_t x, int16_t y, uint16_t color) {
+  if (_list)
+    record(x, y, 1, 1, color);
+  else
+    _target->writePixel(x, y, color);
+}
+
+/*!
+    @brief  Record a filled rectangle.
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  color  16-bit color.
+*/
+void Adafruit_DisplayList::writeFillRect(int16_t x, int16_t y, int16_t w,
+                                         int16_t h, uint16_t color) {
+  if (_list)
+    record(x, y, w, h, color);
+  else
+    _target->writeFillRect(x, y, w, h, color);
+}
+
+/*!
+    @brief  Record a vertical line.
+    @param  x      Column.
+    @param  y      Top row.
+    @param  h      Length in pixels.
+    @param  color  16-bit color.
+*/
+void Adafruit_DisplayList::writeFastVLine(int16_t x, int16_t y, int16_t h,
+                                          uint16_t color) {
+  if (_list)
+    record(x, y, 1, h, color);
+  else
+    _target->writeFastVLine(x, y, h, color);
+}
+
+/*!
+    @brief  Record a horizontal line.
+    @param  x      Left column.
+    @param  y      Row.
+    @param  w      Length in pixels.
+    @param  color  16-bit color.
+*/
+void Adafruit_DisplayList::writeFastHLine(int16_t x, int16_t y, int16_t w,
+                                          uint16_t color) {
+  if (_list)
+    record(x, y, w, 1, color);
+  else
+    _target->writeFastHLine(x, y, w, color);
+}
+
+/*!
+    @brief  Record a filled rectangle.
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  color  16-bit color.
+*/
+void Adafruit_DisplayList::fillRect(int16_t x, int16_t y, int16_t w,
+                                    int16_t h, uint16_t color) {
+  if (_list)
+    record(x, y, w, h, color);
+  else
+    _target->fillRect(x, y, w, h, color);
+}
+
+/*!
+    @brief  Record a vertical line.
+    @param  x      Column.
+    @param  y      Top row.
+    @param  h      Length in pixels.
+    @param  color  16-bit color.
+*/
+void Adafruit_DisplayList::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                         uint16_t color) {
+  if (_list)
+    record(x, y, 1, h, color);
+  else
+    _target->drawFastVLine(x, y, h, color);
+}
+
+/*!
+    @brief  Record a horizontal line.
+    @param  x      Left column.
+    @param  y      Row.
+    @param  w      Length in pixels.
+    @param  color  16-bit color.
+*/
+void Adafruit_DisplayList::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                         uint16_t color) {
+  if (_list)
+    record(x, y, w, 1, color);
+  else
+    _target->drawFastHLine(x, y, w, color);
+}
@@ -0,0 +1,102 @@
+/*!
+ * @file Adafruit_DisplayList.h
+ *
+ * Part of Adafruit's GFX graphics library. Records drawing into a compact
+ * list of solid rectangles and replays it to another Adafruit_GFX device
+ * in a single write transaction, merging and discarding commands along
+ * the way.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_DISPLAYLIST_H_
+#define _ADAFRUIT_DISPLAYLIST_H_
+
+#include "Adafruit_GFX.h"
+
+// Recorded rects at least this many pixels in area are checked against
+// earlier commands, which are dropped if fully covered by the new rect.
+// Smaller rects (text pixels, line steps) skip the check.
+#ifndef DL_COVER_MIN
+#define DL_COVER_MIN 64 ///< Min area (pixels) to test for overdraw
+#endif
+
+/// One recorded command: a solid rectangle (a pixel is 1x1); w of 0
+/// marks a command dropped by overdraw.
+typedef struct {
+  int16_t x;      ///< Left edge, target coordinates
+  int16_t y;      ///< Top edge, target coordinates
+  int16_t w;      ///< Width in pixels, 0 if dropped
+  int16_t h;      ///< Height in pixels
+  uint16_t color; ///< 16-bit color
+} DLcommand;
+
+/*!
+  @brief  An Adafruit_GFX that draws nothing itself but records every
+          pixel and solid span it's handed, to be issued later to a
+          target display with flush(). Every primitive -- lines, circles,
+          triangles, text, bitmaps -- reduces to these, so all of them
+          record. Typical use:
+
+              Adafruit_DisplayList dl(&tft, 512);
+              dl.begin();               // After tft.setRotation()
+              dl.fillScreen(BLACK);     // Draw a frame as usual...
+              dl.fillRoundRect(10, 10, 100, 40, 8, BLUE);
+              dl.print("Hello");
+              dl.flush();               // ...issue it all at once
+
+          While recording, a command that continues the previous one
+          (same color, adjoining edge of the same length) is merged into
+          it, and a large rect discards earlier commands it fully covers.
+          flush() then issues what remains inside one startWrite() /
+          endWrite() pair, so a frame becomes far fewer address windows
+          and transactions. If the list fills mid-frame it's flushed
+          automatically; output is the same, only less fully optimized.
+
+          The list records in the target's coordinate space at its
+          rotation when begin() is called; don't rotate either afterward.
+          The list's own setClipRect() and setOrigin() apply as it
+          records. Drawn before begin() (or if it failed), primitives go
+          straight to the target, clipped by the target's settings.
+*/
+class Adafruit_DisplayList : public Adafruit_GFX {
+public:
+  Adafruit_DisplayList(Adafruit_GFX *target, uint16_t maxCommands = 256);
+  virtual ~Adafruit_DisplayList(void);
+  virtual bool begin(void);
+  virtual void flush(void);
+  void clear(void);
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void writePixel(int16_t x, int16_t y, uint16_t color);
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color);
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+
+  /*!
+    @brief   Get the number of commands currently held, including any
+             dropped but not yet compacted away.
+    @return  Command count.
+  */
+  uint16_t commands(void) const { return _count; }
+
+protected:
+  void record(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void compact(void);
+  virtual void overflow(void);
+
+  Adafruit_GFX *_target; ///< Device commands are issued to
+  DLcommand *_list;      ///< Command buffer
+  uint16_t _max;         ///< Capacity of _list, in commands
+  uint16_t _count;       ///< Commands in _list
+};
+
+#endif // end _ADAFRUIT_DISPLAYLIST_H_
@@ -0,0 +1,290 @@
+/*!
+ * @file Adafruit_FontFile.cpp
+ *
+ * Part of Adafruit's GFX graphics library. Run-time loading of binary
+ * GFXfont files, memory-mapped or streamed through a glyph cache. See
+ * Adafruit_FontFile.h for usage and fontconvert.c for the file format.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#if !defined(__AVR__)
+
+#include "Adafruit_FontFile.h"
+
+#define FONTFILE_HEADER 20  ///< Bytes of file header
+#define FONTFILE_VERSION 1  ///< File format version read
+#define FONTFILE_EMPTY 0xFF ///< Slot::glyph byte value of an empty slot
+
+static Adafruit_FontFile *fontFiles = NULL; ///< Loaded fonts, for find()
+
+/*!
+    @brief  Constructor. Nothing is loaded until begin().
+*/
+Adafruit_FontFile::Adafruit_FontFile(void)
+    : _reader(NULL), _context(NULL), _tables(NULL), _cache(NULL),
+      _slots(NULL), _next(NULL), _loaded(false) {
+  memset(&_font, 0, sizeof _font);
+}
+
+/*!
+    @brief  Destructor, frees any RAM. Stop using the font first.
+*/
+Adafruit_FontFile::~Adafruit_FontFile(void) { end(); }
+
+/*!
+    @brief   Use a font file that's already in the address space, such as
+             memory-mapped QSPI flash. Nothing is copied or allocated.
+    @param   data  The whole file, 4-byte aligned.
+    @param   len   File size in bytes.
+    @return  true on success, false if the data isn't a valid font file
+             (or not laid out for this platform).
+*/
+bool Adafruit_FontFile::begin(const uint8_t *data, uint32_t len) {
+  uint32_t tableBytes;
+  uint16_t largest;
+  end();
+  if (!data || ((uintptr_t)data & 3) || (len < FONTFILE_HEADER) ||
+      !parseHeader(data, &tableBytes) ||
+      (len - FONTFILE_HEADER < tableBytes) ||
+      (len - _bitmapStart < _bitmapBytes))
+    return false;
+  setTables((uint8_t *)data + FONTFILE_HEADER);
+  _font.bitmap = (uint8_t *)data + _bitmapStart;
+  if (!checkTables(&largest))
+    return false;
+  _next = fontFiles;
+  fontFiles = this;
+  return _loaded = true;
+}
+
+/*!
+    @brief   Use a font file read through a callback, e.g. from SD. The
+             header and glyph tables are read now; glyph bitmaps as
+             they're drawn, into a cache.
+    @param   reader     Function that reads the file.
+    @param   context    Passed to reader, e.g. a File.
+    @param   cacheSize  Bytes of RAM to cache glyph bitmaps in. Split into
+                        slots for the font's largest glyph; at least one
+                        slot is allocated, however small this is.
+    @return  true on success, false if the file couldn't be read, isn't a
+             valid font file, or the RAM couldn't be allocated.
+*/
+bool Adafruit_FontFile::begin(GFXfontReader reader, void *context,
+                              uint16_t cacheSize) {
+  uint8_t header[FONTFILE_HEADER];
+  uint32_t tableBytes;
+  uint16_t largest;
+  end();
+  if (!reader ||
+      (reader(context, 0, header, FONTFILE_HEADER) != FONTFILE_HEADER) ||
+      !parseHeader(header, &tableBytes) ||
+      !(_tables = (uint8_t *)malloc(tableBytes)))
+    return false;
+  setTables(_tables);
+  if ((reader(context, FONTFILE_HEADER, _tables, tableBytes) != tableBytes) ||
+      !checkTables(&largest)) {
+    end();
+    return false;
+  }
+  uint16_t slots = largest ? cacheSize / largest : 1;
+  _slotCount = (slots < 1) ? 1 : (slots > 255) ? 255 : slots;
+  _slotSize = largest;
+  if (!(_slots = (Slot *)malloc(_slotCount * (sizeof(Slot) + _slotSize)))) {
+    end();
+    return false;
+  }
+  memset(_slots, FONTFILE_EMPTY, _slotCount * sizeof(Slot));
+  _cache = (uint8_t *)&_slots[_slotCount];
+  _reader = reader;
+  _context = context;
+  _next = fontFiles;
+  fontFiles = this;
+  return _loaded = true;
+}
+
+/*!
+    @brief  Unload the font and free any RAM. Stop using the font (see
+            setFont()) first.
+*/
+void Adafruit_FontFile::end(void) {
+  if (_loaded) {
+    for (Adafruit_FontFile **f = &fontFiles; *f; f = &(*f)->_next) {
+      if (*f == this) {
+        *f = _next;
+        break;
+      }
+    }
+  }
+  free(_tables);
+  free(_slots);
+  _tables = _cache = NULL;
+  _slots = NULL;
+  _reader = NULL;
+  _reads = 0;
+  _clock = 0;
+  _loaded = false;
+  memset(&_font, 0, sizeof _font);
+}
+
+/*!
+    @brief   Get a glyph's bitmap, reading it into the cache if it's not
+             there. Used by the text renderers.
+    @param   glyph  Glyph index (see gfxGlyphIndex()).
+    @return  Pointer to the bitmap, valid until the next call, or NULL if
+             it couldn't be read.
+*/
+const uint8_t *Adafruit_FontFile::getGlyphBitmap(uint16_t glyph) {
+  if (!_loaded || (glyph >= _glyphs))
+    return NULL;
+  uint32_t offset = _font.glyph[glyph].bitmapOffset;
+  if (!_reader)
+    return _font.bitmap + offset;
+  uint32_t end = (glyph + 1 < _glyphs) ? _font.glyph[glyph + 1].bitmapOffset
+                                       : _bitmapBytes;
+  if (end == offset)
+    return _cache; // Empty glyph (space), nothing to read or cache
+
+  // Cached? If not, replace the empty or least recently used slot
+  uint8_t s, victim = 0;
+  _clock++;
+  for (s = 0; s < _slotCount; s++) {
+    if (_slots[s].glyph == glyph) {
+      _slots[s].used = _clock;
+      return &_cache[s * _slotSize];
+    }
+    if ((_slots[victim].glyph != 0xFFFF) &&
+        ((_slots[s].glyph == 0xFFFF) ||
+         ((uint16_t)(_clock - _slots[s].used) >
+          (uint16_t)(_clock - _slots[victim].used))))
+      victim = s;
+  }
+  uint8_t *dest = &_cache[victim * _slotSize];
+  _slots[victim].glyph = 0xFFFF;
+  if (_reader(_context, _bitmapStart + offset, dest, end - offset) !=
+      end - offset)
+    return NULL;
+  _slots[victim].glyph = glyph;
+  _slots[victim].used = _clock;
+  _reads++;
+  return dest;
+}
+
+/*!
+    @brief   Find the Adafruit_FontFile a font was loaded by. Used by
+             Adafruit_GFX::setFont() for streamed fonts.
+    @param   font  A font from getFont().
+    @return  The loader, or NULL if font isn't one loaded now.
+*/
+Adafruit_FontFile *Adafruit_FontFile::find(const GFXfont *font) {
+  for (Adafruit_FontFile *f = fontFiles; f; f = f->_next)
+    if (&f->_font == font)
+      return f;
+  return NULL;
+}
+
+/*!
+    @brief   Check a file header and take the font's scalar fields from it.
+    @param   header      First FONTFILE_HEADER bytes of the file.
+    @param   tableBytes  Set to the size of the tables following header.
+    @return  true if it's a font file this code and platform can use.
+*/
+bool Adafruit_FontFile::parseHeader(const uint8_t *header,
+                                    uint32_t *tableBytes) {
+  // Tables are used in place, which needs the struct layouts of the file:
+  // little-endian, 2-byte aligned 16-bit fields
+  const uint16_t one = 1;
+  if ((sizeof(GFXglyph) != 8) || (sizeof(GFXrange) != 8) ||
+      (sizeof(GFXkernPair) != 4) || (*(const uint8_t *)&one != 1))
+    return false;
+  if (memcmp(header, "GFXF", 4) || (header[4] != FONTFILE_VERSION))
+    return false;
+  _font.format = header[5];
+  _font.first = header[6];
+  _font.last = header[7];
+  _font.yAdvance = header[8];
+  _glyphs = header[10] | (header[11] << 8);
+  _font.ranges = header[12] | (header[13] << 8);
+  _kernPairs = header[14] | (header[15] << 8);
+  _bitmapBytes = header[16] | (header[17] << 8) | ((uint32_t)header[18] << 16) |
+                 ((uint32_t)header[19] << 24);
+  if (!_glyphs || (_font.format > GFXFONT_AA4))
+    return false;
+  *tableBytes = (uint32_t)_font.ranges * sizeof(GFXrange) +
+                (uint32_t)_glyphs * sizeof(GFXglyph);
+  if (_kernPairs)
+    *tableBytes += (((uint32_t)_glyphs + 1) * 2 + 3) / 4 * 4 +
+                   (uint32_t)_kernPairs * sizeof(GFXkernPair);
+  _bitmapStart = FONTFILE_HEADER + *tableBytes;
+  return true;
+}
+
+/*!
+    @brief  Point the font at its tables, as laid out by parseHeader().
+    @param  tables  The tables, in the file or a RAM copy.
+*/
+void Adafruit_FontFile::setTables(uint8_t *tables) {
+  _font.range = _font.ranges ? (GFXrange *)tables : NULL;
+  tables += _font.ranges * sizeof(GFXrange);
+  _font.glyph = (GFXglyph *)tables;
+  tables += _glyphs * sizeof(GFXglyph);
+  if (_kernPairs) {
+    _font.kernIndex = (uint16_t *)tables;
+    _font.kern = (GFXkernPair *)(tables + ((_glyphs + 1) * 2 + 3) / 4 * 4);
+  } else {
+    _font.kernIndex = NULL;
+    _font.kern = NULL;
+  }
+}
+
+/*!
+    @brief   Check the tables are consistent, so a bad file can't send the
+             renderers outside them.
+    @param   largest  Set to the size of the largest glyph bitmap.
+    @return  true if the tables are usable.
+*/
+bool Adafruit_FontFile::checkTables(uint16_t *largest) {
+  uint32_t next = 0;
+  *largest = 0;
+  for (uint16_t i = 0; i < _font.ranges; i++) {
+    const GFXrange *r = &_font.range[i];
+    if (!r->count || (r->glyph + r->count > _glyphs) ||
+        (i && (r->first < _font.range[i - 1].first + _font.range[i - 1].count)))
+      return false;
+  }
+  if (!_font.ranges && (_glyphs != _font.last - _font.first + 1))
+    return false;
+  // Bitmaps follow glyph order, each ending where the next one starts
+  uint8_t bpp = (_font.format == GFXFONT_AA2)   ? 2
+                : (_font.format == GFXFONT_AA4) ? 4
+                                                : 1;
+  for (uint16_t i = 0; i < _glyphs; i++) {
+    const GFXglyph *g = &_font.glyph[i];
+    uint32_t end = (i + 1 < _glyphs) ? _font.glyph[i + 1].bitmapOffset
+                                     : _bitmapBytes;
+    if ((g->bitmapOffset != next) || (end < next) || (end - next > 0xFFFF) ||
+        ((_font.format != GFXFONT_RLE) &&
+         ((g->width * g->height * bpp + 7u) / 8 > end - next)))
+      return false;
+    if (end - next > *largest)
+      *largest = end - next;
+    next = end;
+  }
+  if (_kernPairs) {
+    for (uint16_t i = 0; i < _glyphs; i++)
+      if (_font.kernIndex[i] > _font.kernIndex[i + 1])
+        return false;
+    if (_font.kernIndex[0] || (_font.kernIndex[_glyphs] != _kernPairs))
+      return false;
+    for (uint16_t i = 0; i < _kernPairs; i++)
+      if (_font.kern[i].right >= _glyphs)
+        return false;
+  }
+  return true;
+}
+
+#endif // end __AVR__
@@ -0,0 +1,119 @@
+/*!
+ * @file Adafruit_FontFile.h
+ *
+ * Part of Adafruit's GFX graphics library. Loads GFXfonts at run time
+ * from the binary files fontconvert -b writes, so fonts can live in
+ * external flash or on an SD card instead of being compiled in.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_FONTFILE_H_
+#define _ADAFRUIT_FONTFILE_H_
+
+#if !defined(__AVR__) // Fonts are read with plain loads, not pgm_read
+
+#include "Adafruit_GFX.h"
+
+// Default RAM for glyph bitmaps of a streamed font; as many glyphs as fit
+// are cached (up to 255), at least one
+#ifndef FONTFILE_CACHE
+#define FONTFILE_CACHE 1024 ///< Bytes of glyph cache for begin(reader)
+#endif
+
+/*!
+  @brief   Source of font file data for Adafruit_FontFile: copy len bytes
+           from offset in the file to dest. For a file (SD, SdFat, a QSPI
+           flash filesystem), something like:
+
+               uint32_t readFont(void *f, uint32_t offset, uint8_t *dest,
+                                 uint32_t len) {
+                 File *file = (File *)f;
+                 return file->seek(offset) ? file->read(dest, len) : 0;
+               }
+
+  @param   context  Whatever was passed to begin(), e.g. a File.
+  @param   offset   Byte position in the file.
+  @param   dest     Where to put the data.
+  @param   len      Number of bytes wanted.
+  @return  Number of bytes copied, less than len only on error.
+*/
+typedef uint32_t (*GFXfontReader)(void *context, uint32_t offset,
+                                  uint8_t *dest, uint32_t len);
+
+/*!
+  @brief  A GFXfont loaded at run time from a file written by fontconvert
+          -b, in one of two ways:
+          - begin(data, len) for a file in the address space: memory-
+            mapped QSPI flash, or a copy in RAM. Nothing is copied; the
+            font reads straight from the data, as fast as a built-in one.
+          - begin(reader, context) for a file on SD or the like. The
+            glyph table (8 bytes a glyph) is read into RAM, and glyph
+            bitmaps are read as drawn into a small cache holding the most
+            recently used ones, so text in a few dozen distinct characters
+            doesn't go back to the card for each one.
+
+          Either way, pass getFont() to setFont() on any display or canvas
+          and print as usual; measuring and metrics need no bitmaps and
+          work the same. Keep the Adafruit_FontFile (and for
+          begin(data, len) the data, for begin(reader) its context) alive
+          while the font is in use.
+*/
+class Adafruit_FontFile {
+public:
+  Adafruit_FontFile(void);
+  ~Adafruit_FontFile(void);
+  bool begin(const uint8_t *data, uint32_t len);
+  bool begin(GFXfontReader reader, void *context,
+             uint16_t cacheSize = FONTFILE_CACHE);
+  void end(void);
+  const uint8_t *getGlyphBitmap(uint16_t glyph);
+  static Adafruit_FontFile *find(const GFXfont *font);
+
+  /*!
+    @brief   Get the loaded font, for setFont().
+    @return  The font, or NULL if begin() hasn't succeeded.
+  */
+  const GFXfont *getFont(void) const { return _loaded ? &_font : NULL; }
+  /*!
+    @brief   Get how many glyph bitmaps have been read from the file, as
+             opposed to found in the cache. Useful for sizing the cache.
+    @return  Reads since begin(), 0 for a memory-mapped font.
+  */
+  uint32_t getReads(void) const { return _reads; }
+
+private:
+  bool parseHeader(const uint8_t *header, uint32_t *tableBytes);
+  void setTables(uint8_t *tables);
+  bool checkTables(uint16_t *largest);
+
+  /// A glyph bitmap in the cache of a streamed font
+  typedef struct {
+    uint16_t glyph; ///< Glyph index, 0xFFFF if slot is empty
+    uint16_t used;  ///< _clock when last drawn
+  } Slot;
+
+  GFXfont _font;            ///< The font, pointing into the file or RAM
+  GFXfontReader _reader;    ///< Streamed font's data source, else NULL
+  void *_context;           ///< Passed to _reader
+  uint8_t *_tables;         ///< Streamed: RAM copy of glyph tables
+  uint8_t *_cache;          ///< Streamed: glyph bitmap slots
+  Slot *_slots;             ///< Streamed: what's in each slot
+  Adafruit_FontFile *_next; ///< Next in list of loaded fonts
+  uint32_t _bitmapStart;    ///< File offset of bitmap data
+  uint32_t _bitmapBytes;    ///< Size of bitmap data
+  uint32_t _reads;          ///< Glyph bitmaps read from the file
+  uint16_t _glyphs;         ///< Number of glyphs
+  uint16_t _kernPairs;      ///< Number of kerning pairs
+  uint16_t _slotSize;       ///< Bytes per cache slot (largest glyph)
+  uint16_t _clock;          ///< Counts glyph draws, for LRU
+  uint8_t _slotCount;       ///< Number of cache slots
+  bool _loaded;             ///< begin() succeeded
+};
+
+#endif // end __AVR__
+#endif // end _ADAFRUIT_FONTFILE_H_
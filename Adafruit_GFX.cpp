@@ -32,63 +32,39 @@ POSSIBILITY OF SUCH DAMAGE.
  */
 
 #include "Adafruit_GFX.h"
+#if !defined(GFX_NO_CLASSIC_FONT)
 #include "glcdfont.c"
-#ifdef __AVR__
-#include <avr/pgmspace.h>
-#elif defined(ESP8266) || defined(ESP32)
-#include <pgmspace.h>
 #endif
-
-// Many (but maybe not all) non-AVR board installs define macros
-// for compatibility with existing PROGMEM-reading AVR code.
-// Do our own checks and defines here for good measure...
-
-#ifndef pgm_read_byte
-#define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#if !defined(__AVR__)
+#include "Adafruit_FontFile.h"
 #endif
-#ifndef pgm_read_word
-#define pgm_read_word(addr) (*(const unsigned short *)(addr))
+#ifndef min
+#define min(a, b) (((a) < (b)) ? (a) : (b))
 #endif
-#ifndef pgm_read_dword
-#define pgm_read_dword(addr) (*(const unsigned long *)(addr))
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
 #endif
 
-// Pointers are a peculiar case...typically 16-bit on AVR boards,
-// 32 bits elsewhere.  Try to accommodate both...
-
-#if !defined(__INT_MAX__) || (__INT_MAX__ > 0xFFFF)
-#define pgm_read_pointer(addr) ((void *)pgm_read_dword(addr))
-#else
-#define pgm_read_pointer(addr) ((void *)pgm_read_word(addr))
-#endif
+#define FNV1A_INIT 2166136261UL ///< Initial value for fnv1a()
 
-inline GFXglyph *pgm_read_glyph_ptr(const GFXfont *gfxFont, uint8_t c) {
-#ifdef __AVR__
-  return &(((GFXglyph *)pgm_read_pointer(&gfxFont->glyph))[c]);
-#else
-  // expression in __AVR__ section may generate "dereferencing type-punned
-  // pointer will break strict-aliasing rules" warning In fact, on other
-  // platforms (such as STM32) there is no need to do this pointer magic as
-  // program memory may be read in a usual way So expression may be simplified
-  return gfxFont->glyph + c;
-#endif //__AVR__
+// FNV-1a hash of len bytes at data, continuing from h
+static uint32_t fnv1a(uint32_t h, const void *data, size_t len) {
+  const uint8_t *p = (const uint8_t *)data;
+  while (len--)
+    h = (h ^ *p++) * 16777619UL;
+  return h;
 }
 
-inline uint8_t *pgm_read_bitmap_ptr(const GFXfont *gfxFont) {
-#ifdef __AVR__
-  return (uint8_t *)pgm_read_pointer(&gfxFont->bitmap);
-#else
-  // expression in __AVR__ section generates "dereferencing type-punned pointer
-  // will break strict-aliasing rules" warning In fact, on other platforms (such
-  // as STM32) there is no need to do this pointer magic as program memory may
-  // be read in a usual way So expression may be simplified
-  return gfxFont->bitmap;
-#endif //__AVR__
-}
+#define DJB2_INIT 5381UL ///< Initial value for djb2()
 
-#ifndef min
-#define min(a, b) (((a) < (b)) ? (a) : (b))
-#endif
+// Bernstein (djb2, xor variant) hash of len bytes at data, continuing from
+// h. Unrelated to FNV-1a, so it's a second, independent check on a match.
+static uint32_t djb2(uint32_t h, const void *data, size_t len) {
+  const uint8_t *p = (const uint8_t *)data;
+  while (len--)
+    h = (h * 33) ^ *p++;
+  return h;
+}
 
 #ifndef _swap_int16_t
 #define _swap_int16_t(a, b)                                                    \
@@ -99,6 +75,160 @@ inline uint8_t *pgm_read_bitmap_ptr(const GFXfont *gfxFont) {
   }
 #endif
 
+#if defined(GFX_PROFILE)
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) ||                   \
+    defined(__ARM_ARCH_8M_MAIN__)
+#define GFX_PROFILE_DWT ///< Time with the Cortex-M cycle counter
+// Debug registers, by address as not every core pulls in CMSIS
+#define DEMCR (*(volatile uint32_t *)0xE000EDFC)      ///< Debug control
+#define DWT_CTRL (*(volatile uint32_t *)0xE0001000)   ///< DWT control
+#define DWT_CYCCNT (*(volatile uint32_t *)0xE0001004) ///< Cycle count
+static bool profileStarted; // Counter turned on
+#endif
+
+static GFXprofileEntry profileRing[GFX_PROFILE_SIZE];
+static uint32_t profileCalls; // Recorded since reset; slot is % size
+static uint8_t profileDepth;  // Scopes open right now
+
+// Names for dump, in GFXprofileID order
+static const char profileNames[][14] PROGMEM = {
+    "fillRect",      "drawFastHLine", "drawFastVLine", "fillScreen",
+    "drawLine",      "drawRect",      "drawCircle",    "fillCircle",
+    "drawRoundRect", "fillRoundRect", "drawTriangle",  "fillTriangle",
+    "drawBitmap",    "drawGrayBmp",   "drawRGBBitmap", "drawChar",
+    "write",         "writePixels",   "writeColor",    "flushCanvas"};
+
+/*!
+    @brief   Read the profiling clock, starting it on first use.
+    @return  CPU cycles on Cortex-M3 and up (wrapping every 2^32), micros()
+             elsewhere.
+*/
+uint32_t gfxProfileTicks(void) {
+#if defined(GFX_PROFILE_DWT)
+  if (!profileStarted) {
+    DEMCR |= 1UL << 24; // TRCENA: turn on the DWT unit...
+    DWT_CTRL |= 1;      // ...and its cycle counter
+    profileStarted = true;
+  }
+  return DWT_CYCCNT;
+#else
+  return micros();
+#endif
+}
+
+/*!
+    @brief  Empty the profile ring, e.g. at the start of a frame, so a
+            dump shows just that frame.
+*/
+void gfxProfileReset(void) { profileCalls = 0; }
+
+/*!
+    @brief   Get how many calls the ring holds.
+    @return  Calls recorded since gfxProfileReset(), up to GFX_PROFILE_SIZE.
+*/
+uint16_t gfxProfileCount(void) {
+  return (profileCalls < GFX_PROFILE_SIZE) ? profileCalls : GFX_PROFILE_SIZE;
+}
+
+/*!
+    @brief   Get how many calls were recorded over, the ring being full.
+    @return  Oldest calls lost since gfxProfileReset(); if not 0, a larger
+             GFX_PROFILE_SIZE (or an earlier reset) would keep them.
+*/
+uint32_t gfxProfileDropped(void) {
+  return profileCalls - gfxProfileCount();
+}
+
+/*!
+    @brief   Get a call from the ring, for analysis on the device itself.
+    @param   i  Index, 0 (oldest) thru gfxProfileCount() - 1. Calls are
+                kept in the order they finished, so a call's nested calls
+                come before it.
+    @param   e  Entry to fill in.
+    @return  true if i is in range.
+*/
+bool gfxProfileGet(uint16_t i, GFXprofileEntry *e) {
+  uint16_t n = gfxProfileCount();
+  if (i >= n)
+    return false;
+  *e = profileRing[(profileCalls - n + i) % GFX_PROFILE_SIZE];
+  return true;
+}
+
+/*!
+    @brief  Print the ring as CSV, oldest call first: a comment line giving
+            the units, then a header, then one line per call of start time,
+            nesting depth, primitive, pixels and duration. With the start
+            and duration, nested calls stack inside their callers for a
+            flame-chart view of the frame.
+    @param  out  Where to print, e.g. Serial.
+*/
+void gfxProfileDump(Print &out) {
+  out.print(F("# GFX profile: "));
+  out.print(gfxProfileCount());
+  out.print(F(" calls, "));
+  out.print(gfxProfileDropped());
+#if defined(GFX_PROFILE_DWT)
+  out.print(F(" dropped, ticks are CPU cycles"));
+#if defined(F_CPU)
+  out.print(F(" at "));
+  out.print((uint32_t)F_CPU);
+  out.print(F(" Hz"));
+#endif
+  out.println();
+#else
+  out.println(F(" dropped, ticks are microseconds"));
+#endif
+  out.println(F("start,depth,primitive,pixels,ticks"));
+  GFXprofileEntry e;
+  for (uint16_t i = 0; gfxProfileGet(i, &e); i++) {
+    out.print(e.start);
+    out.print(',');
+    out.print(e.depth);
+    out.print(',');
+    if (e.id >= GFX_PROF_USER) {
+      out.print(F("user"));
+      out.print(e.id - GFX_PROF_USER);
+    } else {
+      for (const char *s = profileNames[e.id]; char c = pgm_read_byte(s); s++)
+        out.print(c);
+    }
+    out.print(',');
+    out.print(e.pixels);
+    out.print(',');
+    out.println(e.ticks);
+  }
+}
+
+/*!
+    @brief  Start timing a call.
+    @param  id      GFXprofileID of the primitive, or GFX_PROF_USER + n.
+    @param  pixels  Pixels it's asked to draw; sign is ignored, as for a
+                    rect given a negative width.
+*/
+GFXprofileScope::GFXprofileScope(uint8_t id, int32_t pixels)
+    : _pixels((pixels < 0) ? -pixels : pixels), _id(id) {
+  profileDepth++;
+  _start = gfxProfileTicks();
+}
+
+/*!
+    @brief  Finish timing a call and add it to the ring, over the oldest
+            if full.
+*/
+GFXprofileScope::~GFXprofileScope(void) {
+  uint32_t t = gfxProfileTicks();
+  GFXprofileEntry *e = &profileRing[profileCalls++ % GFX_PROFILE_SIZE];
+  e->start = _start;
+  e->ticks = t - _start;
+  e->pixels = _pixels;
+  e->id = _id;
+  e->depth = --profileDepth;
+}
+
+#endif // end GFX_PROFILE
+
 /**************************************************************************/
 /*!
    @brief    Instatiate a GFX context for graphics! Can only be done by a
@@ -117,6 +247,15 @@ Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
   wrap = true;
   _cp437 = false;
   gfxFont = NULL;
+  metrics = NULL;
+  kernPrev = -1;
+  fontFile = NULL;
+  digitAdvance = 0;
+  textOrientation = 0;
+  tabularDigits = false;
+  _originX = _originY = 0;
+  hwCaps = 0;
+  clearClipRect();
 }
 
 /**************************************************************************/
@@ -264,6 +403,7 @@ void Adafruit_GFX::endWrite() {}
 /**************************************************************************/
 void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                  uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_FASTVLINE, h);
   startWrite();
   writeLine(x, y, x, y + h - 1, color);
   endWrite();
@@ -281,6 +421,7 @@ void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h,
 /**************************************************************************/
 void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                  uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_FASTHLINE, w);
   startWrite();
   writeLine(x, y, x + w - 1, y, color);
   endWrite();
@@ -299,8 +440,20 @@ void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w,
 /**************************************************************************/
 void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                             uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_FILLRECT, (int32_t)w * h);
+  if (hwCaps & GFX_HW_FILL) {
+    int16_t dx = x, dy = y, dw = w, dh = h;
+    if (!clipRect(&dx, &dy, &dw, &dh) || hwFillRect(dx, dy, dw, dh, color))
+      return;
+  }
+  int16_t cx1, cy1, cx2, cy2, x2 = x + w - 1;
+  clipBounds(&cx1, &cy1, &cx2, &cy2);
+  if (x < cx1) // Skip clipped columns, no need to issue them
+    x = cx1;
+  if (x2 > cx2)
+    x2 = cx2;
   startWrite();
-  for (int16_t i = x; i < x + w; i++) {
+  for (int16_t i = x; i <= x2; i++) {
     writeFastVLine(i, y, h, color);
   }
   endWrite();
@@ -314,7 +467,8 @@ void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
 */
 /**************************************************************************/
 void Adafruit_GFX::fillScreen(uint16_t color) {
-  fillRect(0, 0, _width, _height, color);
+  GFX_PROFILE_SCOPE(GFX_PROF_FILLSCREEN, (int32_t)_width * _height);
+  fillRect(-_originX, -_originY, _width, _height, color); // Whole display
 }
 
 /**************************************************************************/
@@ -329,6 +483,7 @@ void Adafruit_GFX::fillScreen(uint16_t color) {
 /**************************************************************************/
 void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                             uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_LINE, max(abs(x1 - x0), abs(y1 - y0)) + 1);
   // Update in subclasses if desired!
   if (x0 == x1) {
     if (y0 > y1)
@@ -356,40 +511,18 @@ void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 /**************************************************************************/
 void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r,
                               uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_CIRCLE, (int32_t)(2 * r + 1) * (2 * r + 1));
 #if defined(ESP8266)
   yield();
 #endif
-  int16_t f = 1 - r;
-  int16_t ddF_x = 1;
-  int16_t ddF_y = -2 * r;
-  int16_t x = 0;
-  int16_t y = r;
-
+  if (!clipOverlaps(x0 - r, y0 - r, x0 + r, y0 + r))
+    return;
   startWrite();
   writePixel(x0, y0 + r, color);
   writePixel(x0, y0 - r, color);
   writePixel(x0 + r, y0, color);
   writePixel(x0 - r, y0, color);
-
-  while (x < y) {
-    if (f >= 0) {
-      y--;
-      ddF_y += 2;
-      f += ddF_y;
-    }
-    x++;
-    ddF_x += 2;
-    f += ddF_x;
-
-    writePixel(x0 + x, y0 + y, color);
-    writePixel(x0 - x, y0 + y, color);
-    writePixel(x0 + x, y0 - y, color);
-    writePixel(x0 - x, y0 - y, color);
-    writePixel(x0 + y, y0 + x, color);
-    writePixel(x0 - y, y0 + x, color);
-    writePixel(x0 + y, y0 - x, color);
-    writePixel(x0 - y, y0 - x, color);
-  }
+  drawCircleHelper(x0, y0, r, 0xF, color); // Same 8 pixels per step
   endWrite();
 }
 
@@ -411,6 +544,13 @@ void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
   int16_t ddF_y = -2 * r;
   int16_t x = 0;
   int16_t y = r;
+  // Each octant goes into a list of its own, so pixels along a scanline
+  // (octants by the top and bottom) or a column (by the sides) merge into
+  // short lines, one address window each instead of one per pixel
+  GFXspanList bottomR(this, color), sideBR(this, color);
+  GFXspanList topR(this, color), sideTR(this, color);
+  GFXspanList sideBL(this, color), bottomL(this, color);
+  GFXspanList sideTL(this, color), topL(this, color);
 
   while (x < y) {
     if (f >= 0) {
@@ -422,22 +562,30 @@ void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
     ddF_x += 2;
     f += ddF_x;
     if (cornername & 0x4) {
-      writePixel(x0 + x, y0 + y, color);
-      writePixel(x0 + y, y0 + x, color);
+      bottomR.add(x0 + x, y0 + y, 1, 1);
+      sideBR.add(x0 + y, y0 + x, 1, 1);
     }
     if (cornername & 0x2) {
-      writePixel(x0 + x, y0 - y, color);
-      writePixel(x0 + y, y0 - x, color);
+      topR.add(x0 + x, y0 - y, 1, 1);
+      sideTR.add(x0 + y, y0 - x, 1, 1);
     }
     if (cornername & 0x8) {
-      writePixel(x0 - y, y0 + x, color);
-      writePixel(x0 - x, y0 + y, color);
+      sideBL.add(x0 - y, y0 + x, 1, 1);
+      bottomL.add(x0 - x, y0 + y, 1, 1);
     }
     if (cornername & 0x1) {
-      writePixel(x0 - y, y0 - x, color);
-      writePixel(x0 - x, y0 - y, color);
+      sideTL.add(x0 - y, y0 - x, 1, 1);
+      topL.add(x0 - x, y0 - y, 1, 1);
     }
   }
+  bottomR.flush(); // Lists of corners not drawn are empty, flush is a no-op
+  sideBR.flush();
+  topR.flush();
+  sideTR.flush();
+  sideBL.flush();
+  bottomL.flush();
+  sideTL.flush();
+  topL.flush();
 }
 
 /**************************************************************************/
@@ -451,6 +599,9 @@ void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
 /**************************************************************************/
 void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r,
                               uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_FILLCIRCLE, (int32_t)(2 * r + 1) * (2 * r + 1));
+  if (!clipOverlaps(x0 - r, y0 - r, x0 + r, y0 + r))
+    return;
   startWrite();
   writeFastVLine(x0, y0 - r, 2 * r + 1, color);
   fillCircleHelper(x0, y0, r, 3, 0, color);
@@ -479,6 +630,9 @@ void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r,
   int16_t y = r;
   int16_t px = x;
   int16_t py = y;
+  // Each side's columns go into a list of their own, so equal heights
+  // on adjacent columns merge into one rect
+  GFXspanList right(this, color), left(this, color);
 
   delta++; // Avoid some +1's in the loop
 
@@ -495,19 +649,21 @@ void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r,
     // for the SSD1306 library which has an INVERT drawing mode.
     if (x < (y + 1)) {
       if (corners & 1)
-        writeFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+        right.add(x0 + x, y0 - y, 1, 2 * y + delta);
       if (corners & 2)
-        writeFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+        left.add(x0 - x, y0 - y, 1, 2 * y + delta);
     }
     if (y != py) {
       if (corners & 1)
-        writeFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+        right.add(x0 + py, y0 - px, 1, 2 * px + delta);
       if (corners & 2)
-        writeFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+        left.add(x0 - py, y0 - px, 1, 2 * px + delta);
       py = y;
     }
     px = x;
   }
+  right.flush();
+  left.flush();
 }
 
 /**************************************************************************/
@@ -522,6 +678,7 @@ void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r,
 /**************************************************************************/
 void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
                             uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_RECT, (int32_t)w * h);
   startWrite();
   writeFastHLine(x, y, w, color);
   writeFastHLine(x, y + h - 1, w, color);
@@ -530,6 +687,184 @@ void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
   endWrite();
 }
 
+// Steps along a linear gradient len pixels long, one pixel per next(),
+// with a multiply per channel and no divides except at each stop
+struct GradientWalk {
+  const GFXgradientStop *stops;
+  uint8_t last, s;             // Index of last stop, and of segment start
+  uint32_t u, du;              // Position and step, in stop units << 16
+  uint32_t p0, p1, rcp;        // Segment ends in stop units << 8, 2^24/dp
+  uint16_t c0, c1;             // Segment end colors
+  int16_t r0, g0, b0, dr, dg, db; // Start fields and the change to the end
+  GradientWalk(const GFXgradientStop *stops, uint8_t nStops, int16_t len,
+               int16_t from)
+      : stops(stops), last(nStops - 1),
+        // Rounding the step up puts the last pixel at (or past) pos 255
+        du((len > 1) ? ((255UL << 16) + len - 2) / (len - 1) : 0) {
+    u = (uint32_t)from * du;
+    segment(0);
+  }
+  void segment(uint8_t i) {
+    s = i;
+    p0 = (uint32_t)stops[i].pos << 8;
+    p1 = (uint32_t)stops[i + 1].pos << 8;
+    rcp = (p1 > p0) ? (256UL << 16) / (p1 - p0) : 0;
+    c0 = stops[i].color;
+    c1 = stops[i + 1].color;
+    r0 = c0 >> 11;
+    g0 = (c0 >> 5) & 0x3F;
+    b0 = c0 & 0x1F;
+    dr = (c1 >> 11) - r0;
+    dg = ((c1 >> 5) & 0x3F) - g0;
+    db = (c1 & 0x1F) - b0;
+  }
+  uint16_t next(void) {
+    uint32_t v = u >> 8;
+    u += du;
+    while ((v > p1) && (s + 1 < last))
+      segment(s + 1);
+    if (v <= p0) // Also before the first stop
+      return c0;
+    if (v >= p1) // Also after the last stop
+      return c1;
+    int32_t a = ((v - p0) * rcp + 0x8000) >> 16; // 0 thru 256
+    return ((r0 + ((dr * a + 128) >> 8)) << 11) |
+           ((g0 + ((dg * a + 128) >> 8)) << 5) | (b0 + ((db * a + 128) >> 8));
+  }
+};
+
+/**************************************************************************/
+/*!
+    @brief  Compute a run of a linear gradient's colors, for a display or
+            canvas subclass filling its own pixel buffers
+    @param  dst        Where the 5-6-5 colors go
+    @param  count      Number of pixels
+    @param  stops      RAM-resident colors and positions, pos ascending
+    @param  nStops     Number of stops; 1 is a solid color
+    @param  len        Length of the whole gradient in pixels
+    @param  from       First pixel wanted, 0 thru len - 1
+    @param  bigEndian  true to store colors byte-swapped, in display order
+*/
+/**************************************************************************/
+void gfxGradient565(uint16_t *dst, uint32_t count,
+                    const GFXgradientStop *stops, uint8_t nStops, int16_t len,
+                    int16_t from, bool bigEndian) {
+  if (nStops < 2) {
+    if (nStops) {
+      uint16_t c = stops[0].color;
+      gfxFill565(dst, bigEndian ? __builtin_bswap16(c) : c, count);
+    }
+    return;
+  }
+  GradientWalk g(stops, nStops, len, from);
+  while (count--) {
+    uint16_t c = g.next();
+    *dst++ = bigEndian ? __builtin_bswap16(c) : c;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Fill a rectangle with a linear gradient through any number of
+   colors: each row one color if vertical (drawn as a fast horizontal
+   line), else each column
+    @param    x         Top left corner x coordinate
+    @param    y         Top left corner y coordinate
+    @param    w         Width in pixels
+    @param    h         Height in pixels
+    @param    stops     RAM-resident colors and where each falls along the
+                        rectangle, 0 the top (or left) edge to 255 the
+                        bottom (or right), in ascending order. Before the
+                        first stop and after the last, their colors
+                        continue.
+    @param    nStops    Number of stops
+    @param    vertical  true (default) for colors changing top to bottom,
+                        false for left to right
+*/
+/**************************************************************************/
+void Adafruit_GFX::fillRectGradientStops(int16_t x, int16_t y, int16_t w,
+                                         int16_t h,
+                                         const GFXgradientStop *stops,
+                                         uint8_t nStops, bool vertical) {
+  if ((w <= 0) || (h <= 0) || !nStops ||
+      !clipOverlaps(x, y, x + w - 1, y + h - 1))
+    return;
+  if (nStops == 1) {
+    fillRect(x, y, w, h, stops[0].color);
+    return;
+  }
+  GradientWalk g(stops, nStops, vertical ? h : w, 0);
+  startWrite();
+  if (vertical) {
+    for (int16_t j = 0; j < h; j++)
+      writeFastHLine(x, y + j, w, g.next());
+  } else {
+    for (int16_t i = 0; i < w; i++)
+      writeFastVLine(x + i, y, h, g.next());
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief   Fill a rectangle with a linear gradient from one color to
+   another (see fillRectGradientStops() for more colors)
+    @param    x         Top left corner x coordinate
+    @param    y         Top left corner y coordinate
+    @param    w         Width in pixels
+    @param    h         Height in pixels
+    @param    color0    16-bit 5-6-5 Color of the top (or left) edge
+    @param    color1    16-bit 5-6-5 Color of the bottom (or right) edge
+    @param    vertical  true (default) for colors changing top to bottom,
+                        false for left to right
+*/
+/**************************************************************************/
+void Adafruit_GFX::fillRectGradient(int16_t x, int16_t y, int16_t w,
+                                    int16_t h, uint16_t color0,
+                                    uint16_t color1, bool vertical) {
+  GFXgradientStop stops[2] = {{0, color0}, {255, color1}};
+  fillRectGradientStops(x, y, w, h, stops, 2, vertical);
+}
+
+/**************************************************************************/
+/*!
+   @brief   Fill a rectangle with copies of a small image, tiled from
+   drawing coordinate (0,0) so that neighboring and later fills with the
+   same pattern line up
+    @param    x        Top left corner x coordinate
+    @param    y        Top left corner y coordinate
+    @param    w        Width in pixels
+    @param    h        Height in pixels
+    @param    pattern  RAM-resident 16-bit 5-6-5 tile, pw * ph pixels
+    @param    pw       Width of tile in pixels
+    @param    ph       Height of tile in pixels
+*/
+/**************************************************************************/
+void Adafruit_GFX::fillRectPattern(int16_t x, int16_t y, int16_t w, int16_t h,
+                                   const uint16_t *pattern, int16_t pw,
+                                   int16_t ph) {
+  if ((w <= 0) || (h <= 0) || (pw <= 0) || (ph <= 0) ||
+      !clipOverlaps(x, y, x + w - 1, y + h - 1))
+    return;
+  int16_t i0 = x % pw, t = y % ph; // Tile column and row of (x, y)
+  if (i0 < 0)
+    i0 += pw;
+  if (t < 0)
+    t += ph;
+  startWrite();
+  for (int16_t j = 0; j < h; j++) {
+    const uint16_t *line = &pattern[(int32_t)t * pw];
+    for (int16_t i = 0, c = i0; i < w; i++) {
+      writePixel(x + i, y + j, line[c]);
+      if (++c == pw)
+        c = 0;
+    }
+    if (++t == ph)
+      t = 0;
+  }
+  endWrite();
+}
+
 /**************************************************************************/
 /*!
    @brief   Draw a rounded rectangle with no fill color
@@ -543,6 +878,9 @@ void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
 /**************************************************************************/
 void Adafruit_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                  int16_t r, uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_ROUNDRECT, (int32_t)w * h);
+  if (!clipOverlaps(x, y, x + w - 1, y + h - 1))
+    return;
   int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
   if (r > max_radius)
     r = max_radius;
@@ -573,6 +911,9 @@ void Adafruit_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
 /**************************************************************************/
 void Adafruit_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                  int16_t r, uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_FILLROUNDRECT, (int32_t)w * h);
+  if (!clipOverlaps(x, y, x + w - 1, y + h - 1))
+    return;
   int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
   if (r > max_radius)
     r = max_radius;
@@ -599,6 +940,7 @@ void Adafruit_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
 /**************************************************************************/
 void Adafruit_GFX::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                                 int16_t x2, int16_t y2, uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_TRIANGLE, 0);
   drawLine(x0, y0, x1, y1, color);
   drawLine(x1, y1, x2, y2, color);
   drawLine(x2, y2, x0, y0, color);
@@ -618,6 +960,7 @@ void Adafruit_GFX::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 /**************************************************************************/
 void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                                 int16_t x2, int16_t y2, uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_FILLTRIANGLE, 0);
 
   int16_t a, b, y, last;
 
@@ -635,17 +978,23 @@ void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
     _swap_int16_t(x0, x1);
   }
 
+  // Reject if bounding box is clipped entirely, else trim rows to clip
+  int16_t cx1, cy1, cx2, cy2;
+  clipBounds(&cx1, &cy1, &cx2, &cy2);
+  a = b = x0;
+  if (x1 < a)
+    a = x1;
+  else if (x1 > b)
+    b = x1;
+  if (x2 < a)
+    a = x2;
+  else if (x2 > b)
+    b = x2;
+  if ((y0 > cy2) || (y2 < cy1) || (a > cx2) || (b < cx1))
+    return;
+
   startWrite();
   if (y0 == y2) { // Handle awkward all-on-same-line case as its own thing
-    a = b = x0;
-    if (x1 < a)
-      a = x1;
-    else if (x1 > b)
-      b = x1;
-    if (x2 < a)
-      a = x2;
-    else if (x2 > b)
-      b = x2;
     writeFastHLine(a, y0, b - a + 1, color);
     endWrite();
     return;
@@ -653,7 +1002,8 @@ void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 
   int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
           dx12 = x2 - x1, dy12 = y2 - y1;
-  int32_t sa = 0, sb = 0;
+  int32_t sa, sb;
+  GFXspanList spans(this, color); // Rows with equal ends merge into rects
 
   // For upper part of triangle, find scanline crossings for segments
   // 0-1 and 0-2.  If y1=y2 (flat-bottomed triangle), the scanline y1
@@ -666,7 +1016,12 @@ void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
   else
     last = y1 - 1; // Skip it
 
-  for (y = y0; y <= last; y++) {
+  // Rows above or below the clip are skipped, not just clipped
+  y = (y0 < cy1) ? cy1 : y0;
+  int16_t end = (last < cy2) ? last : cy2;
+  sa = (int32_t)dx01 * (y - y0);
+  sb = (int32_t)dx02 * (y - y0);
+  for (; y <= end; y++) {
     a = x0 + sa / dy01;
     b = x0 + sb / dy02;
     sa += dx01;
@@ -677,14 +1032,17 @@ void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
     */
     if (a > b)
       _swap_int16_t(a, b);
-    writeFastHLine(a, y, b - a + 1, color);
+    spans.add(a, y, b - a + 1, 1);
   }
 
   // For lower part of triangle, find scanline crossings for segments
   // 0-2 and 1-2.  This loop is skipped if y1=y2.
+  if (y <= last)
+    y = last + 1;
+  end = (y2 < cy2) ? y2 : cy2;
   sa = (int32_t)dx12 * (y - y1);
   sb = (int32_t)dx02 * (y - y0);
-  for (; y <= y2; y++) {
+  for (; y <= end; y++) {
     a = x1 + sa / dy12;
     b = x0 + sb / dy02;
     sa += dx12;
@@ -695,149 +1053,478 @@ void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
     */
     if (a > b)
       _swap_int16_t(a, b);
-    writeFastHLine(a, y, b - a + 1, color);
+    spans.add(a, y, b - a + 1, 1);
   }
+  spans.flush();
   endWrite();
 }
 
-// BITMAP / XBITMAP / GRAYSCALE / RGB BITMAP FUNCTIONS ---------------------
+// POLYLINES AND CHART SERIES ----------------------------------------------
 
 /**************************************************************************/
 /*!
-   @brief      Draw a PROGMEM-resident 1-bit image at the specified (x,y)
-   position, using the specified foreground color (unset bits are transparent).
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with monochrome bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
+   @brief    Write a line as runs of pixels rather than single pixels: the
+             same pixels as writeLine(), but each horizontal run (shallow
+             lines) or vertical run (steep lines) goes out as one
+             writeFastHLine() or writeFastVLine()
+    @param    x0  Start point x coordinate
+    @param    y0  Start point y coordinate
+    @param    x1  End point x coordinate
+    @param    y1  End point y coordinate
     @param    color 16-bit 5-6-5 Color to draw with
+    @param    skipFirst  If true, leave out the start point (already drawn
+                         as the end of the previous segment)
 */
 /**************************************************************************/
-void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
-                              int16_t w, int16_t h, uint16_t color) {
+void Adafruit_GFX::writeLineRuns(int16_t x0, int16_t y0, int16_t x1,
+                                 int16_t y1, uint16_t color, bool skipFirst) {
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    _swap_int16_t(x0, y0);
+    _swap_int16_t(x1, y1);
+  }
+  bool reversed = x0 > x1;
+  if (reversed) {
+    _swap_int16_t(x0, x1);
+    _swap_int16_t(y0, y1);
+  }
 
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t byte = 0;
+  int16_t dx = x1 - x0, dy = abs(y1 - y0), err = dx / 2;
+  int16_t ystep = (y0 < y1) ? 1 : -1;
+  int16_t first = x0, last = x1; // Extent to draw along the major axis
+  if (skipFirst) {
+    if (reversed)
+      last--;
+    else
+      first++;
+  }
 
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-      if (byte & 0x80)
-        writePixel(x + i, y, color);
+  for (int16_t run = x0; x0 <= x1; x0++) {
+    err -= dy;
+    if ((err < 0) || (x0 == x1)) { // Minor axis steps after this pixel
+      int16_t a = (run > first) ? run : first, b = (x0 < last) ? x0 : last;
+      if (a <= b) {
+        if (steep)
+          writeFastVLine(y0, a, b - a + 1, color);
+        else
+          writeFastHLine(a, y0, b - a + 1, color);
+      }
+      y0 += ystep;
+      err += dx;
+      run = x0 + 1;
     }
   }
-  endWrite();
 }
 
 /**************************************************************************/
 /*!
-   @brief      Draw a PROGMEM-resident 1-bit image at the specified (x,y)
-   position, using the specified foreground (for set bits) and background (unset
-   bits) colors.
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with monochrome bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
-    @param    color 16-bit 5-6-5 Color to draw pixels with
-    @param    bg 16-bit 5-6-5 Color to draw background with
+   @brief    Draw connected line segments through a list of points. Same
+             pixels as drawLine() between each pair of points, but inside
+             a single write transaction, with segments entirely outside
+             the clip rect skipped and shared endpoints drawn only once.
+    @param    x  Array of n point x coordinates
+    @param    y  Array of n point y coordinates
+    @param    n  Number of points (one point draws a pixel)
+    @param    color 16-bit 5-6-5 Color to draw with
 */
 /**************************************************************************/
-void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
-                              int16_t w, int16_t h, uint16_t color,
-                              uint16_t bg) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t byte = 0;
-
+void Adafruit_GFX::drawPolyline(const int16_t *x, const int16_t *y,
+                                uint16_t n, uint16_t color) {
+  if (!n)
+    return;
+  int16_t cx1, cy1, cx2, cy2;
+  clipBounds(&cx1, &cy1, &cx2, &cy2);
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-      writePixel(x + i, y, (byte & 0x80) ? color : bg);
-    }
+  if (n == 1)
+    writePixel(x[0], y[0], color);
+  for (uint16_t i = 1; i < n; i++) {
+    int16_t x0 = x[i - 1], y0 = y[i - 1], x1 = x[i], y1 = y[i];
+    if (((x0 < cx1) && (x1 < cx1)) || ((x0 > cx2) && (x1 > cx2)) ||
+        ((y0 < cy1) && (y1 < cy1)) || ((y0 > cy2) && (y1 > cy2)))
+      continue; // Segment's bounding box is outside the clip
+    writeLineRuns(x0, y0, x1, y1, color, i > 1);
   }
   endWrite();
 }
 
 /**************************************************************************/
 /*!
-   @brief      Draw a RAM-resident 1-bit image at the specified (x,y) position,
-   using the specified foreground color (unset bits are transparent).
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with monochrome bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
+   @brief    Draw a chart series: connected line segments through n values
+             at evenly spaced columns, same pixels as drawPolyline(). With
+             one column per value (dx of 1 or -1), each column is a single
+             vertical span from where the line enters to where it leaves,
+             and columns outside the clip rect aren't visited at all.
+    @param    x  Column of the first value
+    @param    dx Columns between successive values, may be negative
+    @param    y  Array of n row values
+    @param    n  Number of values
     @param    color 16-bit 5-6-5 Color to draw with
 */
 /**************************************************************************/
-void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
-                              int16_t h, uint16_t color) {
+void Adafruit_GFX::drawSeries(int16_t x, int16_t dx, const int16_t *y,
+                              uint16_t n, uint16_t color) {
+  if (!n)
+    return;
+  int16_t cx1, cy1, cx2, cy2;
+  clipBounds(&cx1, &cy1, &cx2, &cy2);
+  if ((dx != 1) && (dx != -1)) {
+    startWrite();
+    if (n == 1)
+      writePixel(x, y[0], color);
+    int16_t x0 = x;
+    for (uint16_t i = 1; i < n; i++) {
+      int16_t x1 = x0 + dx, y0 = y[i - 1], y1 = y[i];
+      if (!(((x0 < cx1) && (x1 < cx1)) || ((x0 > cx2) && (x1 > cx2)) ||
+            ((y0 < cy1) && (y1 < cy1)) || ((y0 > cy2) && (y1 > cy2))))
+        writeLineRuns(x0, y0, x1, y1, color, i > 1);
+      x0 = x1;
+    }
+    endWrite();
+    return;
+  }
 
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t byte = 0;
+  // Values i0 to i1 land in visible columns
+  int32_t i0, i1;
+  if (dx > 0) {
+    i0 = (int32_t)cx1 - x;
+    i1 = (int32_t)cx2 - x;
+  } else {
+    i0 = (int32_t)x - cx2;
+    i1 = (int32_t)x - cx1;
+  }
+  if (i0 < 0)
+    i0 = 0;
+  if (i1 > n - 1)
+    i1 = n - 1;
+  if (i0 > i1)
+    return;
 
+  // Between adjacent columns, drawLine() puts the first d/2 + 1 of the d + 1
+  // rows spanned, counting from the smaller y, in that point's column and
+  // the rest in the other
+  GFXspanList spans(this, color);
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = bitmap[j * byteWidth + i / 8];
-      if (byte & 0x80)
-        writePixel(x + i, y, color);
+  for (int32_t i = i0; i <= i1; i++) {
+    int16_t v = y[i], lo = v, hi = v, d;
+    if (i > 0) { // Segment from the previous value
+      int16_t p = y[i - 1];
+      if (p < v) {
+        d = v - p;
+        lo = p + d / 2 + 1;
+      } else if (p > v) {
+        d = p - v;
+        hi = v + d / 2;
+      }
+    }
+    if (i < n - 1) { // Segment to the next value
+      int16_t q = y[i + 1];
+      if (q < v) {
+        d = v - q;
+        if (q + d / 2 + 1 < lo)
+          lo = q + d / 2 + 1;
+      } else if (q > v) {
+        d = q - v;
+        if (v + d / 2 > hi)
+          hi = v + d / 2;
+      }
     }
+    spans.add(x + i * dx, lo, 1, hi - lo + 1);
   }
+  spans.flush();
   endWrite();
 }
 
-/**************************************************************************/
-/*!
-   @brief      Draw a RAM-resident 1-bit image at the specified (x,y) position,
-   using the specified foreground (for set bits) and background (unset bits)
-   colors.
-    @param    x   Top left corner x coordinate
-    @param    y   Top left corner y coordinate
-    @param    bitmap  byte array with monochrome bitmap
-    @param    w   Width of bitmap in pixels
-    @param    h   Height of bitmap in pixels
-    @param    color 16-bit 5-6-5 Color to draw pixels with
-    @param    bg 16-bit 5-6-5 Color to draw background with
-*/
-/**************************************************************************/
-void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
-                              int16_t h, uint16_t color, uint16_t bg) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t byte = 0;
-
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = bitmap[j * byteWidth + i / 8];
-      writePixel(x + i, y, (byte & 0x80) ? color : bg);
+// ANTI-ALIASED PRIMITIVES -------------------------------------------------
+
+// Integer square root, rounded down
+static uint16_t isqrt32(uint32_t n) {
+  uint32_t root = 0, bit = 1UL << 30;
+  while (bit > n)
+    bit >>= 2;
+  while (bit) {
+    if (n >= root + bit) {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
     }
+    bit >>= 2;
   }
-  endWrite();
+  return root;
 }
 
 /**************************************************************************/
 /*!
-   @brief      Draw PROGMEM-resident XBitMap Files (*.xbm), exported from GIMP.
-   Usage: Export from GIMP to *.xbm, rename *.xbm to *.c and open in editor.
-   C Array can be directly used with this function.
+   @brief    Draw an anti-aliased line (Xiaolin Wu's algorithm, integer
+             fixed-point). Each step along the major axis splits coverage
+             between the two pixels straddling the ideal line. Horizontal,
+             vertical and 45 degree lines fall exactly on pixels and are
+             drawn by drawLine() instead.
+    @param    x0  Start point x coordinate
+    @param    y0  Start point y coordinate
+    @param    x1  End point x coordinate
+    @param    y1  End point y coordinate
+    @param    color 16-bit 5-6-5 Color to draw with
+    @param    bg  16-bit 5-6-5 Color partially covered pixels are blended
+                  toward. Ignored on a GFXcanvas16, which blends with the
+                  pixels already in the canvas.
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawLineAA(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                              uint16_t color, uint16_t bg) {
+  int16_t dx = abs(x1 - x0), dy = abs(y1 - y0);
+  if (!dx || !dy || (dx == dy)) {
+    drawLine(x0, y0, x1, y1, color);
+    return;
+  }
+  // Box around the line, plus the pixel either side of it
+  if (!clipOverlaps(((x0 < x1) ? x0 : x1) - 1, ((y0 < y1) ? y0 : y1) - 1,
+                    ((x0 > x1) ? x0 : x1) + 1, ((y0 > y1) ? y0 : y1) + 1))
+    return;
+
+  bool steep = dy > dx;
+  if (steep) { // Step along y instead
+    _swap_int16_t(x0, y0);
+    _swap_int16_t(x1, y1);
+  }
+  if (x0 > x1) {
+    _swap_int16_t(x0, x1);
+    _swap_int16_t(y0, y1);
+  }
+
+  // Minor axis position in 16.16 fixed point; top 8 bits of the fraction
+  // are the coverage of the farther pixel
+  int32_t grad = (int32_t)(y1 - y0) * 65536 / (x1 - x0),
+          yf = (int32_t)y0 * 65536 + grad;
+  startWrite();
+  if (steep) {
+    writePixel(y0, x0, color); // Endpoints are exact
+    writePixel(y1, x1, color);
+  } else {
+    writePixel(x0, y0, color);
+    writePixel(x1, y1, color);
+  }
+  for (int16_t x = x0 + 1; x < x1; x++, yf += grad) {
+    int16_t y = yf >> 16;
+    uint8_t a = (yf >> 8) & 0xFF;
+    if (steep) {
+      blendPixel(y, x, color, bg, ~a);
+      blendPixel(y + 1, x, color, bg, a);
+    } else {
+      blendPixel(x, y, color, bg, ~a);
+      blendPixel(x, y + 1, color, bg, a);
+    }
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw an anti-aliased circle outline (Wu's algorithm). Each
+             column of an octant splits coverage between the two pixels
+             straddling the ideal circle, found with an integer square
+             root, and is mirrored into the other seven octants.
+    @param    x0   Center-point x coordinate
+    @param    y0   Center-point y coordinate
+    @param    r   Radius of circle
+    @param    color 16-bit 5-6-5 Color to draw with
+    @param    bg  16-bit 5-6-5 Color partially covered pixels are blended
+                  toward. Ignored on a GFXcanvas16, which blends with the
+                  pixels already in the canvas.
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawCircleAA(int16_t x0, int16_t y0, int16_t r,
+                                uint16_t color, uint16_t bg) {
+  if (r <= 0) {
+    drawCircle(x0, y0, r, color);
+    return;
+  }
+  if (!clipOverlaps(x0 - r - 1, y0 - r - 1, x0 + r + 1, y0 + r + 1))
+    return;
+
+  // Square root is taken with as many fraction bits (up to 8) as fit
+  uint32_t r2 = (uint32_t)r * r;
+  uint8_t fb = 8;
+  while (fb && (r2 >> (32 - 2 * fb)))
+    fb--;
+
+  startWrite();
+  for (int16_t x = 0;; x++) {
+    uint16_t yf = isqrt32((r2 - (uint32_t)x * x) << (2 * fb));
+    int16_t y = yf >> fb;
+    if (x > y)
+      break;
+    uint8_t a = (yf << (8 - fb)) & 0xFF; // Coverage of outer pixel
+    for (uint8_t q = 0; q < 4; q++) {    // Each quadrant...
+      int16_t sx = (q & 1) ? -1 : 1, sy = (q & 2) ? -1 : 1;
+      if (!(x == 0 && (q & 1))) { // Octant nearer the vertical axis
+        blendPixel(x0 + sx * x, y0 + sy * y, color, bg, ~a);
+        blendPixel(x0 + sx * x, y0 + sy * (y + 1), color, bg, a);
+      }
+      if (!(x == 0 && (q & 2))) { // Octant nearer the horizontal axis
+        if (x != y)               // (Same pixel as above on the diagonal)
+          blendPixel(x0 + sx * y, y0 + sy * x, color, bg, ~a);
+        blendPixel(x0 + sx * (y + 1), y0 + sy * x, color, bg, a);
+      }
+    }
+  }
+  endWrite();
+}
+
+// BITMAP / XBITMAP / GRAYSCALE / RGB BITMAP FUNCTIONS ---------------------
+
+/**************************************************************************/
+/*!
+   @brief      Draw a PROGMEM-resident 1-bit image at the specified (x,y)
+   position, using the specified foreground color (unset bits are transparent).
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                              int16_t w, int16_t h, uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_BITMAP, (int32_t)w * h);
+
+  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
+  uint8_t byte = 0;
+
+  int16_t j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
+  startWrite();
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7)
+        byte <<= 1;
+      else
+        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+      if (byte & 0x80)
+        writePixel(x + i, y + j, color);
+    }
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief      Draw a PROGMEM-resident 1-bit image at the specified (x,y)
+   position, using the specified foreground (for set bits) and background (unset
+   bits) colors.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color 16-bit 5-6-5 Color to draw pixels with
+    @param    bg 16-bit 5-6-5 Color to draw background with
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                              int16_t w, int16_t h, uint16_t color,
+                              uint16_t bg) {
+  GFX_PROFILE_SCOPE(GFX_PROF_BITMAP, (int32_t)w * h);
+
+  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
+  uint8_t byte = 0;
+
+  int16_t j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
+  startWrite();
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7)
+        byte <<= 1;
+      else
+        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+      writePixel(x + i, y + j, (byte & 0x80) ? color : bg);
+    }
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief      Draw a RAM-resident 1-bit image at the specified (x,y) position,
+   using the specified foreground color (unset bits are transparent).
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                              int16_t h, uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_BITMAP, (int32_t)w * h);
+
+  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
+  uint8_t byte = 0;
+
+  int16_t j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
+  startWrite();
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7)
+        byte <<= 1;
+      else
+        byte = bitmap[j * byteWidth + i / 8];
+      if (byte & 0x80)
+        writePixel(x + i, y + j, color);
+    }
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief      Draw a RAM-resident 1-bit image at the specified (x,y) position,
+   using the specified foreground (for set bits) and background (unset bits)
+   colors.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color 16-bit 5-6-5 Color to draw pixels with
+    @param    bg 16-bit 5-6-5 Color to draw background with
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                              int16_t h, uint16_t color, uint16_t bg) {
+  GFX_PROFILE_SCOPE(GFX_PROF_BITMAP, (int32_t)w * h);
+
+  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
+  uint8_t byte = 0;
+
+  int16_t j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
+  startWrite();
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7)
+        byte <<= 1;
+      else
+        byte = bitmap[j * byteWidth + i / 8];
+      writePixel(x + i, y + j, (byte & 0x80) ? color : bg);
+    }
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief      Draw PROGMEM-resident XBitMap Files (*.xbm), exported from GIMP.
+   Usage: Export from GIMP to *.xbm, rename *.xbm to *.c and open in editor.
+   C Array can be directly used with this function.
    There is no RAM-resident version of this function; if generating bitmaps
    in RAM, use the format defined by drawBitmap() and call that instead.
     @param    x   Top left corner x coordinate
@@ -850,12 +1537,16 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
 /**************************************************************************/
 void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
                                int16_t w, int16_t h, uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_BITMAP, (int32_t)w * h);
 
   int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
   uint8_t byte = 0;
 
+  int16_t j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
+  for (int16_t j = j0; j < j1; j++) {
     for (int16_t i = 0; i < w; i++) {
       if (i & 7)
         byte >>= 1;
@@ -864,7 +1555,7 @@ void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
       // Nearly identical to drawBitmap(), only the bit order
       // is reversed here (left-to-right = LSB to MSB):
       if (byte & 0x01)
-        writePixel(x + i, y, color);
+        writePixel(x + i, y + j, color);
     }
   }
   endWrite();
@@ -885,10 +1576,14 @@ void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
 void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
                                        const uint8_t bitmap[], int16_t w,
                                        int16_t h) {
+  GFX_PROFILE_SCOPE(GFX_PROF_GRAYBITMAP, (int32_t)w * h);
+  int16_t j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
+  for (int16_t j = j0; j < j1; j++) {
     for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
+      writePixel(x + i, y + j, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
     }
   }
   endWrite();
@@ -908,10 +1603,14 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
 /**************************************************************************/
 void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
                                        int16_t w, int16_t h) {
+  GFX_PROFILE_SCOPE(GFX_PROF_GRAYBITMAP, (int32_t)w * h);
+  int16_t j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
+  for (int16_t j = j0; j < j1; j++) {
     for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, bitmap[j * w + i]);
+      writePixel(x + i, y + j, bitmap[j * w + i]);
     }
   }
   endWrite();
@@ -936,17 +1635,21 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
                                        const uint8_t bitmap[],
                                        const uint8_t mask[], int16_t w,
                                        int16_t h) {
+  GFX_PROFILE_SCOPE(GFX_PROF_GRAYBITMAP, (int32_t)w * h);
   int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
   uint8_t byte = 0;
+  int16_t j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
+  for (int16_t j = j0; j < j1; j++) {
     for (int16_t i = 0; i < w; i++) {
       if (i & 7)
         byte <<= 1;
       else
         byte = pgm_read_byte(&mask[j * bw + i / 8]);
       if (byte & 0x80) {
-        writePixel(x + i, y, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
+        writePixel(x + i, y + j, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
       }
     }
   }
@@ -970,17 +1673,21 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
 /**************************************************************************/
 void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
                                        uint8_t *mask, int16_t w, int16_t h) {
+  GFX_PROFILE_SCOPE(GFX_PROF_GRAYBITMAP, (int32_t)w * h);
   int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
   uint8_t byte = 0;
+  int16_t j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
+  for (int16_t j = j0; j < j1; j++) {
     for (int16_t i = 0; i < w; i++) {
       if (i & 7)
         byte <<= 1;
       else
         byte = mask[j * bw + i / 8];
       if (byte & 0x80) {
-        writePixel(x + i, y, bitmap[j * w + i]);
+        writePixel(x + i, y + j, bitmap[j * w + i]);
       }
     }
   }
@@ -1000,10 +1707,14 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
 /**************************************************************************/
 void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
                                  int16_t w, int16_t h) {
+  GFX_PROFILE_SCOPE(GFX_PROF_RGBBITMAP, (int32_t)w * h);
+  int16_t j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
+  for (int16_t j = j0; j < j1; j++) {
     for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, pgm_read_word(&bitmap[j * w + i]));
+      writePixel(x + i, y + j, pgm_read_word(&bitmap[j * w + i]));
     }
   }
   endWrite();
@@ -1022,10 +1733,14 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
 /**************************************************************************/
 void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
                                  int16_t w, int16_t h) {
+  GFX_PROFILE_SCOPE(GFX_PROF_RGBBITMAP, (int32_t)w * h);
+  int16_t j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
+  for (int16_t j = j0; j < j1; j++) {
     for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, bitmap[j * w + i]);
+      writePixel(x + i, y + j, bitmap[j * w + i]);
     }
   }
   endWrite();
@@ -1047,17 +1762,21 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
 /**************************************************************************/
 void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
                                  const uint8_t mask[], int16_t w, int16_t h) {
+  GFX_PROFILE_SCOPE(GFX_PROF_RGBBITMAP, (int32_t)w * h);
   int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
   uint8_t byte = 0;
+  int16_t j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
+  for (int16_t j = j0; j < j1; j++) {
     for (int16_t i = 0; i < w; i++) {
       if (i & 7)
         byte <<= 1;
       else
         byte = pgm_read_byte(&mask[j * bw + i / 8]);
       if (byte & 0x80) {
-        writePixel(x + i, y, pgm_read_word(&bitmap[j * w + i]));
+        writePixel(x + i, y + j, pgm_read_word(&bitmap[j * w + i]));
       }
     }
   }
@@ -1080,17 +1799,200 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
 /**************************************************************************/
 void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
                                  uint8_t *mask, int16_t w, int16_t h) {
+  GFX_PROFILE_SCOPE(GFX_PROF_RGBBITMAP, (int32_t)w * h);
   int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
   uint8_t byte = 0;
+  int16_t j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
+  for (int16_t j = j0; j < j1; j++) {
     for (int16_t i = 0; i < w; i++) {
       if (i & 7)
         byte <<= 1;
       else
         byte = mask[j * bw + i / 8];
       if (byte & 0x80) {
-        writePixel(x + i, y, bitmap[j * w + i]);
+        writePixel(x + i, y + j, bitmap[j * w + i]);
+      }
+    }
+  }
+  endWrite();
+}
+
+// Images of 8 bits per channel (camera frames, decoded network images)
+// are quantized to the target's depth with optional ordered dithering:
+// each channel is scaled to its range plus a threshold from a 4x4 Bayer
+// matrix by pixel position, then truncated, so flat areas between two
+// levels come out as a fine, even mix of both rather than as bands.
+
+// 4x4 Bayer matrix, by row then column mod 4
+static const uint8_t bayer4x4[16] = {0, 8,  2, 10, 12, 4,  14, 6,
+                                     3, 11, 1, 9,  15, 7,  13, 5};
+
+// Rounding threshold, 0 thru 248, for the pixel at (x, y): its Bayer level
+// spread over a byte if dithering, else the midpoint (nearest level)
+static inline uint8_t ditherLevel(int16_t x, int16_t y, bool dither) {
+  return dither ? bayer4x4[((y & 3) << 2) | (x & 3)] * 16 + 8 : 127;
+}
+
+// Scale an 8-bit channel to 0 thru top: (v * top + t) / 255, the divide
+// done exactly with shifts and adds
+static inline uint8_t quantize(uint8_t v, uint8_t top, uint8_t t) {
+  uint16_t n = v * top + t;
+  return (n + 1 + (n >> 8)) >> 8;
+}
+
+// Quantize one pixel of an 8-bit-per-channel image to 565 (depth 16),
+// RGB332 (depth 8) or, by luminance, 1 bit, rounding with threshold t
+static inline uint16_t rgbQuantize(const uint8_t *p, GFXrgbFormat format,
+                                   uint8_t depth, uint8_t t) {
+  uint8_t r, g, b;
+  if (format == GFX_GRAY8) {
+    r = g = b = p[0];
+  } else if (format == GFX_RGB888) {
+    r = p[0];
+    g = p[1];
+    b = p[2];
+  } else {
+    b = p[0];
+    g = p[1];
+    r = p[2];
+  }
+  if (depth == 16)
+    return (quantize(r, 31, t) << 11) | (quantize(g, 63, t) << 5) |
+           quantize(b, 31, t);
+  if (depth == 8)
+    return (quantize(r, 7, t) << 5) | (quantize(g, 7, t) << 2) |
+           quantize(b, 3, t);
+  return quantize((r * 77 + g * 150 + b * 29) >> 8, 1, t);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Convert a row of 8-bit-per-channel pixels to 16-bit 5-6-5, for
+            a canvas buffer or a display's pixel stream
+    @param  dst        Where the 565 pixels go. May be the same memory as
+                       src, converting in place.
+    @param  src        Source pixels
+    @param  len        Number of pixels
+    @param  format     Layout of src
+    @param  x          Screen column of the first pixel, for the dither
+                       pattern
+    @param  y          Screen row of the pixels
+    @param  dither     true for ordered dithering, false to round each
+                       channel to the nearest level
+    @param  bigEndian  true to store pixels byte-swapped, in display order
+*/
+/**************************************************************************/
+void gfxConvert565(uint16_t *dst, const uint8_t *src, uint32_t len,
+                   GFXrgbFormat format, int16_t x, int16_t y, bool dither,
+                   bool bigEndian) {
+  uint8_t bpp = (format == GFX_GRAY8) ? 1 : 3;
+  for (uint32_t i = 0; i < len; i++, src += bpp) {
+    uint16_t c = rgbQuantize(src, format, 16, ditherLevel(x + i, y, dither));
+    dst[i] = bigEndian ? __builtin_bswap16(c) : c;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Convert a row of 8-bit-per-channel pixels to RRRGGGBB (RGB332),
+            the default GFXcanvas8 palette's indices
+    @param  dst     Where the 8-bit pixels go. May be the same memory as
+                    src, converting in place.
+    @param  src     Source pixels
+    @param  len     Number of pixels
+    @param  format  Layout of src
+    @param  x       Screen column of the first pixel, for the dither pattern
+    @param  y       Screen row of the pixels
+    @param  dither  true for ordered dithering, false to round each channel
+                    to the nearest level
+*/
+/**************************************************************************/
+void gfxConvert332(uint8_t *dst, const uint8_t *src, uint32_t len,
+                   GFXrgbFormat format, int16_t x, int16_t y, bool dither) {
+  uint8_t bpp = (format == GFX_GRAY8) ? 1 : 3;
+  for (uint32_t i = 0; i < len; i++, src += bpp)
+    dst[i] = rgbQuantize(src, format, 8, ditherLevel(x + i, y, dither));
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a RAM-resident image of 8 bits per channel, such as a
+   camera frame, at the specified (x,y) position, converted to 16-bit 5-6-5
+   color. Canvases convert to their own depth instead, straight into their
+   buffers, and Adafruit_SPITFT a chunk at a time into its pixel stream.
+    @param    x       Top left corner x coordinate
+    @param    y       Top left corner y coordinate
+    @param    bitmap  Image rows, w pixels each with no padding
+    @param    w       Width of bitmap in pixels
+    @param    h       Height of bitmap in pixels
+    @param    format  GFX_RGB888 (the default), GFX_BGR888 or GFX_GRAY8
+    @param    dither  true (the default) for ordered dithering, smoothing
+                      gradients that would otherwise show bands; false to
+                      round to the nearest color
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawRGB888Bitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                    int16_t w, int16_t h, GFXrgbFormat format,
+                                    bool dither) {
+  uint8_t bpp = (format == GFX_GRAY8) ? 1 : 3;
+  int16_t j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
+  startWrite();
+  for (int16_t j = j0; j < j1; j++) {
+    const uint8_t *p = &bitmap[(int32_t)j * w * bpp];
+    for (int16_t i = 0; i < w; i++, p += bpp)
+      writePixel(x + i, y + j,
+                 rgbQuantize(p, format, 16,
+                             ditherLevel(x + i, y + j, dither)));
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a PROGMEM-resident compressed sprite (see GFXspriteReader)
+   at the specified (x,y) position: a 16-bit image stored as runs of one
+   color, runs of transparent pixels and literal spans, typically in much
+   less flash than drawRGBBitmap() and its separate mask need. Each run is
+   drawn as a single line, so decoding is often faster than copying the
+   same pixels from a plain bitmap.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    sprite  byte array made by the spriteconvert tool
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawSprite(int16_t x, int16_t y, const uint8_t sprite[]) {
+  int16_t w = GFXspriteReader::width(sprite),
+          h = GFXspriteReader::height(sprite), j0, j1; // Visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
+  GFXspriteReader reader(sprite);
+  int16_t i = 0, j = 0; // Sprite column & row of next op
+  startWrite();
+  while (j < j1) {
+    uint16_t n;
+    uint8_t op = reader.next(&n);
+    while (n && (j < j1)) { // Split op at row ends
+      int16_t k = (n < (uint16_t)(w - i)) ? n : w - i;
+      if (op == GFXSPRITE_RUN) {
+        if (j >= j0)
+          writeFastHLine(x + i, y + j, k, reader.runColor());
+      } else if (op == GFXSPRITE_LITERAL) {
+        if (j >= j0) {
+          for (int16_t p = 0; p < k; p++)
+            writePixel(x + i + p, y + j, reader.pixel());
+        } else {
+          reader.skip(k);
+        }
+      }
+      n -= k;
+      if ((i += k) == w) {
+        i = 0;
+        j++;
       }
     }
   }
@@ -1134,105 +2036,436 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
 void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
                             uint16_t color, uint16_t bg, uint8_t size_x,
                             uint8_t size_y) {
+  GFX_PROFILE_SCOPE(GFX_PROF_CHAR, gfxFont ? 0 : 48 * size_x * size_y);
+  startWrite();
+  writeChar(x, y, c, color, bg, size_x, size_y);
+  endWrite();
+}
 
-  if (!gfxFont) { // 'Classic' built-in font
-
-    if ((x >= _width) ||              // Clip right
-        (y >= _height) ||             // Clip bottom
-        ((x + 6 * size_x - 1) < 0) || // Clip left
-        ((y + 8 * size_y - 1) < 0))   // Clip top
-      return;
-
-    if (!_cp437 && (c >= 176))
-      c++; // Handle 'classic' charset behavior
-
-    startWrite();
-    for (int8_t i = 0; i < 5; i++) { // Char bitmap = 5 columns
-      uint8_t line = pgm_read_byte(&font[c * 5 + i]);
-      for (int8_t j = 0; j < 8; j++, line >>= 1) {
-        if (line & 1) {
-          if (size_x == 1 && size_y == 1)
-            writePixel(x + i, y + j, color);
-          else
-            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y,
-                          color);
-        } else if (bg != color) {
-          if (size_x == 1 && size_y == 1)
-            writePixel(x + i, y + j, bg);
-          else
-            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
-        }
+/**************************************************************************/
+/*!
+   @brief   Draw a single character, as the generic drawChar() does but
+            without a write transaction of its own, so several characters
+            (or other shapes) can share one. Not self-contained; should
+            follow startWrite().
+    @param    x   Bottom left corner x coordinate
+    @param    y   Bottom left corner y coordinate
+    @param    c   The 8-bit font-indexed character (likely ascii)
+    @param    color 16-bit 5-6-5 Color to draw chraracter with
+    @param    bg 16-bit 5-6-5 Color to fill background with (if same as color,
+   no background)
+    @param    size_x  Font magnification level in X-axis, 1 is 'original' size
+    @param    size_y  Font magnification level in Y-axis, 1 is 'original' size
+*/
+/**************************************************************************/
+void Adafruit_GFX::writeChar(int16_t x, int16_t y, unsigned char c,
+                             uint16_t color, uint16_t bg, uint8_t size_x,
+                             uint8_t size_y) {
+
+  if (!gfxFont) { // 'Classic' built-in font
+
+    int16_t cx = 0, cy = 0, cw = 6 * size_x, ch = 8 * size_y;
+    turnTextRect(x, y, &cx, &cy, &cw, &ch);
+    if (!clipOverlaps(cx, cy, cx + cw - 1, cy + ch - 1))
+      return; // Character cell is entirely clipped
+
+    // Char bitmap = 5 columns, plus a blank 6th if opaque. Each column
+    // is drawn as vertical runs of one color, identical neighboring
+    // columns together, so magnified text takes a few rects rather than
+    // one per font pixel.
+    uint8_t cols[6], n = (bg != color) ? 6 : 5;
+    getClassicGlyph(c, cols);
+    cols[5] = 0;
+    for (int8_t i = 0, w; i < n; i += w) {
+      uint8_t line = cols[i];
+      for (w = 1; (i + w < n) && (cols[i + w] == line); w++)
+        ;
+      for (int8_t j = 0, run; j < 8; j += run) {
+        bool set = (line >> j) & 1;
+        for (run = 1; (j + run < 8) && (((line >> (j + run)) & 1) == set);
+             run++)
+          ;
+        if (set || (bg != color))
+          writeGlyphRun(x, y, i, j, w, run, set ? color : bg, size_x,
+                        size_y);
       }
     }
-    if (bg != color) { // If opaque, draw vertical line for last column
-      if (size_x == 1 && size_y == 1)
-        writeFastVLine(x + 5, y, 8, bg);
-      else
-        writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
-    }
-    endWrite();
 
   } else { // Custom font
+    writeGlyph(x, y, c, color, bg, size_x, size_y);
+  } // End classic vs custom font
+}
 
-    // Character is assumed previously filtered by write() to eliminate
-    // newlines, returns, non-printable characters, etc.  Calling
-    // drawChar() directly with 'bad' characters of font may cause mayhem!
-
-    c -= (uint8_t)pgm_read_byte(&gfxFont->first);
-    GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c);
-    uint8_t *bitmap = pgm_read_bitmap_ptr(gfxFont);
-
-    uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
-    uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
-    int8_t xo = pgm_read_byte(&glyph->xOffset),
-           yo = pgm_read_byte(&glyph->yOffset);
-    uint8_t xx, yy, bits = 0, bit = 0;
-    int16_t xo16 = 0, yo16 = 0;
-
-    if (size_x > 1 || size_y > 1) {
-      xo16 = xo;
-      yo16 = yo;
-    }
-
-    // Todo: Add character clipping here
-
-    // NOTE: THERE IS NO 'BACKGROUND' COLOR OPTION ON CUSTOM FONTS.
-    // THIS IS ON PURPOSE AND BY DESIGN.  The background color feature
-    // has typically been used with the 'classic' font to overwrite old
-    // screen contents with new data.  This ONLY works because the
-    // characters are a uniform size; it's not a sensible thing to do with
-    // proportionally-spaced fonts with glyphs of varying sizes (and that
-    // may overlap).  To replace previously-drawn text when using a custom
-    // font, use the getTextBounds() function to determine the smallest
-    // rectangle encompassing a string, erase the area with fillRect(),
-    // then draw new text.  This WILL infortunately 'blink' the text, but
-    // is unavoidable.  Drawing 'background' pixels will NOT fix this,
-    // only creates a new set of problems.  Have an idea to work around
-    // this (a canvas object type for MCUs that can afford the RAM and
-    // displays supporting setAddrWindow() and pushColors()), but haven't
-    // implemented this yet.
-
+/**************************************************************************/
+/*!
+   @brief   Draw a single character of any font, including those above 0xFF
+            in an extended (Unicode) font. Characters up to 0xFF go to
+            drawChar(), so a subclass's version of that is used for them.
+    @param    x   Bottom left corner x coordinate
+    @param    y   Bottom left corner y coordinate
+    @param    c   The character, a Unicode codepoint for extended fonts
+    @param    color 16-bit 5-6-5 Color to draw chraracter with
+    @param    bg 16-bit 5-6-5 Color to fill background with (if same as color,
+   no background)
+    @param    size_x  Font magnification level in X-axis, 1 is 'original' size
+    @param    size_y  Font magnification level in Y-axis, 1 is 'original' size
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawGlyph(int16_t x, int16_t y, uint32_t c, uint16_t color,
+                             uint16_t bg, uint8_t size_x, uint8_t size_y) {
+  if (c <= 0xFF) {
+    drawChar(x, y, c, color, bg, size_x, size_y);
+  } else {
     startWrite();
-    for (yy = 0; yy < h; yy++) {
-      for (xx = 0; xx < w; xx++) {
-        if (!(bit++ & 7)) {
-          bits = pgm_read_byte(&bitmap[bo++]);
+    writeGlyph(x, y, c, color, bg, size_x, size_y);
+    endWrite();
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a single character of any font, as drawGlyph() does but
+            without a write transaction of its own. Not self-contained;
+            should follow startWrite(). Characters the font lacks are
+            skipped.
+    @param    x   Bottom left corner x coordinate
+    @param    y   Bottom left corner y coordinate
+    @param    c   The character, a Unicode codepoint for extended fonts
+    @param    color 16-bit 5-6-5 Color to draw chraracter with
+    @param    bg 16-bit 5-6-5 Color to fill background with (if same as color,
+   no background)
+    @param    size_x  Font magnification level in X-axis, 1 is 'original' size
+    @param    size_y  Font magnification level in Y-axis, 1 is 'original' size
+*/
+/**************************************************************************/
+void Adafruit_GFX::writeGlyph(int16_t x, int16_t y, uint32_t c,
+                              uint16_t color, uint16_t bg, uint8_t size_x,
+                              uint8_t size_y) {
+  if (!gfxFont) {
+    if (c <= 0xFF)
+      writeChar(x, y, c, color, bg, size_x, size_y);
+    return;
+  }
+
+  int32_t index = gfxGlyphIndex(gfxFont, c);
+  if (index < 0)
+    return; // Not in this font
+  GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, index);
+  uint8_t *bitmap;
+  uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
+  int8_t xo = pgm_read_byte(&glyph->xOffset),
+         yo = pgm_read_byte(&glyph->yOffset);
+  uint8_t format = pgm_read_byte(&gfxFont->format);
+  int16_t xx = xo * size_x, yy = yo * size_y, run = w * size_x,
+          rows = h * size_y; // Glyph's screen rect, for now
+
+  turnTextRect(x, y, &xx, &yy, &run, &rows);
+  if (!w || !h || !clipOverlaps(xx, yy, xx + run - 1, yy + rows - 1) ||
+      !(bitmap = glyphBitmap(index)))
+    return; // Nothing to draw, glyph is entirely clipped, or read failed
+
+  // NOTE: THERE IS NO 'BACKGROUND' COLOR OPTION ON CUSTOM FONTS.
+  // THIS IS ON PURPOSE AND BY DESIGN.  The background color feature
+  // has typically been used with the 'classic' font to overwrite old
+  // screen contents with new data.  This ONLY works because the
+  // characters are a uniform size; it's not a sensible thing to do with
+  // proportionally-spaced fonts with glyphs of varying sizes (and that
+  // may overlap).  To replace previously-drawn text when using a custom
+  // font, use the getTextBounds() function to determine the smallest
+  // rectangle encompassing a string, erase the area with fillRect(),
+  // then draw new text.  This WILL infortunately 'blink' the text, but
+  // is unavoidable.  Drawing 'background' pixels will NOT fix this,
+  // only creates a new set of problems.  Have an idea to work around
+  // this (a canvas object type for MCUs that can afford the RAM and
+  // displays supporting setAddrWindow() and pushColors()); see
+  // Adafruit_SPITFT::setFontOpaque() for the latter.
+
+  // Glyphs are drawn as horizontal runs of one color, each issued as a
+  // single line or rect rather than one call per pixel.
+  uint8_t bpp = (format == GFXFONT_AA2)   ? 2
+                : (format == GFXFONT_AA4) ? 4
+                                          : 1;
+  uint8_t maxv = (1 << bpp) - 1, v, runv = 0, bits = 0;
+  uint32_t bit = 0; // Bit index into bitmap
+  if ((bpp == 1) || (bg == color)) {
+    // One color: each row is decoded to 1 bit per pixel (anti-aliased
+    // coverage thresholded at half, what's behind the text being
+    // unknown), and runs of identical rows (stems, bars) are drawn as
+    // one rect per set run rather than one per row, which at large sizes
+    // saves many rects.
+    uint8_t minv = (maxv + 1) / 2;
+    GFXrleReader rle(bitmap);
+    uint8_t rowBits[2][32], bytes = (w + 7) / 8, cur = 0;
+    rows = 0;
+    for (yy = 0; yy <= h; yy++) {
+      uint8_t *row = rowBits[cur], *prev = rowBits[!cur];
+      if (yy < h) {
+        if (format == GFXFONT_RLE) {
+          rle.readRow(row, w);
+        } else {
+          memset(row, 0, bytes);
+          for (xx = 0; xx < w; xx++, bit += bpp) {
+            if (!(bit & 7))
+              bits = pgm_read_byte(&bitmap[bit >> 3]);
+            if (((bits >> (8 - bpp - (bit & 7))) & maxv) >= minv)
+              row[xx >> 3] |= 0x80 >> (xx & 7);
+          }
+        }
+        if (rows && !memcmp(row, prev, bytes)) {
+          rows++; // Same as the row(s) pending, draw them together later
+          continue;
         }
-        if (bits & 0x80) {
-          if (size_x == 1 && size_y == 1) {
-            writePixel(x + xo + xx, y + yo + yy, color);
-          } else {
-            writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y,
-                          size_x, size_y, color);
+      }
+      for (xx = 0; rows && (xx < w); xx += run) { // Flush pending rows
+        for (run = 0; (xx + run < w) &&
+                      (prev[(xx + run) >> 3] & (0x80 >> ((xx + run) & 7)));
+             run++)
+          ;
+        if (run)
+          writeGlyphRun(x, y, xo + xx, yo + yy - rows, run, rows, color,
+                        size_x, size_y);
+        else
+          run = 1;
+      }
+      cur = !cur;
+      rows = 1;
+    }
+  } else {
+    // 2 or 4 bits of coverage per pixel, blended toward bg. Column w is
+    // a sentinel (always 0) so a run reaching the right edge gets
+    // flushed.
+    uint16_t pal[16];
+    for (v = 1; v <= maxv; v++)
+      pal[v] = blend565(color, bg, v * 255 / maxv);
+    for (yy = 0; yy < h; yy++) {
+      for (xx = run = 0; xx <= w; xx++) {
+        v = 0;
+        if (xx < w) {
+          if (!(bit & 7)) {
+            bits = pgm_read_byte(&bitmap[bit >> 3]);
           }
+          v = (bits >> (8 - bpp - (bit & 7))) & maxv;
+          bit += bpp;
+        }
+        if (v != runv) {
+          if (runv)
+            writeGlyphRun(x, y, xo + xx - run, yo + yy, run, 1, pal[runv],
+                          size_x, size_y);
+          runv = v;
+          run = 0;
         }
-        bits <<= 1;
+        run++;
       }
     }
-    endWrite();
+  }
+}
 
-  } // End classic vs custom font
+/**************************************************************************/
+/*!
+    @brief  Draw one horizontal run of a glyph's pixels, repeated over
+            one or more rows, as a pixel, line or rect (magnified, and
+            turned by the text orientation, as needed). Used by
+            drawChar().
+    @param  x       Text cursor X
+    @param  y       Text cursor Y (baseline, or top for the classic font)
+    @param  gx      Run start, X offset in font pixels from cursor
+    @param  gy      Run's first row, Y offset in font pixels from cursor
+    @param  len     Run length in font pixels
+    @param  rows    Number of rows, in font pixels
+    @param  color   16-bit 5-6-5 Color to draw with
+    @param  size_x  Font magnification level in X-axis, 1 is 'original' size
+    @param  size_y  Font magnification level in Y-axis, 1 is 'original' size
+*/
+/**************************************************************************/
+void Adafruit_GFX::writeGlyphRun(int16_t x, int16_t y, int16_t gx, int16_t gy,
+                                 int16_t len, int16_t rows, uint16_t color,
+                                 uint8_t size_x, uint8_t size_y) {
+  len *= size_x;
+  rows *= size_y;
+  gx *= size_x;
+  gy *= size_y;
+  turnTextRect(x, y, &gx, &gy, &len, &rows);
+  x = gx;
+  y = gy;
+  if (rows == 1) {
+    if (len == 1)
+      writePixel(x, y, color);
+    else
+      writeFastHLine(x, y, len, color);
+  } else if (len == 1) {
+    writeFastVLine(x, y, rows, color);
+  } else {
+    writeFillRect(x, y, len, rows, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Place part of a character on screen by the text orientation,
+            turning it about its cursor (the cursor's own pixel stays
+            put). Every text primitive goes through this, so rotated text
+            is drawn as directly as unrotated text, in runs and rects.
+    @param  x   Text cursor X
+    @param  y   Text cursor Y
+    @param  rx  Pointer to rect's X offset from cursor, as unrotated
+                text; screen X of the turned rect's left column on return
+    @param  ry  Pointer to rect's Y offset from cursor; screen Y of the
+                turned rect's top row on return
+    @param  rw  Pointer to rect's width; turned width on return
+    @param  rh  Pointer to rect's height; turned height on return
+*/
+/**************************************************************************/
+void Adafruit_GFX::turnTextRect(int16_t x, int16_t y, int16_t *rx,
+                                int16_t *ry, int16_t *rw, int16_t *rh) const {
+  int16_t w = *rw, h = *rh;
+  switch (textOrientation) {
+  case 0:
+    *rx += x;
+    *ry += y;
+    return;
+  case 1: // Down the screen, tops of characters to the right
+    x -= *ry + h - 1;
+    y += *rx;
+    break;
+  case 2: // Upside down
+    x -= *rx + w - 1;
+    y -= *ry + h - 1;
+    w = h = 0; // Not swapped
+    break;
+  default: // Up the screen, tops of characters to the left
+    x += *ry;
+    y -= *rx + w - 1;
+    break;
+  }
+  *rx = x;
+  *ry = y;
+  if (w) { // Quarter turn, width and height swap
+    *rw = h;
+    *rh = w;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Convert a text cursor position between the screen and the
+            text's own frame, the screen as if turned so that the text
+            runs left to right across it. Within that frame write()
+            wraps and starts new lines as it does for unrotated text.
+    @param  x         Pointer to X coordinate, converted in place
+    @param  y         Pointer to Y coordinate, converted in place
+    @param  toScreen  true to convert from the text's frame to the
+                      screen, false for the reverse
+*/
+/**************************************************************************/
+void Adafruit_GFX::textFrame(int16_t *x, int16_t *y, bool toScreen) const {
+  int16_t t = *x;
+  switch (textOrientation) {
+  case 1:
+    if (toScreen) {
+      *x = _width - 1 - *y;
+      *y = t;
+    } else {
+      *x = *y;
+      *y = _width - 1 - t;
+    }
+    break;
+  case 2:
+    *x = _width - 1 - *x;
+    *y = _height - 1 - *y;
+    break;
+  case 3:
+    if (toScreen) {
+      *x = *y;
+      *y = _height - 1 - t;
+    } else {
+      *x = _height - 1 - *y;
+      *y = t;
+    }
+    break;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Write a partially covered pixel, used by the anti-aliased
+            primitives. Not self-contained; should follow startWrite().
+            Blends toward bg here; devices that can read their pixels
+            back may override this to blend with those instead.
+    @param  x      x coordinate
+    @param  y      y coordinate
+    @param  color  16-bit 5-6-5 color at full coverage
+    @param  bg     16-bit 5-6-5 color at zero coverage
+    @param  alpha  Coverage, 0 (nothing drawn) to 255 (color)
+*/
+/**************************************************************************/
+void Adafruit_GFX::blendPixel(int16_t x, int16_t y, uint16_t color,
+                              uint16_t bg, uint8_t alpha) {
+  if (alpha == 255)
+    writePixel(x, y, color);
+  else if (alpha)
+    writePixel(x, y, blend565(color, bg, alpha));
+}
+
+/**************************************************************************/
+/*!
+    @brief   Blend two 16-bit 5-6-5 colors
+    @param   fg     Foreground color
+    @param   bg     Background color
+    @param   alpha  Foreground weight, 0 (all bg) to 255 (all fg)
+    @returns Blended color
+*/
+/**************************************************************************/
+uint16_t Adafruit_GFX::blend565(uint16_t fg, uint16_t bg, uint8_t alpha) {
+  // Spread R, G, B into separate bit fields of a 32-bit word so all three
+  // are scaled in one multiply. 5-bit alpha leaves headroom for that.
+  uint32_t a = (alpha + 4) >> 3, f = (fg | ((uint32_t)fg << 16)) & 0x07E0F81F,
+           b = (bg | ((uint32_t)bg << 16)) & 0x07E0F81F,
+           r = ((f * a + b * (32 - a)) >> 5) & 0x07E0F81F;
+  return r | (r >> 16);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fetch the column bitmaps of one 'classic' built-in font
+            character, for subclasses that render it in their own way.
+            Applies the same cp437() adjustment as drawChar().
+    @param  c     The character as passed to drawChar()
+    @param  cols  Array to receive 5 column bytes, LSB is the top row
+*/
+/**************************************************************************/
+void Adafruit_GFX::getClassicGlyph(unsigned char c, uint8_t *cols) {
+#if defined(GFX_NO_CLASSIC_FONT)
+  (void)c;
+  memset(cols, 0, 5); // No font, all blank
+#else
+  if (!_cp437 && (c >= 176))
+    c++; // Handle 'classic' charset behavior
+  for (uint8_t i = 0; i < 5; i++)
+    cols[i] = pgm_read_byte(&font[c * 5 + i]);
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief   Get a custom-font glyph's bitmap, from the font or, for one
+             loaded by Adafruit_FontFile from a stream, its glyph cache.
+    @param   glyph  Index of the glyph in gfxFont
+    @return  Pointer to the bitmap (in PROGMEM for a built-in font), valid
+             until the next call, or NULL if it couldn't be read
+*/
+/**************************************************************************/
+uint8_t *Adafruit_GFX::glyphBitmap(uint16_t glyph) {
+#if !defined(__AVR__)
+  if (fontFile)
+    return (uint8_t *)fontFile->getGlyphBitmap(glyph);
+#endif
+  uint8_t *bitmap = pgm_read_bitmap_ptr(gfxFont);
+  if (!bitmap)
+    return NULL; // Font file since unloaded
+  return bitmap +
+         pgm_read_word(&pgm_read_glyph_ptr(gfxFont, glyph)->bitmapOffset);
 }
+
 /**************************************************************************/
 /*!
     @brief  Print one byte/character of data, used to support print()
@@ -1240,48 +2473,78 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
 */
 /**************************************************************************/
 size_t Adafruit_GFX::write(uint8_t c) {
+  GFX_PROFILE_SCOPE(GFX_PROF_WRITE,
+                    gfxFont ? 0 : 48 * textsize_x * textsize_y);
+  // Cursor in the text's own frame, where it runs left to right across a
+  // line tw long whatever the text orientation
+  int16_t tx = cursor_x, ty = cursor_y, x, y,
+          tw = (textOrientation & 1) ? _height : _width;
+  textFrame(&tx, &ty, false);
+
   if (!gfxFont) { // 'Classic' built-in font
 
-    if (c == '\n') {              // Newline?
-      cursor_x = 0;               // Reset x to zero,
-      cursor_y += textsize_y * 8; // advance y one line
-    } else if (c != '\r') {       // Ignore carriage returns
-      if (wrap && ((cursor_x + textsize_x * 6) > _width)) { // Off right?
-        cursor_x = 0;                                       // Reset x to zero,
-        cursor_y += textsize_y * 8; // advance y one line
+    if (c == '\n') {        // Newline?
+      tx = 0;               // Reset x to zero,
+      ty += textsize_y * 8; // advance y one line
+    } else if (c != '\r') { // Ignore carriage returns
+      if (wrap && ((tx + textsize_x * 6) > tw)) { // Off right?
+        tx = 0;                                   // Reset x to zero,
+        ty += textsize_y * 8;                     // advance y one line
       }
-      drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
-               textsize_y);
-      cursor_x += textsize_x * 6; // Advance x one char
+      x = tx;
+      y = ty;
+      textFrame(&x, &y, true);
+      drawChar(x, y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+      tx += textsize_x * 6; // Advance x one char
     }
 
   } else { // Custom font
 
-    if (c == '\n') {
-      cursor_x = 0;
-      cursor_y +=
-          (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
-    } else if (c != '\r') {
-      uint8_t first = pgm_read_byte(&gfxFont->first);
-      if ((c >= first) && (c <= (uint8_t)pgm_read_byte(&gfxFont->last))) {
-        GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
+    uint32_t code; // Character, once any UTF-8 sequence is complete
+    if (!textDecoder.decode(c, &code)) {
+      // Partway into a UTF-8 sequence
+    } else if (code == '\n') {
+      tx = 0;
+      ty += (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+      kernPrev = -1;
+    } else if (code != '\r') {
+      int32_t i = gfxGlyphIndex(gfxFont, code);
+      if (i >= 0) {
+        GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, i);
+        uint8_t xa = pgm_read_byte(&glyph->xAdvance);
+        // Tabular digits are centered in equal cells, with no kerning
+        bool tab = tabularDigit(code);
+        int16_t pad = tab ? (digitAdvance - xa) / 2 * (int16_t)textsize_x : 0;
+        if (tab)
+          kernPrev = -1;
+        // Kerning with the previous character, before any wrap
+        tx += gfxKernAdjust(gfxFont, kernPrev, i) * (int16_t)textsize_x;
+        kernPrev = tab ? -1 : i;
         uint8_t w = pgm_read_byte(&glyph->width),
                 h = pgm_read_byte(&glyph->height);
         if ((w > 0) && (h > 0)) { // Is there an associated bitmap?
           int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset); // sic
-          if (wrap && ((cursor_x + textsize_x * (xo + w)) > _width)) {
-            cursor_x = 0;
-            cursor_y += (int16_t)textsize_y *
-                        (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+          if (wrap && ((tx + pad + textsize_x * (xo + w)) > tw)) {
+            tx = 0;
+            ty += (int16_t)textsize_y *
+                  (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
           }
-          drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
-                   textsize_y);
         }
-        cursor_x +=
-            (uint8_t)pgm_read_byte(&glyph->xAdvance) * (int16_t)textsize_x;
+        // Blank glyphs (e.g. space) are still passed on when opaque
+        if (((w > 0) && (h > 0)) || (textbgcolor != textcolor)) {
+          x = tx + pad;
+          y = ty;
+          textFrame(&x, &y, true);
+          drawGlyph(x, y, code, textcolor, textbgcolor, textsize_x,
+                    textsize_y);
+        }
+        tx += (tab ? digitAdvance : xa) * (int16_t)textsize_x;
       }
     }
   }
+  textFrame(&tx, &ty, true);
+  cursor_x = tx;
+  cursor_y = ty;
   return 1;
 }
 
@@ -1329,6 +2592,334 @@ void Adafruit_GFX::setRotation(uint8_t x) {
   }
 }
 
+/**************************************************************************/
+/*!
+    @brief  Limit all drawing to a rectangle of the display. Primitives
+            test their bounds against it once and skip (or trim) whatever
+            lies outside, so redrawing a small area of a complex scene
+            costs little more than the area itself. The rect is in display
+            coordinates at the current rotation, unaffected by
+            setOrigin(). Drivers must test pixels and spans with
+            clipPixel() / clipRect() for the clip and origin to take
+            effect; the canvases and Adafruit_SPITFT do.
+    @param  x  Left column of clip rect
+    @param  y  Top row of clip rect
+    @param  w  Width in pixels
+    @param  h  Height in pixels
+*/
+/**************************************************************************/
+void Adafruit_GFX::setClipRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+  int32_t x2 = (int32_t)x + w - 1, y2 = (int32_t)y + h - 1;
+  _clipX1 = (x < 0) ? 0 : x;
+  _clipY1 = (y < 0) ? 0 : y;
+  // An empty rect leaves X2 left of X1, which nothing can pass
+  _clipX2 = (x2 < 0) ? -1 : (x2 > 0x7FFF) ? 0x7FFF : x2;
+  _clipY2 = (y2 < 0) ? -1 : (y2 > 0x7FFF) ? 0x7FFF : y2;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the area drawing is currently limited to: the clip rect
+            intersected with the display, in display coordinates.
+    @param  x  Pointer to left column
+    @param  y  Pointer to top row
+    @param  w  Pointer to width, 0 if nothing can be drawn
+    @param  h  Pointer to height, 0 if nothing can be drawn
+*/
+/**************************************************************************/
+void Adafruit_GFX::getClipRect(int16_t *x, int16_t *y, int16_t *w,
+                               int16_t *h) const {
+  int16_t x2 = (_clipX2 < _width) ? _clipX2 : _width - 1,
+          y2 = (_clipY2 < _height) ? _clipY2 : _height - 1;
+  *x = _clipX1;
+  *y = _clipY1;
+  *w = (x2 >= _clipX1) ? x2 - _clipX1 + 1 : 0;
+  *h = (y2 >= _clipY1) ? y2 - _clipY1 + 1 : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Translate a rectangle by the drawing origin and trim it to
+              the clip rect and display edges
+    @param    x  Pointer to left edge, display column on return
+    @param    y  Pointer to top edge, display row on return
+    @param    w  Pointer to width (negative extends left), positive on
+                 return
+    @param    h  Pointer to height (negative extends up), positive on
+                 return
+    @returns  true if any of the rectangle is visible
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipRect(int16_t *x, int16_t *y, int16_t *w,
+                           int16_t *h) const {
+  if (*w < 0) {
+    *x += *w + 1;
+    *w = -*w;
+  }
+  if (*h < 0) {
+    *y += *h + 1;
+    *h = -*h;
+  }
+  if (!*w || !*h)
+    return false;
+  *x += _originX;
+  *y += _originY;
+  int16_t x2 = *x + *w - 1, y2 = *y + *h - 1,
+          cx2 = (_clipX2 < _width) ? _clipX2 : _width - 1,
+          cy2 = (_clipY2 < _height) ? _clipY2 : _height - 1;
+  if ((cx2 < _clipX1) || (cy2 < _clipY1))
+    return false; // Clip rect is off the display (e.g. since setRotation())
+  if ((*x > cx2) || (*y > cy2) || (x2 < _clipX1) || (y2 < _clipY1))
+    return false;
+  if (*x < _clipX1)
+    *x = _clipX1;
+  if (*y < _clipY1)
+    *y = _clipY1;
+  if (x2 > cx2)
+    x2 = cx2;
+  if (y2 > cy2)
+    y2 = cy2;
+  *w = x2 - *x + 1;
+  *h = y2 - *y + 1;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Find which rows of an image drawn at (x,y) are visible, so
+              bitmap functions can skip the rest without testing each
+              pixel. Columns are still clipped per pixel.
+    @param    x   Left edge of image
+    @param    y   Top edge of image
+    @param    w   Image width in pixels
+    @param    h   Image height in pixels
+    @param    j0  Pointer to first visible row, 0 = top row of image
+    @param    j1  Pointer to row after last visible row
+    @returns  false if none of the image is visible
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipRows(int16_t x, int16_t y, int16_t w, int16_t h,
+                            int16_t *j0, int16_t *j1) const {
+  if ((w <= 0) || (h <= 0))
+    return false;
+  int16_t cy = y;
+  if (!clipRect(&x, &cy, &w, &h))
+    return false;
+  *j0 = cy - (y + _originY);
+  *j1 = *j0 + h;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the visible area in origin-relative coordinates, for
+            primitives to reject or trim themselves against
+    @param  x1  Pointer to left column
+    @param  y1  Pointer to top row
+    @param  x2  Pointer to right column (inclusive, less than x1 if
+                nothing is visible)
+    @param  y2  Pointer to bottom row (inclusive)
+*/
+/**************************************************************************/
+void Adafruit_GFX::clipBounds(int16_t *x1, int16_t *y1, int16_t *x2,
+                              int16_t *y2) const {
+  *x1 = _clipX1 - _originX;
+  *y1 = _clipY1 - _originY;
+  *x2 = ((_clipX2 < _width) ? _clipX2 : _width - 1) - _originX;
+  *y2 = ((_clipY2 < _height) ? _clipY2 : _height - 1) - _originY;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Clip a bitmap for copying straight into a canvas buffer, and
+              work out where its visible pixels land at the current rotation
+    @param    x       Bitmap's left column, origin-relative
+    @param    y       Bitmap's top row
+    @param    w       Bitmap width in pixels
+    @param    h       Bitmap height in pixels
+    @param    stride  Buffer index change per unrotated buffer row (bits for
+                      a packed 1-bit buffer)
+    @param    b       Receives the visible part and its buffer walk
+    @returns  true if any of the bitmap is visible
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipBlit(int16_t x, int16_t y, int16_t w, int16_t h,
+                            int32_t stride, GFXblit *b) const {
+  if ((w <= 0) || (h <= 0))
+    return false;
+  int16_t cx = x, cy = y, cw = w, ch = h;
+  if (!clipRect(&cx, &cy, &cw, &ch))
+    return false;
+  b->i0 = cx - (x + _originX);
+  b->j0 = cy - (y + _originY);
+  b->i1 = b->i0 + cw;
+  b->j1 = b->j0 + ch;
+
+  // Buffer index of display pixel (0,0), and its steps along x and y
+  int32_t org;
+  switch (rotation) {
+  case 0:
+    org = 0;
+    b->stepX = 1;
+    b->stepY = stride;
+    break;
+  case 1:
+    org = WIDTH - 1;
+    b->stepX = stride;
+    b->stepY = -1;
+    break;
+  case 2:
+    org = WIDTH - 1 + (int32_t)(HEIGHT - 1) * stride;
+    b->stepX = -1;
+    b->stepY = -stride;
+    break;
+  default:
+    org = (int32_t)(HEIGHT - 1) * stride;
+    b->stepX = -stride;
+    b->stepY = 1;
+    break;
+  }
+  b->base = org + cx * b->stepX + cy * b->stepY;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Find the index of a character's glyph in a custom font. For an
+              extended font the range table is binary searched, so lookup
+              cost grows only with the log of the number of runs.
+    @param    font  The font
+    @param    c     Character code, a Unicode codepoint for extended fonts
+    @returns  Index into the font's glyph array, or -1 if the font lacks the
+              character
+*/
+/**************************************************************************/
+int32_t gfxGlyphIndex(const GFXfont *font, uint32_t c) {
+  uint16_t n = pgm_read_word(&font->ranges);
+  if (!n) { // first to last
+    uint8_t first = pgm_read_byte(&font->first);
+    return ((c >= first) && (c <= (uint8_t)pgm_read_byte(&font->last)))
+               ? (int32_t)(c - first)
+               : -1;
+  }
+  GFXrange *range = pgm_read_range_ptr(font);
+  uint16_t lo = 0, hi = n; // Find last run starting at or before c
+  while (hi - lo > 1) {
+    uint16_t mid = (lo + hi) / 2;
+    if ((uint32_t)pgm_read_dword(&range[mid].first) <= c)
+      lo = mid;
+    else
+      hi = mid;
+  }
+  uint32_t start = pgm_read_dword(&range[lo].first);
+  if ((c < start) || (c - start >= pgm_read_word(&range[lo].count)))
+    return -1;
+  return pgm_read_word(&range[lo].glyph) + (c - start);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Get the number of glyphs in a custom font
+    @param    font  The font
+    @returns  Length of the font's glyph array
+*/
+/**************************************************************************/
+uint16_t gfxGlyphCount(const GFXfont *font) {
+  uint16_t n = pgm_read_word(&font->ranges);
+  if (!n) {
+    uint8_t first = pgm_read_byte(&font->first),
+            last = pgm_read_byte(&font->last);
+    return (last >= first) ? last - first + 1 : 0;
+  }
+  GFXrange *range = pgm_read_range_ptr(font) + n - 1;
+  return pgm_read_word(&range->glyph) + pgm_read_word(&range->count);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Get the width of tabular digit cells in a custom font: the
+              advance of its widest digit
+    @param    font  The font
+    @returns  Advance in font pixels, 0 if the font has no digits
+*/
+/**************************************************************************/
+uint8_t gfxDigitAdvance(const GFXfont *font) {
+  uint8_t widest = 0;
+  for (uint8_t c = '0'; c <= '9'; c++) {
+    GFXglyph *glyph = gfxGetGlyph(font, c);
+    uint8_t xa = glyph ? pgm_read_byte(&glyph->xAdvance) : 0;
+    if (xa > widest)
+      widest = xa;
+  }
+  return widest;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Get the kerning between two glyphs of a custom font. Only the
+              pairs of the left glyph, typically a handful, are looked at.
+    @param    font   The font
+    @param    left   Glyph index (see gfxGlyphIndex()) of the first
+                     character, or -1 if none
+    @param    right  Glyph index of the character following it
+    @returns  Pixels to add to the left glyph's xAdvance, 0 if the font
+              has no kerning or none for this pair
+*/
+/**************************************************************************/
+int8_t gfxKernAdjust(const GFXfont *font, int32_t left, int32_t right) {
+#ifdef __AVR__
+  uint16_t *index = (uint16_t *)pgm_read_pointer(&font->kernIndex);
+  GFXkernPair *kern = (GFXkernPair *)pgm_read_pointer(&font->kern);
+#else
+  uint16_t *index = font->kernIndex;
+  GFXkernPair *kern = font->kern;
+#endif
+  if (!index || (left < 0) || (right < 0))
+    return 0;
+  for (uint16_t p = pgm_read_word(&index[left]),
+                end = pgm_read_word(&index[left + 1]);
+       p < end; p++) { // Sorted by right glyph
+    uint16_t r = pgm_read_word(&kern[p].right);
+    if (r >= right)
+      return (r == right) ? (int8_t)pgm_read_byte(&kern[p].adjust) : 0;
+  }
+  return 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Take the next byte of text
+    @param    b     The byte
+    @param    code  Set to the character when one is complete
+    @returns  true if a character is complete (and code set), false while
+              partway into a UTF-8 sequence or after a malformed byte
+*/
+/**************************************************************************/
+bool GFXtextDecoder::decode(uint8_t b, uint32_t *code) {
+  // One-byte character, cutting short any unfinished sequence
+  if (!_utf8 || (b < 0x80)) {
+    _need = 0;
+    *code = b;
+    return true;
+  }
+  if (b < 0xC0) { // Continuation byte
+    if (!_need)
+      return false; // Stray, dropped
+    _code = (_code << 6) | (b & 0x3F);
+    if (--_need)
+      return false;
+    *code = _code;
+    return true;
+  }
+  if (b >= 0xF8) { // Not valid in UTF-8
+    _need = 0;
+    return false;
+  }
+  _need = (b >= 0xF0) ? 3 : (b >= 0xE0) ? 2 : 1; // Lead byte
+  _code = b & (0x3F >> _need);
+  return false;
+}
+
 /**************************************************************************/
 /*!
     @brief Set the font to display when print()ing, either custom or default
@@ -1348,6 +2939,53 @@ void Adafruit_GFX::setFont(const GFXfont *f) {
     cursor_y -= 6;
   }
   gfxFont = (GFXfont *)f;
+  textDecoder.setFont(f);
+  kernPrev = -1;
+  digitAdvance = (tabularDigits && f) ? gfxDigitAdvance(f) : 0;
+#if !defined(__AVR__)
+  // A font without bitmaps is streamed from a file by whatever loaded it
+  fontFile =
+      (f && !pgm_read_bitmap_ptr(f)) ? Adafruit_FontFile::find(f) : NULL;
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief    Set digits of custom fonts in tabular (equal width) cells,
+              so numbers line up in columns and a readout doesn't shift as
+              its digits change. Each digit is centered in a cell as wide
+              as the font's widest digit and isn't kerned; other
+              characters are unchanged. Applies to print(), getTextBounds()
+              and opaque cells; the classic font's digits are always
+              equal width. GFXfontMetrics::getTextWidth() still measures
+              digits at their own widths.
+    @param    tabular  true for tabular digits, false (the default) for
+                       the font's own widths
+*/
+/**************************************************************************/
+void Adafruit_GFX::setTabularDigits(bool tabular) {
+  tabularDigits = tabular;
+  digitAdvance = (tabular && gfxFont) ? gfxDigitAdvance(gfxFont) : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Set which way text runs, turning each character as it's
+              drawn rather than drawing it upright and rotating the
+              pixels after, so e.g. a graph's vertical axis label takes
+              no more time than a horizontal one. This is on top of, and
+              separate from, setRotation(): the screen keeps its
+              orientation for everything else. drawChar(), print() and
+              getTextBounds() follow it; the cursor (setCursor()) is the
+              point characters turn about, and print() wraps and starts
+              new lines as if the screen were turned with the text.
+    @param    orientation  Quarter turns clockwise: 0 (the default) for
+                           normal text, 1 reads top to bottom, 2 upside
+                           down, 3 bottom to top
+*/
+/**************************************************************************/
+void Adafruit_GFX::setTextOrientation(uint8_t orientation) {
+  textOrientation = orientation & 3;
 }
 
 /**************************************************************************/
@@ -1355,40 +2993,69 @@ void Adafruit_GFX::setFont(const GFXfont *f) {
     @brief    Helper to determine size of a character with current font/size.
        Broke this out as it's used by both the PROGMEM- and RAM-resident
    getTextBounds() functions.
-    @param    c     The ascii character in question
+    @param    c     The character in question, a Unicode codepoint for
+                    extended fonts
     @param    x     Pointer to x location of character
     @param    y     Pointer to y location of character
     @param    minx  Minimum clipping value for X
     @param    miny  Minimum clipping value for Y
     @param    maxx  Maximum clipping value for X
     @param    maxy  Maximum clipping value for Y
+    @param    prev  Glyph index of previous character (for kerning), -1
+                    for none; updated
 */
 /**************************************************************************/
-void Adafruit_GFX::charBounds(char c, int16_t *x, int16_t *y, int16_t *minx,
-                              int16_t *miny, int16_t *maxx, int16_t *maxy) {
+void Adafruit_GFX::charBounds(uint32_t c, int16_t *x, int16_t *y,
+                              int16_t *minx, int16_t *miny, int16_t *maxx,
+                              int16_t *maxy, int32_t *prev) {
+  int16_t tw = (textOrientation & 1) ? _height : _width; // Line length
 
   if (gfxFont) {
 
     if (c == '\n') { // Newline?
       *x = 0;        // Reset x to zero, advance y by one line
       *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+      *prev = -1;
     } else if (c != '\r') { // Not a carriage return; is normal char
-      uint8_t first = pgm_read_byte(&gfxFont->first),
-              last = pgm_read_byte(&gfxFont->last);
-      if ((c >= first) && (c <= last)) { // Char present in this font?
-        GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
-        uint8_t gw = pgm_read_byte(&glyph->width),
-                gh = pgm_read_byte(&glyph->height),
-                xa = pgm_read_byte(&glyph->xAdvance);
-        int8_t xo = pgm_read_byte(&glyph->xOffset),
-               yo = pgm_read_byte(&glyph->yOffset);
-        if (wrap && ((*x + (((int16_t)xo + gw) * textsize_x)) > _width)) {
+      uint8_t gw, gh, xa, present = 0;
+      int8_t xo, yo;
+      const GFXfontMetrics::Glyph *cached;
+      if (metrics && (metrics->getFont() == gfxFont) &&
+          (cached = metrics->getGlyph(c))) { // RAM copy of metrics
+        gw = cached->width;
+        gh = cached->height;
+        xa = cached->xAdvance;
+        xo = cached->xOffset;
+        yo = cached->yOffset;
+        present = 1;
+      } else {
+        GFXglyph *glyph = gfxGetGlyph(gfxFont, c);
+        if (glyph) { // Char present in this font?
+          gw = pgm_read_byte(&glyph->width);
+          gh = pgm_read_byte(&glyph->height);
+          xa = pgm_read_byte(&glyph->xAdvance);
+          xo = pgm_read_byte(&glyph->xOffset);
+          yo = pgm_read_byte(&glyph->yOffset);
+          present = 1;
+        }
+      }
+      if (present) {
+        int32_t i = gfxGlyphIndex(gfxFont, c); // Kerning, as in write()
+        bool tab = tabularDigit(c);
+        int16_t tsx = (int16_t)textsize_x, tsy = (int16_t)textsize_y,
+                pad = tab ? (digitAdvance - xa) / 2 * tsx : 0;
+        if (tab)
+          *prev = -1;
+        *x += gfxKernAdjust(gfxFont, *prev, i) * tsx;
+        *prev = tab ? -1 : i;
+        if (wrap && ((*x + pad + (((int16_t)xo + gw) * tsx)) > tw)) {
           *x = 0; // Reset x to zero, advance y by one line
           *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
         }
-        int16_t tsx = (int16_t)textsize_x, tsy = (int16_t)textsize_y,
-                x1 = *x + xo * tsx, y1 = *y + yo * tsy, x2 = x1 + gw * tsx - 1,
-                y2 = y1 + gh * tsy - 1;
+        int16_t x1 = *x + pad + xo * tsx, y1 = *y + yo * tsy,
+                x2 = x1 + gw * tsx - 1, y2 = y1 + gh * tsy - 1;
+        if (tab)
+          xa = digitAdvance;
         if (x1 < *minx)
           *minx = x1;
         if (y1 < *miny)
@@ -1408,7 +3075,7 @@ void Adafruit_GFX::charBounds(char c, int16_t *x, int16_t *y, int16_t *minx,
       *y += textsize_y * 8; // advance y one line
       // min/max x/y unchaged -- that waits for next 'normal' character
     } else if (c != '\r') { // Normal char; ignore carriage returns
-      if (wrap && ((*x + textsize_x * 6) > _width)) { // Off right?
+      if (wrap && ((*x + textsize_x * 6) > tw)) { // Off right?
         *x = 0;                                       // Reset x to zero,
         *y += textsize_y * 8;                         // advance y one line
       }
@@ -1444,16 +3111,54 @@ void Adafruit_GFX::getTextBounds(const char *str, int16_t x, int16_t y,
                                  int16_t *x1, int16_t *y1, uint16_t *w,
                                  uint16_t *h) {
   uint8_t c; // Current character
+  uint32_t key = 0, check = 0;
+  uint16_t len = 0;
+
+  if (metrics && (metrics->getFont() == gfxFont)) {
+    // Key covers everything the result depends on: string, cursor,
+    // text size, wrap, tabular digits, orientation and display
+    // dimensions.
+    int16_t state[] = {
+        x, y, _width, _height, (int16_t)((textsize_x << 8) | textsize_y),
+        (int16_t)((digitAdvance << 8) | (textOrientation << 1) | wrap)};
+    size_t n = strlen(str);
+    key = fnv1a(fnv1a(FNV1A_INIT, str, n), state, sizeof state);
+    key |= !key; // 0 means unused memo entry
+    // Second hash and length must match too, so a hit needs a collision
+    // of both hashes at once rather than of one
+    check = djb2(djb2(DJB2_INIT, str, n), state, sizeof state);
+    len = n;
+    if (metrics->memoGet(key, check, len, x1, y1, w, h))
+      return;
+  }
 
   *x1 = x;
   *y1 = y;
   *w = *h = 0;
 
-  int16_t minx = _width, miny = _height, maxx = -1, maxy = -1;
+  textFrame(&x, &y, false);
+  bool turned = textOrientation & 1; // Frame's width and height swapped
+  int16_t minx = turned ? _height : _width, miny = turned ? _width : _height,
+          maxx = -1, maxy = -1;
 
+  GFXtextDecoder text(gfxFont);
+  uint32_t code;
+  int32_t prev = -1;
   while ((c = *str++))
-    charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
-
+    if (text.decode(c, &code))
+      charBounds(code, &x, &y, &minx, &miny, &maxx, &maxy, &prev);
+
+  if (textOrientation && (maxx >= minx) && (maxy >= miny)) {
+    // Turn the box back to the screen, by opposite corners
+    textFrame(&minx, &miny, true);
+    textFrame(&maxx, &maxy, true);
+    int16_t t = minx;
+    minx = min(t, maxx);
+    maxx = max(t, maxx);
+    t = miny;
+    miny = min(t, maxy);
+    maxy = max(t, maxy);
+  }
   if (maxx >= minx) {
     *x1 = minx;
     *w = maxx - minx + 1;
@@ -1462,6 +3167,8 @@ void Adafruit_GFX::getTextBounds(const char *str, int16_t x, int16_t y,
     *y1 = miny;
     *h = maxy - miny + 1;
   }
+  if (key)
+    metrics->memoPut(key, check, len, *x1, *y1, *w, *h);
 }
 
 /**************************************************************************/
@@ -1507,11 +3214,29 @@ void Adafruit_GFX::getTextBounds(const __FlashStringHelper *str, int16_t x,
   *y1 = y;
   *w = *h = 0;
 
-  int16_t minx = _width, miny = _height, maxx = -1, maxy = -1;
+  textFrame(&x, &y, false);
+  bool turned = textOrientation & 1; // Frame's width and height swapped
+  int16_t minx = turned ? _height : _width, miny = turned ? _width : _height,
+          maxx = -1, maxy = -1;
 
+  GFXtextDecoder text(gfxFont);
+  uint32_t code;
+  int32_t prev = -1;
   while ((c = pgm_read_byte(s++)))
-    charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
-
+    if (text.decode(c, &code))
+      charBounds(code, &x, &y, &minx, &miny, &maxx, &maxy, &prev);
+
+  if (textOrientation && (maxx >= minx) && (maxy >= miny)) {
+    // Turn the box back to the screen, by opposite corners
+    textFrame(&minx, &miny, true);
+    textFrame(&maxx, &maxy, true);
+    int16_t t = minx;
+    minx = min(t, maxx);
+    maxx = max(t, maxx);
+    t = miny;
+    miny = min(t, maxy);
+    maxy = max(t, maxy);
+  }
   if (maxx >= minx) {
     *x1 = minx;
     *w = maxx - minx + 1;
@@ -1532,22 +3257,253 @@ void Adafruit_GFX::invertDisplay(boolean i) {
   // Do nothing, must be subclassed if supported by hardware
 }
 
-/***************************************************************************/
-
 /**************************************************************************/
 /*!
-   @brief    Create a simple drawn button UI element
+   @brief  Add a span. If it continues the pending one -- directly right,
+           left, below or above it, with the same height or width -- the
+           two are merged, otherwise the pending span is issued first.
+   @param  x  Left edge
+   @param  y  Top edge
+   @param  w  Width in pixels (1 for a vertical line)
+   @param  h  Height in pixels (1 for a horizontal line)
 */
 /**************************************************************************/
-Adafruit_GFX_Button::Adafruit_GFX_Button(void) { _gfx = 0; }
-
-/**************************************************************************/
-/*!
-   @brief    Initialize button with our desired color/size/settings
-   @param    gfx     Pointer to our display so we can draw to it!
-   @param    x       The X coordinate of the center of the button
-   @param    y       The Y coordinate of the center of the button
-   @param    w       Width of the buttton
+void GFXspanList::add(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if ((w <= 0) || (h <= 0)) { // Odd cases pass through unmerged, as-is
+    flush();
+    emit(x, y, w, h);
+    return;
+  }
+  if (_w) {
+    if ((x == _x) && (w == _w)) { // Same columns, stacked?
+      if (y == _y + _h) {
+        _h += h;
+        return;
+      }
+      if (y + h == _y) {
+        _y = y;
+        _h += h;
+        return;
+      }
+    } else if ((y == _y) && (h == _h)) { // Same rows, side by side?
+      if (x == _x + _w) {
+        _w += w;
+        return;
+      }
+      if (x + w == _x) {
+        _x = x;
+        _w += w;
+        return;
+      }
+    }
+    flush();
+  }
+  _x = x;
+  _y = y;
+  _w = w;
+  _h = h;
+}
+
+/**************************************************************************/
+/*!
+   @brief  Issue the pending span, if any, to the device
+*/
+/**************************************************************************/
+void GFXspanList::flush(void) {
+  if (_w) {
+    emit(_x, _y, _w, _h);
+    _w = 0;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Issue one span via the cheapest device call for its shape
+   @param  x  Left edge
+   @param  y  Top edge
+   @param  w  Width in pixels
+   @param  h  Height in pixels
+*/
+/**************************************************************************/
+void GFXspanList::emit(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (w == 1)
+    _gfx->writeFastVLine(x, y, h, _color);
+  else if (h == 1)
+    _gfx->writeFastHLine(x, y, w, _color);
+  else
+    _gfx->writeFillRect(x, y, w, h, _color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Create a metrics cache for a font: a RAM copy of each glyph's
+             size and offsets, so measuring text doesn't need PROGMEM reads,
+             and a memo of the last few getTextBounds() results. Attach to
+             a display with setFontMetrics().
+   @param    f         The font, or NULL for the classic built-in font (for
+                       which only the memo applies)
+   @param    memoSize  Number of measured strings to remember, 0 for none.
+                       Strings are recognized by two independent 32-bit
+                       hashes and length, not kept; a false match is that
+                       unlikely, but not impossible. Use 0 where bounds
+                       must be exact.
+*/
+/**************************************************************************/
+GFXfontMetrics::GFXfontMetrics(const GFXfont *f, uint8_t memoSize)
+    : font(f), glyphs(NULL), memo(NULL), first(1), last(0),
+      memoSize(memoSize), memoNext(0), extended(false) {
+  if (f) {
+    first = pgm_read_byte(&f->first);
+    last = pgm_read_byte(&f->last);
+    extended = pgm_read_word(&f->ranges);
+    uint16_t n = gfxGlyphCount(f);
+    if (n && (glyphs = (Glyph *)malloc(n * sizeof(Glyph)))) {
+      for (uint16_t i = 0; i < n; i++) {
+        GFXglyph *glyph = pgm_read_glyph_ptr(f, i);
+        glyphs[i].width = pgm_read_byte(&glyph->width);
+        glyphs[i].height = pgm_read_byte(&glyph->height);
+        glyphs[i].xAdvance = pgm_read_byte(&glyph->xAdvance);
+        glyphs[i].xOffset = pgm_read_byte(&glyph->xOffset);
+        glyphs[i].yOffset = pgm_read_byte(&glyph->yOffset);
+      }
+    }
+  }
+  if (memoSize && !(memo = (Memo *)calloc(memoSize, sizeof(Memo))))
+    this->memoSize = 0;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Delete the metrics cache, free memory. Detach it from any
+             displays (setFontMetrics(NULL)) first.
+*/
+/**************************************************************************/
+GFXfontMetrics::~GFXfontMetrics(void) {
+  if (glyphs)
+    free(glyphs);
+  if (memo)
+    free(memo);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Get the advance width of a string: how far printing it moves
+             the cursor (the widest line, if it contains newlines). Unlike
+             getTextBounds() this ignores wrapping and glyph overhang (but
+             not kerning), and is the usual measure for right-aligning or
+             centering text.
+   @param    str     The string to measure, UTF-8 for extended fonts
+   @param    size_x  Text magnification in X-axis
+   @returns  Width in pixels
+*/
+/**************************************************************************/
+uint16_t GFXfontMetrics::getTextWidth(const char *str, uint8_t size_x) const {
+  uint16_t width = 0, line = 0;
+  GFXtextDecoder text(font);
+  uint32_t c;
+  int32_t prev = -1, i; // Glyph indices, for kerning
+
+  while (*str) {
+    if (!text.decode(*str++, &c)) {
+      // Partway into a UTF-8 sequence
+    } else if (c == '\n') {
+      line = 0;
+      prev = -1;
+    } else if (c != '\r') {
+      if (!font) {
+        line += 6;
+      } else if ((i = gfxGlyphIndex(font, c)) >= 0) {
+        line += gfxKernAdjust(font, prev, i);
+        if (glyphs)
+          line += glyphs[i].xAdvance;
+        else // No table
+          line += pgm_read_byte(&pgm_read_glyph_ptr(font, i)->xAdvance);
+        prev = i;
+      }
+      if (line > width)
+        width = line;
+    }
+  }
+  return width * size_x;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Look up a remembered getTextBounds() result
+   @param    key    Hash of the string and all layout state
+   @param    check  Second, independent hash of the same, must match too
+   @param    len    Length of the string, must match too
+   @param    x1     The boundary X coordinate, set if found
+   @param    y1     The boundary Y coordinate, set if found
+   @param    w      The boundary width, set if found
+   @param    h      The boundary height, set if found
+   @returns  true if found
+*/
+/**************************************************************************/
+bool GFXfontMetrics::memoGet(uint32_t key, uint32_t check, uint16_t len,
+                             int16_t *x1, int16_t *y1, uint16_t *w,
+                             uint16_t *h) const {
+  for (uint8_t i = 0; i < memoSize; i++) {
+    if ((memo[i].key == key) && (memo[i].check == check) &&
+        (memo[i].len == len)) {
+      *x1 = memo[i].x1;
+      *y1 = memo[i].y1;
+      *w = memo[i].w;
+      *h = memo[i].h;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Remember a getTextBounds() result, replacing the oldest one
+   @param    key    Hash of the string and all layout state, nonzero
+   @param    check  Second, independent hash of the same
+   @param    len    Length of the string
+   @param    x1     The boundary X coordinate
+   @param    y1     The boundary Y coordinate
+   @param    w      The boundary width
+   @param    h      The boundary height
+*/
+/**************************************************************************/
+void GFXfontMetrics::memoPut(uint32_t key, uint32_t check, uint16_t len,
+                             int16_t x1, int16_t y1, uint16_t w, uint16_t h) {
+  if (memoSize) {
+    memo[memoNext].key = key;
+    memo[memoNext].check = check;
+    memo[memoNext].len = len;
+    memo[memoNext].x1 = x1;
+    memo[memoNext].y1 = y1;
+    memo[memoNext].w = w;
+    memo[memoNext].h = h;
+    if (++memoNext >= memoSize)
+      memoNext = 0;
+  }
+}
+
+/***************************************************************************/
+
+/**************************************************************************/
+/*!
+   @brief    Create a simple drawn button UI element
+*/
+/**************************************************************************/
+Adafruit_GFX_Button::Adafruit_GFX_Button(void) {
+  _gfx = 0;
+  _label[0] = 0;
+  currstate = laststate = false;
+  drawnstate = BUTTON_UNDRAWN;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Initialize button with our desired color/size/settings
+   @param    gfx     Pointer to our display so we can draw to it!
+   @param    x       The X coordinate of the center of the button
+   @param    y       The Y coordinate of the center of the button
+   @param    w       Width of the buttton
    @param    h       Height of the buttton
    @param    outline  Color of the outline (16-bit 5-6-5 standard)
    @param    fill  Color of the button fill (16-bit 5-6-5 standard)
@@ -1651,16 +3607,34 @@ void Adafruit_GFX_Button::initButtonUL(Adafruit_GFX *gfx, int16_t x1,
   _textsize_y = textsize_y;
   _gfx = gfx;
   strncpy(_label, label, 9);
+  _label[9] = 0;
+  drawnstate = BUTTON_UNDRAWN;
 }
 
 /**************************************************************************/
 /*!
-   @brief    Draw the button on the screen
+   @brief    Draw the button on the screen, as one write transaction
    @param    inverted Whether to draw with fill/text swapped to indicate
    'pressed'
 */
 /**************************************************************************/
 void Adafruit_GFX_Button::drawButton(boolean inverted) {
+  _gfx->startWrite();
+  writeButton(inverted);
+  _gfx->endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw the button without starting a write transaction, so
+   several buttons can share one. Not self-contained; should follow
+   startWrite(). The label is drawn in the display's current font; the
+   display's text cursor, color and size are left as they were.
+   @param    inverted Whether to draw with fill/text swapped to indicate
+   'pressed'
+*/
+/**************************************************************************/
+void Adafruit_GFX_Button::writeButton(boolean inverted) {
   uint16_t fill, outline, text;
 
   if (!inverted) {
@@ -1673,15 +3647,74 @@ void Adafruit_GFX_Button::drawButton(boolean inverted) {
     text = _fillcolor;
   }
 
-  uint8_t r = min(_w, _h) / 4; // Corner radius
-  _gfx->fillRoundRect(_x1, _y1, _w, _h, r, fill);
-  _gfx->drawRoundRect(_x1, _y1, _w, _h, r, outline);
+  // Same shapes as fillRoundRect() then drawRoundRect()
+  int16_t r = min(_w, _h) / 4; // Corner radius
+  _gfx->writeFillRect(_x1 + r, _y1, _w - 2 * r, _h, fill);
+  _gfx->fillCircleHelper(_x1 + _w - r - 1, _y1 + r, r, 1, _h - 2 * r - 1,
+                         fill);
+  _gfx->fillCircleHelper(_x1 + r, _y1 + r, r, 2, _h - 2 * r - 1, fill);
+  _gfx->writeFastHLine(_x1 + r, _y1, _w - 2 * r, outline);
+  _gfx->writeFastHLine(_x1 + r, _y1 + _h - 1, _w - 2 * r, outline);
+  _gfx->writeFastVLine(_x1, _y1 + r, _h - 2 * r, outline);
+  _gfx->writeFastVLine(_x1 + _w - 1, _y1 + r, _h - 2 * r, outline);
+  _gfx->drawCircleHelper(_x1 + r, _y1 + r, r, 1, outline);
+  _gfx->drawCircleHelper(_x1 + _w - r - 1, _y1 + r, r, 2, outline);
+  _gfx->drawCircleHelper(_x1 + _w - r - 1, _y1 + _h - r - 1, r, 4, outline);
+  _gfx->drawCircleHelper(_x1 + r, _y1 + _h - r - 1, r, 8, outline);
+
+  // Label, placed as for the classic font and advanced as print() would
+  const GFXfont *f = _gfx->getFont();
+  int16_t x = _x1 + (_w / 2) - (strlen(_label) * 3 * _textsize_x),
+          y = _y1 + (_h / 2) - (4 * _textsize_y);
+  GFXtextDecoder label(f);
+  uint32_t c;
+  int32_t prev = -1, i;
+  for (const char *p = _label; *p; p++) {
+    if (!label.decode(*p, &c)) {
+      // Partway into a UTF-8 sequence
+    } else if (!f) {
+      _gfx->writeChar(x, y, c, text, text, _textsize_x, _textsize_y);
+      x += 6 * _textsize_x;
+    } else if ((i = gfxGlyphIndex(f, c)) >= 0) {
+      x += gfxKernAdjust(f, prev, i) * (int16_t)_textsize_x;
+      _gfx->writeGlyph(x, y, c, text, text, _textsize_x, _textsize_y);
+      GFXglyph *glyph = pgm_read_glyph_ptr(f, i);
+      x += (uint8_t)pgm_read_byte(&glyph->xAdvance) * (int16_t)_textsize_x;
+      prev = i;
+    }
+  }
+  drawnstate = inverted ? BUTTON_DRAWN_PRESSED : BUTTON_DRAWN;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw the button if the screen doesn't show it as it is (see
+   needsRedraw()): inverted if pressed. Call every touch poll instead of
+   drawButton(); it only draws on press, release or a label change.
+   @returns  True if the button was drawn
+*/
+/**************************************************************************/
+boolean Adafruit_GFX_Button::updateButton(void) {
+  if (!needsRedraw())
+    return false;
+  drawButton(currstate);
+  return true;
+}
 
-  _gfx->setCursor(_x1 + (_w / 2) - (strlen(_label) * 3 * _textsize_x),
-                  _y1 + (_h / 2) - (4 * _textsize_y));
-  _gfx->setTextColor(text);
-  _gfx->setTextSize(_textsize_x, _textsize_y);
-  _gfx->print(_label);
+/**************************************************************************/
+/*!
+   @brief    Change the button's label. If it differs, the next
+   updateButton() redraws the button.
+   @param    label  Ascii string of the text inside the button, up to 9
+   characters
+*/
+/**************************************************************************/
+void Adafruit_GFX_Button::setLabel(const char *label) {
+  if (strncmp(_label, label, 9)) {
+    strncpy(_label, label, 9);
+    _label[9] = 0;
+    drawnstate = BUTTON_UNDRAWN;
+  }
 }
 
 /**************************************************************************/
@@ -1716,6 +3749,176 @@ boolean Adafruit_GFX_Button::justReleased() {
   return (!currstate && laststate);
 }
 
+/**************************************************************************/
+/*!
+   @brief    Create a group over an array of buttons. Nothing is allocated
+   until begin().
+   @param    buttons  Array of buttons, all on the same display
+   @param    n        Number of buttons in the array
+*/
+/**************************************************************************/
+Adafruit_GFX_ButtonGroup::Adafruit_GFX_ButtonGroup(Adafruit_GFX_Button *buttons,
+                                                   uint8_t n)
+    : _buttons(buttons), _cellStart(NULL), _cellList(NULL), _gridX(0),
+      _gridY(0), _cellW(1), _cellH(1), _gridCols(0), _gridRows(0), _n(n) {}
+
+/**************************************************************************/
+/*!
+   @brief    Delete the group's grid. The buttons are left alone.
+*/
+/**************************************************************************/
+Adafruit_GFX_ButtonGroup::~Adafruit_GFX_ButtonGroup(void) {
+  free(_cellStart);
+  free(_cellList);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Build the hit-test grid from the buttons' current positions.
+   Call after their initButton() calls, and again if any move.
+   @returns  True on success, false if the grid couldn't be allocated
+*/
+/**************************************************************************/
+bool Adafruit_GFX_ButtonGroup::begin(void) {
+  free(_cellStart);
+  free(_cellList);
+  _cellStart = NULL;
+  _cellList = NULL;
+  _gridCols = _gridRows = 0;
+  if (!_n)
+    return true;
+
+  // Bounds of all the buttons, right & bottom exclusive
+  int32_t x1 = 0x7FFF, y1 = 0x7FFF, x2 = -0x8000, y2 = -0x8000;
+  for (uint8_t i = 0; i < _n; i++) {
+    Adafruit_GFX_Button *b = &_buttons[i];
+    x1 = min(x1, (int32_t)b->_x1);
+    y1 = min(y1, (int32_t)b->_y1);
+    x2 = max(x2, (int32_t)b->_x1 + b->_w);
+    y2 = max(y2, (int32_t)b->_y1 + b->_h);
+  }
+  if ((x2 <= x1) || (y2 <= y1))
+    return true; // All empty; nothing can be hit
+
+  // About one cell per button, in the shape of the area they cover
+  uint8_t n = 1;
+  while (n * n < _n)
+    n++;
+  _gridCols = _gridRows = n;
+  _gridX = x1;
+  _gridY = y1;
+  _cellW = (x2 - x1 + n - 1) / n;
+  _cellH = (y2 - y1 + n - 1) / n;
+
+  // Count each button into the cells it overlaps, then fill the lists
+  uint16_t cells = n * n, i, total = 0;
+  if (!(_cellStart = (uint16_t *)calloc(cells + 1, sizeof(uint16_t))))
+    return false;
+  for (uint8_t pass = 0; pass < 2; pass++) {
+    for (uint8_t k = 0; k < _n; k++) {
+      Adafruit_GFX_Button *b = &_buttons[k];
+      if (!b->_w || !b->_h)
+        continue;
+      uint8_t c1 = (b->_x1 - _gridX) / _cellW, r1 = (b->_y1 - _gridY) / _cellH,
+              c2 = (b->_x1 + b->_w - 1 - _gridX) / _cellW,
+              r2 = (b->_y1 + b->_h - 1 - _gridY) / _cellH;
+      for (uint8_t r = r1; r <= r2; r++) {
+        for (uint8_t c = c1; c <= c2; c++) {
+          if (!pass)
+            _cellStart[r * n + c + 1]++;
+          else
+            _cellList[_cellStart[r * n + c]++] = k;
+        }
+      }
+    }
+    if (!pass) {
+      for (i = 1; i <= cells; i++)
+        _cellStart[i] += _cellStart[i - 1];
+      total = _cellStart[cells];
+      if (!(_cellList = (uint8_t *)malloc(total))) {
+        free(_cellStart);
+        _cellStart = NULL;
+        _gridCols = _gridRows = 0;
+        return false;
+      }
+    }
+  }
+  // Filling advanced each start to the next cell's; shift them back
+  for (i = cells; i > 0; i--)
+    _cellStart[i] = _cellStart[i - 1];
+  _cellStart[0] = 0;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Find the button at a point, checking only those in the grid
+   cell the point is in
+   @param    x  The X coordinate to check
+   @param    y  The Y coordinate to check
+   @returns  Index of the first button in the array containing the point,
+   or -1 if none does
+*/
+/**************************************************************************/
+int16_t Adafruit_GFX_ButtonGroup::find(int16_t x, int16_t y) {
+  if (!_gridCols || (x < _gridX) || (y < _gridY))
+    return -1;
+  uint16_t c = (x - _gridX) / _cellW, r = (y - _gridY) / _cellH;
+  if ((c >= _gridCols) || (r >= _gridRows))
+    return -1;
+  uint16_t cell = r * _gridCols + c;
+  for (uint16_t i = _cellStart[cell]; i < _cellStart[cell + 1]; i++) {
+    if (_buttons[_cellList[i]].contains(x, y))
+      return _cellList[i];
+  }
+  return -1;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Update every button's state from one touch poll: the button
+   at the touch (if any) is pressed and all others released, so their
+   justPressed() and justReleased() work as with press()
+   @param    x        The X coordinate of the touch
+   @param    y        The Y coordinate of the touch
+   @param    touched  False if there's no touch; all are released
+   @returns  Index of the button touched, or -1 if none
+*/
+/**************************************************************************/
+int16_t Adafruit_GFX_ButtonGroup::press(int16_t x, int16_t y,
+                                        boolean touched) {
+  int16_t hit = touched ? find(x, y) : -1;
+  for (uint8_t i = 0; i < _n; i++)
+    _buttons[i].press(i == hit);
+  return hit;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw the buttons the screen doesn't show as they are (see
+   Adafruit_GFX_Button::needsRedraw()), or all of them, inverted if
+   pressed, in a single write transaction
+   @param    all  True to draw every button, e.g. over a cleared screen
+   @returns  Number of buttons drawn
+*/
+/**************************************************************************/
+uint8_t Adafruit_GFX_ButtonGroup::render(boolean all) {
+  uint8_t drawn = 0;
+  Adafruit_GFX *gfx = NULL;
+  for (uint8_t i = 0; i < _n; i++) {
+    Adafruit_GFX_Button *b = &_buttons[i];
+    if (!b->_gfx || (!all && !b->needsRedraw()))
+      continue;
+    if (!gfx)
+      (gfx = b->_gfx)->startWrite();
+    b->writeButton(b->currstate);
+    drawn++;
+  }
+  if (gfx)
+    gfx->endWrite();
+  return drawn;
+}
+
 // -------------------------------------------------------------------------
 
 // GFXcanvas1, GFXcanvas8 and GFXcanvas16 (currently a WIP, don't get too
@@ -1732,219 +3935,603 @@ boolean Adafruit_GFX_Button::justReleased() {
 // as the text+bitmap draw can be pokey).  GFXcanvas1 requires 1 bit per
 // pixel (rounded up to nearest byte per scanline), GFXcanvas8 is 1 byte
 // per pixel (no scanline pad), and GFXcanvas16 uses 2 bytes per pixel (no
-// scanline pad).
+// scanline pad).  GFXcanvas2 and GFXcanvas4 pack 2 or 4 bits per pixel
+// (rounded up to nearest byte per scanline), each a palette index.
 // NOT EXTENSIVELY TESTED YET.  MAY CONTAIN WORST BUGS KNOWN TO HUMANKIND.
 
-/**************************************************************************/
-/*!
-   @brief    Instatiate a GFX 1-bit canvas context for graphics
-   @param    w   Display width, in pixels
-   @param    h   Display height, in pixels
-*/
-/**************************************************************************/
-GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
-  uint16_t bytes = ((w + 7) / 8) * h;
-  if ((buffer = (uint8_t *)malloc(bytes))) {
-    memset(buffer, 0, bytes);
+// Canvas span/rect fills are clipped in rotated (user) space, then the
+// surviving rectangle is mapped once into the canvas' unrotated buffer
+// space, so the inner loops are straight memory fills with no per-pixel
+// bounds check or rotation switch.
+
+// Map a (clipped) rect from rotated space to unrotated buffer space.
+// raw_w, raw_h are the canvas' rotation-0 dimensions (WIDTH, HEIGHT).
+static inline void canvasRotateRect(uint8_t rotation, int16_t raw_w,
+                                    int16_t raw_h, int16_t *x, int16_t *y,
+                                    int16_t *w, int16_t *h) {
+  int16_t t;
+  switch (rotation) {
+  case 1:
+    t = *x;
+    *x = raw_w - *y - *h;
+    *y = t;
+    t = *w;
+    *w = *h;
+    *h = t;
+    break;
+  case 2:
+    *x = raw_w - *x - *w;
+    *y = raw_h - *y - *h;
+    break;
+  case 3:
+    t = *y;
+    *y = raw_h - *x - *w;
+    *x = t;
+    t = *w;
+    *w = *h;
+    *h = t;
+    break;
   }
 }
 
-/**************************************************************************/
-/*!
-   @brief    Delete the canvas, free memory
-*/
-/**************************************************************************/
-GFXcanvas1::~GFXcanvas1(void) {
-  if (buffer)
-    free(buffer);
-}
+// PIXEL ROW KERNELS -------------------------------------------------------
 
-/**************************************************************************/
-/*!
-    @brief  Draw a pixel to the canvas framebuffer
-    @param  x     x coordinate
-    @param  y     y coordinate
-    @param  color 16-bit 5-6-5 Color to fill with
-*/
-/**************************************************************************/
-void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
-#ifdef __AVR__
-  // Bitmask tables of 0x80>>X and ~(0x80>>X), because X>>Y is slow on AVR
-  static const uint8_t PROGMEM GFXsetBit[] = {0x80, 0x40, 0x20, 0x10,
-                                              0x08, 0x04, 0x02, 0x01},
-                               GFXclrBit[] = {0x7F, 0xBF, 0xDF, 0xEF,
-                                              0xF7, 0xFB, 0xFD, 0xFE};
+// Pixel rows are filled and byte-swapped a 32-bit word (two pixels) at a
+// time, four words per loop pass. On ARMv6-M and later (Cortex-M0+ thru
+// M7, so SAMD21/51, nRF52, RP2040, Teensy 3/4) REV16 swaps both pixels of
+// a word in one instruction; elsewhere it takes two masks and shifts.
+#if defined(__arm__) && defined(__ARM_ARCH) && (__ARM_ARCH >= 6)
+#define GFX_PIXEL_REV16 ///< CPU has REV16
 #endif
 
-  if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
-      return;
-
-    int16_t t;
-    switch (rotation) {
-    case 1:
-      t = x;
-      x = WIDTH - 1 - y;
-      y = t;
-      break;
-    case 2:
-      x = WIDTH - 1 - x;
-      y = HEIGHT - 1 - y;
-      break;
-    case 3:
-      t = x;
-      x = y;
-      y = HEIGHT - 1 - t;
-      break;
-    }
-
-    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
-#ifdef __AVR__
-    if (color)
-      *ptr |= pgm_read_byte(&GFXsetBit[x & 7]);
-    else
-      *ptr &= pgm_read_byte(&GFXclrBit[x & 7]);
+// Swap the bytes of both 16-bit pixels in a word
+static inline uint32_t swapPixelPair(uint32_t p) {
+#if defined(GFX_PIXEL_REV16)
+  __asm__("rev16 %0, %1" : "=l"(p) : "l"(p));
+  return p;
 #else
-    if (color)
-      *ptr |= 0x80 >> (x & 7);
-    else
-      *ptr &= ~(0x80 >> (x & 7));
+  return ((p & 0x00FF00FF) << 8) | ((p >> 8) & 0x00FF00FF);
 #endif
-  }
 }
 
 /**************************************************************************/
 /*!
-    @brief  Fill the framebuffer completely with one color
-    @param  color 16-bit 5-6-5 Color to fill with
+    @brief  Fill a row of 16-bit pixels with one value, two pixels per
+            32-bit store (memset if both its bytes are the same). The
+            value is stored as given, so pass it byte-swapped for a
+            big-endian buffer.
+    @param  dst    First pixel
+    @param  color  Pixel value
+    @param  len    Number of pixels
 */
 /**************************************************************************/
-void GFXcanvas1::fillScreen(uint16_t color) {
-  if (buffer) {
-    uint16_t bytes = ((WIDTH + 7) / 8) * HEIGHT;
-    memset(buffer, color ? 0xFF : 0x00, bytes);
+void gfxFill565(uint16_t *dst, uint16_t color, uint32_t len) {
+  if ((color >> 8) == (color & 0xFF)) {
+    memset(dst, color & 0xFF, len * 2);
+    return;
   }
+  if (len && ((uintptr_t)dst & 2)) {
+    *dst++ = color;
+    len--;
+  }
+  uint32_t *dst32 = (uint32_t *)dst,
+           twoPixels = (uint32_t)color * 0x00010001u;
+  for (uint32_t n = len / 8; n--; dst32 += 4) {
+    dst32[0] = twoPixels;
+    dst32[1] = twoPixels;
+    dst32[2] = twoPixels;
+    dst32[3] = twoPixels;
+  }
+  for (uint32_t n = (len / 2) & 3; n--;)
+    *dst32++ = twoPixels;
+  if (len & 1)
+    *(uint16_t *)dst32 = color;
 }
 
 /**************************************************************************/
 /*!
-   @brief    Instatiate a GFX 8-bit canvas context for graphics
-   @param    w   Display width, in pixels
-   @param    h   Display height, in pixels
+    @brief  Copy a row of 16-bit pixels, swapping the two bytes of each:
+            native 565 to the big-endian order displays take, or back.
+            Two pixels per 32-bit word unless the rows are differently
+            aligned. Source and destination may be the same row, to swap
+            in place.
+    @param  dst  First destination pixel
+    @param  src  First source pixel
+    @param  len  Number of pixels
 */
 /**************************************************************************/
-GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
-  uint32_t bytes = w * h;
-  if ((buffer = (uint8_t *)malloc(bytes))) {
-    memset(buffer, 0, bytes);
+void gfxSwap565(uint16_t *dst, const uint16_t *src, uint32_t len) {
+  if (((uintptr_t)dst ^ (uintptr_t)src) & 2) { // Can't both be aligned
+    while (len--)
+      *dst++ = __builtin_bswap16(*src++);
+    return;
+  }
+  if (len && ((uintptr_t)dst & 2)) {
+    *dst++ = __builtin_bswap16(*src++);
+    len--;
   }
+  uint32_t *d = (uint32_t *)dst;
+  const uint32_t *s = (const uint32_t *)src;
+  for (uint32_t n = len / 8; n--; d += 4, s += 4) {
+    uint32_t a = s[0], b = s[1], c = s[2], e = s[3]; // Loads together
+    d[0] = swapPixelPair(a);
+    d[1] = swapPixelPair(b);
+    d[2] = swapPixelPair(c);
+    d[3] = swapPixelPair(e);
+  }
+  for (uint32_t n = (len / 2) & 3; n--;)
+    *d++ = swapPixelPair(*s++);
+  if (len & 1)
+    *(uint16_t *)d = __builtin_bswap16(*(const uint16_t *)s);
 }
 
-/**************************************************************************/
-/*!
-   @brief    Delete the canvas, free memory
-*/
-/**************************************************************************/
-GFXcanvas8::~GFXcanvas8(void) {
-  if (buffer)
-    free(buffer);
+// Bitmap copies into canvases go through canvasBlit(), instantiated for
+// each combination of source format and buffer depth, so the inner loop is
+// a fetch and a store at a buffer index stepped by clipBlit()'s strides:
+// no per-pixel bounds check, rotation switch or virtual call.
+
+static inline uint16_t blitRead(const uint16_t *p, bool pgm) {
+  return pgm ? pgm_read_word(p) : *p;
+}
+static inline uint8_t blitRead(const uint8_t *p, bool pgm) {
+  return pgm ? pgm_read_byte(p) : *p;
 }
 
-/**************************************************************************/
-/*!
-    @brief  Draw a pixel to the canvas framebuffer
-    @param  x   x coordinate
-    @param  y   y coordinate
-    @param  color 16-bit 5-6-5 Color to fill with
-*/
-/**************************************************************************/
-void GFXcanvas8::drawPixel(int16_t x, int16_t y, uint16_t color) {
-  if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
-      return;
-
-    int16_t t;
-    switch (rotation) {
-    case 1:
-      t = x;
-      x = WIDTH - 1 - y;
-      y = t;
-      break;
-    case 2:
-      x = WIDTH - 1 - x;
-      y = HEIGHT - 1 - y;
-      break;
-    case 3:
-      t = x;
-      x = y;
-      y = HEIGHT - 1 - t;
-      break;
+// Source of whole pixels (16-bit color or 8-bit grayscale), with an
+// optional 1-bit mask. row() selects a bitmap row; get() fetches a pixel,
+// returning false where the mask makes it transparent.
+template <typename T, bool Pgm, bool Masked> struct BlitPixels {
+  const T *bitmap, *line;
+  const uint8_t *mask, *mline;
+  int16_t w;
+  BlitPixels(const T *b, const uint8_t *m, int16_t w)
+      : bitmap(b), line(b), mask(m), mline(m), w(w) {}
+  void row(int16_t j) {
+    line = &bitmap[(int32_t)j * w];
+    if (Masked)
+      mline = &mask[j * ((w + 7) / 8)];
+  }
+  bool get(int16_t i, uint16_t *c) {
+    if (Masked && !(blitRead(&mline[i >> 3], Pgm) & (0x80 >> (i & 7))))
+      return false;
+    *c = blitRead(&line[i], Pgm);
+    return true;
+  }
+};
+
+// Source of 1-bit pixels as drawBitmap() takes them, set bits in fg and
+// unset in bg, or transparent unless Opaque
+template <bool Pgm, bool Opaque> struct BlitMono {
+  const uint8_t *bitmap, *line;
+  int16_t bw;
+  uint16_t fg, bg;
+  BlitMono(const uint8_t *b, int16_t w, uint16_t fg, uint16_t bg)
+      : bitmap(b), line(b), bw((w + 7) / 8), fg(fg), bg(bg) {}
+  void row(int16_t j) { line = &bitmap[j * bw]; }
+  bool get(int16_t i, uint16_t *c) {
+    bool set = blitRead(&line[i >> 3], Pgm) & (0x80 >> (i & 7));
+    if (!Opaque && !set)
+      return false;
+    *c = set ? fg : bg;
+    return true;
+  }
+};
+
+// Source of 8-bit-per-channel pixels, quantized to a canvas depth (16,
+// 8 or 1; see rgbQuantize()) and dithered by drawing position
+template <uint8_t Depth> struct BlitRGB888 {
+  const uint8_t *bitmap, *line;
+  int16_t w, x, y, yj;
+  GFXrgbFormat format;
+  uint8_t bpp;
+  bool dither;
+  BlitRGB888(const uint8_t *b, int16_t w, int16_t x, int16_t y,
+             GFXrgbFormat format, bool dither)
+      : bitmap(b), line(b), w(w), x(x), y(y), yj(y), format(format),
+        bpp((format == GFX_GRAY8) ? 1 : 3), dither(dither) {}
+  void row(int16_t j) {
+    line = &bitmap[(int32_t)j * w * bpp];
+    yj = y + j;
+  }
+  bool get(int16_t i, uint16_t *c) {
+    *c = rgbQuantize(&line[i * bpp], format, Depth,
+                     ditherLevel(x + i, yj, dither));
+    return true;
+  }
+};
+
+// Buffer stores, by canvas depth
+struct BlitPut16 {
+  uint16_t *buf;
+  void put(int32_t i, uint16_t c) { buf[i] = c; }
+};
+struct BlitPut16BE {
+  uint16_t *buf;
+  void put(int32_t i, uint16_t c) { buf[i] = __builtin_bswap16(c); }
+};
+struct BlitPut8 {
+  uint8_t *buf;
+  void put(int32_t i, uint16_t c) { buf[i] = c; }
+};
+struct BlitPut1 {
+  uint8_t *buf;
+  void put(int32_t i, uint16_t c) {
+    if (c)
+      buf[i >> 3] |= 0x80 >> (i & 7);
+    else
+      buf[i >> 3] &= ~(0x80 >> (i & 7));
+  }
+};
+
+template <class Src, class Dst>
+static void canvasBlit(const GFXblit &b, Src src, Dst dst) {
+  int32_t row = b.base;
+  for (int16_t j = b.j0; j < b.j1; j++, row += b.stepY) {
+    src.row(j);
+    int32_t d = row;
+    for (int16_t i = b.i0; i < b.i1; i++, d += b.stepX) {
+      uint16_t c;
+      if (src.get(i, &c))
+        dst.put(d, c);
     }
-
-    buffer[x + y * WIDTH] = color;
   }
 }
 
-/**************************************************************************/
-/*!
-    @brief  Fill the framebuffer completely with one color
-    @param  color 16-bit 5-6-5 Color to fill with
-*/
-/**************************************************************************/
-void GFXcanvas8::fillScreen(uint16_t color) {
-  if (buffer) {
-    memset(buffer, color, WIDTH * HEIGHT);
+template <class Src>
+static void canvasBlit16(uint16_t *buf, bool bigEndian, const GFXblit &b,
+                         Src src) {
+  if (bigEndian) {
+    BlitPut16BE dst = {buf};
+    canvasBlit(b, src, dst);
+  } else {
+    BlitPut16 dst = {buf};
+    canvasBlit(b, src, dst);
   }
 }
 
-void GFXcanvas8::writeFastHLine(int16_t x, int16_t y, int16_t w,
-                                uint16_t color) {
+// Canvas-to-canvas copies work on unrotated buffer rows of any depth (1,
+// 2, 4, 8 or 16 bits per pixel), sub-byte pixels packed leftmost in the
+// most significant bits as all the canvases store them.
+
+static inline uint16_t rasterGet(const uint8_t *row, int32_t x,
+                                 uint8_t depth) {
+  if (depth == 16)
+    return ((const uint16_t *)row)[x];
+  if (depth == 8)
+    return row[x];
+  int32_t bit = x * depth;
+  return (row[bit >> 3] >> (8 - depth - (bit & 7))) & ((1 << depth) - 1);
+}
 
-  if ((x >= _width) || (y < 0) || (y >= _height))
-    return;
-  int16_t x2 = x + w - 1;
-  if (x2 < 0)
-    return;
+static inline void rasterPut(uint8_t *row, int32_t x, uint8_t depth,
+                             uint16_t c) {
+  if (depth == 16) {
+    ((uint16_t *)row)[x] = c;
+  } else if (depth == 8) {
+    row[x] = c;
+  } else {
+    int32_t bit = x * depth;
+    uint8_t shift = 8 - depth - (bit & 7),
+            mask = ((1 << depth) - 1) << shift;
+    row[bit >> 3] = (row[bit >> 3] & ~mask) | ((c << shift) & mask);
+  }
+}
 
-  // Clip left/right
-  if (x < 0) {
-    x = 0;
-    w = x2 + 1;
+static inline void rasterMove(uint8_t *drow, int32_t dx, const uint8_t *srow,
+                              int32_t sx, uint8_t depth, bool swap) {
+  uint16_t c = rasterGet(srow, sx, depth);
+  rasterPut(drow, dx, depth, swap ? __builtin_bswap16(c) : c);
+}
+
+// Copy n pixels from column sx of one buffer row to column dx of another,
+// or of the same row (overlap is fine). Runs at the same bit alignment
+// move by memmove() apart from any partial bytes at their ends; swap
+// byte-swaps 16-bit pixels, between canvases of opposite endianness.
+static void rasterCopyRow(uint8_t *drow, int16_t dx, const uint8_t *srow,
+                          int16_t sx, int16_t n, uint8_t depth, bool swap) {
+  int32_t sbit = (int32_t)sx * depth, dbit = (int32_t)dx * depth;
+  int16_t head = 0, tail = n, i;
+  int32_t bytes = 0;
+  if (!swap && !((sbit ^ dbit) & 7)) {
+    head = ((8 - (dbit & 7)) & 7) / depth;
+    if (head > n)
+      head = n;
+    bytes = (int32_t)(n - head) * depth / 8;
+    tail = n - head - bytes * 8 / depth;
   }
-  if (x2 >= _width)
-    w = _width - x;
+  // Moving right, work from the right end so no pixel is overwritten
+  // before it's read
+  bool back = (dx > sx);
+  if (back) {
+    for (i = n; i-- > n - tail;)
+      rasterMove(drow, dx + i, srow, sx + i, depth, swap);
+  } else {
+    for (i = 0; i < head; i++)
+      rasterMove(drow, dx + i, srow, sx + i, depth, swap);
+  }
+  if (bytes) {
+    int32_t skip = (int32_t)head * depth;
+    memmove(&drow[(dbit + skip) >> 3], &srow[(sbit + skip) >> 3], bytes);
+  }
+  if (back) {
+    for (i = head; i--;)
+      rasterMove(drow, dx + i, srow, sx + i, depth, swap);
+  } else {
+    for (i = n - tail; i < n; i++)
+      rasterMove(drow, dx + i, srow, sx + i, depth, swap);
+  }
+}
 
-  int16_t t;
+// Unrotated buffer position of canvas pixel (x,y) at a rotation
+static void rasterPoint(uint8_t rotation, int16_t raw_w, int16_t raw_h,
+                        int16_t x, int16_t y, int16_t *rx, int16_t *ry) {
   switch (rotation) {
+  case 0:
+    *rx = x;
+    *ry = y;
+    break;
   case 1:
-    t = x;
-    x = WIDTH - 1 - y;
-    y = t;
+    *rx = raw_w - 1 - y;
+    *ry = x;
     break;
   case 2:
-    x = WIDTH - 1 - x;
-    y = HEIGHT - 1 - y;
+    *rx = raw_w - 1 - x;
+    *ry = raw_h - 1 - y;
     break;
-  case 3:
-    t = x;
-    x = y;
-    y = HEIGHT - 1 - t;
+  default:
+    *rx = y;
+    *ry = raw_h - 1 - x;
     break;
   }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Trim a copy between two displays or canvases (or within
+              one): the source rect to the source's edges and the
+              destination to this one's clip rect, each trimming the
+              other.
+    @param    src  Display or canvas being copied from (may be this one)
+    @param    sx   Pointer to left column of source rect, in src's
+                   drawing coordinates; src's display column on return
+    @param    sy   Pointer to top row of source rect, likewise
+    @param    dx   Pointer to left column of destination, in drawing
+                   coordinates; display column on return
+    @param    dy   Pointer to top row of destination, likewise
+    @param    w    Pointer to width, width to copy on return
+    @param    h    Pointer to height, height to copy on return
+    @returns  true if any pixels are left to copy
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipCopy(const Adafruit_GFX *src, int16_t *sx,
+                            int16_t *sy, int16_t *dx, int16_t *dy,
+                            int16_t *w, int16_t *h) const {
+  if ((*w <= 0) || (*h <= 0))
+    return false;
+  *sx += src->_originX;
+  *sy += src->_originY;
+  if (*sx < 0) {
+    *dx -= *sx;
+    *w += *sx;
+    *sx = 0;
+  }
+  if (*sy < 0) {
+    *dy -= *sy;
+    *h += *sy;
+    *sy = 0;
+  }
+  if (*sx + *w > src->_width)
+    *w = src->_width - *sx;
+  if (*sy + *h > src->_height)
+    *h = src->_height - *sy;
+  int16_t x = *dx, y = *dy;
+  if ((*w <= 0) || (*h <= 0) || !clipRect(dx, dy, w, h))
+    return false;
+  *sx += *dx - (x + _originX);
+  *sy += *dy - (y + _originY);
+  return true;
+}
 
-  memset(buffer + y * WIDTH + x, color, w);
+/**************************************************************************/
+/*!
+    @brief    Copy a rectangle of pixels from one canvas buffer to another
+              of the same depth, or within one buffer, trimmed as
+              clipCopy() does. With both at the same rotation (always so
+              within one canvas) rows are copied in unrotated buffer
+              space, in whichever order keeps overlapping areas intact.
+    @param    src    Canvas being copied from (may be this one)
+    @param    sbuf   Its buffer
+    @param    srow   Its bytes per unrotated row
+    @param    dbuf   This canvas's buffer
+    @param    drow   Its bytes per unrotated row
+    @param    depth  Bits per pixel, 1, 2, 4, 8 or 16
+    @param    swap   true to byte-swap 16-bit pixels along the way
+    @param    sx     Left column of source rect, src's drawing coordinates
+    @param    sy     Top row of source rect
+    @param    dx     Pointer to left column of destination, in drawing
+                     coordinates; display column of what was written on
+                     return
+    @param    dy     Pointer to top row of destination, likewise
+    @param    w      Pointer to width, width written on return
+    @param    h      Pointer to height, height written on return
+    @returns  true if any pixels were copied
+*/
+/**************************************************************************/
+bool Adafruit_GFX::canvasCopy(const Adafruit_GFX *src, const uint8_t *sbuf,
+                              int32_t srow, uint8_t *dbuf, int32_t drow,
+                              uint8_t depth, bool swap, int16_t sx,
+                              int16_t sy, int16_t *dx, int16_t *dy,
+                              int16_t *w, int16_t *h) {
+  if (!clipCopy(src, &sx, &sy, dx, dy, w, h))
+    return false;
+
+  if (src->rotation == rotation) {
+    int16_t rsx = sx, rsy = sy, rw = *w, rh = *h, rdx = *dx, rdy = *dy;
+    int16_t tw = *w, th = *h;
+    canvasRotateRect(rotation, src->WIDTH, src->HEIGHT, &rsx, &rsy, &rw,
+                     &rh);
+    canvasRotateRect(rotation, WIDTH, HEIGHT, &rdx, &rdy, &tw, &th);
+    const uint8_t *s = &sbuf[rsy * srow];
+    uint8_t *d = &dbuf[rdy * drow];
+    if (!swap && !rsx && !rdx && (srow == drow) &&
+        ((int32_t)rw * depth == drow * 8)) {
+      memmove(d, s, rh * drow); // Whole rows, one contiguous block
+    } else if ((sbuf == dbuf) && (rdy > rsy)) { // Bottom up, for overlap
+      for (int16_t j = rh; j--;)
+        rasterCopyRow(&d[j * drow], rdx, &s[j * srow], rsx, rw, depth, swap);
+    } else {
+      for (int16_t j = 0; j < rh; j++)
+        rasterCopyRow(&d[j * drow], rdx, &s[j * srow], rsx, rw, depth, swap);
+    }
+  } else { // Different canvases at different rotations: pixel by pixel
+    int16_t s0x, s0y, s1x, s1y, s2x, s2y, d0x, d0y, d1x, d1y, d2x, d2y;
+    rasterPoint(src->rotation, src->WIDTH, src->HEIGHT, sx, sy, &s0x, &s0y);
+    rasterPoint(src->rotation, src->WIDTH, src->HEIGHT, sx + 1, sy + 1,
+                &s1x, &s1y);
+    rasterPoint(src->rotation, src->WIDTH, src->HEIGHT, sx + 1, sy, &s2x,
+                &s2y);
+    rasterPoint(rotation, WIDTH, HEIGHT, *dx, *dy, &d0x, &d0y);
+    rasterPoint(rotation, WIDTH, HEIGHT, *dx + 1, *dy + 1, &d1x, &d1y);
+    rasterPoint(rotation, WIDTH, HEIGHT, *dx + 1, *dy, &d2x, &d2y);
+    // Buffer steps per pixel along a canvas row (2 - 0) and column (1 - 2)
+    int16_t sxi = s2x - s0x, syi = s2y - s0y, sxj = s1x - s2x,
+            syj = s1y - s2y, dxi = d2x - d0x, dyi = d2y - d0y,
+            dxj = d1x - d2x, dyj = d1y - d2y;
+    for (int16_t j = 0; j < *h; j++) {
+      int16_t ax = s0x + j * sxj, ay = s0y + j * syj, bx = d0x + j * dxj,
+              by = d0y + j * dyj;
+      for (int16_t i = 0; i < *w; i++, ax += sxi, ay += syi, bx += dxi,
+                   by += dyi) {
+        rasterMove(&dbuf[by * drow], bx, &sbuf[ay * srow], ax, depth, swap);
+      }
+    }
+  }
+  return true;
 }
 
 /**************************************************************************/
 /*!
-   @brief    Instatiate a GFX 16-bit canvas context for graphics
+    @brief  Copy a rectangle to elsewhere on the display; the two may
+            overlap. The source is trimmed to the display and the
+            destination to the clip rect. This version hands the copy to
+            hwCopyRect() if the display has one and otherwise does
+            nothing; canvases and displays that can read back override
+            it.
+    @param  sx  Left column of source rect
+    @param  sy  Top row of source rect
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  dx  Left column of destination
+    @param  dy  Top row of destination
+*/
+/**************************************************************************/
+void Adafruit_GFX::copyRect(int16_t sx, int16_t sy, int16_t w, int16_t h,
+                            int16_t dx, int16_t dy) {
+  if ((hwCaps & GFX_HW_COPY) && clipCopy(this, &sx, &sy, &dx, &dy, &w, &h))
+    hwCopyRect(sx, sy, w, h, dx, dy);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Move everything within the clip rect (the whole display if
+            none is set) dx pixels right and dy down, filling the area
+            uncovered with one color. Pixels moved outside are lost.
+            Done by hwScroll() if the display has it, else as a
+            copyRect() and fillRect()s of the strips uncovered.
+    @param  dx    Columns to move right (negative moves left)
+    @param  dy    Rows to move down (negative moves up)
+    @param  fill  Color for the uncovered area, as fillRect() takes it
+*/
+/**************************************************************************/
+void Adafruit_GFX::scroll(int16_t dx, int16_t dy, uint16_t fill) {
+  int16_t x, y, w, h;
+  getClipRect(&x, &y, &w, &h);
+  if (!w || !h)
+    return;
+  if ((hwCaps & GFX_HW_SCROLL) && hwScroll(x, y, w, h, dx, dy, fill))
+    return;
+  x -= _originX; // Back to drawing coordinates
+  y -= _originY;
+  if ((dx < w) && (dx > -w) && (dy < h) && (dy > -h))
+    copyRect(x, y, w, h, x + dx, y + dy);
+  if (dx > 0)
+    fillRect(x, y, dx, h, fill);
+  else if (dx < 0)
+    fillRect(x + w + dx, y, -dx, h, fill);
+  if (dy > 0)
+    fillRect(x, y, w, dy, fill);
+  else if (dy < 0)
+    fillRect(x, y + h + dy, w, -dy, fill);
+}
+
+/**************************************************************************/
+/*!
+    @brief   Fill a rectangle with the display's 2D engine. Called by
+             fillRect() (and by subclasses' fills) when hwCaps has
+             GFX_HW_FILL; this version does nothing.
+    @param   x      Left column, display coordinates, clipped
+    @param   y      Top row
+    @param   w      Width in pixels, at least 1
+    @param   h      Height in pixels, at least 1
+    @param   color  16-bit 5-6-5 color
+    @returns true if the rectangle was filled, false to stream it instead
+*/
+/**************************************************************************/
+bool Adafruit_GFX::hwFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                              uint16_t color) {
+  return false;
+}
+
+/**************************************************************************/
+/*!
+    @brief   Move a rectangle with the display's 2D engine, overlap and
+             all. Called by copyRect() when hwCaps has GFX_HW_COPY; this
+             version does nothing.
+    @param   sx  Left column of source rect, display coordinates
+    @param   sy  Top row of source rect
+    @param   w   Width in pixels, at least 1
+    @param   h   Height in pixels, at least 1
+    @param   dx  Left column of destination
+    @param   dy  Top row of destination
+    @returns true if the rectangle was copied, false to copy it otherwise
+*/
+/**************************************************************************/
+bool Adafruit_GFX::hwCopyRect(int16_t sx, int16_t sy, int16_t w, int16_t h,
+                              int16_t dx, int16_t dy) {
+  return false;
+}
+
+/**************************************************************************/
+/*!
+    @brief   Scroll a rectangle in place with the display's 2D engine,
+             filling what's uncovered. Called by scroll() when hwCaps has
+             GFX_HW_SCROLL; this version does nothing.
+    @param   x     Left column of the area, display coordinates
+    @param   y     Top row of the area
+    @param   w     Width in pixels, at least 1
+    @param   h     Height in pixels, at least 1
+    @param   dx    Columns to move right (negative moves left)
+    @param   dy    Rows to move down (negative moves up)
+    @param   fill  Color for the uncovered area
+    @returns true if the area was scrolled, false to scroll it by
+             copyRect() and fillRect()
+*/
+/**************************************************************************/
+bool Adafruit_GFX::hwScroll(int16_t x, int16_t y, int16_t w, int16_t h,
+                            int16_t dx, int16_t dy, uint16_t fill) {
+  return false;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 1-bit canvas context for graphics
    @param    w   Display width, in pixels
    @param    h   Display height, in pixels
 */
 /**************************************************************************/
-GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
-  uint32_t bytes = w * h * 2;
-  if ((buffer = (uint16_t *)malloc(bytes))) {
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+  uint16_t bytes = ((w + 7) / 8) * h;
+  if ((buffer = (uint8_t *)malloc(bytes))) {
     memset(buffer, 0, bytes);
   }
 }
@@ -1954,7 +4541,7 @@ GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
    @brief    Delete the canvas, free memory
 */
 /**************************************************************************/
-GFXcanvas16::~GFXcanvas16(void) {
+GFXcanvas1::~GFXcanvas1(void) {
   if (buffer)
     free(buffer);
 }
@@ -1962,14 +4549,22 @@ GFXcanvas16::~GFXcanvas16(void) {
 /**************************************************************************/
 /*!
     @brief  Draw a pixel to the canvas framebuffer
-    @param  x   x coordinate
-    @param  y   y coordinate
+    @param  x     x coordinate
+    @param  y     y coordinate
     @param  color 16-bit 5-6-5 Color to fill with
 */
 /**************************************************************************/
-void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
+void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
+#ifdef __AVR__
+  // Bitmask tables of 0x80>>X and ~(0x80>>X), because X>>Y is slow on AVR
+  static const uint8_t PROGMEM GFXsetBit[] = {0x80, 0x40, 0x20, 0x10,
+                                              0x08, 0x04, 0x02, 0x01},
+                               GFXclrBit[] = {0x7F, 0xBF, 0xDF, 0xEF,
+                                              0xF7, 0xFB, 0xFD, 0xFE};
+#endif
+
   if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    if (!clipPixel(&x, &y))
       return;
 
     int16_t t;
@@ -1990,7 +4585,18 @@ void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
       break;
     }
 
-    buffer[x + y * WIDTH] = color;
+    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+#ifdef __AVR__
+    if (color)
+      *ptr |= pgm_read_byte(&GFXsetBit[x & 7]);
+    else
+      *ptr &= pgm_read_byte(&GFXclrBit[x & 7]);
+#else
+    if (color)
+      *ptr |= 0x80 >> (x & 7);
+    else
+      *ptr &= ~(0x80 >> (x & 7));
+#endif
   }
 }
 
@@ -2000,36 +4606,1980 @@ void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
     @param  color 16-bit 5-6-5 Color to fill with
 */
 /**************************************************************************/
-void GFXcanvas16::fillScreen(uint16_t color) {
-  if (buffer) {
-    uint8_t hi = color >> 8, lo = color & 0xFF;
-    if (hi == lo) {
-      memset(buffer, lo, WIDTH * HEIGHT * 2);
-    } else {
-      uint32_t i, pixels = WIDTH * HEIGHT;
-      for (i = 0; i < pixels; i++)
-        buffer[i] = color;
+void GFXcanvas1::fillScreen(uint16_t color) {
+  if (clipActive()) {
+    fillRect(-_originX, -_originY, _width, _height, color);
+  } else if (buffer) {
+    uint16_t bytes = ((WIDTH + 7) / 8) * HEIGHT;
+    memset(buffer, color ? 0xFF : 0x00, bytes);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a perfectly vertical line, optimized for 1-bit canvas
+   @param  x      Top-most x coordinate
+   @param  y      Top-most y coordinate
+   @param  h      Height in pixels
+   @param  color  Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                               uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a perfectly horizontal line, optimized for 1-bit canvas
+   @param  x      Left-most x coordinate
+   @param  y      Left-most y coordinate
+   @param  w      Width in pixels
+   @param  color  Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                               uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Fill a rectangle, optimized for 1-bit canvas. Clipped and
+           rotated once, then filled a byte at a time (masked at edges).
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color) {
+  if (buffer && clipRect(&x, &y, &w, &h)) {
+    canvasRotateRect(rotation, WIDTH, HEIGHT, &x, &y, &w, &h);
+    fillRectRaw(x, y, w, h, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Fill a rectangle in unrotated buffer space. No clipping, all
+           inputs MUST be in-bounds with positive width and height.
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::fillRectRaw(int16_t x, int16_t y, int16_t w, int16_t h,
+                             uint16_t color) {
+  int16_t bytesPerRow = (WIDTH + 7) / 8;
+  uint8_t *row = &buffer[(x / 8) + y * bytesPerRow];
+  uint8_t startBit = x & 7, fill = color ? 0xFF : 0x00, leftMask = 0,
+          rightMask = 0;
+  int16_t midBytes = 0;
+
+  // Precompute edge masks and whole-byte count, same for every row
+  if ((startBit + w) <= 8) { // Span lies within a single byte
+    leftMask = (0xFF >> startBit) & ~(0xFF >> (startBit + w));
+  } else {
+    int16_t n = w;
+    if (startBit) {
+      leftMask = 0xFF >> startBit;
+      n -= 8 - startBit;
+    }
+    midBytes = n / 8;
+    if (n & 7)
+      rightMask = ~(0xFF >> (n & 7));
+  }
+
+  while (h--) {
+    uint8_t *ptr = row;
+    if (leftMask) {
+      if (color)
+        *ptr |= leftMask;
+      else
+        *ptr &= ~leftMask;
+      ptr++;
+    }
+    if (midBytes) {
+      memset(ptr, fill, midBytes);
+      ptr += midBytes;
     }
+    if (rightMask) {
+      if (color)
+        *ptr |= rightMask;
+      else
+        *ptr &= ~rightMask;
+    }
+    row += bytesPerRow;
   }
 }
 
 /**************************************************************************/
 /*!
-    @brief  Reverses the "endian-ness" of each 16-bit pixel within the
-            canvas; little-endian to big-endian, or big-endian to little.
-            Most microcontrollers (such as SAMD) are little-endian, while
-            most displays tend toward big-endianness. All the drawing
-            functions (including RGB bitmap drawing) take care of this
-            automatically, but some specialized code (usually involving
-            DMA) can benefit from having pixel data already in the
-            display-native order. Note that this does NOT convert to a
-            SPECIFIC endian-ness, it just flips the bytes within each word.
+    @brief  Draw a PROGMEM-resident 1-bit image into the canvas, unset bits
+            transparent; same result as Adafruit_GFX::drawBitmap(), copied
+            straight into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Byte array with monochrome bitmap
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  color  Color to draw set bits with
 */
 /**************************************************************************/
-void GFXcanvas16::byteSwap(void) {
-  if (buffer) {
-    uint32_t i, pixels = WIDTH * HEIGHT;
-    for (i = 0; i < pixels; i++)
-      buffer[i] = __builtin_bswap16(buffer[i]);
+void GFXcanvas1::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                            int16_t w, int16_t h, uint16_t color) {
+  GFXblit b;
+  BlitPut1 dst = {buffer};
+  if (buffer && clipBlit(x, y, w, h, ((WIDTH + 7) / 8) * 8, &b))
+    canvasBlit(b, BlitMono<true, false>(bitmap, w, color, 0), dst);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a PROGMEM-resident 1-bit image into the canvas, unset bits in
+            bg; same result as Adafruit_GFX::drawBitmap(), copied straight
+            into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Byte array with monochrome bitmap
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  color  Color to draw set bits with
+    @param  bg     Color to draw unset bits with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                            int16_t w, int16_t h, uint16_t color, uint16_t bg) {
+  GFXblit b;
+  BlitPut1 dst = {buffer};
+  if (buffer && clipBlit(x, y, w, h, ((WIDTH + 7) / 8) * 8, &b))
+    canvasBlit(b, BlitMono<true, true>(bitmap, w, color, bg), dst);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a RAM-resident 1-bit image into the canvas, unset bits
+            transparent; same result as Adafruit_GFX::drawBitmap(), copied
+            straight into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Byte array with monochrome bitmap
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  color  Color to draw set bits with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                            int16_t h, uint16_t color) {
+  GFXblit b;
+  BlitPut1 dst = {buffer};
+  if (buffer && clipBlit(x, y, w, h, ((WIDTH + 7) / 8) * 8, &b))
+    canvasBlit(b, BlitMono<false, false>(bitmap, w, color, 0), dst);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a RAM-resident 1-bit image into the canvas, unset bits in bg;
+            same result as Adafruit_GFX::drawBitmap(), copied straight into
+            the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Byte array with monochrome bitmap
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  color  Color to draw set bits with
+    @param  bg     Color to draw unset bits with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                            int16_t h, uint16_t color, uint16_t bg) {
+  GFXblit b;
+  BlitPut1 dst = {buffer};
+  if (buffer && clipBlit(x, y, w, h, ((WIDTH + 7) / 8) * 8, &b))
+    canvasBlit(b, BlitMono<false, true>(bitmap, w, color, bg), dst);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a RAM-resident image of 8 bits per channel, each pixel set
+            if its luminance reaches half (or, dithered, a threshold from
+            an ordered pattern, giving shades as pixel density), copied
+            straight into the buffer
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Image rows, w pixels each with no padding
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+    @param  format  GFX_RGB888 (the default), GFX_BGR888 or GFX_GRAY8
+    @param  dither  true (the default) for ordered dithering
+*/
+/**************************************************************************/
+void GFXcanvas1::drawRGB888Bitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                  int16_t w, int16_t h, GFXrgbFormat format,
+                                  bool dither) {
+  GFXblit b;
+  BlitPut1 dst = {buffer};
+  if (buffer && clipBlit(x, y, w, h, ((WIDTH + 7) / 8) * 8, &b))
+    canvasBlit(b, BlitRGB888<1>(bitmap, w, x, y, format, dither), dst);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Copy a rectangle of another GFXcanvas1 (or of this one, see
+            copyRect()) into this canvas, buffer contents as they are.
+            Coordinates are each canvas's drawing coordinates, at its own
+            rotation and origin; the source rect is trimmed to its canvas
+            and the destination to this canvas's clip rect.
+    @param  src  Canvas to copy from
+    @param  sx   Left column of source rect
+    @param  sy   Top row of source rect
+    @param  w    Width in pixels
+    @param  h    Height in pixels
+    @param  dx   Left column of destination
+    @param  dy   Top row of destination
+*/
+/**************************************************************************/
+void GFXcanvas1::blit(const GFXcanvas1 *src, int16_t sx, int16_t sy,
+                      int16_t w, int16_t h, int16_t dx, int16_t dy) {
+  if (buffer && src && src->buffer)
+    canvasCopy(src, src->buffer, (src->WIDTH + 7) / 8, buffer, (WIDTH + 7) / 8,
+               1, false, sx, sy, &dx, &dy, &w, &h);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Scroll the canvas, or just the area inside its clip rect (e.g.
+            a text window), moving pixels rather than redrawing them.
+    @param  dx    Columns to move right (negative moves left)
+    @param  dy    Rows to move down (negative moves up)
+    @param  fill  Color for the area uncovered
+*/
+/**************************************************************************/
+void GFXcanvas1::scroll(int16_t dx, int16_t dy, uint16_t fill) {
+  if (buffer)
+    Adafruit_GFX::scroll(dx, dy, fill);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 8-bit canvas context for graphics
+   @param    w   Display width, in pixels
+   @param    h   Display height, in pixels
+*/
+/**************************************************************************/
+GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h)
+    : Adafruit_GFX(w, h), palette(NULL) {
+  uint32_t bytes = w * h;
+  if ((buffer = (uint8_t *)malloc(bytes))) {
+    memset(buffer, 0, bytes);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Delete the canvas, free memory
+*/
+/**************************************************************************/
+GFXcanvas8::~GFXcanvas8(void) {
+  if (buffer)
+    free(buffer);
+  free(palette);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Get the canvas's RGB565 palette, allocating it on first use.
+              Until changed, entry i is pixel value i read as RRRGGGBB
+              ("RGB332") color.
+    @returns  Pointer to the 256 palette entries, which may be changed
+              directly, or NULL if the palette couldn't be allocated
+*/
+/**************************************************************************/
+uint16_t *GFXcanvas8::getPalette(void) {
+  if (!palette && (palette = (uint16_t *)malloc(256 * sizeof(uint16_t)))) {
+    for (uint16_t i = 0; i < 256; i++) {
+      uint8_t r = i >> 5, g = (i >> 2) & 7, b = i & 3;
+      palette[i] = ((r * 31 / 7) << 11) | ((g * 63 / 7) << 5) | (b * 31 / 3);
+    }
+  }
+  return palette;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Set the first count palette entries
+    @param    colors  Array of count RGB565 colors (RAM-resident)
+    @param    count   Number of entries to set, up to 256
+    @returns  true on success, false if the palette couldn't be allocated
+*/
+/**************************************************************************/
+bool GFXcanvas8::setPalette(const uint16_t *colors, uint16_t count) {
+  if (!getPalette())
+    return false;
+  memcpy(palette, colors, ((count < 256) ? count : 256) * sizeof(uint16_t));
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set one palette entry. Pixels already drawn with this index
+            take the new color the next time the canvas is pushed.
+    @param  index  Pixel value, 0-255
+    @param  color  16-bit 5-6-5 Color it's shown as
+*/
+/**************************************************************************/
+void GFXcanvas8::setPaletteColor(uint8_t index, uint16_t color) {
+  if (getPalette())
+    palette[index] = color;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Get one palette entry
+    @param    index  Pixel value, 0-255
+    @returns  16-bit 5-6-5 Color it's shown as (0 if there's no palette)
+*/
+/**************************************************************************/
+uint16_t GFXcanvas8::getPaletteColor(uint8_t index) {
+  return getPalette() ? palette[index] : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Rotate a range of palette entries by one place, each taking the
+            color of the one after it and the last taking the first's: the
+            next push animates whatever was drawn in those indices, with no
+            redrawing. Call each frame for color-cycling effects.
+    @param  first  First index of the range
+    @param  last   Last index of the range (inclusive), greater than first
+                   for cycling one way, less for the other
+*/
+/**************************************************************************/
+void GFXcanvas8::cyclePalette(uint8_t first, uint8_t last) {
+  if ((first == last) || !getPalette())
+    return;
+  if (first < last) {
+    uint16_t c = palette[first];
+    memmove(&palette[first], &palette[first + 1],
+            (last - first) * sizeof(uint16_t));
+    palette[last] = c;
+  } else {
+    uint16_t c = palette[first];
+    memmove(&palette[last + 1], &palette[last],
+            (first - last) * sizeof(uint16_t));
+    palette[last] = c;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a pixel to the canvas framebuffer
+    @param  x   x coordinate
+    @param  y   y coordinate
+    @param  color 16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas8::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (buffer) {
+    if (!clipPixel(&x, &y))
+      return;
+
+    int16_t t;
+    switch (rotation) {
+    case 1:
+      t = x;
+      x = WIDTH - 1 - y;
+      y = t;
+      break;
+    case 2:
+      x = WIDTH - 1 - x;
+      y = HEIGHT - 1 - y;
+      break;
+    case 3:
+      t = x;
+      x = y;
+      y = HEIGHT - 1 - t;
+      break;
+    }
+
+    buffer[x + y * WIDTH] = color;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill the framebuffer completely with one color
+    @param  color 16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas8::fillScreen(uint16_t color) {
+  if (clipActive()) {
+    fillRect(-_originX, -_originY, _width, _height, color);
+  } else if (buffer) {
+    memset(buffer, color, WIDTH * HEIGHT);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a perfectly horizontal line, optimized for 8-bit canvas
+   @param  x      Left-most x coordinate
+   @param  y      Left-most y coordinate
+   @param  w      Width in pixels
+   @param  color  8-bit Color to fill with. Only lower byte of uint16_t is used.
+*/
+/**************************************************************************/
+void GFXcanvas8::writeFastHLine(int16_t x, int16_t y, int16_t w,
+                                uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a perfectly vertical line, optimized for 8-bit canvas
+   @param  x      Top-most x coordinate
+   @param  y      Top-most y coordinate
+   @param  h      Height in pixels
+   @param  color  8-bit Color to fill with. Only lower byte of uint16_t is used.
+*/
+/**************************************************************************/
+void GFXcanvas8::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                               uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a perfectly horizontal line, optimized for 8-bit canvas
+   @param  x      Left-most x coordinate
+   @param  y      Left-most y coordinate
+   @param  w      Width in pixels
+   @param  color  8-bit Color to fill with. Only lower byte of uint16_t is used.
+*/
+/**************************************************************************/
+void GFXcanvas8::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                               uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Fill a rectangle, optimized for 8-bit canvas. Clipped and
+           rotated once, then filled with one memset() per row.
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  8-bit Color to fill with. Only lower byte of uint16_t is used.
+*/
+/**************************************************************************/
+void GFXcanvas8::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color) {
+  if (buffer && clipRect(&x, &y, &w, &h)) {
+    canvasRotateRect(rotation, WIDTH, HEIGHT, &x, &y, &w, &h);
+    fillRectRaw(x, y, w, h, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Fill a rectangle in unrotated buffer space. No clipping, all
+           inputs MUST be in-bounds with positive width and height.
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  8-bit Color to fill with. Only lower byte of uint16_t is used.
+*/
+/**************************************************************************/
+void GFXcanvas8::fillRectRaw(int16_t x, int16_t y, int16_t w, int16_t h,
+                             uint16_t color) {
+  uint8_t *ptr = &buffer[y * WIDTH + x];
+  if (w == WIDTH) { // Full-width rows are contiguous
+    memset(ptr, color, (uint32_t)w * h);
+  } else {
+    while (h--) {
+      memset(ptr, color, w);
+      ptr += WIDTH;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a PROGMEM-resident 1-bit image into the canvas, unset bits
+            transparent; same result as Adafruit_GFX::drawBitmap(), copied
+            straight into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Byte array with monochrome bitmap
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  color  Color to draw set bits with
+*/
+/**************************************************************************/
+void GFXcanvas8::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                            int16_t w, int16_t h, uint16_t color) {
+  GFXblit b;
+  BlitPut8 dst = {buffer};
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b))
+    canvasBlit(b, BlitMono<true, false>(bitmap, w, color, 0), dst);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a PROGMEM-resident 1-bit image into the canvas, unset bits in
+            bg; same result as Adafruit_GFX::drawBitmap(), copied straight
+            into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Byte array with monochrome bitmap
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  color  Color to draw set bits with
+    @param  bg     Color to draw unset bits with
+*/
+/**************************************************************************/
+void GFXcanvas8::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                            int16_t w, int16_t h, uint16_t color, uint16_t bg) {
+  GFXblit b;
+  BlitPut8 dst = {buffer};
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b))
+    canvasBlit(b, BlitMono<true, true>(bitmap, w, color, bg), dst);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a RAM-resident 1-bit image into the canvas, unset bits
+            transparent; same result as Adafruit_GFX::drawBitmap(), copied
+            straight into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Byte array with monochrome bitmap
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  color  Color to draw set bits with
+*/
+/**************************************************************************/
+void GFXcanvas8::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                            int16_t h, uint16_t color) {
+  GFXblit b;
+  BlitPut8 dst = {buffer};
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b))
+    canvasBlit(b, BlitMono<false, false>(bitmap, w, color, 0), dst);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a RAM-resident 1-bit image into the canvas, unset bits in bg;
+            same result as Adafruit_GFX::drawBitmap(), copied straight into
+            the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Byte array with monochrome bitmap
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  color  Color to draw set bits with
+    @param  bg     Color to draw unset bits with
+*/
+/**************************************************************************/
+void GFXcanvas8::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                            int16_t h, uint16_t color, uint16_t bg) {
+  GFXblit b;
+  BlitPut8 dst = {buffer};
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b))
+    canvasBlit(b, BlitMono<false, true>(bitmap, w, color, bg), dst);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a PROGMEM-resident 8-bit image into the canvas; same result
+            as Adafruit_GFX::drawGrayscaleBitmap(), copied straight into the
+            buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Array of 8-bit pixels
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXcanvas8::drawGrayscaleBitmap(int16_t x, int16_t y,
+                                     const uint8_t bitmap[], int16_t w,
+                                     int16_t h) {
+  GFXblit b;
+  BlitPut8 dst = {buffer};
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b))
+    canvasBlit(b, BlitPixels<uint8_t, true, false>(bitmap, NULL, w), dst);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a PROGMEM-resident 8-bit image into the canvas through a 1-bit
+            mask; same result as Adafruit_GFX::drawGrayscaleBitmap(), copied
+            straight into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Array of 8-bit pixels
+    @param  mask   Byte array with monochrome mask bitmap (set bits opaque)
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXcanvas8::drawGrayscaleBitmap(int16_t x, int16_t y,
+                                     const uint8_t bitmap[],
+                                     const uint8_t mask[], int16_t w,
+                                     int16_t h) {
+  GFXblit b;
+  BlitPut8 dst = {buffer};
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b))
+    canvasBlit(b, BlitPixels<uint8_t, true, true>(bitmap, mask, w), dst);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a RAM-resident 8-bit image into the canvas; same result as
+            Adafruit_GFX::drawGrayscaleBitmap(), copied straight into the
+            buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Array of 8-bit pixels
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXcanvas8::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                     int16_t w, int16_t h) {
+  GFXblit b;
+  BlitPut8 dst = {buffer};
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b))
+    canvasBlit(b, BlitPixels<uint8_t, false, false>(bitmap, NULL, w), dst);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a RAM-resident 8-bit image into the canvas through a 1-bit
+            mask; same result as Adafruit_GFX::drawGrayscaleBitmap(), copied
+            straight into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Array of 8-bit pixels
+    @param  mask   Byte array with monochrome mask bitmap (set bits opaque)
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXcanvas8::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                     uint8_t *mask, int16_t w, int16_t h) {
+  GFXblit b;
+  BlitPut8 dst = {buffer};
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b))
+    canvasBlit(b, BlitPixels<uint8_t, false, true>(bitmap, mask, w), dst);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a RAM-resident image of 8 bits per channel as RRRGGGBB
+            (RGB332) pixels, the default palette's colors (see
+            getPalette()), copied straight into the buffer
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Image rows, w pixels each with no padding
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+    @param  format  GFX_RGB888 (the default), GFX_BGR888 or GFX_GRAY8
+    @param  dither  true (the default) for ordered dithering, which 3 bits
+                    of red and green and 2 of blue sorely need
+*/
+/**************************************************************************/
+void GFXcanvas8::drawRGB888Bitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                  int16_t w, int16_t h, GFXrgbFormat format,
+                                  bool dither) {
+  GFXblit b;
+  BlitPut8 dst = {buffer};
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b))
+    canvasBlit(b, BlitRGB888<8>(bitmap, w, x, y, format, dither), dst);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Copy a rectangle of another GFXcanvas8 (or of this one, see
+            copyRect()) into this canvas, buffer contents as they are.
+            Coordinates are each canvas's drawing coordinates, at its own
+            rotation and origin; the source rect is trimmed to its canvas
+            and the destination to this canvas's clip rect.
+    @param  src  Canvas to copy from
+    @param  sx   Left column of source rect
+    @param  sy   Top row of source rect
+    @param  w    Width in pixels
+    @param  h    Height in pixels
+    @param  dx   Left column of destination
+    @param  dy   Top row of destination
+*/
+/**************************************************************************/
+void GFXcanvas8::blit(const GFXcanvas8 *src, int16_t sx, int16_t sy,
+                      int16_t w, int16_t h, int16_t dx, int16_t dy) {
+  if (buffer && src && src->buffer)
+    canvasCopy(src, src->buffer, src->WIDTH, buffer, WIDTH, 8, false, sx, sy,
+               &dx, &dy, &w, &h);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Scroll the canvas, or just the area inside its clip rect (e.g.
+            a text window), moving pixels rather than redrawing them.
+    @param  dx    Columns to move right (negative moves left)
+    @param  dy    Rows to move down (negative moves up)
+    @param  fill  Color for the area uncovered
+*/
+/**************************************************************************/
+void GFXcanvas8::scroll(int16_t dx, int16_t dy, uint16_t fill) {
+  if (buffer)
+    Adafruit_GFX::scroll(dx, dy, fill);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a packed canvas context for graphics
+   @param    w      Display width, in pixels
+   @param    h      Display height, in pixels
+   @param    depth  Bits per pixel, 2 or 4
+*/
+/**************************************************************************/
+GFXcanvasPacked::GFXcanvasPacked(uint16_t w, uint16_t h, uint8_t depth)
+    : Adafruit_GFX(w, h), depth(depth) {
+  uint32_t bytes = (uint32_t)getRowBytes() * h;
+  if ((buffer = (uint8_t *)malloc(bytes))) {
+    memset(buffer, 0, bytes);
+  }
+  // Default palette: even steps of gray from black (0) to white
+  uint8_t max = (1 << depth) - 1;
+  for (uint8_t i = 0; i <= max; i++) {
+    uint8_t level = i * 255 / max;
+    palette[i] = ((level & 0xF8) << 8) | ((level & 0xFC) << 3) | (level >> 3);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Delete the canvas, free memory
+*/
+/**************************************************************************/
+GFXcanvasPacked::~GFXcanvasPacked(void) {
+  if (buffer)
+    free(buffer);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set the first count palette entries
+    @param  colors  Array of count RGB565 colors (RAM-resident)
+    @param  count   Number of entries to set, up to 1 << getDepth()
+*/
+/**************************************************************************/
+void GFXcanvasPacked::setPalette(const uint16_t *colors, uint8_t count) {
+  uint8_t n = 1 << depth;
+  memcpy(palette, colors, ((count < n) ? count : n) * sizeof(uint16_t));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set one palette entry. Pixels already drawn with this index
+            take the new color the next time the canvas is pushed.
+    @param  index  Pixel value, less than 1 << getDepth()
+    @param  color  16-bit 5-6-5 Color it's shown as
+*/
+/**************************************************************************/
+void GFXcanvasPacked::setPaletteColor(uint8_t index, uint16_t color) {
+  palette[index & ((1 << depth) - 1)] = color;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Get one palette entry
+    @param    index  Pixel value, less than 1 << getDepth()
+    @returns  16-bit 5-6-5 Color it's shown as
+*/
+/**************************************************************************/
+uint16_t GFXcanvasPacked::getPaletteColor(uint8_t index) const {
+  return palette[index & ((1 << depth) - 1)];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a pixel to the canvas framebuffer
+    @param  x      x coordinate
+    @param  y      y coordinate
+    @param  color  Palette index to store. Only the low getDepth() bits of
+                   uint16_t are used.
+*/
+/**************************************************************************/
+void GFXcanvasPacked::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (buffer) {
+    if (!clipPixel(&x, &y))
+      return;
+
+    int16_t t;
+    switch (rotation) {
+    case 1:
+      t = x;
+      x = WIDTH - 1 - y;
+      y = t;
+      break;
+    case 2:
+      x = WIDTH - 1 - x;
+      y = HEIGHT - 1 - y;
+      break;
+    case 3:
+      t = x;
+      x = y;
+      y = HEIGHT - 1 - t;
+      break;
+    }
+
+    uint16_t bit = x * depth;
+    uint8_t *ptr = &buffer[(bit / 8) + y * getRowBytes()];
+    uint8_t shift = 8 - depth - (bit & 7), mask = ((1 << depth) - 1) << shift;
+    *ptr = (*ptr & ~mask) | ((color << shift) & mask);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Read back a pixel of the canvas
+    @param    x  x coordinate, relative to the drawing origin like drawPixel()
+    @param    y  y coordinate
+    @returns  Palette index of the pixel, or 0 if off the canvas
+*/
+/**************************************************************************/
+uint16_t GFXcanvasPacked::getPixel(int16_t x, int16_t y) const {
+  x += _originX;
+  y += _originY;
+  if (!buffer || (x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    return 0;
+
+  int16_t t;
+  switch (rotation) {
+  case 1:
+    t = x;
+    x = WIDTH - 1 - y;
+    y = t;
+    break;
+  case 2:
+    x = WIDTH - 1 - x;
+    y = HEIGHT - 1 - y;
+    break;
+  case 3:
+    t = x;
+    x = y;
+    y = HEIGHT - 1 - t;
+    break;
+  }
+
+  uint16_t bit = x * depth;
+  return (buffer[(bit / 8) + y * getRowBytes()] >> (8 - depth - (bit & 7))) &
+         ((1 << depth) - 1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill the framebuffer completely with one color
+    @param  color  Palette index to fill with
+*/
+/**************************************************************************/
+void GFXcanvasPacked::fillScreen(uint16_t color) {
+  if (clipActive()) {
+    fillRect(-_originX, -_originY, _width, _height, color);
+  } else if (buffer) {
+    color &= (1 << depth) - 1;
+    memset(buffer, color * ((depth == 4) ? 0x11 : 0x55),
+           (uint32_t)getRowBytes() * HEIGHT);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a perfectly horizontal line, optimized for packed canvas
+   @param  x      Left-most x coordinate
+   @param  y      Left-most y coordinate
+   @param  w      Width in pixels
+   @param  color  Palette index to fill with
+*/
+/**************************************************************************/
+void GFXcanvasPacked::writeFastHLine(int16_t x, int16_t y, int16_t w,
+                                     uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a perfectly vertical line, optimized for packed canvas
+   @param  x      Top-most x coordinate
+   @param  y      Top-most y coordinate
+   @param  h      Height in pixels
+   @param  color  Palette index to fill with
+*/
+/**************************************************************************/
+void GFXcanvasPacked::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                    uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a perfectly horizontal line, optimized for packed canvas
+   @param  x      Left-most x coordinate
+   @param  y      Left-most y coordinate
+   @param  w      Width in pixels
+   @param  color  Palette index to fill with
+*/
+/**************************************************************************/
+void GFXcanvasPacked::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                    uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Fill a rectangle, optimized for packed canvas. Clipped and
+           rotated once, then filled a byte at a time (masked at edges).
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  Palette index to fill with
+*/
+/**************************************************************************/
+void GFXcanvasPacked::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                               uint16_t color) {
+  if (buffer && clipRect(&x, &y, &w, &h)) {
+    canvasRotateRect(rotation, WIDTH, HEIGHT, &x, &y, &w, &h);
+    fillRectRaw(x, y, w, h, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Fill a rectangle in unrotated buffer space. No clipping, all
+           inputs MUST be in-bounds with positive width and height.
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  Palette index to fill with
+*/
+/**************************************************************************/
+void GFXcanvasPacked::fillRectRaw(int16_t x, int16_t y, int16_t w, int16_t h,
+                                  uint16_t color) {
+  // Same as GFXcanvas1::fillRectRaw() with the span measured in bits, and
+  // edge bytes merged with a pattern of the color rather than set/cleared
+  uint16_t bytesPerRow = getRowBytes(), bit = x * depth, bits = w * depth;
+  uint8_t *row = &buffer[(bit / 8) + y * bytesPerRow];
+  uint8_t startBit = bit & 7, leftMask = 0, rightMask = 0,
+          fill = (color & ((1 << depth) - 1)) * ((depth == 4) ? 0x11 : 0x55);
+  uint16_t midBytes = 0;
+
+  if ((startBit + bits) <= 8) { // Span lies within a single byte
+    leftMask = (0xFF >> startBit) & ~(0xFF >> (startBit + bits));
+  } else {
+    uint16_t n = bits;
+    if (startBit) {
+      leftMask = 0xFF >> startBit;
+      n -= 8 - startBit;
+    }
+    midBytes = n / 8;
+    if (n & 7)
+      rightMask = ~(0xFF >> (n & 7));
+  }
+
+  while (h--) {
+    uint8_t *ptr = row;
+    if (leftMask) {
+      *ptr = (*ptr & ~leftMask) | (fill & leftMask);
+      ptr++;
+    }
+    if (midBytes) {
+      memset(ptr, fill, midBytes);
+      ptr += midBytes;
+    }
+    if (rightMask)
+      *ptr = (*ptr & ~rightMask) | (fill & rightMask);
+    row += bytesPerRow;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Copy a rectangle of another canvas of the same depth (or of
+            this one, see copyRect()) into this canvas, buffer contents as
+            they are.
+            Coordinates are each canvas's drawing coordinates, at its own
+            rotation and origin; the source rect is trimmed to its canvas
+            and the destination to this canvas's clip rect.
+    @param  src  Canvas to copy from
+    @param  sx   Left column of source rect
+    @param  sy   Top row of source rect
+    @param  w    Width in pixels
+    @param  h    Height in pixels
+    @param  dx   Left column of destination
+    @param  dy   Top row of destination
+*/
+/**************************************************************************/
+void GFXcanvasPacked::blit(const GFXcanvasPacked *src, int16_t sx,
+                           int16_t sy, int16_t w, int16_t h, int16_t dx,
+                           int16_t dy) {
+  if (buffer && src && src->buffer && (src->depth == depth))
+    canvasCopy(src, src->buffer, src->getRowBytes(), buffer, getRowBytes(),
+               depth, false, sx, sy, &dx, &dy, &w, &h);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Scroll the canvas, or just the area inside its clip rect (e.g.
+            a text window), moving pixels rather than redrawing them.
+    @param  dx    Columns to move right (negative moves left)
+    @param  dy    Rows to move down (negative moves up)
+    @param  fill  Color for the area uncovered
+*/
+/**************************************************************************/
+void GFXcanvasPacked::scroll(int16_t dx, int16_t dy, uint16_t fill) {
+  if (buffer)
+    Adafruit_GFX::scroll(dx, dy, fill);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 16-bit canvas context for graphics
+   @param    w          Display width, in pixels
+   @param    h          Display height, in pixels
+   @param    bigEndian  If true, pixels are stored byte-swapped, i.e. in
+                        the big-endian order most displays expect, so the
+                        buffer can be sent (e.g. by DMA) without a copy or
+                        byteSwap() pass. Drawing functions still take
+                        normal 16-bit 5-6-5 colors.
+*/
+/**************************************************************************/
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h, bool bigEndian)
+    : Adafruit_GFX(w, h), bigEndian(bigEndian) {
+  uint32_t bytes = w * h * 2;
+  if ((buffer = (uint16_t *)malloc(bytes))) {
+    memset(buffer, 0, bytes);
+  }
+  dirtyTracking = false;
+  dirtyCount = 0;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Delete the canvas, free memory
+*/
+/**************************************************************************/
+GFXcanvas16::~GFXcanvas16(void) {
+  if (buffer)
+    free(buffer);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a pixel to the canvas framebuffer
+    @param  x   x coordinate
+    @param  y   y coordinate
+    @param  color 16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (buffer) {
+    if (!clipPixel(&x, &y))
+      return;
+
+    int16_t t;
+    switch (rotation) {
+    case 1:
+      t = x;
+      x = WIDTH - 1 - y;
+      y = t;
+      break;
+    case 2:
+      x = WIDTH - 1 - x;
+      y = HEIGHT - 1 - y;
+      break;
+    case 3:
+      t = x;
+      x = y;
+      y = HEIGHT - 1 - t;
+      break;
+    }
+
+    buffer[x + y * WIDTH] = bigEndian ? __builtin_bswap16(color) : color;
+    if (dirtyTracking)
+      addDirty(x, y, x, y);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Read back a pixel of the canvas
+    @param    x  x coordinate, relative to the drawing origin like drawPixel()
+    @param    y  y coordinate
+    @returns  16-bit 5-6-5 color (in native order, even if the canvas is
+              big-endian), or 0 if off the canvas
+*/
+/**************************************************************************/
+uint16_t GFXcanvas16::getPixel(int16_t x, int16_t y) const {
+  x += _originX;
+  y += _originY;
+  if (!buffer || (x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    return 0;
+
+  int16_t t;
+  switch (rotation) {
+  case 1:
+    t = x;
+    x = WIDTH - 1 - y;
+    y = t;
+    break;
+  case 2:
+    x = WIDTH - 1 - x;
+    y = HEIGHT - 1 - y;
+    break;
+  case 3:
+    t = x;
+    x = y;
+    y = HEIGHT - 1 - t;
+    break;
+  }
+
+  uint16_t c = buffer[x + y * WIDTH];
+  return bigEndian ? __builtin_bswap16(c) : c;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Blend a partially covered pixel with what's in the canvas
+    @param  x      x coordinate
+    @param  y      y coordinate
+    @param  color  16-bit 5-6-5 color at full coverage
+    @param  bg     Unused, the canvas' own pixel is the background
+    @param  alpha  Coverage, 0 (nothing drawn) to 255 (color)
+*/
+/**************************************************************************/
+void GFXcanvas16::blendPixel(int16_t x, int16_t y, uint16_t color,
+                             uint16_t bg, uint8_t alpha) {
+  if (alpha == 255)
+    drawPixel(x, y, color);
+  else if (alpha)
+    drawPixel(x, y, blend565(color, getPixel(x, y), alpha));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill the framebuffer completely with one color
+    @param  color 16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::fillScreen(uint16_t color) {
+  if (clipActive()) {
+    fillRect(-_originX, -_originY, _width, _height, color);
+  } else if (buffer) {
+    if (dirtyTracking)
+      addDirty(0, 0, WIDTH - 1, HEIGHT - 1);
+    if (bigEndian)
+      color = __builtin_bswap16(color);
+    gfxFill565(buffer, color, (uint32_t)WIDTH * HEIGHT);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a perfectly vertical line, optimized for 16-bit canvas
+   @param  x      Top-most x coordinate
+   @param  y      Top-most y coordinate
+   @param  h      Height in pixels
+   @param  color  16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a perfectly horizontal line, optimized for 16-bit canvas
+   @param  x      Left-most x coordinate
+   @param  y      Left-most y coordinate
+   @param  w      Width in pixels
+   @param  color  16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Fill a rectangle, optimized for 16-bit canvas. Clipped and
+           rotated once, then filled a word (or two) at a time per row.
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                           uint16_t color) {
+  if (buffer && clipRect(&x, &y, &w, &h)) {
+    canvasRotateRect(rotation, WIDTH, HEIGHT, &x, &y, &w, &h);
+    fillRectRaw(x, y, w, h, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Fill a rectangle in unrotated buffer space. No clipping, all
+           inputs MUST be in-bounds with positive width and height.
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::fillRectRaw(int16_t x, int16_t y, int16_t w, int16_t h,
+                              uint16_t color) {
+  if (dirtyTracking)
+    addDirty(x, y, x + w - 1, y + h - 1);
+  if (bigEndian)
+    color = __builtin_bswap16(color);
+  uint16_t *ptr = &buffer[y * WIDTH + x];
+  if (w == WIDTH) { // Full-width rows are contiguous
+    gfxFill565(ptr, color, (uint32_t)w * h);
+  } else {
+    while (h--) {
+      gfxFill565(ptr, color, w);
+      ptr += WIDTH;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a PROGMEM-resident 1-bit image into the canvas, unset bits
+            transparent; same result as Adafruit_GFX::drawBitmap(), copied
+            straight into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Byte array with monochrome bitmap
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  color  Color to draw set bits with
+*/
+/**************************************************************************/
+void GFXcanvas16::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                             int16_t w, int16_t h, uint16_t color) {
+  GFXblit b;
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b)) {
+    canvasBlit16(buffer, bigEndian, b,
+                 BlitMono<true, false>(bitmap, w, color, 0));
+    addDirtyBlit(b);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a PROGMEM-resident 1-bit image into the canvas, unset bits in
+            bg; same result as Adafruit_GFX::drawBitmap(), copied straight
+            into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Byte array with monochrome bitmap
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  color  Color to draw set bits with
+    @param  bg     Color to draw unset bits with
+*/
+/**************************************************************************/
+void GFXcanvas16::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                             int16_t w, int16_t h, uint16_t color,
+                             uint16_t bg) {
+  GFXblit b;
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b)) {
+    canvasBlit16(buffer, bigEndian, b,
+                 BlitMono<true, true>(bitmap, w, color, bg));
+    addDirtyBlit(b);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a RAM-resident 1-bit image into the canvas, unset bits
+            transparent; same result as Adafruit_GFX::drawBitmap(), copied
+            straight into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Byte array with monochrome bitmap
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  color  Color to draw set bits with
+*/
+/**************************************************************************/
+void GFXcanvas16::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                             int16_t h, uint16_t color) {
+  GFXblit b;
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b)) {
+    canvasBlit16(buffer, bigEndian, b,
+                 BlitMono<false, false>(bitmap, w, color, 0));
+    addDirtyBlit(b);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a RAM-resident 1-bit image into the canvas, unset bits in bg;
+            same result as Adafruit_GFX::drawBitmap(), copied straight into
+            the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Byte array with monochrome bitmap
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  color  Color to draw set bits with
+    @param  bg     Color to draw unset bits with
+*/
+/**************************************************************************/
+void GFXcanvas16::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                             int16_t h, uint16_t color, uint16_t bg) {
+  GFXblit b;
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b)) {
+    canvasBlit16(buffer, bigEndian, b,
+                 BlitMono<false, true>(bitmap, w, color, bg));
+    addDirtyBlit(b);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a PROGMEM-resident 16-bit image into the canvas; same result
+            as Adafruit_GFX::drawRGBBitmap(), copied straight into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Array of 16-bit color pixels
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXcanvas16::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
+                                int16_t w, int16_t h) {
+  GFXblit b;
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b)) {
+    canvasBlit16(buffer, bigEndian, b,
+                 BlitPixels<uint16_t, true, false>(bitmap, NULL, w));
+    addDirtyBlit(b);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a PROGMEM-resident 16-bit image into the canvas through a 1-bit
+            mask; same result as Adafruit_GFX::drawRGBBitmap(), copied straight
+            into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Array of 16-bit color pixels
+    @param  mask   Byte array with monochrome mask bitmap (set bits opaque)
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXcanvas16::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
+                                const uint8_t mask[], int16_t w, int16_t h) {
+  GFXblit b;
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b)) {
+    canvasBlit16(buffer, bigEndian, b,
+                 BlitPixels<uint16_t, true, true>(bitmap, mask, w));
+    addDirtyBlit(b);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a RAM-resident 16-bit image into the canvas; same result as
+            Adafruit_GFX::drawRGBBitmap(), copied straight into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Array of 16-bit color pixels
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXcanvas16::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
+                                int16_t w, int16_t h) {
+  GFXblit b;
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b)) {
+    canvasBlit16(buffer, bigEndian, b,
+                 BlitPixels<uint16_t, false, false>(bitmap, NULL, w));
+    addDirtyBlit(b);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a RAM-resident 16-bit image into the canvas through a 1-bit
+            mask; same result as Adafruit_GFX::drawRGBBitmap(), copied straight
+            into the buffer
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Array of 16-bit color pixels
+    @param  mask   Byte array with monochrome mask bitmap (set bits opaque)
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXcanvas16::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
+                                uint8_t *mask, int16_t w, int16_t h) {
+  GFXblit b;
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b)) {
+    canvasBlit16(buffer, bigEndian, b,
+                 BlitPixels<uint16_t, false, true>(bitmap, mask, w));
+    addDirtyBlit(b);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a RAM-resident image of 8 bits per channel, converted to
+            5-6-5 straight into the buffer
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Image rows, w pixels each with no padding
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+    @param  format  GFX_RGB888 (the default), GFX_BGR888 or GFX_GRAY8
+    @param  dither  true (the default) for ordered dithering
+*/
+/**************************************************************************/
+void GFXcanvas16::drawRGB888Bitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                   int16_t w, int16_t h, GFXrgbFormat format,
+                                   bool dither) {
+  GFXblit b;
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b)) {
+    canvasBlit16(buffer, bigEndian, b,
+                 BlitRGB888<16>(bitmap, w, x, y, format, dither));
+    addDirtyBlit(b);
+  }
+}
+
+// Alpha blending in GFXcanvas16. Each color's fields are spread apart with
+// headroom above each, so one multiply scales several at once: at 5-bit
+// alpha R, G and B all fit one 32-bit word (as in blend565()), at 8-bit
+// alpha R and B share a word and G has its own.
+
+static inline uint32_t alphaSpreadRB(uint16_t c) {
+  return (c & 0x001F) | ((uint32_t)(c & 0xF800) << 5);
+}
+
+// Repack R+B and G words that carry 8 bits of alpha scaling
+static inline uint16_t alphaJoin(uint32_t rb, uint32_t g) {
+  rb >>= 8;
+  return (rb & 0x001F) | ((rb >> 5) & 0xF800) | ((g >> 8) & 0x07E0);
+}
+
+// 8-bit counterpart of blend565(), a from 0 (all bg) to 256 (all fg)
+static inline uint16_t blend565Fine(uint16_t fg, uint16_t bg, uint16_t a) {
+  return alphaJoin(alphaSpreadRB(fg) * a + alphaSpreadRB(bg) * (256 - a),
+                   (uint32_t)(fg & 0x07E0) * a +
+                       (uint32_t)(bg & 0x07E0) * (256 - a));
+}
+
+template <bool Fast>
+static inline uint16_t alphaBlend(uint16_t fg, uint16_t bg, uint8_t alpha) {
+  return Fast ? Adafruit_GFX::blend565(fg, bg, alpha)
+              : blend565Fine(fg, bg, alpha + (alpha >> 7));
+}
+
+// Blends pixels toward one color, whose weighted share is worked out up
+// front, leaving one multiply per pixel (Fast) or two
+template <bool Fast> struct BlendConst {
+  uint32_t frb, fg6;
+  uint16_t ia;
+  BlendConst(uint16_t fg, uint8_t alpha) {
+    if (Fast) {
+      uint16_t a = (alpha + 4) >> 3;
+      frb = ((fg | ((uint32_t)fg << 16)) & 0x07E0F81F) * a;
+      ia = 32 - a;
+    } else {
+      uint16_t a = alpha + (alpha >> 7);
+      frb = alphaSpreadRB(fg) * a;
+      fg6 = (uint32_t)(fg & 0x07E0) * a;
+      ia = 256 - a;
+    }
+  }
+  uint16_t blend(uint16_t bg) const {
+    if (Fast) {
+      uint32_t b = (bg | ((uint32_t)bg << 16)) & 0x07E0F81F,
+               r = ((frb + b * ia) >> 5) & 0x07E0F81F;
+      return r | (r >> 16);
+    }
+    return alphaJoin(frb + alphaSpreadRB(bg) * ia,
+                     fg6 + (uint32_t)(bg & 0x07E0) * ia);
+  }
+};
+
+// Blend a rect of unrotated buffer rows toward color
+template <bool Fast>
+static void canvasBlendRect(uint16_t *ptr, int16_t stride, int32_t w,
+                            int16_t h, bool bigEndian, uint16_t color,
+                            uint8_t alpha) {
+  BlendConst<Fast> k(color, alpha);
+  if (w == stride) { // Full-width rows are contiguous
+    w *= h;
+    h = 1;
+  }
+  for (; h--; ptr += stride) {
+    uint16_t *p = ptr;
+    if (bigEndian) {
+      for (int32_t i = w; i--; p++)
+        *p = __builtin_bswap16(k.blend(__builtin_bswap16(*p)));
+    } else {
+      for (int32_t i = w; i--; p++)
+        *p = k.blend(*p);
+    }
+  }
+}
+
+// Source of 16-bit pixels with one alpha for all, or (Map) each with its
+// own from an 8-bit alpha map laid out like the bitmap. get() fetches a
+// pixel and returns its alpha.
+template <bool Pgm, bool Map> struct BlitAlpha {
+  const uint16_t *bitmap, *line;
+  const uint8_t *amap, *aline;
+  int16_t w;
+  uint8_t alpha;
+  BlitAlpha(const uint16_t *b, const uint8_t *m, int16_t w, uint8_t alpha)
+      : bitmap(b), line(b), amap(m), aline(m), w(w), alpha(alpha) {}
+  void row(int16_t j) {
+    line = &bitmap[(int32_t)j * w];
+    if (Map)
+      aline = &amap[(int32_t)j * w];
+  }
+  uint8_t get(int16_t i, uint16_t *c) {
+    uint8_t a = Map ? blitRead(&aline[i], Pgm) : alpha;
+    if (a)
+      *c = blitRead(&line[i], Pgm);
+    return a;
+  }
+};
+
+// Counterpart of canvasBlit16() that blends each pixel with the buffer
+template <bool Fast, class Src>
+static void canvasBlend(uint16_t *buf, bool bigEndian, const GFXblit &b,
+                        Src src) {
+  int32_t row = b.base;
+  for (int16_t j = b.j0; j < b.j1; j++, row += b.stepY) {
+    src.row(j);
+    int32_t d = row;
+    for (int16_t i = b.i0; i < b.i1; i++, d += b.stepX) {
+      uint16_t c;
+      uint8_t a = src.get(i, &c);
+      if (!a)
+        continue;
+      if (a != 255) {
+        uint16_t bg = bigEndian ? __builtin_bswap16(buf[d]) : buf[d];
+        c = alphaBlend<Fast>(c, bg, a);
+      }
+      buf[d] = bigEndian ? __builtin_bswap16(c) : c;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Blend a rectangle of one color over the canvas, e.g. to darken
+           or tint an area, or (repeated over the whole canvas) fade it
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  16-bit 5-6-5 Color to blend in
+   @param  alpha  Opacity, 0 (canvas unchanged) to 255 (same as fillRect())
+   @param  fast   true to blend at 5-bit alpha, one multiply per pixel;
+                  false (default) for full 8-bit alpha, two multiplies
+*/
+/**************************************************************************/
+void GFXcanvas16::fillRectAlpha(int16_t x, int16_t y, int16_t w, int16_t h,
+                                uint16_t color, uint8_t alpha, bool fast) {
+  if (alpha == 255) {
+    fillRect(x, y, w, h, color);
+  } else if (alpha && buffer && clipRect(&x, &y, &w, &h)) {
+    canvasRotateRect(rotation, WIDTH, HEIGHT, &x, &y, &w, &h);
+    if (dirtyTracking)
+      addDirty(x, y, x + w - 1, y + h - 1);
+    uint16_t *ptr = &buffer[y * WIDTH + x];
+    if (fast)
+      canvasBlendRect<true>(ptr, WIDTH, w, h, bigEndian, color, alpha);
+    else
+      canvasBlendRect<false>(ptr, WIDTH, w, h, bigEndian, color, alpha);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Blend a PROGMEM-resident 16-bit image over the canvas at one
+            opacity
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Array of 16-bit color pixels
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  alpha  Opacity, 0 (canvas unchanged) to 255 (as drawRGBBitmap())
+    @param  fast   true to blend at 5-bit alpha, false (default) at 8-bit
+*/
+/**************************************************************************/
+void GFXcanvas16::drawRGBBitmapAlpha(int16_t x, int16_t y,
+                                     const uint16_t bitmap[], int16_t w,
+                                     int16_t h, uint8_t alpha, bool fast) {
+  GFXblit b;
+  if (alpha == 255) {
+    drawRGBBitmap(x, y, bitmap, w, h);
+  } else if (alpha && buffer && clipBlit(x, y, w, h, WIDTH, &b)) {
+    BlitAlpha<true, false> src(bitmap, NULL, w, alpha);
+    if (fast)
+      canvasBlend<true>(buffer, bigEndian, b, src);
+    else
+      canvasBlend<false>(buffer, bigEndian, b, src);
+    addDirtyBlit(b);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Blend a RAM-resident 16-bit image over the canvas at one
+            opacity
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Array of 16-bit color pixels
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  alpha  Opacity, 0 (canvas unchanged) to 255 (as drawRGBBitmap())
+    @param  fast   true to blend at 5-bit alpha, false (default) at 8-bit
+*/
+/**************************************************************************/
+void GFXcanvas16::drawRGBBitmapAlpha(int16_t x, int16_t y, uint16_t *bitmap,
+                                     int16_t w, int16_t h, uint8_t alpha,
+                                     bool fast) {
+  GFXblit b;
+  if (alpha == 255) {
+    drawRGBBitmap(x, y, bitmap, w, h);
+  } else if (alpha && buffer && clipBlit(x, y, w, h, WIDTH, &b)) {
+    BlitAlpha<false, false> src(bitmap, NULL, w, alpha);
+    if (fast)
+      canvasBlend<true>(buffer, bigEndian, b, src);
+    else
+      canvasBlend<false>(buffer, bigEndian, b, src);
+    addDirtyBlit(b);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Blend a PROGMEM-resident 16-bit image over the canvas through
+            a per-pixel 8-bit alpha map, e.g. for anti-aliased edges or
+            soft shadows
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Array of 16-bit color pixels
+    @param  alpha  Array (PROGMEM) of one opacity byte per pixel, laid out
+                   like the bitmap, 0 transparent to 255 opaque
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  fast   true to blend at 5-bit alpha, false (default) at 8-bit
+*/
+/**************************************************************************/
+void GFXcanvas16::drawRGBBitmapAlpha(int16_t x, int16_t y,
+                                     const uint16_t bitmap[],
+                                     const uint8_t alpha[], int16_t w,
+                                     int16_t h, bool fast) {
+  GFXblit b;
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b)) {
+    BlitAlpha<true, true> src(bitmap, alpha, w, 0);
+    if (fast)
+      canvasBlend<true>(buffer, bigEndian, b, src);
+    else
+      canvasBlend<false>(buffer, bigEndian, b, src);
+    addDirtyBlit(b);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Blend a RAM-resident 16-bit image over the canvas through a
+            per-pixel 8-bit alpha map
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  bitmap Array of 16-bit color pixels
+    @param  alpha  Array of one opacity byte per pixel, laid out like the
+                   bitmap, 0 transparent to 255 opaque
+    @param  w      Width of bitmap in pixels
+    @param  h      Height of bitmap in pixels
+    @param  fast   true to blend at 5-bit alpha, false (default) at 8-bit
+*/
+/**************************************************************************/
+void GFXcanvas16::drawRGBBitmapAlpha(int16_t x, int16_t y, uint16_t *bitmap,
+                                     uint8_t *alpha, int16_t w, int16_t h,
+                                     bool fast) {
+  GFXblit b;
+  if (buffer && clipBlit(x, y, w, h, WIDTH, &b)) {
+    BlitAlpha<false, true> src(bitmap, alpha, w, 0);
+    if (fast)
+      canvasBlend<true>(buffer, bigEndian, b, src);
+    else
+      canvasBlend<false>(buffer, bigEndian, b, src);
+    addDirtyBlit(b);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Copy a rectangle of another GFXcanvas16 (or of this one, see
+            copyRect()) into this canvas, byte-swapped if the two differ
+            in endianness. Coordinates are each canvas's drawing
+            coordinates, at its own rotation and origin; the source rect
+            is trimmed to its canvas and the destination to this canvas's
+            clip rect. The destination is marked dirty.
+    @param  src  Canvas to copy from
+    @param  sx   Left column of source rect
+    @param  sy   Top row of source rect
+    @param  w    Width in pixels
+    @param  h    Height in pixels
+    @param  dx   Left column of destination
+    @param  dy   Top row of destination
+*/
+/**************************************************************************/
+void GFXcanvas16::blit(const GFXcanvas16 *src, int16_t sx, int16_t sy,
+                       int16_t w, int16_t h, int16_t dx, int16_t dy) {
+  if (buffer && src && src->buffer &&
+      canvasCopy(src, (const uint8_t *)src->buffer, src->WIDTH * 2,
+                 (uint8_t *)buffer, WIDTH * 2, 16,
+                 src->bigEndian != bigEndian, sx, sy, &dx, &dy, &w, &h))
+    markDirty(dx, dy, w, h);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Scroll the canvas, or just the area inside its clip rect (e.g.
+            a text window), moving pixels rather than redrawing them. The
+            whole area is marked dirty.
+    @param  dx    Columns to move right (negative moves left)
+    @param  dy    Rows to move down (negative moves up)
+    @param  fill  Color for the area uncovered
+*/
+/**************************************************************************/
+void GFXcanvas16::scroll(int16_t dx, int16_t dy, uint16_t fill) {
+  if (buffer) {
+    Adafruit_GFX::scroll(dx, dy, fill);
+    int16_t x, y, w, h;
+    getClipRect(&x, &y, &w, &h);
+    markDirty(x, y, w, h);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Reverses the "endian-ness" of each 16-bit pixel within the
+            canvas; little-endian to big-endian, or big-endian to little.
+            Most microcontrollers (such as SAMD) are little-endian, while
+            most displays tend toward big-endianness. All the drawing
+            functions (including RGB bitmap drawing) take care of this
+            automatically, but some specialized code (usually involving
+            DMA) can benefit from having pixel data already in the
+            display-native order. Note that this does NOT convert to a
+            SPECIFIC endian-ness, it just flips the bytes within each word.
+            Canvases constructed with bigEndian set are already in display
+            order and don't need this.
+*/
+/**************************************************************************/
+void GFXcanvas16::byteSwap(void) {
+  if (buffer) {
+    gfxSwap565(buffer, buffer, (uint32_t)WIDTH * HEIGHT);
+    if (dirtyTracking)
+      addDirty(0, 0, WIDTH - 1, HEIGHT - 1);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Enable or disable dirty-rectangle tracking. While enabled, the
+            canvas records the areas changed by drawing operations (as a
+            short list of bounding boxes) so that only those areas need to
+            be pushed to a display, e.g. with Adafruit_SPITFT::flushCanvas().
+            Enabling marks the whole canvas dirty, since its contents have
+            not been pushed anywhere yet.
+    @param  enable  true to track changed areas, false to stop tracking.
+*/
+/**************************************************************************/
+void GFXcanvas16::setDirtyTracking(boolean enable) {
+  dirtyTracking = enable;
+  if (enable)
+    addDirty(0, 0, WIDTH - 1, HEIGHT - 1);
+  else
+    dirtyCount = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Explicitly mark an area of the canvas as changed, for code that
+            writes to getBuffer() directly. Ignored if tracking is disabled.
+    @param  x  Top left corner x coordinate (at current rotation)
+    @param  y  Top left corner y coordinate (at current rotation)
+    @param  w  Width in pixels
+    @param  h  Height in pixels
+*/
+/**************************************************************************/
+void GFXcanvas16::markDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (!dirtyTracking || (w <= 0) || (h <= 0))
+    return;
+  int16_t x2 = x + w - 1, y2 = y + h - 1;
+  // Clip to canvas
+  if (x < 0)
+    x = 0;
+  if (y < 0)
+    y = 0;
+  if (x2 >= _width)
+    x2 = _width - 1;
+  if (y2 >= _height)
+    y2 = _height - 1;
+  if ((x > x2) || (y > y2))
+    return;
+
+  // Rotate both corners into buffer space, then re-sort
+  int16_t t;
+  switch (rotation) {
+  case 1:
+    t = x;
+    x = WIDTH - 1 - y;
+    y = t;
+    t = x2;
+    x2 = WIDTH - 1 - y2;
+    y2 = t;
+    break;
+  case 2:
+    x = WIDTH - 1 - x;
+    y = HEIGHT - 1 - y;
+    x2 = WIDTH - 1 - x2;
+    y2 = HEIGHT - 1 - y2;
+    break;
+  case 3:
+    t = x;
+    x = y;
+    y = HEIGHT - 1 - t;
+    t = x2;
+    x2 = y2;
+    y2 = HEIGHT - 1 - t;
+    break;
+  }
+  if (x > x2)
+    _swap_int16_t(x, x2);
+  if (y > y2)
+    _swap_int16_t(y, y2);
+  addDirty(x, y, x2, y2);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Retrieve one of the recorded dirty rectangles. Coordinates are
+            in the canvas' unrotated buffer space (the same space as
+            getBuffer(), with a scanline stride of the canvas' rotation-0
+            width), which is what a display push needs.
+    @param  i  Index of rectangle, 0 to getDirtyCount() - 1
+    @param  x  Pointer to receive left edge
+    @param  y  Pointer to receive top edge
+    @param  w  Pointer to receive width in pixels
+    @param  h  Pointer to receive height in pixels
+    @returns   true if the rectangle exists, false if index out of range
+*/
+/**************************************************************************/
+boolean GFXcanvas16::getDirtyRect(uint8_t i, int16_t *x, int16_t *y,
+                                  int16_t *w, int16_t *h) const {
+  if (i >= dirtyCount)
+    return false;
+  *x = dirty[i].x1;
+  *y = dirty[i].y1;
+  *w = dirty[i].x2 - dirty[i].x1 + 1;
+  *h = dirty[i].y2 - dirty[i].y1 + 1;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Record the buffer area a bitmap copy wrote, if tracking
+    @param  b  The copy's walk, as set up by clipBlit()
+*/
+/**************************************************************************/
+void GFXcanvas16::addDirtyBlit(const GFXblit &b) {
+  if (!dirtyTracking)
+    return;
+  int32_t a = b.base, z = b.base + (int32_t)(b.i1 - b.i0 - 1) * b.stepX +
+                          (int32_t)(b.j1 - b.j0 - 1) * b.stepY;
+  int16_t ax = a % WIDTH, ay = a / WIDTH, zx = z % WIDTH, zy = z / WIDTH;
+  addDirty(min(ax, zx), min(ay, zy), max(ax, zx), max(ay, zy));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Add an area (unrotated buffer coordinates, inclusive corners,
+            already clipped) to the dirty list. Merges with an existing
+            rectangle it overlaps or touches; otherwise takes a free slot;
+            if the list is full, merges with whichever rectangle grows the
+            least as a result.
+    @param  x1  Left edge
+    @param  y1  Top edge
+    @param  x2  Right edge
+    @param  y2  Bottom edge
+*/
+/**************************************************************************/
+void GFXcanvas16::addDirty(int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+  uint8_t i, best = 0;
+  for (i = 0; i < dirtyCount; i++) {
+    if ((x1 <= dirty[i].x2 + 1) && (x2 >= dirty[i].x1 - 1) &&
+        (y1 <= dirty[i].y2 + 1) && (y2 >= dirty[i].y1 - 1))
+      break; // Overlaps or abuts this one
+  }
+  if (i == dirtyCount) {
+    if (dirtyCount < GFXCANVAS_MAX_DIRTY) {
+      dirty[dirtyCount].x1 = x1;
+      dirty[dirtyCount].y1 = y1;
+      dirty[dirtyCount].x2 = x2;
+      dirty[dirtyCount].y2 = y2;
+      dirtyCount++;
+      return;
+    }
+    // List full, find cheapest merge
+    int32_t bestGrowth = 0x7FFFFFFF;
+    for (i = 0; i < dirtyCount; i++) {
+      int32_t ux1 = min(x1, dirty[i].x1), uy1 = min(y1, dirty[i].y1),
+              ux2 = max(x2, dirty[i].x2), uy2 = max(y2, dirty[i].y2),
+              growth = (ux2 - ux1 + 1) * (uy2 - uy1 + 1) -
+                       (int32_t)(dirty[i].x2 - dirty[i].x1 + 1) *
+                           (dirty[i].y2 - dirty[i].y1 + 1);
+      if (growth < bestGrowth) {
+        bestGrowth = growth;
+        best = i;
+      }
+    }
+    i = best;
   }
+  if (x1 < dirty[i].x1)
+    dirty[i].x1 = x1;
+  if (y1 < dirty[i].y1)
+    dirty[i].y1 = y1;
+  if (x2 > dirty[i].x2)
+    dirty[i].x2 = x2;
+  if (y2 > dirty[i].y2)
+    dirty[i].y2 = y2;
 }
@@ -9,6 +9,434 @@
 #endif
 #include "gfxfont.h"
 
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#elif defined(ESP8266) || defined(ESP32)
+#include <pgmspace.h>
+#endif
+
+// Many (but maybe not all) non-AVR board installs define macros
+// for compatibility with existing PROGMEM-reading AVR code.
+// Do our own checks and defines here for good measure...
+
+#ifndef pgm_read_byte
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#endif
+#ifndef pgm_read_word
+#define pgm_read_word(addr) (*(const unsigned short *)(addr))
+#endif
+#ifndef pgm_read_dword
+#define pgm_read_dword(addr) (*(const unsigned long *)(addr))
+#endif
+
+// Pointers are a peculiar case...typically 16-bit on AVR boards,
+// 32 bits elsewhere.  Try to accommodate both...
+
+#if !defined(__INT_MAX__) || (__INT_MAX__ > 0xFFFF)
+#define pgm_read_pointer(addr) ((void *)pgm_read_dword(addr))
+#else
+#define pgm_read_pointer(addr) ((void *)pgm_read_word(addr))
+#endif
+
+inline GFXglyph *pgm_read_glyph_ptr(const GFXfont *gfxFont, uint16_t c) {
+#ifdef __AVR__
+  return &(((GFXglyph *)pgm_read_pointer(&gfxFont->glyph))[c]);
+#else
+  // expression in __AVR__ section may generate "dereferencing type-punned
+  // pointer will break strict-aliasing rules" warning In fact, on other
+  // platforms (such as STM32) there is no need to do this pointer magic as
+  // program memory may be read in a usual way So expression may be simplified
+  return gfxFont->glyph + c;
+#endif //__AVR__
+}
+
+inline uint8_t *pgm_read_bitmap_ptr(const GFXfont *gfxFont) {
+#ifdef __AVR__
+  return (uint8_t *)pgm_read_pointer(&gfxFont->bitmap);
+#else
+  // expression in __AVR__ section generates "dereferencing type-punned pointer
+  // will break strict-aliasing rules" warning In fact, on other platforms (such
+  // as STM32) there is no need to do this pointer magic as program memory may
+  // be read in a usual way So expression may be simplified
+  return gfxFont->bitmap;
+#endif //__AVR__
+}
+
+inline GFXrange *pgm_read_range_ptr(const GFXfont *gfxFont) {
+#ifdef __AVR__
+  return (GFXrange *)pgm_read_pointer(&gfxFont->range);
+#else
+  return gfxFont->range;
+#endif //__AVR__
+}
+
+int32_t gfxGlyphIndex(const GFXfont *font, uint32_t c);
+uint16_t gfxGlyphCount(const GFXfont *font);
+int8_t gfxKernAdjust(const GFXfont *font, int32_t left, int32_t right);
+uint8_t gfxDigitAdvance(const GFXfont *font);
+
+// Pixel row kernels, a 32-bit word (two pixels) at a time, used by the
+// canvases and by Adafruit_SPITFT to stage pixels for the bus
+void gfxFill565(uint16_t *dst, uint16_t color, uint32_t len);
+void gfxSwap565(uint16_t *dst, const uint16_t *src, uint32_t len);
+
+/// Layouts of 8-bit-per-channel image rows, for drawRGB888Bitmap() and
+/// the gfxConvert565() / gfxConvert332() row converters
+enum GFXrgbFormat {
+  GFX_RGB888, ///< 3 bytes per pixel, red then green then blue
+  GFX_BGR888, ///< 3 bytes per pixel, blue then green then red (as BMP)
+  GFX_GRAY8   ///< 1 byte per pixel, grayscale
+};
+
+// Row converters from 8 bits per channel, optionally ordered-dithered by
+// the position (x, y) of the row's first pixel
+void gfxConvert565(uint16_t *dst, const uint8_t *src, uint32_t len,
+                   GFXrgbFormat format, int16_t x = 0, int16_t y = 0,
+                   bool dither = false, bool bigEndian = false);
+void gfxConvert332(uint8_t *dst, const uint8_t *src, uint32_t len,
+                   GFXrgbFormat format, int16_t x = 0, int16_t y = 0,
+                   bool dither = false);
+
+/// One color of a linear gradient (see Adafruit_GFX::fillRectGradient())
+typedef struct {
+  uint8_t pos;    ///< Where it falls, 0 (first pixel) thru 255 (last pixel)
+  uint16_t color; ///< 16-bit 5-6-5 color there
+} GFXgradientStop;
+
+// Colors of pixels from thru from + count - 1 of a gradient len pixels long
+void gfxGradient565(uint16_t *dst, uint32_t count,
+                    const GFXgradientStop *stops, uint8_t nStops, int16_t len,
+                    int16_t from = 0, bool bigEndian = false);
+
+/************************************************************************/
+/*!
+  @brief    Look up a character's glyph in a custom font
+  @param    font  The font
+  @param    c     Character code, a Unicode codepoint for extended fonts
+  @returns  Pointer (PROGMEM) to the glyph, or NULL if the font lacks it
+*/
+/************************************************************************/
+inline GFXglyph *gfxGetGlyph(const GFXfont *font, uint32_t c) {
+  int32_t i = gfxGlyphIndex(font, c);
+  return (i < 0) ? NULL : pgm_read_glyph_ptr(font, i);
+}
+
+/// Turns text, a byte at a time, into character codes for a font: UTF-8
+/// is decoded for an extended font (one with a range table), any other
+/// font takes a byte per character. Stray or cut-short UTF-8 sequences
+/// are dropped rather than drawn as garbage.
+class GFXtextDecoder {
+
+public:
+  /**********************************************************************/
+  /*!
+    @brief  Start decoding text
+    @param  f  Font the text is for, NULL for the classic built-in font
+  */
+  /**********************************************************************/
+  GFXtextDecoder(const GFXfont *f = NULL) { setFont(f); }
+
+  /**********************************************************************/
+  /*!
+    @brief  Switch to text for another font, dropping any partly decoded
+            character
+    @param  f  Font the text is for, NULL for the classic built-in font
+  */
+  /**********************************************************************/
+  void setFont(const GFXfont *f) {
+    _utf8 = f && pgm_read_word(&f->ranges);
+    _code = 0;
+    _need = 0;
+  }
+  bool decode(uint8_t b, uint32_t *code);
+
+private:
+  uint32_t _code; ///< Codepoint bits gathered so far
+  uint8_t _need;  ///< Continuation bytes still to come
+  bool _utf8;     ///< Text is UTF-8 (font has a range table)
+};
+
+/// Reads a GFXFONT_RLE glyph bitmap: pixel run lengths, alternating clear
+/// and set (starting with clear), flowing row-major from one row into the
+/// next. Each run is a series of 4-bit values (high nibble first) summed
+/// until one is less than 15, so e.g. a run of 15 is stored as 15, 0.
+class GFXrleReader {
+
+public:
+  /**********************************************************************/
+  /*!
+    @brief  Start reading a glyph's run data
+    @param  p  Pointer (PROGMEM) to glyph's first byte in font bitmap
+  */
+  /**********************************************************************/
+  GFXrleReader(const uint8_t *p) : ptr(p), half(0), left(0), set(1) {}
+
+  /**********************************************************************/
+  /*!
+    @brief    Read the next run length. Runs alternate clear, set, clear...
+    @returns  Run length in pixels, may be 0
+  */
+  /**********************************************************************/
+  uint16_t run(void) {
+    uint16_t len = 0;
+    uint8_t v;
+    do {
+      uint8_t b = pgm_read_byte(ptr);
+      if ((half ^= 1)) {
+        v = b >> 4;
+      } else {
+        v = b & 0x0F;
+        ptr++;
+      }
+      len += v;
+    } while (v == 15);
+    return len;
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Decode the next row of the glyph as packed bits, MSB first,
+            same as one row of an uncompressed glyph. Don't mix with run().
+    @param  bits  Array to receive (w + 7) / 8 bytes
+    @param  w     Glyph width in pixels
+  */
+  /**********************************************************************/
+  void readRow(uint8_t *bits, uint8_t w) {
+    memset(bits, 0, (w + 7) / 8);
+    for (uint8_t x = 0; x < w;) {
+      if (!left) {
+        left = run();
+        set = !set;
+        continue;
+      }
+      uint8_t n = (left < (uint16_t)(w - x)) ? left : w - x;
+      left -= n;
+      if (set) {
+        while (n--) {
+          bits[x >> 3] |= 0x80 >> (x & 7);
+          x++;
+        }
+      } else {
+        x += n;
+      }
+    }
+  }
+
+private:
+  const uint8_t *ptr;
+  uint8_t half;
+  uint16_t left;
+  uint8_t set;
+};
+
+// Op types of a compressed sprite, in the top 2 bits of each op byte
+#define GFXSPRITE_LITERAL 0x00 ///< Pixels of their own colors follow
+#define GFXSPRITE_RUN 0x40     ///< Pixels all one color, which follows
+#define GFXSPRITE_SKIP 0x80    ///< Transparent pixels
+#define GFXSPRITE_REPEAT 0xC0  ///< Pixels all the prior run's color
+
+/// Reads a compressed RGB565 sprite (PROGMEM) for drawSprite(). A sprite
+/// is its width and height, 16 bits each, followed by ops that cover its
+/// pixels row by row, top to bottom, any op continuing onto the next row.
+/// Each op is one byte, its type (GFXSPRITE_*) in the top 2 bits and its
+/// length in the rest: 0-62 for 1-63 pixels, or 63 for 64 plus the next
+/// byte (up to 319 pixels). A GFXSPRITE_RUN op is followed by its color
+/// and a GFXSPRITE_LITERAL op by its pixels. Multi-byte values are
+/// little-endian. The spriteconvert tool makes sprites from BMP images.
+class GFXspriteReader {
+
+public:
+  /**********************************************************************/
+  /*!
+    @brief  Start reading a sprite's ops
+    @param  sprite  Pointer (PROGMEM) to sprite's first byte
+  */
+  /**********************************************************************/
+  GFXspriteReader(const uint8_t *sprite) : ptr(sprite + 4), color(0) {}
+
+  /**********************************************************************/
+  /*!
+    @brief  Reader with no sprite, to be assigned one before use
+  */
+  /**********************************************************************/
+  GFXspriteReader(void) : ptr(NULL), color(0) {}
+
+  /**********************************************************************/
+  /*!
+    @brief    Read the next op. For a literal, that many pixel() or
+              skip() calls must follow before the next op.
+    @param    count  Receives the number of pixels the op covers
+    @returns  GFXSPRITE_LITERAL, GFXSPRITE_RUN (of runColor(); also
+              returned for GFXSPRITE_REPEAT) or GFXSPRITE_SKIP
+  */
+  /**********************************************************************/
+  uint8_t next(uint16_t *count) {
+    uint8_t op = pgm_read_byte(ptr++), n = op & 0x3F;
+    *count = (n < 63) ? n + 1 : 64 + pgm_read_byte(ptr++);
+    op &= 0xC0;
+    if (op == GFXSPRITE_RUN)
+      color = pixel();
+    return (op == GFXSPRITE_REPEAT) ? GFXSPRITE_RUN : op;
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief    Read the next pixel of a literal
+    @returns  16-bit 5-6-5 Color
+  */
+  /**********************************************************************/
+  uint16_t pixel(void) {
+    uint16_t c = pgm_read_byte(ptr) | (pgm_read_byte(ptr + 1) << 8);
+    ptr += 2;
+    return c;
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Pass over pixels of a literal without reading them
+    @param  n  Number of pixels
+  */
+  /**********************************************************************/
+  void skip(uint16_t n) { ptr += n * 2; }
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the color of the most recent run
+    @returns  16-bit 5-6-5 Color
+  */
+  /**********************************************************************/
+  uint16_t runColor(void) const { return color; }
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the width of a sprite
+    @param    sprite  Pointer (PROGMEM) to sprite's first byte
+    @returns  Width in pixels
+  */
+  /**********************************************************************/
+  static int16_t width(const uint8_t *sprite) {
+    return pgm_read_byte(sprite) | (pgm_read_byte(sprite + 1) << 8);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the height of a sprite
+    @param    sprite  Pointer (PROGMEM) to sprite's first byte
+    @returns  Height in pixels
+  */
+  /**********************************************************************/
+  static int16_t height(const uint8_t *sprite) {
+    return pgm_read_byte(sprite + 2) | (pgm_read_byte(sprite + 3) << 8);
+  }
+
+private:
+  const uint8_t *ptr;
+  uint16_t color;
+};
+
+/// Where a clipped bitmap lands in a canvas buffer: the visible part of the
+/// bitmap, and the buffer index of its first pixel and how far that moves
+/// per bitmap column and row at the canvas's rotation
+typedef struct {
+  int16_t i0;    ///< First visible bitmap column
+  int16_t i1;    ///< Last visible bitmap column + 1
+  int16_t j0;    ///< First visible bitmap row
+  int16_t j1;    ///< Last visible bitmap row + 1
+  int32_t base;  ///< Buffer index of bitmap pixel (i0, j0)
+  int32_t stepX; ///< Index change per bitmap column
+  int32_t stepY; ///< Index change per bitmap row
+} GFXblit;
+
+class GFXfontMetrics;
+class Adafruit_FontFile;
+
+// Bits of Adafruit_GFX::getHardwareCaps(), one per 2D-engine hook
+#define GFX_HW_FILL 0x01   ///< hwFillRect() fills rectangles
+#define GFX_HW_COPY 0x02   ///< hwCopyRect() moves rectangles on screen
+#define GFX_HW_SCROLL 0x04 ///< hwScroll() scrolls a rectangle in place
+
+// Define GFX_NO_CLASSIC_FONT for the whole build to leave the 'classic'
+// built-in font (1,275 bytes of flash) out of products that only print
+// in GFXfonts; it's otherwise linked in by the virtual drawChar() and
+// write() whether used or not. Classic-font characters then draw blank.
+// For drawing without the vtable, see Adafruit_GFX_Direct.h.
+
+// Define GFX_PROFILE for the whole build (a compiler flag such as
+// -DGFX_PROFILE, as with SPITFT_STATS) to have the drawing primitives time
+// every call into a ring buffer, for a call-by-call picture of a frame;
+// see gfxProfileDump(). Times are CPU cycles from the DWT counter on
+// Cortex-M3/M4/M7/M33, micros() elsewhere. Off by default, and costs
+// nothing then.
+#ifndef GFX_PROFILE_SIZE
+#define GFX_PROFILE_SIZE 128 ///< # of calls the profile ring holds
+#endif
+
+/*! Primitives a GFX_PROFILE build times, as recorded in GFXprofileEntry */
+enum GFXprofileID {
+  GFX_PROF_FILLRECT,      ///< fillRect()
+  GFX_PROF_FASTHLINE,     ///< drawFastHLine()
+  GFX_PROF_FASTVLINE,     ///< drawFastVLine()
+  GFX_PROF_FILLSCREEN,    ///< fillScreen()
+  GFX_PROF_LINE,          ///< drawLine()
+  GFX_PROF_RECT,          ///< drawRect()
+  GFX_PROF_CIRCLE,        ///< drawCircle()
+  GFX_PROF_FILLCIRCLE,    ///< fillCircle()
+  GFX_PROF_ROUNDRECT,     ///< drawRoundRect()
+  GFX_PROF_FILLROUNDRECT, ///< fillRoundRect()
+  GFX_PROF_TRIANGLE,      ///< drawTriangle()
+  GFX_PROF_FILLTRIANGLE,  ///< fillTriangle()
+  GFX_PROF_BITMAP,        ///< drawBitmap(), drawXBitmap()
+  GFX_PROF_GRAYBITMAP,    ///< drawGrayscaleBitmap()
+  GFX_PROF_RGBBITMAP,     ///< drawRGBBitmap()
+  GFX_PROF_CHAR,          ///< drawChar()
+  GFX_PROF_WRITE,         ///< write(), one character of print()
+  GFX_PROF_WRITEPIXELS,   ///< Adafruit_SPITFT::writePixels()
+  GFX_PROF_WRITECOLOR,    ///< Adafruit_SPITFT::writeColor()
+  GFX_PROF_FLUSHCANVAS,   ///< Adafruit_SPITFT::flushCanvas()
+  GFX_PROF_USER = 64      ///< First of the IDs for a sketch's own scopes
+};
+
+#if defined(GFX_PROFILE)
+/*! One timed call in the GFX_PROFILE ring */
+typedef struct {
+  uint32_t start;  ///< When the call began, in ticks (see gfxProfileTicks())
+  uint32_t ticks;  ///< How long it took, including calls it made
+  uint32_t pixels; ///< Area of rect or image, line length...; 0 if unknown
+  uint8_t id;      ///< GFXprofileID, or GFX_PROF_USER + n
+  uint8_t depth;   ///< Nesting: 0 for a call made by the sketch itself
+} GFXprofileEntry;
+
+/*!
+  @brief  Times the scope it's declared in, adding a GFXprofileEntry to the
+          ring when the scope ends. Declared with GFX_PROFILE_SCOPE(), which
+          a sketch can use too, with IDs from GFX_PROF_USER up, to see its
+          own functions (a widget's draw, say) around the library's calls.
+*/
+class GFXprofileScope {
+public:
+  GFXprofileScope(uint8_t id, int32_t pixels);
+  ~GFXprofileScope(void);
+
+private:
+  uint32_t _start;  ///< gfxProfileTicks() at construction
+  uint32_t _pixels; ///< Pixel count to record
+  uint8_t _id;      ///< ID to record
+};
+
+/// Time the rest of the enclosing scope as a call to primitive id
+#define GFX_PROFILE_SCOPE(id, pixels)                                          \
+  GFXprofileScope gfxProfileScope_(id, (int32_t)(pixels))
+
+uint32_t gfxProfileTicks(void);
+void gfxProfileReset(void);
+uint16_t gfxProfileCount(void);
+uint32_t gfxProfileDropped(void);
+bool gfxProfileGet(uint16_t i, GFXprofileEntry *e);
+void gfxProfileDump(Print &out);
+#else
+#define GFX_PROFILE_SCOPE(id, pixels) ///< Profiling is compiled out
+#endif
+
 /// A generic graphics superclass that can handle all sorts of drawing. At a
 /// minimum you can subclass and provide drawPixel(). At a maximum you can do a
 /// ton of overriding to optimize. Used for any/all Adafruit displays!
@@ -57,6 +485,49 @@ public:
       drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color),
       drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
 
+  // GRADIENT AND PATTERN FILLS
+  // Generated a line at a time; a display may override these to build
+  // each line in its own pixel buffers (see Adafruit_SPITFT).
+  virtual void fillRectGradientStops(int16_t x, int16_t y, int16_t w,
+                                     int16_t h, const GFXgradientStop *stops,
+                                     uint8_t nStops, bool vertical = true),
+      fillRectPattern(int16_t x, int16_t y, int16_t w, int16_t h,
+                      const uint16_t *pattern, int16_t pw, int16_t ph);
+  void fillRectGradient(int16_t x, int16_t y, int16_t w, int16_t h,
+                        uint16_t color0, uint16_t color1,
+                        bool vertical = true);
+
+  // TEXT DRAW API
+  // This MAY be overridden by the subclass to provide device-specific
+  // optimized code (e.g. pushing whole glyphs at once).
+  virtual void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                        uint16_t bg, uint8_t size_x, uint8_t size_y);
+  // Any character of an extended font; those up to 0xFF go to drawChar()
+  virtual void drawGlyph(int16_t x, int16_t y, uint32_t c, uint16_t color,
+                         uint16_t bg, uint8_t size_x, uint8_t size_y);
+  // PIXEL COPY API
+  // Canvases move their buffers; a display does it with its 2D engine
+  // where it advertises one (see hwCopyRect()), or however its subclass
+  // can. copyRect() does nothing on a display that can't.
+  virtual void copyRect(int16_t sx, int16_t sy, int16_t w, int16_t h,
+                        int16_t dx, int16_t dy),
+      scroll(int16_t dx, int16_t dy, uint16_t fill = 0);
+
+  /**********************************************************************/
+  /*!
+    @brief    Get which 2D-engine hooks the display implements
+    @returns  GFX_HW_FILL, GFX_HW_COPY and GFX_HW_SCROLL bits, 0 for a
+              display (or canvas) that streams every pixel
+  */
+  /**********************************************************************/
+  uint8_t getHardwareCaps(void) const { return hwCaps; }
+
+  // Generic version inside a transaction the caller holds
+  void writeChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                 uint16_t bg, uint8_t size_x, uint8_t size_y);
+  void writeGlyph(int16_t x, int16_t y, uint32_t c, uint16_t color,
+                  uint16_t bg, uint8_t size_x, uint8_t size_y);
+
   // These exist only with Adafruit_GFX (no subclass overrides)
   void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color),
       drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername,
@@ -98,10 +569,11 @@ public:
                     const uint8_t mask[], int16_t w, int16_t h),
       drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, uint8_t *mask,
                     int16_t w, int16_t h),
+      drawRGB888Bitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                       int16_t h, GFXrgbFormat format = GFX_RGB888,
+                       bool dither = true),
       drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
                uint16_t bg, uint8_t size),
-      drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
-               uint16_t bg, uint8_t size_x, uint8_t size_y),
       getTextBounds(const char *string, int16_t x, int16_t y, int16_t *x1,
                     int16_t *y1, uint16_t *w, uint16_t *h),
       getTextBounds(const __FlashStringHelper *s, int16_t x, int16_t y,
@@ -111,6 +583,22 @@ public:
       setTextSize(uint8_t s), setTextSize(uint8_t sx, uint8_t sy),
       setFont(const GFXfont *f = NULL);
 
+  // Compressed RGB565 image with transparency (see GFXspriteReader)
+  void drawSprite(int16_t x, int16_t y, const uint8_t sprite[]);
+
+  // Connected line segments through n points, in one write transaction
+  void drawPolyline(const int16_t *x, const int16_t *y, uint16_t n,
+                    uint16_t color),
+      drawSeries(int16_t x, int16_t dx, const int16_t *y, uint16_t n,
+                 uint16_t color);
+
+  // Anti-aliased outlines, blended toward bg (or, on a GFXcanvas16, onto
+  // what's already there)
+  void drawLineAA(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                  uint16_t color, uint16_t bg),
+      drawCircleAA(int16_t x0, int16_t y0, int16_t r, uint16_t color,
+                   uint16_t bg);
+
   /**********************************************************************/
   /*!
     @brief  Set text cursor location
@@ -121,6 +609,7 @@ public:
   void setCursor(int16_t x, int16_t y) {
     cursor_x = x;
     cursor_y = y;
+    kernPrev = -1;
   }
 
   /**********************************************************************/
@@ -154,6 +643,26 @@ public:
   /**********************************************************************/
   void setTextWrap(boolean w) { wrap = w; }
 
+  void setTabularDigits(bool tabular);
+
+  /**********************************************************************/
+  /*!
+    @brief    Get whether digits of custom fonts are set in equal cells
+    @returns  The setTabularDigits() setting
+  */
+  /**********************************************************************/
+  bool getTabularDigits(void) const { return tabularDigits; }
+
+  void setTextOrientation(uint8_t orientation);
+
+  /**********************************************************************/
+  /*!
+    @brief    Get which way text runs, independent of the display rotation
+    @returns  Quarter turns clockwise, 0 thru 3 (see setTextOrientation())
+  */
+  /**********************************************************************/
+  uint8_t getTextOrientation(void) const { return textOrientation; }
+
   /**********************************************************************/
   /*!
     @brief  Enable (or disable) Code Page 437-compatible charset.
@@ -170,6 +679,62 @@ public:
   /**********************************************************************/
   void cp437(boolean x = true) { _cp437 = x; }
 
+  static uint16_t blend565(uint16_t fg, uint16_t bg, uint8_t alpha);
+
+  /**********************************************************************/
+  /*!
+    @brief  Attach a metrics cache to speed up getTextBounds(). It's used
+            only while its font is the current font (see setFont()), so
+            one display can keep several, switching with the font.
+    @param  m  Pointer to GFXfontMetrics object, or NULL to detach.
+  */
+  /**********************************************************************/
+  void setFontMetrics(GFXfontMetrics *m) { metrics = m; }
+
+  void setClipRect(int16_t x, int16_t y, int16_t w, int16_t h);
+  void getClipRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) const;
+
+  /**********************************************************************/
+  /*!
+    @brief  Remove the clip rect, so drawing is limited only by the edges
+            of the display.
+  */
+  /**********************************************************************/
+  void clearClipRect(void) {
+    _clipX1 = _clipY1 = 0;
+    _clipX2 = _clipY2 = 0x7FFF;
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Set the drawing origin. All coordinates passed to drawing
+            functions (and to setCursor() text) are then relative to this
+            point on the display; the clip rect is not affected.
+    @param  x  Display column that becomes X coordinate 0
+    @param  y  Display row that becomes Y coordinate 0
+  */
+  /**********************************************************************/
+  void setOrigin(int16_t x, int16_t y) {
+    _originX = x;
+    _originY = y;
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the X drawing origin set with setOrigin()
+    @returns  Display column of X coordinate 0
+  */
+  /**********************************************************************/
+  int16_t getOriginX(void) const { return _originX; }
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the Y drawing origin set with setOrigin()
+    @returns  Display row of Y coordinate 0
+  */
+  /**********************************************************************/
+  int16_t getOriginY(void) const { return _originY; }
+
   using Print::write;
 #if ARDUINO >= 100
   virtual size_t write(uint8_t);
@@ -219,15 +784,140 @@ public:
   /************************************************************************/
   int16_t getCursorY(void) const { return cursor_y; };
 
+  /************************************************************************/
+  /*!
+    @brief      Get the current font
+    @returns    Font set with setFont(), or NULL for the classic font
+  */
+  /************************************************************************/
+  const GFXfont *getFont(void) const { return gfxFont; }
+
 protected:
-  void charBounds(char c, int16_t *x, int16_t *y, int16_t *minx, int16_t *miny,
-                  int16_t *maxx, int16_t *maxy);
-  int16_t WIDTH,      ///< This is the 'raw' display width - never changes
+  void charBounds(uint32_t c, int16_t *x, int16_t *y, int16_t *minx,
+                  int16_t *miny, int16_t *maxx, int16_t *maxy,
+                  int32_t *prev);
+  void getClassicGlyph(unsigned char c, uint8_t *cols);
+  uint8_t *glyphBitmap(uint16_t glyph);
+  /**********************************************************************/
+  /*!
+    @brief    Check whether a character of the custom font is drawn in a
+              tabular digit cell, digitAdvance wide, centered and unkerned
+    @param    c  The character
+    @returns  true if setTabularDigits() is on and c is a digit
+  */
+  /**********************************************************************/
+  bool tabularDigit(uint32_t c) const {
+    return digitAdvance && (c >= '0') && (c <= '9');
+  }
+  void writeGlyphRun(int16_t x, int16_t y, int16_t gx, int16_t gy, int16_t len,
+                     int16_t rows, uint16_t color, uint8_t size_x,
+                     uint8_t size_y);
+  void turnTextRect(int16_t x, int16_t y, int16_t *rx, int16_t *ry,
+                    int16_t *rw, int16_t *rh) const;
+  void textFrame(int16_t *x, int16_t *y, bool toScreen) const;
+  virtual void blendPixel(int16_t x, int16_t y, uint16_t color, uint16_t bg,
+                          uint8_t alpha);
+  void writeLineRuns(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                     uint16_t color, bool skipFirst);
+
+  // Clip/origin support for drawPixel() and span implementations. Each
+  // takes coordinates relative to the origin and returns with them
+  // translated to the display, or false if nothing is visible.
+  /**********************************************************************/
+  /*!
+    @brief    Translate a pixel by the drawing origin and test it against
+              the clip rect and display edges
+    @param    x  Pointer to X coordinate, display column on return
+    @param    y  Pointer to Y coordinate, display row on return
+    @returns  true if the pixel is visible
+  */
+  /**********************************************************************/
+  bool clipPixel(int16_t *x, int16_t *y) const {
+    *x += _originX;
+    *y += _originY;
+    // _clipX1/_clipY1 are never negative, so these also test against 0
+    return (*x >= _clipX1) && (*y >= _clipY1) && (*x <= _clipX2) &&
+           (*y <= _clipY2) && (*x < _width) && (*y < _height);
+  }
+  bool clipRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) const;
+  bool clipRows(int16_t x, int16_t y, int16_t w, int16_t h, int16_t *j0,
+                int16_t *j1) const;
+  void clipBounds(int16_t *x1, int16_t *y1, int16_t *x2, int16_t *y2) const;
+  bool clipBlit(int16_t x, int16_t y, int16_t w, int16_t h, int32_t stride,
+                GFXblit *b) const;
+
+  /**********************************************************************/
+  /*!
+    @brief    Test a primitive's bounding box against the visible area
+    @param    x1  Column of one corner, origin-relative
+    @param    y1  Row of one corner, origin-relative
+    @param    x2  Column of opposite corner (inclusive), either side of x1
+    @param    y2  Row of opposite corner (inclusive), either side of y1
+    @returns  true if any of the box is visible
+  */
+  /**********************************************************************/
+  bool clipOverlaps(int16_t x1, int16_t y1, int16_t x2, int16_t y2) const {
+    int16_t cx1, cy1, cx2, cy2;
+    clipBounds(&cx1, &cy1, &cx2, &cy2);
+    int16_t t;
+    if (x1 > x2) {
+      t = x1;
+      x1 = x2;
+      x2 = t;
+    }
+    if (y1 > y2) {
+      t = y1;
+      y1 = y2;
+      y2 = t;
+    }
+    return (cx1 <= cx2) && (cy1 <= cy2) && // Clip not off the display
+           (x1 <= cx2) && (y1 <= cy2) && (x2 >= cx1) && (y2 >= cy1);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief    Query whether a clip rect or origin is in effect
+    @returns  true if drawing is translated or clipped beyond the display
+              edges
+  */
+  /**********************************************************************/
+  bool clipActive(void) const {
+    return _originX || _originY || _clipX1 || _clipY1 ||
+           (_clipX2 < _width - 1) || (_clipY2 < _height - 1);
+  }
+
+  // 2D-engine hooks for displays that have one. Each is only called
+  // when its GFX_HW_* bit is set in hwCaps, with display coordinates at
+  // the current rotation (origin added, already clipped), with or
+  // without a transaction held. Return false to have the caller stream
+  // pixels instead.
+  virtual bool hwFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color);
+  virtual bool hwCopyRect(int16_t sx, int16_t sy, int16_t w, int16_t h,
+                          int16_t dx, int16_t dy);
+  virtual bool hwScroll(int16_t x, int16_t y, int16_t w, int16_t h,
+                        int16_t dx, int16_t dy, uint16_t fill);
+  bool clipCopy(const Adafruit_GFX *src, int16_t *sx, int16_t *sy,
+                int16_t *dx, int16_t *dy, int16_t *w, int16_t *h) const;
+
+  // Buffer move behind the canvases' blit() and copyRect()
+  bool canvasCopy(const Adafruit_GFX *src, const uint8_t *sbuf, int32_t srow,
+                  uint8_t *dbuf, int32_t drow, uint8_t depth, bool swap,
+                  int16_t sx, int16_t sy, int16_t *dx, int16_t *dy,
+                  int16_t *w, int16_t *h);
+
+  int16_t WIDTH,     ///< This is the 'raw' display width - never changes
       HEIGHT;         ///< This is the 'raw' display height - never changes
   int16_t _width,     ///< Display width as modified by current rotation
       _height,        ///< Display height as modified by current rotation
       cursor_x,       ///< x location to start print()ing text
-      cursor_y;       ///< y location to start print()ing text
+      cursor_y,       ///< y location to start print()ing text
+      _clipX1,        ///< Clip rect left column, display coordinates
+      _clipY1,        ///< Clip rect top row, display coordinates
+      _clipX2,        ///< Clip rect right column (inclusive)
+      _clipY2,        ///< Clip rect bottom row (inclusive)
+      _originX,       ///< Display column of drawing X coordinate 0
+      _originY;       ///< Display row of drawing Y coordinate 0
   uint16_t textcolor, ///< 16-bit background color for print()
       textbgcolor;    ///< 16-bit text color for print()
   uint8_t textsize_x, ///< Desired magnification in X-axis of text to print()
@@ -236,8 +926,119 @@ protected:
   boolean wrap,       ///< If set, 'wrap' text at right edge of display
       _cp437;         ///< If set, use correct CP437 charset (default is off)
   GFXfont *gfxFont;   ///< Pointer to special font
+
+  GFXfontMetrics *metrics;    ///< Optional glyph metrics/text bounds cache
+  GFXtextDecoder textDecoder; ///< Turns print() bytes into gfxFont chars
+  int32_t kernPrev; ///< Glyph index of last char print()ed, -1 for none
+  Adafruit_FontFile *fontFile; ///< Streams gfxFont's bitmaps, else NULL
+  uint8_t hwCaps; ///< GFX_HW_* bits for the 2D-engine hooks implemented
+
+  uint8_t digitAdvance;    ///< Tabular digit cell width, 0 if not in use
+  uint8_t textOrientation; ///< Quarter turns clockwise of text (0 thru 3)
+  bool tabularDigits;      ///< If set, custom font digits are equal width
 };
 
+/// Collects the spans (lines or thin rects) a filled primitive is made
+/// of, merging each into the previous one when they line up -- adjacent
+/// with the same extent -- so a run of equal spans is issued as a single
+/// writeFillRect() rather than one address window per span. For use
+/// between startWrite() and endWrite(); call flush() before the latter.
+class GFXspanList {
+
+public:
+  /**********************************************************************/
+  /*!
+    @brief  Start an empty span list
+    @param  gfx    Device spans are issued to
+    @param  color  16-bit 5-6-5 color of every span
+  */
+  /**********************************************************************/
+  GFXspanList(Adafruit_GFX *gfx, uint16_t color)
+      : _gfx(gfx), _w(0), _color(color) {}
+  void add(int16_t x, int16_t y, int16_t w, int16_t h);
+  void flush(void);
+
+private:
+  void emit(int16_t x, int16_t y, int16_t w, int16_t h);
+  Adafruit_GFX *_gfx;
+  int16_t _x, _y, _w, _h; // Pending merged rect, _w = 0 if none
+  uint16_t _color;
+};
+
+#ifndef GFXFONTMETRICS_MEMO
+#define GFXFONTMETRICS_MEMO 4 ///< Default # of strings a metrics cache recalls
+#endif
+
+/// Optional RAM cache of one font's glyph metrics, plus a memo of recently
+/// measured strings, for layout code that repeatedly measures text
+class GFXfontMetrics {
+
+public:
+  GFXfontMetrics(const GFXfont *f, uint8_t memoSize = GFXFONTMETRICS_MEMO);
+  ~GFXfontMetrics(void);
+  uint16_t getTextWidth(const char *str, uint8_t size_x = 1) const;
+
+  /// Metrics of one glyph, as copied from its GFXglyph
+  typedef struct {
+    uint8_t width;    ///< Bitmap dimensions in pixels
+    uint8_t height;   ///< Bitmap dimensions in pixels
+    uint8_t xAdvance; ///< Distance to advance cursor (x axis)
+    int8_t xOffset;   ///< X dist from cursor pos to UL corner
+    int8_t yOffset;   ///< Y dist from cursor pos to UL corner
+  } Glyph;
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the font this cache was built for
+    @returns  GFXfont pointer, or NULL for the classic built-in font
+  */
+  /**********************************************************************/
+  const GFXfont *getFont(void) const { return font; }
+
+  /**********************************************************************/
+  /*!
+    @brief    Get cached metrics for one character
+    @param    c  The character, a Unicode codepoint for extended fonts
+    @returns  Pointer to metrics in RAM, or NULL if the character isn't in
+              the font (or the table couldn't be allocated)
+  */
+  /**********************************************************************/
+  const Glyph *getGlyph(uint32_t c) const {
+    if (!glyphs)
+      return NULL;
+    if (extended) {
+      int32_t i = gfxGlyphIndex(font, c);
+      return (i < 0) ? NULL : &glyphs[i];
+    }
+    return ((c >= first) && (c <= last)) ? &glyphs[c - first] : NULL;
+  }
+
+  // Used by Adafruit_GFX::getTextBounds() to recall prior results
+  bool memoGet(uint32_t key, uint32_t check, uint16_t len, int16_t *x1,
+               int16_t *y1, uint16_t *w, uint16_t *h) const;
+  void memoPut(uint32_t key, uint32_t check, uint16_t len, int16_t x1,
+               int16_t y1, uint16_t w, uint16_t h);
+
+private:
+  typedef struct {
+    uint32_t key;   // Hash of string and layout state, 0 = unused
+    uint32_t check; // Second, independent hash of the same
+    uint16_t len;   // String length (low 16 bits), checked with key
+    int16_t x1, y1;
+    uint16_t w, h;
+  } Memo;
+  const GFXfont *font;
+  Glyph *glyphs;
+  Memo *memo;
+  uint8_t first, last, memoSize, memoNext;
+  bool extended; // Font has a range table; glyphs are indexed by glyph
+};
+
+// Button states as drawn, for updateButton()
+#define BUTTON_UNDRAWN 0       ///< Not drawn since initButton*() or setLabel()
+#define BUTTON_DRAWN 1         ///< Drawn normal
+#define BUTTON_DRAWN_PRESSED 2 ///< Drawn inverted
+
 /// A simple drawn button UI element
 class Adafruit_GFX_Button {
 
@@ -260,8 +1061,23 @@ public:
                     uint16_t textcolor, char *label, uint8_t textsize_x,
                     uint8_t textsize_y);
   void drawButton(boolean inverted = false);
+  void writeButton(boolean inverted = false);
+  boolean updateButton(void);
+  void setLabel(const char *label);
   boolean contains(int16_t x, int16_t y);
 
+  /**********************************************************************/
+  /*!
+    @brief    Query whether the screen doesn't show the button as it is:
+              it was never drawn, its label changed, or it was drawn
+              pressed and isn't (or vice versa)
+    @returns  True if updateButton() would draw it
+  */
+  /**********************************************************************/
+  boolean needsRedraw(void) const {
+    return drawnstate != (currstate ? BUTTON_DRAWN_PRESSED : BUTTON_DRAWN);
+  }
+
   /**********************************************************************/
   /*!
     @brief    Sets button state, should be done by some touch function
@@ -294,6 +1110,35 @@ private:
   char _label[10];
 
   boolean currstate, laststate;
+  uint8_t drawnstate; // BUTTON_* as last drawn, from drawButton()
+
+  friend class Adafruit_GFX_ButtonGroup;
+};
+
+/// A set of buttons hit-tested and drawn together. Buttons stay in the
+/// caller's array; the group adds a grid over the screen area they
+/// cover, so touch polling checks only the buttons near the touch.
+class Adafruit_GFX_ButtonGroup {
+
+public:
+  Adafruit_GFX_ButtonGroup(Adafruit_GFX_Button *buttons, uint8_t n);
+  ~Adafruit_GFX_ButtonGroup(void);
+  bool begin(void);
+  int16_t find(int16_t x, int16_t y);
+  int16_t press(int16_t x, int16_t y, boolean touched = true);
+  uint8_t render(boolean all = false);
+
+private:
+  Adafruit_GFX_Button *_buttons; ///< Caller's buttons
+  uint16_t *_cellStart;          ///< Per grid cell, first index into _cellList
+  uint8_t *_cellList;            ///< Buttons in each cell, in array order
+  int16_t _gridX;                ///< Left edge of grid
+  int16_t _gridY;                ///< Top edge of grid
+  uint16_t _cellW;               ///< Width of each cell
+  uint16_t _cellH;               ///< Height of each cell
+  uint8_t _gridCols;             ///< Cells across
+  uint8_t _gridRows;             ///< Cells down
+  uint8_t _n;                    ///< Number of buttons
 };
 
 /// A GFX 1-bit canvas context for graphics
@@ -302,7 +1147,46 @@ public:
   GFXcanvas1(uint16_t w, uint16_t h);
   ~GFXcanvas1(void);
   void drawPixel(int16_t x, int16_t y, uint16_t color),
-      fillScreen(uint16_t color);
+      fillScreen(uint16_t color),
+      drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color),
+      drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color),
+      fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  // Bitmaps are copied straight into the buffer (see clipBlit())
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color),
+      drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                 int16_t h, uint16_t color, uint16_t bg),
+      drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                 uint16_t color),
+      drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                 uint16_t color, uint16_t bg);
+  // Color or grayscale images are thresholded by luminance (dithered by
+  // default), then copied straight into the buffer
+  void drawRGB888Bitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                        int16_t h, GFXrgbFormat format = GFX_RGB888,
+                        bool dither = true);
+  // Pixel copies between or within canvases (see canvasCopy())
+  void blit(const GFXcanvas1 *src, int16_t sx, int16_t sy, int16_t w,
+            int16_t h, int16_t dx, int16_t dy),
+      scroll(int16_t dx, int16_t dy, uint16_t fill = 0);
+
+  /**********************************************************************/
+  /*!
+    @brief  Copy a rectangle to elsewhere in this canvas; the two may
+            overlap. Same as blit() from this canvas.
+    @param  sx  Left column of source rect
+    @param  sy  Top row of source rect
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  dx  Left column of destination
+    @param  dy  Top row of destination
+  */
+  /**********************************************************************/
+  void copyRect(int16_t sx, int16_t sy, int16_t w, int16_t h, int16_t dx,
+                int16_t dy) {
+    blit(this, sx, sy, w, h, dx, dy);
+  }
+
   /**********************************************************************/
   /*!
     @brief    Get a pointer to the internal buffer memory
@@ -311,6 +1195,10 @@ public:
   /**********************************************************************/
   uint8_t *getBuffer(void) const { return buffer; }
 
+protected:
+  void fillRectRaw(int16_t x, int16_t y, int16_t w, int16_t h,
+                   uint16_t color);
+
 private:
   uint8_t *buffer;
 };
@@ -322,7 +1210,54 @@ public:
   ~GFXcanvas8(void);
   void drawPixel(int16_t x, int16_t y, uint16_t color),
       fillScreen(uint16_t color),
-      writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+      writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color),
+      drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color),
+      drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color),
+      fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  // Bitmaps are copied straight into the buffer (see clipBlit())
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color),
+      drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                 int16_t h, uint16_t color, uint16_t bg),
+      drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                 uint16_t color),
+      drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                 uint16_t color, uint16_t bg),
+      drawGrayscaleBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                          int16_t w, int16_t h),
+      drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                          int16_t h),
+      drawGrayscaleBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                          const uint8_t mask[], int16_t w, int16_t h),
+      drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap, uint8_t *mask,
+                          int16_t w, int16_t h);
+  // Color or grayscale images become RGB332 indices (see getPalette()),
+  // dithered by default
+  void drawRGB888Bitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                        int16_t h, GFXrgbFormat format = GFX_RGB888,
+                        bool dither = true);
+  // Pixel copies between or within canvases (see canvasCopy())
+  void blit(const GFXcanvas8 *src, int16_t sx, int16_t sy, int16_t w,
+            int16_t h, int16_t dx, int16_t dy),
+      scroll(int16_t dx, int16_t dy, uint16_t fill = 0);
+
+  /**********************************************************************/
+  /*!
+    @brief  Copy a rectangle to elsewhere in this canvas; the two may
+            overlap. Same as blit() from this canvas.
+    @param  sx  Left column of source rect
+    @param  sy  Top row of source rect
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  dx  Left column of destination
+    @param  dy  Top row of destination
+  */
+  /**********************************************************************/
+  void copyRect(int16_t sx, int16_t sy, int16_t w, int16_t h, int16_t dx,
+                int16_t dy) {
+    blit(this, sx, sy, w, h, dx, dy);
+  }
+
   /**********************************************************************/
   /*!
    @brief    Get a pointer to the internal buffer memory
@@ -331,17 +1266,209 @@ public:
   /**********************************************************************/
   uint8_t *getBuffer(void) const { return buffer; }
 
+  // RGB565 palette for pushing to color displays (see
+  // Adafruit_SPITFT::flushCanvas()); allocated (512 bytes) on first use
+  uint16_t *getPalette(void);
+  bool setPalette(const uint16_t *colors, uint16_t count = 256);
+  void setPaletteColor(uint8_t index, uint16_t color);
+  uint16_t getPaletteColor(uint8_t index);
+  void cyclePalette(uint8_t first, uint8_t last);
+
+protected:
+  void fillRectRaw(int16_t x, int16_t y, int16_t w, int16_t h,
+                   uint16_t color);
+
 private:
   uint8_t *buffer;
+  uint16_t *palette;
 };
 
+/// Common base of the packed 2- and 4-bit canvases: pixels are palette
+/// indices, 8 / depth to a byte, leftmost in the most significant bits,
+/// each buffer row rounded up to a whole byte. Use GFXcanvas2 or
+/// GFXcanvas4.
+class GFXcanvasPacked : public Adafruit_GFX {
+public:
+  ~GFXcanvasPacked(void);
+  void drawPixel(int16_t x, int16_t y, uint16_t color),
+      fillScreen(uint16_t color),
+      writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color),
+      drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color),
+      drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color),
+      fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  uint16_t getPixel(int16_t x, int16_t y) const;
+  // Pixel copies between or within canvases (see canvasCopy())
+  void blit(const GFXcanvasPacked *src, int16_t sx, int16_t sy, int16_t w,
+            int16_t h, int16_t dx, int16_t dy),
+      scroll(int16_t dx, int16_t dy, uint16_t fill = 0);
+
+  /**********************************************************************/
+  /*!
+    @brief  Copy a rectangle to elsewhere in this canvas; the two may
+            overlap. Same as blit() from this canvas.
+    @param  sx  Left column of source rect
+    @param  sy  Top row of source rect
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  dx  Left column of destination
+    @param  dy  Top row of destination
+  */
+  /**********************************************************************/
+  void copyRect(int16_t sx, int16_t sy, int16_t w, int16_t h, int16_t dx,
+                int16_t dy) {
+    blit(this, sx, sy, w, h, dx, dy);
+  }
+
+  void setPalette(const uint16_t *colors, uint8_t count);
+  void setPaletteColor(uint8_t index, uint16_t color);
+  uint16_t getPaletteColor(uint8_t index) const;
+
+  /**********************************************************************/
+  /*!
+    @brief    Get a pointer to the internal buffer memory
+    @returns  A pointer to the allocated buffer
+  */
+  /**********************************************************************/
+  uint8_t *getBuffer(void) const { return buffer; }
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the number of bits per pixel
+    @returns  2 or 4
+  */
+  /**********************************************************************/
+  uint8_t getDepth(void) const { return depth; }
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the length of one (unrotated) buffer row
+    @returns  Bytes per row, including any padding at its end
+  */
+  /**********************************************************************/
+  uint16_t getRowBytes(void) const { return (WIDTH * depth + 7) / 8; }
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the canvas's RGB565 palette, which may be changed
+              directly. Until changed, it's a ramp from black to white.
+    @returns  Pointer to the 1 << getDepth() palette entries
+  */
+  /**********************************************************************/
+  uint16_t *getPalette(void) { return palette; }
+
+protected:
+  GFXcanvasPacked(uint16_t w, uint16_t h, uint8_t depth);
+  void fillRectRaw(int16_t x, int16_t y, int16_t w, int16_t h,
+                   uint16_t color);
+
+private:
+  uint8_t *buffer;
+  uint16_t palette[16];
+  uint8_t depth;
+};
+
+/// A GFX 4-bit (16 color) palette canvas context for graphics
+class GFXcanvas4 : public GFXcanvasPacked {
+public:
+  /**********************************************************************/
+  /*!
+    @brief  Instatiate a GFX 4-bit canvas context for graphics
+    @param  w  Display width, in pixels
+    @param  h  Display height, in pixels
+  */
+  /**********************************************************************/
+  GFXcanvas4(uint16_t w, uint16_t h) : GFXcanvasPacked(w, h, 4) {}
+};
+
+/// A GFX 2-bit (4 color) palette canvas context for graphics
+class GFXcanvas2 : public GFXcanvasPacked {
+public:
+  /**********************************************************************/
+  /*!
+    @brief  Instatiate a GFX 2-bit canvas context for graphics
+    @param  w  Display width, in pixels
+    @param  h  Display height, in pixels
+  */
+  /**********************************************************************/
+  GFXcanvas2(uint16_t w, uint16_t h) : GFXcanvasPacked(w, h, 2) {}
+};
+
+#ifndef GFXCANVAS_MAX_DIRTY
+#define GFXCANVAS_MAX_DIRTY 4 ///< Max # of dirty rects tracked by GFXcanvas16
+#endif
+
 ///  A GFX 16-bit canvas context for graphics
 class GFXcanvas16 : public Adafruit_GFX {
 public:
-  GFXcanvas16(uint16_t w, uint16_t h);
+  GFXcanvas16(uint16_t w, uint16_t h, bool bigEndian = false);
   ~GFXcanvas16(void);
   void drawPixel(int16_t x, int16_t y, uint16_t color),
-      fillScreen(uint16_t color), byteSwap(void);
+      fillScreen(uint16_t color), byteSwap(void),
+      drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color),
+      drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color),
+      fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  uint16_t getPixel(int16_t x, int16_t y) const;
+  // Bitmaps are copied straight into the buffer (see clipBlit())
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color),
+      drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                 int16_t h, uint16_t color, uint16_t bg),
+      drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                 uint16_t color),
+      drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                 uint16_t color, uint16_t bg),
+      drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w,
+                    int16_t h),
+      drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w,
+                    int16_t h),
+      drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
+                    const uint8_t mask[], int16_t w, int16_t h),
+      drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, uint8_t *mask,
+                    int16_t w, int16_t h),
+      drawRGB888Bitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                       int16_t h, GFXrgbFormat format = GFX_RGB888,
+                       bool dither = true);
+  // Blended over what's in the canvas, alpha 0 (unchanged) to 255 (opaque).
+  // fast blends at 5-bit alpha, one multiply per pixel instead of two.
+  void fillRectAlpha(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color, uint8_t alpha, bool fast = false),
+      drawRGBBitmapAlpha(int16_t x, int16_t y, const uint16_t bitmap[],
+                         int16_t w, int16_t h, uint8_t alpha,
+                         bool fast = false),
+      drawRGBBitmapAlpha(int16_t x, int16_t y, uint16_t *bitmap, int16_t w,
+                         int16_t h, uint8_t alpha, bool fast = false),
+      drawRGBBitmapAlpha(int16_t x, int16_t y, const uint16_t bitmap[],
+                         const uint8_t alpha[], int16_t w, int16_t h,
+                         bool fast = false),
+      drawRGBBitmapAlpha(int16_t x, int16_t y, uint16_t *bitmap,
+                         uint8_t *alpha, int16_t w, int16_t h,
+                         bool fast = false);
+  // Pixel copies between or within canvases (see canvasCopy())
+  void blit(const GFXcanvas16 *src, int16_t sx, int16_t sy, int16_t w,
+            int16_t h, int16_t dx, int16_t dy),
+      scroll(int16_t dx, int16_t dy, uint16_t fill = 0);
+
+  /**********************************************************************/
+  /*!
+    @brief  Copy a rectangle to elsewhere in this canvas; the two may
+            overlap. Same as blit() from this canvas.
+    @param  sx  Left column of source rect
+    @param  sy  Top row of source rect
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  dx  Left column of destination
+    @param  dy  Top row of destination
+  */
+  /**********************************************************************/
+  void copyRect(int16_t sx, int16_t sy, int16_t w, int16_t h, int16_t dx,
+                int16_t dy) {
+    blit(this, sx, sy, w, h, dx, dy);
+  }
+
+  void setDirtyTracking(boolean enable);
+  void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+  boolean getDirtyRect(uint8_t i, int16_t *x, int16_t *y, int16_t *w,
+                       int16_t *h) const;
   /**********************************************************************/
   /*!
     @brief    Get a pointer to the internal buffer memory
@@ -350,8 +1477,55 @@ public:
   /**********************************************************************/
   uint16_t *getBuffer(void) const { return buffer; }
 
+  /**********************************************************************/
+  /*!
+    @brief    Query whether pixels are stored byte-swapped (display order)
+    @returns  True if the canvas was constructed with bigEndian set
+  */
+  /**********************************************************************/
+  bool getBigEndian(void) const { return bigEndian; }
+
+  /**********************************************************************/
+  /*!
+    @brief    Query whether dirty-rectangle tracking is enabled
+    @returns  True if drawing operations are recording changed areas
+  */
+  /**********************************************************************/
+  boolean getDirtyTracking(void) const { return dirtyTracking; }
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the number of dirty rectangles currently recorded
+    @returns  0 (canvas unchanged since last clearDirty()) through
+              GFXCANVAS_MAX_DIRTY
+  */
+  /**********************************************************************/
+  uint8_t getDirtyCount(void) const { return dirtyCount; }
+
+  /**********************************************************************/
+  /*!
+    @brief    Forget all recorded dirty rectangles, typically called
+              after the changed areas have been pushed to a display.
+  */
+  /**********************************************************************/
+  void clearDirty(void) { dirtyCount = 0; }
+
+protected:
+  void blendPixel(int16_t x, int16_t y, uint16_t color, uint16_t bg,
+                  uint8_t alpha);
+  void addDirty(int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+  void addDirtyBlit(const GFXblit &b);
+  void fillRectRaw(int16_t x, int16_t y, int16_t w, int16_t h,
+                   uint16_t color);
+
 private:
   uint16_t *buffer;
+  bool bigEndian;
+  boolean dirtyTracking;
+  uint8_t dirtyCount;
+  struct {
+    int16_t x1, y1, x2, y2; // Inclusive corners, unrotated buffer coords
+  } dirty[GFXCANVAS_MAX_DIRTY];
 };
 
 #endif // _ADAFRUIT_GFX_H
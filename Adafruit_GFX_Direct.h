@@ -0,0 +1,610 @@
+/*!
+ * @file Adafruit_GFX_Direct.h
+ *
+ * Part of Adafruit's GFX graphics library. The core shape algorithms as a
+ * template on a concrete display or canvas class, so their pixel and span
+ * writes are bound at compile time instead of through the vtable.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_GFX_DIRECT_H_
+#define _ADAFRUIT_GFX_DIRECT_H_
+
+#include "Adafruit_GFX.h"
+
+// Compile-time check of which class in D's hierarchy declares a drawing
+// member: Adafruit_GFX's own write*() functions just call the draw*()
+// ones through the vtable, so where D still has those, the draw*()
+// function is called (statically) in their place. Deduction picks out the
+// one overload of the right arity, e.g. SPITFT's 3-argument writePixel().
+template <class C> C *gfxOwner(void (C::*)(int16_t, int16_t, uint16_t));
+template <class C>
+C *gfxOwner(void (C::*)(int16_t, int16_t, int16_t, uint16_t));
+template <class C>
+C *gfxOwner(void (C::*)(int16_t, int16_t, int16_t, int16_t, uint16_t));
+
+/// value is nonzero if A and B are the same type (no <type_traits> on AVR)
+template <class A, class B> struct GFXsameType {
+  enum { value = 0 }; ///< Different types
+};
+/// Same-type specialization of GFXsameType
+template <class A> struct GFXsameType<A, A> {
+  enum { value = 1 }; ///< Same type
+};
+
+/// Nonzero if D's member func is still Adafruit_GFX's default
+#define GFX_DIRECT_DEFAULT(func)                                               \
+  (GFXsameType<decltype(gfxOwner(&D::func)), Adafruit_GFX *>::value)
+
+/*!
+  @brief  Devirtualized drawing for a build with one known display or
+          canvas type D (Adafruit_ILI9341, GFXcanvas16...): the lines,
+          rects, circles, round rects, triangles and 1-bit bitmaps of
+          Adafruit_GFX, in the same pixels, but calling D's own pixel and
+          span functions by qualified name, so each is a direct call the
+          compiler can inline where D defines it inline, rather than a
+          load through the vtable for every pixel or span.
+
+              GFXcanvas16 canvas(240, 135);
+              Adafruit_GFX_Direct<GFXcanvas16> gfx(canvas);
+              gfx.fillCircle(60, 60, 40, 0xF800); // Calls GFXcanvas16's
+              canvas.print("Hello");              // Same object as ever
+
+          This is a thin wrapper holding only a reference: clip rect,
+          origin, rotation and text state all live in the display itself,
+          and everything this doesn't cover (text, masks, copyRect()...)
+          is drawn through the display's usual virtual API, freely mixed.
+
+          D must be the display's exact class (a subclass of it that
+          overrides drawing functions would have those overrides skipped).
+*/
+template <class D> class Adafruit_GFX_Direct {
+public:
+  /*!
+    @brief  Wrap a display or canvas.
+    @param  display  Object to draw on, of exactly class D.
+  */
+  explicit Adafruit_GFX_Direct(D &display) : d(display) {}
+
+  /*!
+    @brief   Get the wrapped display, for anything not drawn through here.
+    @return  The display or canvas passed to the constructor.
+  */
+  D &getDisplay(void) const { return d; }
+
+  /*!
+    @brief  Draw a pixel, as D::drawPixel().
+    @param  x      Column.
+    @param  y      Row.
+    @param  color  16-bit 5-6-5 color.
+  */
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    d.D::drawPixel(x, y, color);
+  }
+
+  /*!
+    @brief  Draw a horizontal line, as D::drawFastHLine().
+    @param  x      Left end.
+    @param  y      Row.
+    @param  w      Width in pixels.
+    @param  color  16-bit 5-6-5 color.
+  */
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    d.D::drawFastHLine(x, y, w, color);
+  }
+
+  /*!
+    @brief  Draw a vertical line, as D::drawFastVLine().
+    @param  x      Column.
+    @param  y      Top end.
+    @param  h      Height in pixels.
+    @param  color  16-bit 5-6-5 color.
+  */
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    d.D::drawFastVLine(x, y, h, color);
+  }
+
+  /*!
+    @brief  Fill a rectangle, as D::fillRect().
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  color  16-bit 5-6-5 color.
+  */
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    d.D::fillRect(x, y, w, h, color);
+  }
+
+  /*!
+    @brief  Fill the whole display, as D::fillScreen().
+    @param  color  16-bit 5-6-5 color.
+  */
+  void fillScreen(uint16_t color) { d.D::fillScreen(color); }
+
+  /*!
+    @brief  Draw a line, as Adafruit_GFX::drawLine(), in runs: each
+            horizontal (or, for a steep line, vertical) run of pixels is
+            one span.
+    @param  x0     Start column.
+    @param  y0     Start row.
+    @param  x1     End column.
+    @param  y1     End row.
+    @param  color  16-bit 5-6-5 color.
+  */
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                uint16_t color) {
+    GFX_PROFILE_SCOPE(GFX_PROF_LINE, max(abs(x1 - x0), abs(y1 - y0)) + 1);
+    if (x0 == x1) {
+      drawFastVLine(x0, min(y0, y1), abs(y1 - y0) + 1, color);
+    } else if (y0 == y1) {
+      drawFastHLine(min(x0, x1), y0, abs(x1 - x0) + 1, color);
+    } else {
+      begin();
+      line(x0, y0, x1, y1, color);
+      end();
+    }
+  }
+
+  /*!
+    @brief  Draw a rectangle outline, as Adafruit_GFX::drawRect().
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  color  16-bit 5-6-5 color.
+  */
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    GFX_PROFILE_SCOPE(GFX_PROF_RECT, (int32_t)w * h);
+    begin();
+    hline(x, y, w, color);
+    hline(x, y + h - 1, w, color);
+    vline(x, y, h, color);
+    vline(x + w - 1, y, h, color);
+    end();
+  }
+
+  /*!
+    @brief  Draw a circle outline, as Adafruit_GFX::drawCircle().
+    @param  x0     Center column.
+    @param  y0     Center row.
+    @param  r      Radius in pixels.
+    @param  color  16-bit 5-6-5 color.
+  */
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    GFX_PROFILE_SCOPE(GFX_PROF_CIRCLE, (int32_t)(2 * r + 1) * (2 * r + 1));
+    if (!visible(x0 - r, y0 - r, x0 + r, y0 + r))
+      return;
+    begin();
+    pixel(x0, y0 + r, color);
+    pixel(x0, y0 - r, color);
+    pixel(x0 + r, y0, color);
+    pixel(x0 - r, y0, color);
+    arcs(x0, y0, r, 0xF, color);
+    end();
+  }
+
+  /*!
+    @brief  Draw a filled circle, as Adafruit_GFX::fillCircle().
+    @param  x0     Center column.
+    @param  y0     Center row.
+    @param  r      Radius in pixels.
+    @param  color  16-bit 5-6-5 color.
+  */
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    GFX_PROFILE_SCOPE(GFX_PROF_FILLCIRCLE, (int32_t)(2 * r + 1) * (2 * r + 1));
+    if (!visible(x0 - r, y0 - r, x0 + r, y0 + r))
+      return;
+    begin();
+    vline(x0, y0 - r, 2 * r + 1, color);
+    fillArcs(x0, y0, r, 3, 0, color);
+    end();
+  }
+
+  /*!
+    @brief  Draw a rounded rectangle outline, as
+            Adafruit_GFX::drawRoundRect().
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  r      Corner radius, limited to half the shorter side.
+    @param  color  16-bit 5-6-5 color.
+  */
+  void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                     uint16_t color) {
+    GFX_PROFILE_SCOPE(GFX_PROF_ROUNDRECT, (int32_t)w * h);
+    if (!visible(x, y, x + w - 1, y + h - 1))
+      return;
+    int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
+    if (r > max_radius)
+      r = max_radius;
+    begin();
+    hline(x + r, y, w - 2 * r, color);         // Top
+    hline(x + r, y + h - 1, w - 2 * r, color); // Bottom
+    vline(x, y + r, h - 2 * r, color);         // Left
+    vline(x + w - 1, y + r, h - 2 * r, color); // Right
+    arcs(x + r, y + r, r, 1, color);
+    arcs(x + w - r - 1, y + r, r, 2, color);
+    arcs(x + w - r - 1, y + h - r - 1, r, 4, color);
+    arcs(x + r, y + h - r - 1, r, 8, color);
+    end();
+  }
+
+  /*!
+    @brief  Draw a filled rounded rectangle, as
+            Adafruit_GFX::fillRoundRect().
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  r      Corner radius, limited to half the shorter side.
+    @param  color  16-bit 5-6-5 color.
+  */
+  void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                     uint16_t color) {
+    GFX_PROFILE_SCOPE(GFX_PROF_FILLROUNDRECT, (int32_t)w * h);
+    if (!visible(x, y, x + w - 1, y + h - 1))
+      return;
+    int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
+    if (r > max_radius)
+      r = max_radius;
+    begin();
+    rect(x + r, y, w - 2 * r, h, color);
+    fillArcs(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
+    fillArcs(x + r, y + r, r, 2, h - 2 * r - 1, color);
+    end();
+  }
+
+  /*!
+    @brief  Draw a triangle outline, as Adafruit_GFX::drawTriangle().
+    @param  x0     Vertex #0 column.
+    @param  y0     Vertex #0 row.
+    @param  x1     Vertex #1 column.
+    @param  y1     Vertex #1 row.
+    @param  x2     Vertex #2 column.
+    @param  y2     Vertex #2 row.
+    @param  color  16-bit 5-6-5 color.
+  */
+  void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                    int16_t x2, int16_t y2, uint16_t color) {
+    GFX_PROFILE_SCOPE(GFX_PROF_TRIANGLE, 0);
+    drawLine(x0, y0, x1, y1, color);
+    drawLine(x1, y1, x2, y2, color);
+    drawLine(x2, y2, x0, y0, color);
+  }
+
+  /*!
+    @brief  Draw a filled triangle, as Adafruit_GFX::fillTriangle(): one
+            span per row, rows outside the clip rect skipped.
+    @param  x0     Vertex #0 column.
+    @param  y0     Vertex #0 row.
+    @param  x1     Vertex #1 column.
+    @param  y1     Vertex #1 row.
+    @param  x2     Vertex #2 column.
+    @param  y2     Vertex #2 row.
+    @param  color  16-bit 5-6-5 color.
+  */
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                    int16_t x2, int16_t y2, uint16_t color) {
+    GFX_PROFILE_SCOPE(GFX_PROF_FILLTRIANGLE, 0);
+    // Sort coordinates by Y order (y2 >= y1 >= y0)
+    if (y0 > y1) {
+      swap(&y0, &y1);
+      swap(&x0, &x1);
+    }
+    if (y1 > y2) {
+      swap(&y2, &y1);
+      swap(&x2, &x1);
+    }
+    if (y0 > y1) {
+      swap(&y0, &y1);
+      swap(&x0, &x1);
+    }
+    int16_t a = min(x0, min(x1, x2)), b = max(x0, max(x1, x2)), cx1, cy1,
+            cx2, cy2;
+    bounds(&cx1, &cy1, &cx2, &cy2);
+    if ((y0 > cy2) || (y2 < cy1) || (a > cx2) || (b < cx1))
+      return;
+    begin();
+    if (y0 == y2) { // All on one line
+      hline(a, y0, b - a + 1, color);
+      end();
+      return;
+    }
+    int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
+            dx12 = x2 - x1, dy12 = y2 - y1;
+    // Upper part takes in row y1 only if flat-bottomed (then the lower
+    // loop is skipped); either way neither loop divides by 0
+    int16_t last = (y1 == y2) ? y1 : y1 - 1;
+    int16_t y = (y0 < cy1) ? cy1 : y0, stop = (last < cy2) ? last : cy2;
+    int32_t sa = (int32_t)dx01 * (y - y0), sb = (int32_t)dx02 * (y - y0);
+    for (; y <= stop; y++, sa += dx01, sb += dx02) {
+      a = x0 + sa / dy01;
+      b = x0 + sb / dy02;
+      if (a > b)
+        swap(&a, &b);
+      hline(a, y, b - a + 1, color);
+    }
+    if (y <= last)
+      y = last + 1;
+    stop = (y2 < cy2) ? y2 : cy2;
+    sa = (int32_t)dx12 * (y - y1);
+    sb = (int32_t)dx02 * (y - y0);
+    for (; y <= stop; y++, sa += dx12, sb += dx02) {
+      a = x1 + sa / dy12;
+      b = x0 + sb / dy02;
+      if (a > b)
+        swap(&a, &b);
+      hline(a, y, b - a + 1, color);
+    }
+    end();
+  }
+
+  /*!
+    @brief  Draw a PROGMEM-resident 1-bit image, set bits in one color and
+            unset bits left alone, as Adafruit_GFX::drawBitmap(): each run
+            of set bits along a row is one span.
+    @param  x       Left edge.
+    @param  y       Top edge.
+    @param  bitmap  Image, rows padded to whole bytes, MSB leftmost.
+    @param  w       Width in pixels.
+    @param  h       Height in pixels.
+    @param  color   16-bit 5-6-5 color of set bits.
+  */
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color) {
+    GFX_PROFILE_SCOPE(GFX_PROF_BITMAP, (int32_t)w * h);
+    bitmapRuns(x, y, bitmap, w, h, color, 0, false);
+  }
+
+  /*!
+    @brief  Draw a PROGMEM-resident 1-bit image in two colors, as
+            Adafruit_GFX::drawBitmap(): each run of equal bits along a row
+            is one span.
+    @param  x       Left edge.
+    @param  y       Top edge.
+    @param  bitmap  Image, rows padded to whole bytes, MSB leftmost.
+    @param  w       Width in pixels.
+    @param  h       Height in pixels.
+    @param  color   16-bit 5-6-5 color of set bits.
+    @param  bg      16-bit 5-6-5 color of unset bits.
+  */
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color, uint16_t bg) {
+    GFX_PROFILE_SCOPE(GFX_PROF_BITMAP, (int32_t)w * h);
+    bitmapRuns(x, y, bitmap, w, h, color, bg, true);
+  }
+
+  /*!
+    @brief  Draw a RAM-resident 16-bit image, as D::drawRGBBitmap().
+    @param  x       Left edge.
+    @param  y       Top edge.
+    @param  bitmap  w * h 16-bit 5-6-5 pixels, row by row.
+    @param  w       Width in pixels.
+    @param  h       Height in pixels.
+  */
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w,
+                     int16_t h) {
+    d.D::drawRGBBitmap(x, y, bitmap, w, h);
+  }
+
+private:
+  D &d; ///< Display drawn on
+
+  // Drawing steps, statically bound: D's write*() function if it has one
+  // of its own (some class from Adafruit_GFX down to D declares it), else
+  // the draw*() one that Adafruit_GFX's default would call anyway.
+  void begin(void) { d.D::startWrite(); }
+  void end(void) { d.D::endWrite(); }
+  void pixel(int16_t x, int16_t y, uint16_t color) {
+    if (GFX_DIRECT_DEFAULT(writePixel))
+      d.D::drawPixel(x, y, color);
+    else
+      d.D::writePixel(x, y, color);
+  }
+  void hline(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    if (GFX_DIRECT_DEFAULT(writeFastHLine))
+      d.D::drawFastHLine(x, y, w, color);
+    else
+      d.D::writeFastHLine(x, y, w, color);
+  }
+  void vline(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    if (GFX_DIRECT_DEFAULT(writeFastVLine))
+      d.D::drawFastVLine(x, y, h, color);
+    else
+      d.D::writeFastVLine(x, y, h, color);
+  }
+  void rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (GFX_DIRECT_DEFAULT(writeFillRect))
+      d.D::fillRect(x, y, w, h, color);
+    else
+      d.D::writeFillRect(x, y, w, h, color);
+  }
+
+  static void swap(int16_t *a, int16_t *b) {
+    int16_t t = *a;
+    *a = *b;
+    *b = t;
+  }
+
+  // Clip rect in drawing coordinates (getClipRect() is display coords)
+  void bounds(int16_t *x1, int16_t *y1, int16_t *x2, int16_t *y2) const {
+    int16_t w, h;
+    d.getClipRect(x1, y1, &w, &h);
+    *x1 -= d.getOriginX();
+    *y1 -= d.getOriginY();
+    *x2 = *x1 + w - 1;
+    *y2 = *y1 + h - 1;
+  }
+
+  // True if box (x1, y1)-(x2, y2), corners either way round, overlaps the
+  // clip rect at all
+  bool visible(int16_t x1, int16_t y1, int16_t x2, int16_t y2) const {
+    int16_t cx1, cy1, cx2, cy2;
+    bounds(&cx1, &cy1, &cx2, &cy2);
+    if (x1 > x2)
+      swap(&x1, &x2);
+    if (y1 > y2)
+      swap(&y1, &y2);
+    return (x1 <= cx2) && (x2 >= cx1) && (y1 <= cy2) && (y2 >= cy1);
+  }
+
+  // Bresenham's line, same pixels as Adafruit_GFX::writeLine(), emitted
+  // as one span per run along the major axis
+  void line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+      swap(&x0, &y0);
+      swap(&x1, &y1);
+    }
+    if (x0 > x1) {
+      swap(&x0, &x1);
+      swap(&y0, &y1);
+    }
+    int16_t dx = x1 - x0, dy = abs(y1 - y0), err = dx / 2,
+            ystep = (y0 < y1) ? 1 : -1, run = x0;
+    for (; x0 <= x1; x0++) {
+      err -= dy;
+      if ((err < 0) || (x0 == x1)) { // Minor axis steps after this pixel
+        if (steep)
+          vline(y0, run, x0 - run + 1, color);
+        else
+          hline(run, y0, x0 - run + 1, color);
+        y0 += ystep;
+        err += dx;
+        run = x0 + 1;
+      }
+    }
+  }
+
+  // Quarter-circle outlines for the corners set (1 top left, 2 top right,
+  // 4 bottom right, 8 bottom left): the pixels of
+  // Adafruit_GFX::drawCircleHelper(), each run of them sharing a row
+  // (octants by the top and bottom) or column (by the sides) one span
+  void arcs(int16_t x0, int16_t y0, int16_t r, uint8_t corners,
+            uint16_t color) {
+    int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r, runX = 1,
+            runY = r;
+    while (x < y) {
+      if (f >= 0) {
+        y--;
+        ddF_y += 2;
+        f += ddF_y;
+      }
+      x++;
+      ddF_x += 2;
+      f += ddF_x;
+      if (y != runY) { // Row changed, previous run is complete
+        arcRun(x0, y0, runX, x - 1, runY, corners, color);
+        runX = x;
+        runY = y;
+      }
+    }
+    arcRun(x0, y0, runX, x, runY, corners, color);
+  }
+
+  // One run of arcs(): offsets xa thru xb at offset y, in each octant
+  void arcRun(int16_t x0, int16_t y0, int16_t xa, int16_t xb, int16_t y,
+              uint8_t corners, uint16_t color) {
+    int16_t n = xb - xa + 1;
+    if (n <= 0)
+      return;
+    if (corners & 0x4) {
+      hline(x0 + xa, y0 + y, n, color);
+      vline(x0 + y, y0 + xa, n, color);
+    }
+    if (corners & 0x2) {
+      hline(x0 + xa, y0 - y, n, color);
+      vline(x0 + y, y0 - xb, n, color);
+    }
+    if (corners & 0x8) {
+      vline(x0 - y, y0 + xa, n, color);
+      hline(x0 - xb, y0 + y, n, color);
+    }
+    if (corners & 0x1) {
+      vline(x0 - y, y0 - xb, n, color);
+      hline(x0 - xb, y0 - y, n, color);
+    }
+  }
+
+  // Filled quarter circles, as Adafruit_GFX::fillCircleHelper(): corners
+  // 1 right, 2 left, columns stretched by delta for round rects
+  void fillArcs(int16_t x0, int16_t y0, int16_t r, uint8_t corners,
+                int16_t delta, uint16_t color) {
+    int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r, px = x,
+            py = y;
+    delta++; // Avoid some +1's in the loop
+    while (x < y) {
+      if (f >= 0) {
+        y--;
+        ddF_y += 2;
+        f += ddF_y;
+      }
+      x++;
+      ddF_x += 2;
+      f += ddF_x;
+      // These checks avoid double-drawing certain lines, important
+      // for the SSD1306 library which has an INVERT drawing mode.
+      if (x < (y + 1)) {
+        if (corners & 1)
+          vline(x0 + x, y0 - y, 2 * y + delta, color);
+        if (corners & 2)
+          vline(x0 - x, y0 - y, 2 * y + delta, color);
+      }
+      if (y != py) {
+        if (corners & 1)
+          vline(x0 + py, y0 - px, 2 * px + delta, color);
+        if (corners & 2)
+          vline(x0 - py, y0 - px, 2 * px + delta, color);
+        py = y;
+      }
+      px = x;
+    }
+  }
+
+  // 1-bit PROGMEM image as runs of equal bits per visible row; unset bits
+  // drawn in bg only if opaque
+  void bitmapRuns(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color, uint16_t bg, bool opaque) {
+    int16_t cx1, cy1, cx2, cy2;
+    bounds(&cx1, &cy1, &cx2, &cy2);
+    int16_t byteWidth = (w + 7) / 8, j = (y < cy1) ? cy1 - y : 0,
+            j1 = (y + h - 1 > cy2) ? cy2 - y + 1 : h;
+    if ((w <= 0) || (j >= j1) || (x > cx2) || (x + w - 1 < cx1))
+      return;
+    begin();
+    for (; j < j1; j++) {
+      const uint8_t *row = &bitmap[j * byteWidth];
+      uint8_t byte = 0;
+      bool on = false;
+      int16_t run = 0;
+      for (int16_t i = 0; i <= w; i++) {
+        bool bit = false;
+        if (i < w) {
+          if (i & 7)
+            byte <<= 1;
+          else
+            byte = pgm_read_byte(&row[i / 8]);
+          bit = byte & 0x80;
+        }
+        if ((i == w) || (bit != on)) { // Run ends before pixel i
+          if ((i > run) && (on || opaque))
+            hline(x + run, y + j, i - run, on ? color : bg);
+          on = bit;
+          run = i;
+        }
+      }
+    }
+    end();
+  }
+};
+
+#undef GFX_DIRECT_DEFAULT
+
+#endif // end _ADAFRUIT_GFX_DIRECT_H_
@@ -0,0 +1,288 @@
+/*!
+ * @file Adafruit_RedrawManager.cpp
+ *
+ * Part of Adafruit's GFX graphics library. Invalid-region tracking and
+ * clipped widget redraw. See Adafruit_RedrawManager.h for usage.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_RedrawManager.h"
+
+/*!
+    @brief  Constructor. Starts with no widgets and nothing invalid.
+    @param  gfx  Display or canvas the widgets are drawn on.
+*/
+Adafruit_RedrawManager::Adafruit_RedrawManager(Adafruit_GFX *gfx)
+    : _gfx(gfx), _count(0), _bg(0), _fillBg(false) {
+  for (uint8_t i = 0; i < REDRAW_MAX_WIDGETS; i++)
+    _widget[i].draw = NULL;
+}
+
+/*!
+    @brief   Add a widget on top of those already added. Its area isn't
+             invalidated; call invalidateWidget() to have it drawn.
+    @param   x     Left edge.
+    @param   y     Top edge.
+    @param   w     Width in pixels.
+    @param   h     Height in pixels.
+    @param   draw  Function that draws the widget.
+    @param   arg   Passed to draw, e.g. a pointer to the widget's state.
+    @return  Widget ID for the other widget functions, or -1 if all
+             REDRAW_MAX_WIDGETS slots are taken. A slot freed by
+             removeWidget() is reused, taking that slot's stacking order.
+*/
+int8_t Adafruit_RedrawManager::addWidget(int16_t x, int16_t y, int16_t w,
+                                         int16_t h, RedrawCallback draw,
+                                         void *arg) {
+  if (!draw)
+    return -1;
+  for (uint8_t i = 0; i < REDRAW_MAX_WIDGETS; i++) {
+    Widget *wd = &_widget[i];
+    if (!wd->draw) {
+      wd->draw = draw;
+      wd->arg = arg;
+      wd->x = x;
+      wd->y = y;
+      wd->w = w;
+      wd->h = h;
+      wd->visible = true;
+      return i;
+    }
+  }
+  return -1;
+}
+
+/*!
+    @brief  Remove a widget, invalidating the area it covered.
+    @param  id  Widget ID from addWidget().
+*/
+void Adafruit_RedrawManager::removeWidget(int8_t id) {
+  if (valid(id)) {
+    invalidateWidget(id);
+    _widget[id].draw = NULL;
+  }
+}
+
+/*!
+    @brief  Move or resize a widget, invalidating where it was and where
+            it now is.
+    @param  id  Widget ID from addWidget().
+    @param  x   New left edge.
+    @param  y   New top edge.
+    @param  w   New width in pixels.
+    @param  h   New height in pixels.
+*/
+void Adafruit_RedrawManager::moveWidget(int8_t id, int16_t x, int16_t y,
+                                        int16_t w, int16_t h) {
+  if (valid(id)) {
+    Widget *wd = &_widget[id];
+    invalidateWidget(id);
+    wd->x = x;
+    wd->y = y;
+    wd->w = w;
+    wd->h = h;
+    invalidateWidget(id);
+  }
+}
+
+/*!
+    @brief  Show or hide a widget, invalidating its area if that changes.
+            A hidden widget keeps its slot and stacking order.
+    @param  id       Widget ID from addWidget().
+    @param  visible  true to draw the widget, false not to.
+*/
+void Adafruit_RedrawManager::showWidget(int8_t id, bool visible) {
+  if (valid(id) && (_widget[id].visible != visible)) {
+    _widget[id].visible = visible;
+    Widget *wd = &_widget[id];
+    invalidate(wd->x, wd->y, wd->w, wd->h);
+  }
+}
+
+/*!
+    @brief  Invalidate the whole of a widget's area, e.g. after its state
+            changed.
+    @param  id  Widget ID from addWidget().
+*/
+void Adafruit_RedrawManager::invalidateWidget(int8_t id) {
+  if (valid(id)) {
+    Widget *wd = &_widget[id];
+    invalidate(wd->x, wd->y, wd->w, wd->h);
+  }
+}
+
+/*!
+    @brief  Mark an area as needing redraw. It merges with any invalid
+            region it overlaps or touches (and the result with any that
+            touches, and so on); if it's separate from all of them and
+            REDRAW_MAX_REGIONS are already held, everything is merged
+            into one bounding box instead.
+    @param  x  Left edge.
+    @param  y  Top edge.
+    @param  w  Width in pixels.
+    @param  h  Height in pixels.
+*/
+void Adafruit_RedrawManager::invalidate(int16_t x, int16_t y, int16_t w,
+                                        int16_t h) {
+  int32_t x2 = (int32_t)x + w - 1, y2 = (int32_t)y + h - 1;
+  if (x < 0)
+    x = 0;
+  if (y < 0)
+    y = 0;
+  if (x2 >= _gfx->width())
+    x2 = _gfx->width() - 1;
+  if (y2 >= _gfx->height())
+    y2 = _gfx->height() - 1;
+  if ((x2 < x) || (y2 < y))
+    return; // Off screen
+  Region n = {x, y, (int16_t)x2, (int16_t)y2};
+  for (uint8_t i = 0; i < _count;) {
+    Region *r = &_region[i];
+    if ((n.x1 <= r->x2 + 1) && (n.x2 >= r->x1 - 1) && (n.y1 <= r->y2 + 1) &&
+        (n.y2 >= r->y1 - 1)) { // Touches: absorb it and start over
+      n.x1 = min(n.x1, r->x1);
+      n.y1 = min(n.y1, r->y1);
+      n.x2 = max(n.x2, r->x2);
+      n.y2 = max(n.y2, r->y2);
+      *r = _region[--_count];
+      i = 0;
+    } else {
+      i++;
+    }
+  }
+  if (_count == REDRAW_MAX_REGIONS) { // Full: one bounding box for all
+    for (uint8_t i = 0; i < _count; i++) {
+      n.x1 = min(n.x1, _region[i].x1);
+      n.y1 = min(n.y1, _region[i].y1);
+      n.x2 = max(n.x2, _region[i].x2);
+      n.y2 = max(n.y2, _region[i].y2);
+    }
+    _count = 0;
+  }
+  _region[_count++] = n;
+}
+
+/*!
+    @brief  Invalidate the whole screen.
+*/
+void Adafruit_RedrawManager::invalidateAll(void) {
+  _count = 0;
+  invalidate(0, 0, _gfx->width(), _gfx->height());
+}
+
+/*!
+    @brief  Mark an area as up to date, e.g. after drawing it some other
+            way. Regions inside it are dropped, and regions it covers
+            from one edge are trimmed; a region it would split in two is
+            left whole, so at worst a little more is redrawn than needed.
+    @param  x  Left edge.
+    @param  y  Top edge.
+    @param  w  Width in pixels.
+    @param  h  Height in pixels.
+*/
+void Adafruit_RedrawManager::validate(int16_t x, int16_t y, int16_t w,
+                                      int16_t h) {
+  int32_t x2 = (int32_t)x + w - 1, y2 = (int32_t)y + h - 1;
+  for (uint8_t i = 0; i < _count;) {
+    Region *r = &_region[i];
+    bool spanX = (x <= r->x1) && (x2 >= r->x2),
+         spanY = (y <= r->y1) && (y2 >= r->y2);
+    if (spanX && spanY) { // Covered entirely
+      *r = _region[--_count];
+      continue;
+    }
+    if (spanX) { // Full width: trim rows from the top or bottom
+      if ((y <= r->y1) && (y2 >= r->y1))
+        r->y1 = y2 + 1;
+      else if ((y2 >= r->y2) && (y <= r->y2))
+        r->y2 = y - 1;
+    } else if (spanY) { // Full height: trim columns from left or right
+      if ((x <= r->x1) && (x2 >= r->x1))
+        r->x1 = x2 + 1;
+      else if ((x2 >= r->x2) && (x <= r->x2))
+        r->x2 = x - 1;
+    }
+    i++;
+  }
+}
+
+/*!
+    @brief   Redraw the invalid regions, then mark everything valid. For
+             each region: the background fill (see setBackground()), then
+             each visible widget it intersects, bottom to top, with the
+             clip rect set to the overlap of region and widget and the
+             origin at the widget's top left. All in one write transaction.
+    @return  true if anything was redrawn, false if nothing was invalid.
+*/
+bool Adafruit_RedrawManager::redraw(void) {
+  if (!_count)
+    return false;
+  int16_t ox = _gfx->getOriginX(), oy = _gfx->getOriginY(), cx, cy, cw, ch;
+  _gfx->getClipRect(&cx, &cy, &cw, &ch);
+  _gfx->startWrite();
+  for (uint8_t i = 0; i < _count; i++) {
+    const Region &r = _region[i];
+    if (_fillBg) {
+      _gfx->setOrigin(0, 0);
+      _gfx->setClipRect(r.x1, r.y1, r.x2 - r.x1 + 1, r.y2 - r.y1 + 1);
+      _gfx->fillRect(r.x1, r.y1, r.x2 - r.x1 + 1, r.y2 - r.y1 + 1, _bg);
+    }
+    for (uint8_t j = 0; j < REDRAW_MAX_WIDGETS; j++) {
+      const Widget &wd = _widget[j];
+      if (!wd.draw || !wd.visible)
+        continue;
+      int16_t x1 = max(r.x1, wd.x), y1 = max(r.y1, wd.y),
+              x2 = min((int32_t)r.x2, (int32_t)wd.x + wd.w - 1),
+              y2 = min((int32_t)r.y2, (int32_t)wd.y + wd.h - 1);
+      if ((x2 < x1) || (y2 < y1))
+        continue; // Doesn't intersect this region
+      _gfx->setClipRect(x1, y1, x2 - x1 + 1, y2 - y1 + 1);
+      _gfx->setOrigin(wd.x, wd.y);
+      wd.draw(_gfx, wd.arg, wd.w, wd.h);
+    }
+  }
+  _gfx->endWrite();
+  _gfx->setOrigin(ox, oy);
+  _gfx->setClipRect(cx, cy, cw, ch);
+  _count = 0;
+  return true;
+}
+
+/*!
+    @brief   Get one of the invalid regions redraw() would draw, e.g. to
+             push just those areas of a canvas some other way.
+    @param   i  Index, 0 thru getRegionCount() - 1.
+    @param   x  Pointer to left edge.
+    @param   y  Pointer to top edge.
+    @param   w  Pointer to width.
+    @param   h  Pointer to height.
+    @return  true if i is in range (and the region was returned).
+*/
+bool Adafruit_RedrawManager::getRegion(uint8_t i, int16_t *x, int16_t *y,
+                                       int16_t *w, int16_t *h) const {
+  if (i >= _count)
+    return false;
+  *x = _region[i].x1;
+  *y = _region[i].y1;
+  *w = _region[i].x2 - _region[i].x1 + 1;
+  *h = _region[i].y2 - _region[i].y1 + 1;
+  return true;
+}
+
+/*!
+    @brief   Check a widget ID.
+    @param   id  Widget ID from addWidget().
+    @return  true if it's a widget in use.
+*/
+bool Adafruit_RedrawManager::valid(int8_t id) const {
+  return (id >= 0) && (id < REDRAW_MAX_WIDGETS) && _widget[id].draw;
+}
+
+#endif // end __AVR_ATtiny85__
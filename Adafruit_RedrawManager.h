@@ -0,0 +1,137 @@
+/*!
+ * @file Adafruit_RedrawManager.h
+ *
+ * Part of Adafruit's GFX graphics library. Keeps track of what parts of
+ * a screen of widgets need redrawing and redraws just those, through the
+ * clip rect, on any Adafruit_GFX display or canvas.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_REDRAWMANAGER_H_
+#define _ADAFRUIT_REDRAWMANAGER_H_
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_GFX.h"
+
+#ifndef REDRAW_MAX_REGIONS
+#define REDRAW_MAX_REGIONS 8 ///< Max # of separate invalid regions held
+#endif
+
+#ifndef REDRAW_MAX_WIDGETS
+#define REDRAW_MAX_WIDGETS 16 ///< Max # of widgets a manager can hold
+#endif
+
+/*!
+  @brief  Draws one widget. Called by Adafruit_RedrawManager::redraw()
+          with the drawing origin at the widget's top left corner and the
+          clip rect set to the part being redrawn, so a widget can simply
+          draw itself whole: only what's needed reaches the display.
+  @param  gfx  Display or canvas to draw on.
+  @param  arg  Passed through from addWidget(), e.g. the widget's state.
+  @param  w    Width of widget, as given to addWidget() or moveWidget().
+  @param  h    Height of widget.
+*/
+typedef void (*RedrawCallback)(Adafruit_GFX *gfx, void *arg, int16_t w,
+                               int16_t h);
+
+/*!
+  @brief  An invalidation model for a screen made of widgets: rectangles
+          whose contents change are invalidated, and redraw() then draws,
+          for each invalid region, only the widgets that intersect it,
+          bottom to top in the order they were added, clipped to the
+          region. Touching or overlapping invalid rectangles merge into
+          one region; past REDRAW_MAX_REGIONS, everything merges into
+          their bounding box. Typical use:
+
+              Adafruit_RedrawManager screen(&tft);
+              int8_t bg = screen.addWidget(0, 0, 320, 240, drawBackdrop);
+              int8_t temp = screen.addWidget(20, 20, 120, 40, drawTemp,
+                                             &tempState);
+              ...
+              tempState.value = newReading;  // Something changed...
+              screen.invalidateWidget(temp); // ...say where...
+              screen.redraw();               // ...and draw just that
+
+          On a GFXcanvas16 with dirty tracking on (see setDirtyTracking()),
+          what redraw() draws is recorded as the canvas draws it, so
+          Adafruit_SPITFT::flushCanvas() then sends only those areas.
+          Coordinates are display (or canvas) coordinates, unaffected by
+          setOrigin(); the origin and clip rect in force before redraw()
+          are put back afterward.
+*/
+class Adafruit_RedrawManager {
+public:
+  Adafruit_RedrawManager(Adafruit_GFX *gfx);
+
+  int8_t addWidget(int16_t x, int16_t y, int16_t w, int16_t h,
+                   RedrawCallback draw, void *arg = NULL);
+  void removeWidget(int8_t id);
+  void moveWidget(int8_t id, int16_t x, int16_t y, int16_t w, int16_t h);
+  void showWidget(int8_t id, bool visible);
+  void invalidateWidget(int8_t id);
+
+  void invalidate(int16_t x, int16_t y, int16_t w, int16_t h);
+  void invalidateAll(void);
+  void validate(int16_t x, int16_t y, int16_t w, int16_t h);
+  /*!
+    @brief  Forget all invalid regions without redrawing them, e.g. after
+            drawing the whole screen some other way.
+  */
+  void validateAll(void) { _count = 0; }
+  bool redraw(void);
+
+  /*!
+    @brief  Fill each region with a color before its widgets are drawn,
+            for screens whose widgets don't cover everything.
+    @param  color  16-bit 5-6-5 background color.
+    @param  fill   true (default) to fill, false to leave regions as they
+                   are (the default until this is called).
+  */
+  void setBackground(uint16_t color, bool fill = true) {
+    _bg = color;
+    _fillBg = fill;
+  }
+
+  /*!
+    @brief   Get how many invalid regions are waiting for redraw().
+    @return  0 (nothing to redraw) thru REDRAW_MAX_REGIONS.
+  */
+  uint8_t getRegionCount(void) const { return _count; }
+  bool getRegion(uint8_t i, int16_t *x, int16_t *y, int16_t *w,
+                 int16_t *h) const;
+
+private:
+  /// An invalid area, inclusive corners
+  typedef struct {
+    int16_t x1, y1, x2, y2;
+  } Region;
+
+  /// A widget's place on screen and how to draw it
+  typedef struct {
+    RedrawCallback draw; ///< Draw function, NULL for a free slot
+    void *arg;           ///< Passed to draw
+    int16_t x;           ///< Left edge
+    int16_t y;           ///< Top edge
+    int16_t w;           ///< Width
+    int16_t h;           ///< Height
+    bool visible;        ///< If clear, widget isn't drawn
+  } Widget;
+
+  bool valid(int8_t id) const;
+
+  Adafruit_GFX *_gfx;                  ///< Display or canvas drawn on
+  Region _region[REDRAW_MAX_REGIONS];  ///< Invalid regions
+  Widget _widget[REDRAW_MAX_WIDGETS];  ///< Widgets, bottom to top
+  uint8_t _count;                      ///< Invalid regions held
+  uint16_t _bg;                        ///< Background color
+  bool _fillBg;                        ///< If set, regions are filled first
+};
+
+#endif // end __AVR_ATtiny85__
+#endif // end _ADAFRUIT_REDRAWMANAGER_H_
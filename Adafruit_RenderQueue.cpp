@@ -0,0 +1,349 @@
+/*!
+ * @file Adafruit_RenderQueue.cpp
+ *
+ * Part of Adafruit's GFX graphics library. Display-task command queue
+ * for Adafruit_SPITFT. See Adafruit_RenderQueue.h for usage.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_RenderQueue.h"
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif // The Adafruit nRF52 core's Arduino.h brings in FreeRTOS
+
+// The ring's indices count commands forever (wrapping at 2^32); a slot is
+// index % RENDERQUEUE_SIZE. Only the producer writes _tail, only the
+// consumer _head, each after a barrier so the other side never sees an
+// index ahead of the command data it covers.
+#if defined(RENDERQUEUE_RTOS)
+#define RQ_BARRIER() __sync_synchronize() ///< Order memory across cores
+#else
+#define RQ_BARRIER() ///< Single task, nothing to order
+#endif
+
+#if defined(RENDERQUEUE_RTOS)
+// FreeRTOS task entry point
+static void renderTask(void *queue) { ((Adafruit_RenderQueue *)queue)->run(); }
+#endif
+
+/*!
+    @brief  Constructor. Commands are carried out synchronously until
+            begin() starts the display task.
+*/
+Adafruit_RenderQueue::Adafruit_RenderQueue(void)
+    : _head(0), _tail(0), _task(NULL), _waiter(NULL) {}
+
+/*!
+    @brief  Destructor: finishes what's queued, then stops the task.
+*/
+Adafruit_RenderQueue::~Adafruit_RenderQueue(void) {
+  sync();
+#if defined(RENDERQUEUE_RTOS)
+  if (_task)
+    vTaskDelete((TaskHandle_t)_task);
+#endif
+}
+
+/*!
+    @brief   Start the display task that carries out queued commands.
+             Call after the displays' begin().
+    @param   priority  FreeRTOS priority of the task; 2 (default) is just
+                       above the Arduino loop on both ESP32 and nRF52.
+    @param   core      ESP32 core to run the task on: 0 (default), the
+                       one the Arduino loop doesn't use, or -1 for either.
+                       Ignored on nRF52.
+    @return  true if the task is running; false without FreeRTOS or if
+             it couldn't be created, leaving commands synchronous.
+*/
+bool Adafruit_RenderQueue::begin(uint8_t priority, int8_t core) {
+#if defined(RENDERQUEUE_RTOS)
+  if (_task)
+    return true;
+  TaskHandle_t task = NULL;
+#if defined(ESP32)
+  if (xTaskCreatePinnedToCore(renderTask, "gfx", RENDERQUEUE_STACK, this,
+                              priority, &task,
+                              (core < 0) ? tskNO_AFFINITY : core) != pdPASS)
+    return false;
+#else // Stack depth is in words here
+  if (xTaskCreate(renderTask, "gfx", RENDERQUEUE_STACK / sizeof(StackType_t),
+                  this, priority, &task) != pdPASS)
+    return false;
+#endif
+  _task = task;
+  return true;
+#else
+  return false;
+#endif
+}
+
+/*!
+    @brief   Queue a rectangle of pixels to send to a display.
+    @param   tft        Display to send to.
+    @param   x          Display column of the rect's left edge. Like
+                        Adafruit_SPITFT::flushCanvas(), a display position,
+                        unaffected by setOrigin() or any clip rect.
+    @param   y          Display row of the rect's top edge.
+    @param   w          Width of rect in pixels.
+    @param   h          Height of rect in pixels.
+    @param   pixels     w * h 16-bit 5-6-5 pixels, row by row, left alone
+                        until the ticket is done().
+    @param   bigEndian  true if pixels are already in display byte order,
+                        as in a big-endian GFXcanvas16.
+    @return  Ticket for wait() and done(). If the queue is full, first
+             waits for a slot.
+*/
+uint32_t Adafruit_RenderQueue::pushPixels(Adafruit_SPITFT *tft, int16_t x,
+                                          int16_t y, int16_t w, int16_t h,
+                                          uint16_t *pixels, bool bigEndian) {
+  Command c = Command();
+  c.type = RQ_PIXELS;
+  c.x = x;
+  c.y = y;
+  c.w = w;
+  c.h = h;
+  c.pixels = pixels;
+  c.stride = w;
+  c.bigEndian = bigEndian;
+  return clip(tft, &c) ? add(c) : _tail;
+}
+
+/*!
+    @brief   Queue a GFXcanvas16 to send to a display: the areas changed
+             since it was last pushed if it tracks them (see
+             GFXcanvas16::setDirtyTracking()), each a command of its own,
+             else the whole canvas. The dirty list is cleared as they're
+             queued. Buffer is sent as-is (unrotated), as by flushCanvas().
+    @param   tft     Display to send to.
+    @param   x       Display column of the canvas's left edge.
+    @param   y       Display row of the canvas's top edge.
+    @param   canvas  Canvas to send, not to be drawn into until done.
+    @return  Ticket for wait() and done(), covering every area queued.
+*/
+uint32_t Adafruit_RenderQueue::pushCanvas(Adafruit_SPITFT *tft, int16_t x,
+                                          int16_t y, GFXcanvas16 *canvas) {
+  uint16_t *buf = canvas->getBuffer();
+  if (!buf)
+    return _tail;
+  // Canvas buffer is always laid out at its rotation-0 dimensions
+  int16_t cw = canvas->width(), ch = canvas->height();
+  if (canvas->getRotation() & 1) {
+    int16_t t = cw;
+    cw = ch;
+    ch = t;
+  }
+  if (!canvas->getDirtyTracking())
+    return pushPixels(tft, x, y, cw, ch, buf, canvas->getBigEndian());
+  Command c = Command();
+  c.type = RQ_PIXELS;
+  c.stride = cw;
+  c.bigEndian = canvas->getBigEndian();
+  int16_t rx, ry;
+  for (uint8_t i = 0; canvas->getDirtyRect(i, &rx, &ry, &c.w, &c.h); i++) {
+    c.x = x + rx;
+    c.y = y + ry;
+    c.pixels = &buf[ry * cw + rx];
+    if (clip(tft, &c))
+      add(c);
+  }
+  canvas->clearDirty();
+  return _tail;
+}
+
+/*!
+    @brief   Queue a solid rectangle.
+    @param   tft    Display to fill.
+    @param   x      Display column of the rect's left edge.
+    @param   y      Display row of the rect's top edge.
+    @param   w      Width of rect in pixels.
+    @param   h      Height of rect in pixels.
+    @param   color  16-bit 5-6-5 color.
+    @return  Ticket for wait() and done().
+*/
+uint32_t Adafruit_RenderQueue::fillRect(Adafruit_SPITFT *tft, int16_t x,
+                                        int16_t y, int16_t w, int16_t h,
+                                        uint16_t color) {
+  Command c = Command();
+  c.type = RQ_FILL;
+  c.x = x;
+  c.y = y;
+  c.w = w;
+  c.h = h;
+  c.stride = w;
+  c.pixels = NULL;
+  c.color = color;
+  return clip(tft, &c) ? add(c) : _tail;
+}
+
+/*!
+    @brief   Queue a function to run on the display task once everything
+             queued before it is out: a completion callback (e.g. giving
+             a semaphore, or marking a buffer free), or drawing that must
+             go out in order with the pushes around it.
+    @param   tft  Passed to fn; may be NULL.
+    @param   fn   Function to run. Runs on the display task, so should be
+                  brief and mustn't queue commands itself.
+    @param   arg  Passed to fn.
+    @return  Ticket for wait() and done().
+*/
+uint32_t Adafruit_RenderQueue::call(Adafruit_SPITFT *tft,
+                                    RenderQueueCallback fn, void *arg) {
+  Command c = Command();
+  c.type = RQ_CALL;
+  c.tft = tft;
+  c.fn = fn;
+  c.arg = arg;
+  return add(c);
+}
+
+/*!
+    @brief   Check whether a command has been carried out.
+    @param   ticket  Value returned when it was queued.
+    @return  true if it and everything queued before it are finished.
+*/
+bool Adafruit_RenderQueue::done(uint32_t ticket) const {
+  return (int32_t)(_head - ticket) >= 0;
+}
+
+/*!
+    @brief  Wait for a command to be carried out.
+    @param  ticket  Value returned when it was queued.
+*/
+void Adafruit_RenderQueue::wait(uint32_t ticket) {
+  while (!done(ticket))
+    waitProgress();
+}
+
+/*!
+    @brief  Display task: sleep until commands are queued, carry them out,
+            repeat. Started by begin().
+*/
+void Adafruit_RenderQueue::run(void) {
+#if defined(RENDERQUEUE_RTOS)
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    drain();
+  }
+#endif
+}
+
+/*!
+    @brief   Clip a rect command to its display's edges.
+    @param   tft  Display the command is for.
+    @param   c    Command, rect and pixels adjusted in place.
+    @return  true if any of it is on screen.
+*/
+bool Adafruit_RenderQueue::clip(Adafruit_SPITFT *tft, Command *c) {
+  c->tft = tft;
+  if (c->x < 0) {
+    if (c->pixels)
+      c->pixels -= c->x;
+    c->w += c->x;
+    c->x = 0;
+  }
+  if (c->y < 0) {
+    if (c->pixels)
+      c->pixels -= (int32_t)c->y * c->stride;
+    c->h += c->y;
+    c->y = 0;
+  }
+  if (c->w > tft->width() - c->x)
+    c->w = tft->width() - c->x;
+  if (c->h > tft->height() - c->y)
+    c->h = tft->height() - c->y;
+  return (c->w > 0) && (c->h > 0);
+}
+
+/*!
+    @brief   Put a command in the ring, waiting for a slot if it's full,
+             and wake the display task (or, without one, carry it out).
+    @param   c  Command to queue.
+    @return  Its ticket.
+*/
+uint32_t Adafruit_RenderQueue::add(const Command &c) {
+  while ((uint32_t)(_tail - _head) >= RENDERQUEUE_SIZE)
+    waitProgress();
+  _cmd[_tail % RENDERQUEUE_SIZE] = c;
+  RQ_BARRIER(); // Command in place before the consumer can see it
+  uint32_t ticket = _tail + 1;
+  _tail = ticket;
+#if defined(RENDERQUEUE_RTOS)
+  if (_task) {
+    xTaskNotifyGive((TaskHandle_t)_task);
+    return ticket;
+  }
+#endif
+  drain();
+  return ticket;
+}
+
+/*!
+    @brief  Carry out every queued command, oldest first, waking the
+            producer after each in case it's waiting on one.
+*/
+void Adafruit_RenderQueue::drain(void) {
+  while (_head != _tail) {
+    RQ_BARRIER(); // See the command the producer finished writing
+    execute(_cmd[_head % RENDERQUEUE_SIZE]);
+    RQ_BARRIER(); // Done reading it before the slot is handed back
+    _head = _head + 1;
+#if defined(RENDERQUEUE_RTOS)
+    void *waiter = _waiter;
+    if (waiter)
+      xTaskNotifyGive((TaskHandle_t)waiter);
+#endif
+  }
+}
+
+/*!
+    @brief  Carry out one command on the display's bus.
+    @param  c  Command to carry out.
+*/
+void Adafruit_RenderQueue::execute(const Command &c) {
+  if (c.type == RQ_CALL) {
+    c.fn(c.tft, c.arg);
+    return;
+  }
+  Adafruit_SPITFT *tft = c.tft;
+  uint32_t len = (uint32_t)c.w * c.h;
+  tft->startWrite();
+  tft->writeAddrWindow(c.x, c.y, c.w, c.h);
+  if (c.type == RQ_FILL) {
+    tft->writeColor(c.color, len);
+  } else if (c.w == c.stride) { // Contiguous rows, send in one go
+    tft->writePixels(c.pixels, len, true, c.bigEndian);
+  } else {
+    uint16_t *row = c.pixels;
+    for (int16_t j = 0; j < c.h; j++, row += c.stride)
+      tft->writePixels(row, c.w, true, c.bigEndian);
+  }
+  tft->endWrite();
+}
+
+/*!
+    @brief  Wait for the display task to carry out a command: sleep until
+            it says so, or a tick passes (in case that notice came just
+            before this task started waiting). Without a task, nothing
+            is left pending to wait for.
+*/
+void Adafruit_RenderQueue::waitProgress(void) {
+#if defined(RENDERQUEUE_RTOS)
+  if (_task) {
+    _waiter = xTaskGetCurrentTaskHandle();
+    ulTaskNotifyTake(pdTRUE, 1);
+    return;
+  }
+#endif
+  drain();
+}
+
+#endif // end __AVR_ATtiny85__
@@ -0,0 +1,136 @@
+/*!
+ * @file Adafruit_RenderQueue.h
+ *
+ * Part of Adafruit's GFX graphics library. Hands pixel pushes for
+ * Adafruit_SPITFT displays to a dedicated FreeRTOS task (ESP32, nRF52)
+ * through a lock-free ring, so the drawing task never waits on the bus.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_RENDERQUEUE_H_
+#define _ADAFRUIT_RENDERQUEUE_H_
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_SPITFT.h"
+
+#if defined(ESP32) || defined(ARDUINO_NRF52_ADAFRUIT)
+#define RENDERQUEUE_RTOS ///< FreeRTOS available, begin() can start a task
+#endif
+
+#ifndef RENDERQUEUE_SIZE
+#define RENDERQUEUE_SIZE 16 ///< Max # of commands a queue holds
+#endif
+
+#ifndef RENDERQUEUE_STACK
+#define RENDERQUEUE_STACK 3072 ///< Display task stack, in bytes
+#endif
+
+/*!
+  @brief  Work run on the display task in queue order, for a fence's
+          completion notice or anything else that must go out between two
+          pushes (e.g. a scroll command or drawing straight to tft).
+  @param  tft  Display given to Adafruit_RenderQueue::call(), may be NULL.
+  @param  arg  Passed through from call().
+*/
+typedef void (*RenderQueueCallback)(Adafruit_SPITFT *tft, void *arg);
+
+/*!
+  @brief  An ordered queue of display work (pushes of pixels from memory,
+          fills, callbacks) run by a display task of its own once begin()
+          has started one, so one task (or, on a dual-core ESP32, one
+          core) renders the next frame into canvases while the other
+          drives the bus. Typical use, with two canvases taking turns:
+
+              queue.begin();  // In setup(), after tft.begin()
+              ...
+              GFXcanvas16 *c = canvas[n];
+              queue.wait(ticket[n]);  // Done sending this canvas?
+              drawFrame(c);           // Drawn while the other sends
+              ticket[n] = queue.pushCanvas(&tft, 0, 0, c);
+              n ^= 1;
+
+          Every command returns a ticket: done() and wait() tell when it,
+          and everything queued before it, has been carried out. Until
+          then the pixels it refers to are still being read and must not
+          change. A callback queued with call() runs on the display task
+          once everything before it is out, a completion fence without
+          polling.
+
+          The ring is single-producer, single-consumer: queue commands
+          from one task only. While commands are pending, don't draw to
+          the queue's displays (or others on their bus) except from a
+          call() callback, since the display task may be mid-transfer.
+
+          Where there's no FreeRTOS, or begin() isn't called, commands
+          are carried out as they're queued, so the same sketch runs
+          (synchronously) anywhere.
+*/
+class Adafruit_RenderQueue {
+public:
+  Adafruit_RenderQueue(void);
+  ~Adafruit_RenderQueue(void);
+  bool begin(uint8_t priority = 2, int8_t core = 0);
+
+  uint32_t pushPixels(Adafruit_SPITFT *tft, int16_t x, int16_t y, int16_t w,
+                      int16_t h, uint16_t *pixels, bool bigEndian = false);
+  uint32_t pushCanvas(Adafruit_SPITFT *tft, int16_t x, int16_t y,
+                      GFXcanvas16 *canvas);
+  uint32_t fillRect(Adafruit_SPITFT *tft, int16_t x, int16_t y, int16_t w,
+                    int16_t h, uint16_t color);
+  uint32_t call(Adafruit_SPITFT *tft, RenderQueueCallback fn, void *arg);
+
+  bool done(uint32_t ticket) const;
+  void wait(uint32_t ticket);
+  /*!
+    @brief  Wait for everything queued so far to be carried out.
+  */
+  void sync(void) { wait(_tail); }
+  /*!
+    @brief   Get whether commands run on a display task of their own.
+    @return  true once begin() has started the task.
+  */
+  bool isAsync(void) const { return _task != NULL; }
+
+  void run(void); // Display task body, not for calling directly
+
+private:
+  /// What a command does
+  enum { RQ_PIXELS, RQ_FILL, RQ_CALL };
+
+  /// One queued command
+  typedef struct {
+    Adafruit_SPITFT *tft;   ///< Display to draw to
+    uint16_t *pixels;       ///< RQ_PIXELS: first pixel of top row
+    RenderQueueCallback fn; ///< RQ_CALL: function to run
+    void *arg;              ///< RQ_CALL: passed to fn
+    int16_t x;              ///< Display column of rect's left edge
+    int16_t y;              ///< Display row of rect's top edge
+    int16_t w;              ///< Width of rect
+    int16_t h;              ///< Height of rect
+    int16_t stride;         ///< RQ_PIXELS: pixels from row to row
+    uint16_t color;         ///< RQ_FILL: fill color
+    uint8_t type;           ///< RQ_PIXELS, RQ_FILL or RQ_CALL
+    bool bigEndian;         ///< RQ_PIXELS: already in display byte order
+  } Command;
+
+  bool clip(Adafruit_SPITFT *tft, Command *c);
+  uint32_t add(const Command &c);
+  void drain(void);
+  void execute(const Command &c);
+  void waitProgress(void);
+
+  Command _cmd[RENDERQUEUE_SIZE]; ///< Ring of commands
+  volatile uint32_t _head;        ///< Commands carried out (consumer)
+  volatile uint32_t _tail;        ///< Commands queued (producer)
+  void *volatile _task;           ///< Display task handle, NULL if none
+  void *volatile _waiter;         ///< Producer task, woken on progress
+};
+
+#endif // end __AVR_ATtiny85__
+#endif // end _ADAFRUIT_RENDERQUEUE_H_
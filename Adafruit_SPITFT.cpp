@@ -44,6 +44,15 @@
 #endif
 #endif
 
+#if defined(ESP32)
+#include "esp_heap_caps.h" // heap_caps_malloc() for DMA-capable fill pool
+#endif
+
+#if defined(USE_PIO_PARALLEL)
+#include <hardware/clocks.h> // clock_get_hz() for the write strobe rate
+#include <hardware/dma.h>
+#endif
+
 #if defined(PORT_IOBUS)
 // On SAMD21, redefine digitalPinToPort() to use the slightly-faster
 // PORT_IOBUS rather than PORT (not needed on SAMD51).
@@ -96,6 +105,13 @@ static const struct {
 #define TFT_SOFT_SPI 1 ///< Display interface = software SPI
 #define TFT_PARALLEL 2 ///< Display interface = 8- or 16-bit parallel
 
+// Where PROGMEM is a separate address space (AVR) or flash can't be read a
+// byte at a time like RAM (ESP8266), PROGMEM bitmaps need pgm_read_byte()
+// and can't be handed to functions that read buffers directly.
+#if defined(__AVR__) || defined(ESP8266)
+#define SPITFT_PGM_SEPARATE ///< PROGMEM reads need pgm_read_byte()
+#endif
+
 // CONSTRUCTORS ------------------------------------------------------------
 
 /*!
@@ -347,14 +363,12 @@ Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h, SPIClass *spiClass,
     @brief   Adafruit_SPITFT constructor for parallel display connection.
     @param   w         Display width in pixels at default rotation (0).
     @param   h         Display height in pixels at default rotation (0).
-    @param   busWidth  If tft16 (enumeration in header file), is a 16-bit
-                       parallel connection, else 8-bit.
-                       16-bit isn't fully implemented or tested yet so
-                       applications should pass "tft8bitbus" for now...needed to
-                       stick a required enum argument in there to
-                       disambiguate this constructor from the soft-SPI case.
-                       Argument is ignored on 8-bit architectures (no 'wide'
-                       support there since PORTs are 8 bits anyway).
+    @param   busWidth  If tft16bitbus (enumeration in header file), is a
+                       16-bit parallel connection, else 8-bit. A 16-bit bus
+                       issues each pixel as one word and one write strobe;
+                       command parameters go out as one byte per strobe on
+                       d0-d7. Argument is ignored on AVR (no 'wide' support
+                       there since PORTs are 8 bits anyway).
     @param   d0        Arduino pin # for data bit 0 (1+ are extrapolated).
                        The 8 (or 16) data bits MUST be contiguous and byte-
                        aligned (or word-aligned for wide interface) within
@@ -382,7 +396,13 @@ Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h, tftBusWidth busWidth,
   tft8._d0 = d0;
   tft8._wr = wr;
   tft8._rd = rd;
+#if !defined(__AVR__) // AVR PORTs are 8 bits, wide stays false
   tft8.wide = (busWidth == tft16bitbus);
+#endif
+#if defined(USE_PIO_PARALLEL)
+  tft8.pio = NULL; // State machine and DMA are claimed in initSPI()
+  tft8.dmaChan = -1;
+#endif
 #if defined(USE_FAST_PINIO)
 #if defined(HAS_PORT_SET_CLR)
 #if defined(CORE_TEENSY)
@@ -525,6 +545,7 @@ Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h, tftBusWidth busWidth,
             were generously put in the public section.
 */
 void Adafruit_SPITFT::initSPI(uint32_t freq, uint8_t spiMode) {
+  winValid = false; // Display is about to be reset
 
   if (!freq)
     freq = DEFAULT_SPI_FREQ; // If no freq specified, use default
@@ -635,6 +656,9 @@ void Adafruit_SPITFT::initSPI(uint32_t freq, uint8_t spiMode) {
       pinMode(tft8._rd, OUTPUT);
       digitalWrite(tft8._rd, HIGH);
     }
+#if defined(USE_PIO_PARALLEL)
+    pioBegin(); // Hands data pins and WR over to a state machine
+#endif
   }
 
   if (_rst >= 0) {
@@ -887,6 +911,31 @@ void Adafruit_SPITFT::initSPI(uint32_t freq, uint8_t spiMode) {
     dma.free(); // Deallocate DMA channel
   }
 #endif // end USE_SPI_DMA
+
+#if defined(SPITFT_FILL_POOL)
+  // One allocation, kept for the life of the object (initSPI() may be
+  // called again on re-init).
+  if ((connection == TFT_HARD_SPI) && !fillBuf) {
+    uint16_t major = (WIDTH > HEIGHT) ? WIDTH : HEIGHT;
+#if defined(ESP32)
+    if ((SPITFT_ESP32_FILL_LINES > 0) &&
+        (fillBuf = (uint16_t *)heap_caps_malloc(
+             (uint32_t)major * SPITFT_ESP32_FILL_LINES * 2, MALLOC_CAP_DMA)))
+      maxFillLen = major * SPITFT_ESP32_FILL_LINES;
+#else
+    // Fill scanlines first, then the writePixels() swap line
+    if ((SPITFT_NRF_FILL_LINES > 0) &&
+        (fillBuf = (uint16_t *)rtos_malloc(
+             (uint32_t)major * (SPITFT_NRF_FILL_LINES + 1) * 2))) {
+      maxFillLen = major * SPITFT_NRF_FILL_LINES;
+      pixelBuf = &fillBuf[maxFillLen];
+      maxPixelLen = major;
+    }
+#endif
+    lastFillColor = 0x0000;
+    lastFillLen = 0;
+  }
+#endif
 }
 
 /*!
@@ -906,9 +955,15 @@ void Adafruit_SPITFT::setSPISpeed(uint32_t freq) {
     @brief  Call before issuing command(s) or data to display. Performs
             chip-select (if required) and starts an SPI transaction (if
             using hardware SPI and transactions are supported). Required
-            for all display types; not an SPI-specific function.
+            for all display types; not an SPI-specific function. Calls
+            nest: only the outermost startWrite() touches the bus, so
+            primitives built from other primitives (or called between
+            startFrame() and endFrame()) select the display once.
 */
 void Adafruit_SPITFT::startWrite(void) {
+  if (writeDepth++)
+    return; // Already selected by an outer startWrite()
+  SPITFT_COUNT(transactions, 1);
   SPI_BEGIN_TRANSACTION();
   if (_cs >= 0)
     SPI_CS_LOW();
@@ -918,14 +973,122 @@ void Adafruit_SPITFT::startWrite(void) {
     @brief  Call after issuing command(s) or data to display. Performs
             chip-deselect (if required) and ends an SPI transaction (if
             using hardware SPI and transactions are supported). Required
-            for all display types; not an SPI-specific function.
+            for all display types; not an SPI-specific function. Only the
+            endWrite() matching the outermost startWrite() releases the
+            bus; an unmatched call does nothing.
 */
 void Adafruit_SPITFT::endWrite(void) {
+  if (!writeDepth || --writeDepth)
+    return; // Unmatched, or an outer startWrite() still holds the bus
+  if (transport)
+    transport->wait(); // Nothing may be left in flight past the transaction
   if (_cs >= 0)
     SPI_CS_HIGH();
   SPI_END_TRANSACTION();
 }
 
+/*!
+    @brief  Start drawing a frame: select the display and hold it, in one
+            SPI transaction, until endFrame(). Everything drawn in
+            between (pixels, primitives, text, commands) shares that
+            transaction instead of each starting and ending its own,
+            which on AVR and SAMD saves a noticeable amount of time per
+            call in screens made of many small elements. Other devices on
+            the same SPI bus can't be used until endFrame(). Frames may
+            be nested inside startWrite() / endWrite() and vice versa.
+            With setTearSync() on, an outermost frame first waits for
+            the panel's tearing-effect pulse (see waitForTear()).
+*/
+void Adafruit_SPITFT::startFrame(void) {
+  tearSync();
+  startWrite();
+}
+
+/*!
+    @brief  Finish a frame begun with startFrame(): wait for any pending
+            DMA transfer, then deselect the display and end the SPI
+            transaction (unless an outer startWrite() or startFrame()
+            still holds it).
+*/
+void Adafruit_SPITFT::endFrame(void) {
+  dmaWait();
+  endWrite();
+}
+
+/*!
+    @brief   Use a pin wired to the panel's TE (tearing effect) output to
+             time frames: see waitForTear() and setTearSync(). Measures
+             the refresh period across two pulses, so takes up to a
+             couple of frames (or, if none come, 2 * SPITFT_TE_TIMEOUT).
+             Call after the display's begin().
+    @param   pin   Pin connected to TE, or -1 to stop using one.
+    @param   teon  true (default) to turn the TE output on, vertical
+                   blanking pulses only, with MIPI DCS TEON (0x35), as on
+                   ILI9341, ILI9488, ST7735 and ST7789. false for panels
+                   whose subclass enables it another way.
+    @return  true if pulses were seen; false (no pin, or no signal on it)
+             leaves frames unsynced rather than stalling them.
+*/
+bool Adafruit_SPITFT::setTearPin(int8_t pin, bool teon) {
+  tePin = pin;
+  tePeriod = 0;
+  if (pin < 0)
+    return false;
+  pinMode(pin, INPUT);
+  if (teon) {
+    uint8_t mode = 0; // TE on vertical blanking only
+    sendCommand(0x35, &mode, 1);
+  }
+  if (waitForTear()) {
+    uint32_t t = micros();
+    if (waitForTear()) {
+      tePeriod = micros() - t;
+      return true;
+    }
+  }
+  tePin = -1; // No signal
+  return false;
+}
+
+/*!
+    @brief   Wait for the panel's tearing-effect pulse, the start of its
+             vertical blanking: the scan is about to restart at the top.
+             A push begun now stays clear of the scan (and the panel
+             shows no mix of two frames) if it's quicker than the scan,
+             keeping ahead of it, or if it's slower but takes less than
+             two refresh periods, keeping behind it: the old frame is
+             scanned out whole, then the new one. With a full-screen
+             push slower than that, draw in parts (e.g. bands) and wait
+             before each, or push less (dirty areas only). Doesn't touch
+             the bus, so can be called inside startWrite() / endWrite().
+    @return  true at the pulse's rising edge; false if no TE pin is set,
+             or no pulse came within two refresh periods.
+*/
+bool Adafruit_SPITFT::waitForTear(void) {
+  if (tePin < 0)
+    return false;
+  uint32_t t0 = micros(), limit = tePeriod ? tePeriod * 2 : SPITFT_TE_TIMEOUT;
+  while (digitalRead(tePin)) { // Mid-pulse: too late, wait for the next
+    if (micros() - t0 > limit)
+      return false;
+  }
+  while (!digitalRead(tePin)) {
+    if (micros() - t0 > limit)
+      return false;
+  }
+  return true;
+}
+
+/*!
+    @brief  Before a frame or canvas push: if setTearSync() is on and no
+            outer startWrite() holds the display, wait for the tearing
+            effect pulse.
+*/
+void Adafruit_SPITFT::tearSync(void) {
+  if (teSync && !writeDepth)
+    waitForTear();
+}
+
 // -------------------------------------------------------------------------
 // Lower-level graphics operations. These functions require a chip-select
 // and/or SPI transaction around them (via startWrite(), endWrite() above).
@@ -942,9 +1105,14 @@ void Adafruit_SPITFT::endWrite(void) {
     @param  color  16-bit pixel color in '565' RGB format.
 */
 void Adafruit_SPITFT::writePixel(int16_t x, int16_t y, uint16_t color) {
-  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
-    setAddrWindow(x, y, 1, 1);
-    SPI_WRITE16(color);
+  if (clipPixel(&x, &y)) {
+    writeAddrWindow(x, y, 1, 1);
+    SPITFT_COUNT(pixels, 1);
+    SPITFT_COUNT(bytes, 2);
+    if (transport)
+      transport->pushColor(color, 1);
+    else
+      SPI_WRITE16(color);
   }
 }
 
@@ -972,53 +1140,89 @@ void Adafruit_SPITFT::writePixel(int16_t x, int16_t y, uint16_t color) {
                        example, a bitmap in a uint16_t array having the byte
                        values already reordered big-endian, this can save
                        some processing time here, ESPECIALLY if using this
-                       function's non-blocking DMA mode. Not all cases are
-                       covered...this is really here only for SAMD DMA and
-                       much forethought on the application side.
+                       function's non-blocking DMA mode. Non-DMA cases
+                       honor the flag too (swapping each pixel back as it's
+                       written) so such buffers display correctly anywhere,
+                       but the time savings are really only for SAMD DMA
+                       and nRF52840, and much forethought on the application
+                       side.
 */
 void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
                                   bool bigEndian) {
+  GFX_PROFILE_SCOPE(GFX_PROF_WRITEPIXELS, len);
 
   if (!len)
     return; // Avoid 0-byte transfers
+  SPITFT_COUNT(pixels, len);
+  SPITFT_COUNT(bytes, len * 2);
+
+  if (transport) {
+    transport->pushPixels(colors, len, block, bigEndian);
+    return;
+  }
 
 #if defined(ESP32) // ESP32 has a special SPI pixel-writing function...
   if (connection == TFT_HARD_SPI) {
-    hwspi._spi->writePixels(colors, len * 2);
+    if (bigEndian) // Already in display order, issue bytes as-is
+      hwspi._spi->writeBytes((uint8_t *)colors, len * 2);
+    else
+      hwspi._spi->writePixels(colors, len * 2);
     return;
   }
 #elif defined(ARDUINO_NRF52_ADAFRUIT) &&                                       \
     defined(NRF52840_XXAA) // Adafruit nRF52 use SPIM3 DMA at 32Mhz
-  // TFT and SPI DMA endian is different we need to swap bytes
-  if (!bigEndian) {
-    for (uint32_t i = 0; i < len; i++) {
-      colors[i] = __builtin_bswap16(colors[i]);
+  if (!bigEndian && pixelBuf) {
+    // Swap into the pool's own line rather than twice over the caller's
+    // buffer; fillBuf's cached color is left intact.
+    while (len) {
+      uint32_t const count = min(len, (uint32_t)maxPixelLen);
+      gfxSwap565(pixelBuf, colors, count);
+      colors += count;
+      hwspi._spi->transfer(pixelBuf, NULL, 2 * count);
+      len -= count;
     }
+    return;
   }
 
+  // TFT and SPI DMA endian is different we need to swap bytes
+  if (!bigEndian)
+    gfxSwap565(colors, colors, len);
+
   // use the separate tx, rx buf variant to prevent overwrite the buffer
   hwspi._spi->transfer(colors, NULL, 2 * len);
 
   // swap back color buffer
-  if (!bigEndian) {
-    for (uint32_t i = 0; i < len; i++) {
-      colors[i] = __builtin_bswap16(colors[i]);
-    }
-  }
+  if (!bigEndian)
+    gfxSwap565(colors, colors, len);
 
   return;
+#elif defined(USE_PIO_PARALLEL)
+  if ((connection == TFT_PARALLEL) && (tft8.dmaChan >= 0)) {
+    // DMA straight from the caller's buffer to the state machine, which
+    // issues native pixels high byte first; big-endian pixels are swapped
+    // back by the DMA channel itself.
+    pioPixels(colors, len, true, bigEndian);
+    if (block)
+      dmaSpin();
+    return;
+  }
 #elif defined(USE_SPI_DMA) &&                                                  \
     (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
   if ((connection == TFT_HARD_SPI) || (connection == TFT_PARALLEL)) {
     int maxSpan = maxFillLen / 2; // One scanline max
     uint8_t pixelBufIdx = 0;      // Active pixel buffer number
+    // A 16-bit parallel bus moves halfword beats straight from native
+    // (little-endian) pixels; SPI and 8-bit parallel move byte beats and
+    // want big-endian. BTCNT counts beats.
+    bool wide = (connection == TFT_PARALLEL) && tft8.wide;
+    uint8_t beatsPerPixel = wide ? 1 : 2;
 #if defined(__SAMD51__)
     if (connection == TFT_PARALLEL) {
       // Switch WR pin to PWM or CCL
       pinPeripheral(tft8._wr, wrPeripheral);
     }
 #endif // end __SAMD51__
-    if (!bigEndian) { // Normal little-endian situation...
+    if (bigEndian == wide) { // Normal situation, pixels need a swap...
       while (len) {
         int count = (len < maxSpan) ? len : maxSpan;
 
@@ -1026,20 +1230,18 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
         // bytes from the 'colors' array passed into a DMA working
         // buffer. This can take place while the prior DMA transfer
         // is in progress, hence the need for two pixelBufs.
-        for (int i = 0; i < count; i++) {
-          pixelBuf[pixelBufIdx][i] = __builtin_bswap16(*colors++);
-        }
+        gfxSwap565(pixelBuf[pixelBufIdx], colors, count);
+        colors += count;
         // The transfers themselves are relatively small, so we don't
         // need a long descriptor list. We just alternate between the
         // first two, sharing pixelBufIdx for that purpose.
         descriptor[pixelBufIdx].SRCADDR.reg =
             (uint32_t)pixelBuf[pixelBufIdx] + count * 2;
         descriptor[pixelBufIdx].BTCTRL.bit.SRCINC = 1;
-        descriptor[pixelBufIdx].BTCNT.reg = count * 2;
+        descriptor[pixelBufIdx].BTCNT.reg = count * beatsPerPixel;
         descriptor[pixelBufIdx].DESCADDR.reg = 0;
 
-        while (dma_busy)
-          ; // Wait for prior line to finish
+        dmaSpin(); // Wait for prior line to finish
 
         // Move new descriptor into place...
         memcpy(dptr, &descriptor[pixelBufIdx], sizeof(DmacDescriptor));
@@ -1051,8 +1253,8 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
 
         len -= count;
       }
-    } else { // bigEndian == true
-      // With big-endian pixel data, this can be handled as a single
+    } else { // Already in bus order (big-endian, or native if wide)
+      // With pixel data in bus order, this can be handled as a single
       // DMA transfer using chained descriptors. Even full screen, this
       // needs only a relatively short descriptor list, each
       // transferring a max of 32,767 (not 32,768) pixels. The list
@@ -1063,15 +1265,14 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
         int count = (len < 32767) ? len : 32767;
         descriptor[d].SRCADDR.reg = (uint32_t)colors + count * 2;
         descriptor[d].BTCTRL.bit.SRCINC = 1;
-        descriptor[d].BTCNT.reg = count * 2;
+        descriptor[d].BTCNT.reg = count * beatsPerPixel;
         descriptor[d].DESCADDR.reg = (uint32_t)&descriptor[d + 1];
         len -= count;
         colors += count;
       }
       descriptor[d - 1].DESCADDR.reg = 0;
 
-      while (dma_busy)
-        ; // Wait for prior transfer (if any) to finish
+      dmaSpin(); // Wait for prior transfer (if any) to finish
 
       // Move first descriptor into place and start transfer...
       memcpy(dptr, &descriptor[0], sizeof(DmacDescriptor));
@@ -1084,8 +1285,7 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
     lastFillColor = 0x0000; // pixelBuf has been sullied
     lastFillLen = 0;
     if (block) {
-      while (dma_busy)
-        ; // Wait for last line to complete
+      dmaSpin(); // Wait for last line to complete
 #if defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO)
       if (connection == TFT_HARD_SPI) {
         // See SAMD51/21 note in writeColor()
@@ -1099,707 +1299,2441 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
   }
 #endif // end USE_SPI_DMA
 
+#if defined(USE_FAST_PINIO)
+  if (connection == TFT_SOFT_SPI) {
+    softSPIWritePixels(colors, len, bigEndian);
+    return;
+  }
+#endif
+
   // All other cases (bitbang SPI or non-DMA hard SPI or parallel),
   // use a loop with the normal 16-bit data write function:
-  while (len--) {
-    SPI_WRITE16(*colors++);
+  if (!bigEndian) {
+    while (len--) {
+      SPI_WRITE16(*colors++);
+    }
+  } else { // Data is pre-swapped, restore native order for 16-bit write
+    while (len--) {
+      SPI_WRITE16(__builtin_bswap16(*colors++));
+    }
   }
 }
 
-/*!
-    @brief  Wait for the last DMA transfer in a prior non-blocking
-            writePixels() call to complete. This does nothing if DMA
-            is not enabled, and is not needed if blocking writePixels()
-            was used (as is the default case).
-*/
-void Adafruit_SPITFT::dmaWait(void) {
-#if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
-  while (dma_busy)
-    ;
-#if defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO)
-  if (connection == TFT_HARD_SPI) {
-    // See SAMD51/21 note in writeColor()
-    hwspi._spi->setDataMode(hwspi._mode);
+// Fetch the next palette index for writeIndexed(): whole bytes at depth 8,
+// else depth-bit fields, most significant first, from bit shift of *ptr.
+static inline uint8_t nextIndex(const uint8_t **ptr, uint8_t *shift,
+                                uint8_t depth) {
+  if (depth == 8)
+    return *(*ptr)++;
+  uint8_t i = (**ptr >> *shift) & ((1 << depth) - 1);
+  if (*shift) {
+    *shift -= depth;
   } else {
-    pinPeripheral(tft8._wr, PIO_OUTPUT); // Switch WR back to GPIO
+    *shift = 8 - depth;
+    (*ptr)++;
   }
-#endif // end __SAMD51__ || ARDUINO_SAMD_ZERO
-#endif
+  return i;
 }
 
 /*!
-    @brief  Issue a series of pixels, all the same color. Not self-
-            contained; should follow startWrite() and setAddrWindow() calls.
-    @param  color  16-bit pixel color in '565' RGB format.
-    @param  len    Number of pixels to draw.
+    @brief  Issue a series of palette-indexed pixels, expanding each
+            through an RGB565 lookup table. Not self-contained; should
+            follow startWrite() and setAddrWindow() calls. Where
+            writePixels() byte-swaps through DMA working buffers, the
+            lookup is folded into that same pass, and on SAMD the next
+            line is expanded while the prior one transfers. Blocks until
+            the last pixel is sent.
+    @param  indices  Pointer to pixel values (RAM-resident).
+    @param  len      Number of pixels to issue.
+    @param  palette  RGB565 color of each pixel value, native byte order,
+                     1 << depth entries.
+    @param  depth    Bits per pixel value: 8 (one per byte, the default),
+                     or 4, 2 or 1 packed into bytes leftmost pixel first,
+                     as in GFXcanvas4, GFXcanvas2 and 1-bit bitmaps.
+    @param  skip     With depth less than 8, pixels in the first byte
+                     before the first to issue.
 */
-void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len) {
+void Adafruit_SPITFT::writeIndexed(const uint8_t *indices, uint32_t len,
+                                   const uint16_t *palette, uint8_t depth,
+                                   uint8_t skip) {
 
   if (!len)
     return; // Avoid 0-byte transfers
+  SPITFT_COUNT(pixels, len);
+  SPITFT_COUNT(bytes, len * 2);
 
-  uint8_t hi = color >> 8, lo = color;
+  uint8_t shift = 8 - depth - skip * depth; // Unused at depth 8
 
-#if defined(ESP32) // ESP32 has a special SPI pixel-writing function...
-  if (connection == TFT_HARD_SPI) {
-#define SPI_MAX_PIXELS_AT_ONCE 32
-#define TMPBUF_LONGWORDS (SPI_MAX_PIXELS_AT_ONCE + 1) / 2
-#define TMPBUF_PIXELS (TMPBUF_LONGWORDS * 2)
-    static uint32_t temp[TMPBUF_LONGWORDS];
-    uint32_t c32 = color * 0x00010001;
-    uint16_t bufLen = (len < TMPBUF_PIXELS) ? len : TMPBUF_PIXELS, xferLen,
-             fillLen;
-    // Fill temp buffer 32 bits at a time
-    fillLen = (bufLen + 1) / 2; // Round up to next 32-bit boundary
-    for (uint32_t t = 0; t < fillLen; t++) {
-      temp[t] = c32;
-    }
-    // Issue pixels in blocks from temp buffer
-    while (len) {                              // While pixels remain
-      xferLen = (bufLen < len) ? bufLen : len; // How many this pass?
-      writePixels((uint16_t *)temp, xferLen);
-      len -= xferLen;
+  if (transport) { // Expand a span at a time for the transport
+    uint16_t span[SPITFT_SPAN_LEN];
+    while (len) {
+      uint32_t const count = (len < SPITFT_SPAN_LEN) ? len : SPITFT_SPAN_LEN;
+      for (uint32_t i = 0; i < count; i++) {
+        span[i] = palette[nextIndex(&indices, &shift, depth)];
+      }
+      transport->pushPixels(span, count, true, false);
+      len -= count;
     }
     return;
   }
-#elif defined(ARDUINO_NRF52_ADAFRUIT) &&                                       \
-    defined(NRF52840_XXAA) // Adafruit nRF52840 use SPIM3 DMA at 32Mhz
-  // at most 2 scan lines
-  uint32_t const pixbufcount = min(len, ((uint32_t)2 * width()));
-  uint16_t *pixbuf = (uint16_t *)rtos_malloc(2 * pixbufcount);
-
-  // use SPI3 DMA if we could allocate buffer, else fall back to writing each
-  // pixel loop below
-  if (pixbuf) {
-    uint16_t const swap_color = __builtin_bswap16(color);
-
-    // fill buffer with color
-    for (uint32_t i = 0; i < pixbufcount; i++) {
-      pixbuf[i] = swap_color;
-    }
 
+#if defined(ESP32)
+  if ((connection == TFT_HARD_SPI) && fillBuf) {
+    // Expand into the fill pool in display order, which then no longer
+    // holds the last fill color
     while (len) {
-      uint32_t const count = min(len, pixbufcount);
-      writePixels(pixbuf, count, true, true);
+      uint32_t const count = (len < maxFillLen) ? len : maxFillLen;
+      for (uint32_t i = 0; i < count; i++) {
+        uint16_t c = palette[nextIndex(&indices, &shift, depth)];
+        fillBuf[i] = __builtin_bswap16(c);
+      }
+      hwspi._spi->writeBytes((uint8_t *)fillBuf, count * 2);
       len -= count;
     }
-
-    rtos_free(pixbuf);
+    lastFillLen = 0;
     return;
   }
-#else                      // !ESP32
-#if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
-  if (((connection == TFT_HARD_SPI) || (connection == TFT_PARALLEL)) &&
-      (len >= 16)) { // Don't bother with DMA on short pixel runs
-    int i, d, numDescriptors;
-    if (hi == lo) { // If high & low bytes are same...
-      onePixelBuf = color;
-      // Can do this with a relatively short descriptor list,
-      // each transferring a max of 32,767 (not 32,768) pixels.
-      // This won't run off the end of the allocated descriptor list,
-      // since we're using much larger chunks per descriptor here.
-      numDescriptors = (len + 32766) / 32767;
-      for (d = 0; d < numDescriptors; d++) {
-        int count = (len < 32767) ? len : 32767;
-        descriptor[d].SRCADDR.reg = (uint32_t)&onePixelBuf;
-        descriptor[d].BTCTRL.bit.SRCINC = 0;
-        descriptor[d].BTCNT.reg = count * 2;
-        descriptor[d].DESCADDR.reg = (uint32_t)&descriptor[d + 1];
-        len -= count;
-      }
-      descriptor[d - 1].DESCADDR.reg = 0;
-    } else {
-      // If high and low bytes are distinct, it's necessary to fill
-      // a buffer with pixel data (swapping high and low bytes because
-      // TFT and SAMD are different endianisms) and create a longer
-      // descriptor list pointing repeatedly to this data. We can do
-      // this slightly faster working 2 pixels (32 bits) at a time.
-      uint32_t *pixelPtr = (uint32_t *)pixelBuf[0],
-               twoPixels = __builtin_bswap16(color) * 0x00010001;
-      // We can avoid some or all of the buffer-filling if the color
-      // is the same as last time...
-      if (color == lastFillColor) {
-        // If length is longer than prior instance, fill only the
-        // additional pixels in the buffer and update lastFillLen.
-        if (len > lastFillLen) {
-          int fillStart = lastFillLen / 2,
-              fillEnd = (((len < maxFillLen) ? len : maxFillLen) + 1) / 2;
-          for (i = fillStart; i < fillEnd; i++)
-            pixelPtr[i] = twoPixels;
-          lastFillLen = fillEnd * 2;
-        } // else do nothing, don't set pixels or change lastFillLen
-      } else {
-        int fillEnd = (((len < maxFillLen) ? len : maxFillLen) + 1) / 2;
-        for (i = 0; i < fillEnd; i++)
-          pixelPtr[i] = twoPixels;
-        lastFillLen = fillEnd * 2;
-        lastFillColor = color;
-      }
-
-      numDescriptors = (len + maxFillLen - 1) / maxFillLen;
-      for (d = 0; d < numDescriptors; d++) {
-        int pixels = (len < maxFillLen) ? len : maxFillLen, bytes = pixels * 2;
-        descriptor[d].SRCADDR.reg = (uint32_t)pixelPtr + bytes;
-        descriptor[d].BTCTRL.bit.SRCINC = 1;
-        descriptor[d].BTCNT.reg = bytes;
-        descriptor[d].DESCADDR.reg = (uint32_t)&descriptor[d + 1];
-        len -= pixels;
+#elif defined(ARDUINO_NRF52_ADAFRUIT) &&                                       \
+    defined(NRF52840_XXAA) // Adafruit nRF52 use SPIM3 DMA at 32Mhz
+  if (pixelBuf) {
+    while (len) {
+      uint32_t const count = min(len, (uint32_t)maxPixelLen);
+      for (uint32_t i = 0; i < count; i++) {
+        uint16_t c = palette[nextIndex(&indices, &shift, depth)];
+        pixelBuf[i] = __builtin_bswap16(c);
       }
-      descriptor[d - 1].DESCADDR.reg = 0;
+      hwspi._spi->transfer(pixelBuf, NULL, 2 * count);
+      len -= count;
     }
-    memcpy(dptr, &descriptor[0], sizeof(DmacDescriptor));
+    return;
+  }
+#elif defined(USE_SPI_DMA) &&                                                  \
+    (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
+  if ((connection == TFT_HARD_SPI) || (connection == TFT_PARALLEL)) {
+    int maxSpan = maxFillLen / 2; // One scanline max
+    uint8_t pixelBufIdx = 0;      // Active pixel buffer number
+    bool wide = (connection == TFT_PARALLEL) && tft8.wide; // See writePixels
 #if defined(__SAMD51__)
     if (connection == TFT_PARALLEL) {
       // Switch WR pin to PWM or CCL
       pinPeripheral(tft8._wr, wrPeripheral);
     }
 #endif // end __SAMD51__
+    while (len) {
+      int count = (len < maxSpan) ? len : maxSpan;
+      // Same double-buffered scheme as writePixels(), expanding the next
+      // line while the prior DMA transfer is in progress
+      for (int i = 0; i < count; i++) {
+        uint16_t c = palette[nextIndex(&indices, &shift, depth)];
+        pixelBuf[pixelBufIdx][i] = wide ? c : __builtin_bswap16(c);
+      }
+      descriptor[pixelBufIdx].SRCADDR.reg =
+          (uint32_t)pixelBuf[pixelBufIdx] + count * 2;
+      descriptor[pixelBufIdx].BTCTRL.bit.SRCINC = 1;
+      descriptor[pixelBufIdx].BTCNT.reg = wide ? count : count * 2;
+      descriptor[pixelBufIdx].DESCADDR.reg = 0;
 
-    dma_busy = true;
-    dma.startJob();
-    if (connection == TFT_PARALLEL)
-      dma.trigger();
-    while (dma_busy)
-      ; // Wait for completion
-      // Unfortunately blocking is necessary. An earlier version returned
-      // immediately and checked dma_busy on startWrite() instead, but it
-      // turns out to be MUCH slower on many graphics operations (as when
-      // drawing lines, pixel-by-pixel), perhaps because it's a volatile
-      // type and doesn't cache. Working on this.
-#if defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO)
-    if (connection == TFT_HARD_SPI) {
-      // SAMD51: SPI DMA seems to leave the SPI peripheral in a freaky
-      // state on completion. Workaround is to explicitly set it back...
-      // (5/17/2019: apparently SAMD21 too, in certain cases, observed
-      // with ST7789 display.)
-      hwspi._spi->setDataMode(hwspi._mode);
-    } else {
-      pinPeripheral(tft8._wr, PIO_OUTPUT); // Switch WR back to GPIO
+      dmaSpin(); // Wait for prior line to finish
+
+      memcpy(dptr, &descriptor[pixelBufIdx], sizeof(DmacDescriptor));
+      dma_busy = true;
+      dma.startJob(); // Trigger SPI DMA transfer
+      if (connection == TFT_PARALLEL)
+        dma.trigger();
+      pixelBufIdx = 1 - pixelBufIdx; // Swap DMA pixel buffers
+
+      len -= count;
     }
-#endif // end __SAMD51__
+    lastFillColor = 0x0000; // pixelBuf has been sullied
+    lastFillLen = 0;
+    dmaWait(); // Wait for last line, restore SPI mode or WR pin
     return;
   }
 #endif // end USE_SPI_DMA
-#endif // end !ESP32
 
-  // All other cases (non-DMA hard SPI, bitbang SPI, parallel)...
+  // All other cases, one lookup and 16-bit write per pixel:
+  while (len--) {
+    SPI_WRITE16(palette[nextIndex(&indices, &shift, depth)]);
+  }
+}
 
+/*!
+    @brief  Wait for the last DMA transfer in a prior non-blocking
+            writePixels() call to complete. This does nothing if DMA
+            is not enabled, and is not needed if blocking writePixels()
+            was used (as is the default case).
+*/
+void Adafruit_SPITFT::dmaWait(void) {
+  if (transport)
+    transport->wait();
+#if defined(USE_PIO_PARALLEL)
+  pioWait();
+#endif
+#if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
+  dmaSpin();
+#if defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO)
   if (connection == TFT_HARD_SPI) {
-#if defined(ESP8266)
-    do {
-      uint32_t pixelsThisPass = len;
-      if (pixelsThisPass > 50000)
-        pixelsThisPass = 50000;
-      len -= pixelsThisPass;
-      yield(); // Periodic yield() on long fills
-      while (pixelsThisPass--) {
-        hwspi._spi->write(hi);
-        hwspi._spi->write(lo);
-      }
-    } while (len);
-#else // !ESP8266
-    while (len--) {
-#if defined(__AVR__)
-      AVR_WRITESPI(hi);
-      AVR_WRITESPI(lo);
-#elif defined(ESP32)
-      hwspi._spi->write(hi);
-      hwspi._spi->write(lo);
+    // See SAMD51/21 note in writeColor()
+    hwspi._spi->setDataMode(hwspi._mode);
+  } else {
+    pinPeripheral(tft8._wr, PIO_OUTPUT); // Switch WR back to GPIO
+  }
+#endif // end __SAMD51__ || ARDUINO_SAMD_ZERO
+#endif
+}
+
+/*!
+    @brief   Check whether the last non-blocking writePixels() is still
+             transferring, e.g. to do other work (draw for another
+             display, see Adafruit_BusScheduler) rather than spin in
+             dmaWait(). Where transfers block anyway, or the state can't
+             be queried (a transport), this is false; dmaWait() is still
+             required before talking to the display, and may wait briefly
+             for the last few bytes.
+    @return  true if the SAMD or RP2040 DMA channel is still busy.
+*/
+bool Adafruit_SPITFT::dmaBusy(void) {
+#if defined(USE_PIO_PARALLEL)
+  if ((connection == TFT_PARALLEL) && (tft8.dmaChan >= 0))
+    return dma_channel_is_busy(tft8.dmaChan);
+#elif defined(USE_SPI_DMA) &&                                                  \
+    (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
+  return dma_busy;
+#endif
+  return false;
+}
+
+/*!
+    @brief  Wait for the DMA job in progress, if any, to finish: the SAMD
+            transfer (dma_busy) or the RP2040 parallel channel. With
+            SPITFT_STATS, the time spent is added to the stats.
+*/
+inline void Adafruit_SPITFT::dmaSpin(void) {
+#if defined(SPITFT_STATS)
+  uint32_t const t = micros();
+#endif
+#if defined(USE_PIO_PARALLEL)
+  dma_channel_wait_for_finish_blocking(tft8.dmaChan);
+#elif defined(USE_SPI_DMA) &&                                                  \
+    (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
+  while (dma_busy)
+    ;
+#endif
+#if defined(SPITFT_STATS)
+  stats.dmaWaitMicros += micros() - t;
+#endif
+}
+
+/*!
+    @brief  Set the address window with the MIPI DCS commands most TFT
+            controllers share (CASET 0x2A, RASET 0x2B, RAMWR 0x2C),
+            offset by _xstart and _ystart. A subclass whose controller
+            uses these can implement setAddrWindow() by calling this. The
+            last column and row ranges sent are remembered, and a range
+            that hasn't changed isn't sent again: consecutive pixels along
+            a row cost a CASET and RAMWR, down a column a RASET and RAMWR,
+            and a repeat of the same window just RAMWR, which restarts the
+            pixel pointer at its corner. Any command sent through this
+            class (rotation, scrolling, resets via initSPI()...) forgets
+            the window so the next one is sent in full. Chip-select and
+            transaction must have been previously set, as with
+            setAddrWindow(); 8-bit commands only.
+    @param  x  Leftmost pixel of area to be drawn.
+    @param  y  Topmost pixel of area to be drawn.
+    @param  w  Width of area to be drawn, in pixels (MUST be >0).
+    @param  h  Height of area to be drawn, in pixels (MUST be >0).
+*/
+void Adafruit_SPITFT::setAddrWindowMIPI(uint16_t x, uint16_t y, uint16_t w,
+                                        uint16_t h) {
+  mipiWindow(x, y, w, h, 0x2C); // RAMWR
+}
+
+/*!
+    @brief  Send the CASET and RASET for a window, each only if it differs
+            from the last one sent, then a memory command (RAMWR or
+            RAMRD). Shared by setAddrWindowMIPI() and readRect().
+    @param  x       Leftmost pixel of window.
+    @param  y       Topmost pixel of window.
+    @param  w       Width of window, in pixels (MUST be >0).
+    @param  h       Height of window, in pixels (MUST be >0).
+    @param  memCmd  Command to follow, 0x2C (RAMWR) or 0x2E (RAMRD).
+*/
+void Adafruit_SPITFT::mipiWindow(uint16_t x, uint16_t y, uint16_t w,
+                                 uint16_t h, uint8_t memCmd) {
+  x += _xstart;
+  y += _ystart;
+  uint32_t col = ((uint32_t)x << 16) | (uint16_t)(x + w - 1);
+  uint32_t row = ((uint32_t)y << 16) | (uint16_t)(y + h - 1);
+  bool sendCol = !winValid || (col != winCol);
+  bool sendRow = !winValid || (row != winRow);
+  if (sendCol) {
+    writeCommand(0x2A); // CASET
+    SPI_WRITE32(col);
+  }
+  if (sendRow) {
+    writeCommand(0x2B); // RASET
+    SPI_WRITE32(row);
+  }
+  writeCommand(memCmd);
+  winCol = col; // After writeCommand(), which clears winValid
+  winRow = row;
+  winValid = true;
+}
+
+/*!
+    @brief  Set how readRect() talks to the display: the format its RAMRD
+            returns pixels in and, for hardware SPI, a slower bitrate to
+            read at (panels typically read at well under their write
+            speed; the ILI9341 at about 6 MHz, for instance).
+    @param  format  SPITFT_READ_RGB666 (default, 3 bytes per pixel, as
+                    most SPI panels return regardless of their write
+                    format) or SPITFT_READ_RGB565 (2 bytes per pixel).
+                    On a 16-bit parallel bus, RGB666 reads are taken to be
+                    packed two pixels per three words and RGB565 one
+                    pixel per word.
+    @param  freq    SPI bitrate for reads, 0 (default) for the same as
+                    writes. Ignored for other interfaces, or if the SPI
+                    library has no transactions.
+*/
+void Adafruit_SPITFT::setReadFormat(SPITFTreadFormat format, uint32_t freq) {
+  readFormat = format;
+  readFreq = freq;
+}
+
+/*!
+    @brief   Check whether this display's interface can read pixels.
+             Hardware SPI is assumed to have MISO wired (there's no way to
+             tell); software SPI needs a MISO pin, and parallel a read
+             strobe pin on a port-driven (not PIO) bus.
+    @return  true if readRect() can work.
+*/
+bool Adafruit_SPITFT::canRead(void) const {
+  if (connection == TFT_HARD_SPI)
+    return true;
+  if (connection == TFT_SOFT_SPI)
+    return swspi._miso >= 0;
+#if defined(USE_FAST_PINIO)
+  return tft8._rd >= 0;
 #else
-      hwspi._spi->transfer(hi);
-      hwspi._spi->transfer(lo);
+  return false; // Parallel reads need port access
+#endif
+}
+
+/*!
+    @brief  Read raw bytes from the RAMRD stream in progress. Uses the SPI
+            library's DMA transfer on SAMD (Adafruit core) and nRF52840
+            hardware SPI, and is a byte loop elsewhere. Not for 16-bit
+            parallel, whose reads are whole words.
+    @param  dst  Where bytes go.
+    @param  len  Number of bytes.
+*/
+void Adafruit_SPITFT::readBytes(uint8_t *dst, uint32_t len) {
+#if defined(ARDUINO_SAMD_ADAFRUIT) ||                                          \
+    (defined(ARDUINO_NRF52_ADAFRUIT) && defined(NRF52840_XXAA))
+  if (connection == TFT_HARD_SPI) {
+    SPITFT_COUNT(bytes, len);
+    hwspi._spi->transfer(NULL, dst, len); // Dummy bytes out, DMA in
+    return;
+  }
+#endif
+  while (len--)
+    *dst++ = spiRead();
+}
+
+/*!
+    @brief  Read pixels from the RAMRD stream in progress, converted to
+            native 16-bit 565. Needs no buffer beyond dst: 3-byte RGB666
+            pixels are read into the part of dst not yet filled, as many
+            at a time as fit after the pixels already converted, and
+            converted forward in place (so a big read takes a handful of
+            transfers, each a third the size of the last).
+    @param  dst  Where pixels go.
+    @param  len  Number of pixels.
+*/
+void Adafruit_SPITFT::readPixels(uint16_t *dst, uint32_t len) {
+  if ((connection == TFT_PARALLEL) && tft8.wide) {
+    if (readFormat == SPITFT_READ_RGB565) {
+      while (len--)
+        *dst++ = read16();
+      return;
+    }
+    for (; len >= 2; len -= 2) { // R1 G1, B1 R2, G2 B2
+      uint16_t a = read16(), b = read16(), c = read16();
+      *dst++ = color565(a >> 8, a, b >> 8);
+      *dst++ = color565(b, c >> 8, c);
+    }
+    if (len) { // Last of an odd number: its second word is the end of it
+      uint16_t a = read16(), b = read16();
+      *dst = color565(a >> 8, a, b >> 8);
+    }
+    return;
+  }
+  uint8_t *raw = (uint8_t *)dst;
+  if (readFormat == SPITFT_READ_RGB565) { // Big-endian on the wire
+    readBytes(raw, len * 2);
+    for (uint32_t i = 0; i < len; i++, raw += 2)
+      dst[i] = ((uint16_t)raw[0] << 8) | raw[1];
+    return;
+  }
+  while (len) {
+    uint32_t n = len * 2 / 3; // Pixels whose 3 bytes fit in what's left
+    if (!n) {                 // Final pixel: 3 bytes for a 2-byte slot
+      uint8_t p[3];
+      readBytes(p, 3);
+      *dst = color565(p[0], p[1], p[2]);
+      return;
+    }
+    uint8_t *src = (uint8_t *)dst + len * 2 - n * 3; // End of the slack
+    readBytes(src, n * 3);
+    for (uint32_t i = 0; i < n; i++, src += 3) // Writes trail reads
+      dst[i] = color565(src[0], src[1], src[2]);
+    dst += n;
+    len -= n;
+  }
+}
+
+/*!
+    @brief   Read pixels back from the display's memory into a buffer,
+             e.g. to save the area under a popup and restore it later
+             with drawRGBBitmap(x, y, buf, w, h). Coordinates are drawing
+             coordinates, as with drawRGBBitmap(): the drawing origin
+             applies and the area is clipped, with only the pixels of buf
+             that land on screen (and in the clip rectangle) filled in.
+             Self-contained; uses the MIPI DCS CASET/RASET/RAMRD (0x2E)
+             commands with one dummy read before the pixels, as most TFT
+             controllers expect. See setReadFormat() for the pixel format
+             and read speed.
+    @param   x    Left edge of area.
+    @param   y    Top edge of area.
+    @param   w    Width of area (and of buf), in pixels.
+    @param   h    Height of area, in pixels.
+    @param   buf  w * h pixels, native 16-bit 565, filled row by row.
+    @return  true on success, false if the interface can't read (software
+             SPI without MISO, or parallel without a read strobe).
+*/
+bool Adafruit_SPITFT::readRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                               uint16_t *buf) {
+  if (!canRead())
+    return false;
+  int16_t bx = x + _originX, by = y + _originY, // Unclipped top-left
+      saveW = w;
+  if ((w <= 0) || (h <= 0) || !clipRect(&x, &y, &w, &h))
+    return true; // Nothing visible to read
+  buf += (y - by) * saveW + (x - bx); // Offset ptr to clipped top-left
+  readArea(x, y, w, h, buf, saveW);
+  return true;
+}
+
+/*!
+    @brief  Read a rectangle of pixels from the display's memory, for
+            readRect() and copyRect(). The interface must be able to read
+            (see canRead()).
+    @param  x       Left edge, display coordinates, clipped.
+    @param  y       Top edge.
+    @param  w       Width in pixels (MUST be >0).
+    @param  h       Height in pixels (MUST be >0).
+    @param  buf     Where the top-left pixel goes.
+    @param  stride  Pixels from one row of buf to the next, at least w.
+*/
+void Adafruit_SPITFT::readArea(int16_t x, int16_t y, int16_t w, int16_t h,
+                               uint16_t *buf, int16_t stride) {
+  dmaWait();
+  startWrite();
+#if defined(SPI_HAS_TRANSACTION)
+  SPISettings writeSettings;
+  if (readFreq && (connection == TFT_HARD_SPI)) { // Switch to read speed
+    writeSettings = hwspi.settings;
+    hwspi.settings = SPISettings(readFreq, MSBFIRST, hwspi._mode);
+    SPI_END_TRANSACTION();
+    SPI_BEGIN_TRANSACTION();
+  }
+#endif
+  // Rows contiguous in buf are read as one window, else one per row
+  // (each then only needs a new RASET)
+  int16_t rows = (w == stride) ? h : 1;
+  for (; h > 0; h -= rows, y += rows, buf += stride * rows) {
+    SPITFT_COUNT(addrWindows, 1);
+    mipiWindow(x, y, w, rows, 0x2E); // RAMRD
+    if ((connection == TFT_PARALLEL) && tft8.wide)
+      read16(); // Dummy
+    else
+      spiRead(); // Dummy
+    readPixels(buf, (uint32_t)w * rows);
+  }
+#if defined(SPI_HAS_TRANSACTION)
+  if (readFreq && (connection == TFT_HARD_SPI)) { // Back to write speed
+    hwspi.settings = writeSettings;
+    SPI_END_TRANSACTION();
+    SPI_BEGIN_TRANSACTION();
+  }
+#endif
+  endWrite(); // Deselect ends RAMRD; in a frame, the next command does
+}
+
+/*!
+    @brief  Copy a rectangle to elsewhere on the screen; the two may
+            overlap. Coordinates are drawing coordinates: the source is
+            trimmed to the screen and the destination to the clip rect.
+            Displays that advertise GFX_HW_COPY do it with hwCopyRect();
+            otherwise, if the interface can read, the pixels go through a
+            small buffer (SPITFT_SPAN_LEN pixels at a time, read then
+            written back) in whichever order keeps overlapping areas
+            intact. Does nothing if neither is possible. scroll() uses
+            this.
+    @param  sx  Left column of source rect.
+    @param  sy  Top row of source rect.
+    @param  w   Width in pixels.
+    @param  h   Height in pixels.
+    @param  dx  Left column of destination.
+    @param  dy  Top row of destination.
+*/
+void Adafruit_SPITFT::copyRect(int16_t sx, int16_t sy, int16_t w, int16_t h,
+                               int16_t dx, int16_t dy) {
+  if (!clipCopy(this, &sx, &sy, &dx, &dy, &w, &h))
+    return;
+  if ((hwCaps & GFX_HW_COPY) && hwCopyRect(sx, sy, w, h, dx, dy))
+    return;
+  if (!canRead())
+    return;
+  uint16_t span[SPITFT_SPAN_LEN];
+  bool up = dy > sy,                  // Moving down: bottom row first
+      back = (dy == sy) && (dx > sx); // Right along a row: right end first
+  startWrite();
+  for (int16_t j = 0; j < h; j++) {
+    int16_t row = up ? h - 1 - j : j;
+    for (int16_t i = 0; i < w; i += SPITFT_SPAN_LEN) {
+      int16_t n = (w - i < SPITFT_SPAN_LEN) ? w - i : SPITFT_SPAN_LEN,
+              col = back ? w - i - n : i;
+      readArea(sx + col, sy + row, n, 1, span, n);
+      writeAddrWindow(dx + col, dy + row, n, 1);
+      writePixels(span, n);
+    }
+  }
+  endWrite();
+}
+
+/*!
+    @brief   Read back a single pixel from the display. Self-contained;
+             see readRect().
+    @param   x  Horizontal position, drawing coordinates.
+    @param   y  Vertical position, drawing coordinates.
+    @return  Pixel color in 16-bit 565, or 0 if off screen or the
+             interface can't read.
+*/
+uint16_t Adafruit_SPITFT::readPixel(int16_t x, int16_t y) {
+  uint16_t c = 0;
+  readRect(x, y, 1, 1, &c);
+  return c;
+}
+
+// Default transport hooks: accept installation, leave windows to the display
+
+bool Adafruit_SPITFT_Transport::begin(Adafruit_SPITFT *tft) { return true; }
+
+bool Adafruit_SPITFT_Transport::addrWindow(uint16_t x, uint16_t y, uint16_t w,
+                                           uint16_t h) {
+  return false;
+}
+
+/*!
+    @brief   Install a transport to carry writePixels(), writeColor() and
+             writeIndexed() pixels (and, for the library's primitives, the
+             address window) in place of the built-in code for this
+             platform. Call after the display's begin(). Any pending
+             transfer on the old path is finished first.
+    @param   t  Transport to install, or NULL to revert to built-in code.
+             The transport must outlive its use by the display.
+    @return  true on success, false if t->begin() refused, in which case
+             the prior transport (or built-in code) stays in use.
+*/
+bool Adafruit_SPITFT::setTransport(Adafruit_SPITFT_Transport *t) {
+  dmaWait();
+  if (t && !t->begin(this))
+    return false;
+  transport = t;
+  return true;
+}
+
+#if defined(SPITFT_FILL_POOL)
+/*!
+    @brief   Bring the persistent fill pool up to date for a color. Pool
+             pixels are stored byte-swapped, in display order. If the
+             color matches the prior fill, only pixels beyond what that
+             fill set are written, so repeated short fills (rects, lines,
+             glyph backgrounds) usually write nothing at all.
+    @param   color  16-bit pixel color in '565' RGB format.
+    @param   len    Number of pixels the caller needs to issue.
+    @return  Number of valid pixels at the start of fillBuf: len or the
+             pool size, whichever is smaller.
+*/
+uint32_t Adafruit_SPITFT::fillPool(uint16_t color, uint32_t len) {
+  uint32_t const count = (len < maxFillLen) ? len : maxFillLen;
+  if (color != lastFillColor) {
+    lastFillColor = color;
+    lastFillLen = 0;
+  }
+  if (count > lastFillLen) {
+    gfxFill565(&fillBuf[lastFillLen], __builtin_bswap16(color),
+               count - lastFillLen);
+    lastFillLen = count;
+  }
+  return count;
+}
+#endif // end SPITFT_FILL_POOL
+
+/*!
+    @brief  Issue a series of pixels, all the same color. Not self-
+            contained; should follow startWrite() and setAddrWindow() calls.
+    @param  color  16-bit pixel color in '565' RGB format.
+    @param  len    Number of pixels to draw.
+*/
+void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len) {
+  GFX_PROFILE_SCOPE(GFX_PROF_WRITECOLOR, len);
+
+  if (!len)
+    return; // Avoid 0-byte transfers
+  SPITFT_COUNT(fillPixels, len);
+  SPITFT_COUNT(bytes, len * 2);
+
+  if (transport) {
+    transport->pushColor(color, len);
+    return;
+  }
+
+  uint8_t hi = color >> 8, lo = color;
+
+#if defined(ESP32) // ESP32 has a special SPI pixel-writing function...
+  if (connection == TFT_HARD_SPI) {
+    if (fillBuf) {
+      // Pool is already in display byte order, so it's issued as plain
+      // bytes, up to SPITFT_ESP32_FILL_LINES scanlines per call.
+      uint32_t const count = fillPool(color, len);
+      while (len) {
+        uint32_t const xferLen = (count < len) ? count : len;
+        hwspi._spi->writeBytes((uint8_t *)fillBuf, xferLen * 2);
+        len -= xferLen;
+      }
+      return;
+    }
+#define SPI_MAX_PIXELS_AT_ONCE 32
+#define TMPBUF_LONGWORDS (SPI_MAX_PIXELS_AT_ONCE + 1) / 2
+#define TMPBUF_PIXELS (TMPBUF_LONGWORDS * 2)
+    static uint32_t temp[TMPBUF_LONGWORDS];
+    uint32_t c32 = color * 0x00010001;
+    uint16_t bufLen = (len < TMPBUF_PIXELS) ? len : TMPBUF_PIXELS, xferLen,
+             fillLen;
+    // Fill temp buffer 32 bits at a time
+    fillLen = (bufLen + 1) / 2; // Round up to next 32-bit boundary
+    for (uint32_t t = 0; t < fillLen; t++) {
+      temp[t] = c32;
+    }
+    // Issue pixels in blocks from temp buffer
+    while (len) {                              // While pixels remain
+      xferLen = (bufLen < len) ? bufLen : len; // How many this pass?
+      hwspi._spi->writePixels(temp, xferLen * 2); // As writePixels() does
+      len -= xferLen;
+    }
+    return;
+  }
+#elif defined(ARDUINO_NRF52_ADAFRUIT) &&                                       \
+    defined(NRF52840_XXAA) // Adafruit nRF52840 use SPIM3 DMA at 32Mhz
+  uint16_t const swap_color = __builtin_bswap16(color);
+  uint16_t *pixbuf = fillBuf;
+  uint32_t pixbufcount;
+
+  if (pixbuf) {
+    pixbufcount = fillPool(color, len);
+  } else {
+    // No pool: at most 2 scan lines, allocated for this call only
+    pixbufcount = min(len, ((uint32_t)2 * width()));
+    pixbuf = (uint16_t *)rtos_malloc(2 * pixbufcount);
+    if (pixbuf)
+      gfxFill565(pixbuf, swap_color, pixbufcount);
+  }
+
+  // use SPI3 DMA if we have a buffer, else fall back to writing each
+  // pixel loop below
+  if (pixbuf) {
+    while (len) {
+      uint32_t const count = min(len, pixbufcount);
+      hwspi._spi->transfer(pixbuf, NULL, 2 * count); // Already swapped
+      len -= count;
+    }
+
+    if (pixbuf != fillBuf)
+      rtos_free(pixbuf);
+    return;
+  }
+#else                      // !ESP32
+#if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
+  if (((connection == TFT_HARD_SPI) || (connection == TFT_PARALLEL)) &&
+      (len >= 16)) { // Don't bother with DMA on short pixel runs
+    int d, numDescriptors;
+    bool wide = (connection == TFT_PARALLEL) && tft8.wide; // See writePixels
+    // If high & low bytes are same, or the bus takes a whole pixel per
+    // (halfword) beat, every beat is the same and needs no buffer...
+    if ((hi == lo) || wide) {
+      onePixelBuf = color;
+      // Can do this with a relatively short descriptor list,
+      // each transferring a max of 32,767 (not 32,768) pixels.
+      // This won't run off the end of the allocated descriptor list,
+      // since we're using much larger chunks per descriptor here.
+      numDescriptors = (len + 32766) / 32767;
+      for (d = 0; d < numDescriptors; d++) {
+        int count = (len < 32767) ? len : 32767;
+        descriptor[d].SRCADDR.reg = (uint32_t)&onePixelBuf;
+        descriptor[d].BTCTRL.bit.SRCINC = 0;
+        descriptor[d].BTCNT.reg = wide ? count : count * 2;
+        descriptor[d].DESCADDR.reg = (uint32_t)&descriptor[d + 1];
+        len -= count;
+      }
+      descriptor[d - 1].DESCADDR.reg = 0;
+    } else {
+      // If high and low bytes are distinct, it's necessary to fill
+      // a buffer with pixel data (swapping high and low bytes because
+      // TFT and SAMD are different endianisms) and create a longer
+      // descriptor list pointing repeatedly to this data, filled 2
+      // pixels (32 bits) at a time.
+      uint32_t *pixelPtr = (uint32_t *)pixelBuf[0];
+      uint16_t const swap_color = __builtin_bswap16(color);
+      // We can avoid some or all of the buffer-filling if the color
+      // is the same as last time...
+      if (color == lastFillColor) {
+        // If length is longer than prior instance, fill only the
+        // additional pixels in the buffer and update lastFillLen.
+        if (len > lastFillLen) {
+          int fillStart = lastFillLen / 2,
+              fillEnd = (((len < maxFillLen) ? len : maxFillLen) + 1) / 2;
+          gfxFill565((uint16_t *)&pixelPtr[fillStart], swap_color,
+                     (fillEnd - fillStart) * 2);
+          lastFillLen = fillEnd * 2;
+        } // else do nothing, don't set pixels or change lastFillLen
+      } else {
+        int fillEnd = (((len < maxFillLen) ? len : maxFillLen) + 1) / 2;
+        gfxFill565((uint16_t *)pixelPtr, swap_color, fillEnd * 2);
+        lastFillLen = fillEnd * 2;
+        lastFillColor = color;
+      }
+
+      numDescriptors = (len + maxFillLen - 1) / maxFillLen;
+      for (d = 0; d < numDescriptors; d++) {
+        int pixels = (len < maxFillLen) ? len : maxFillLen, bytes = pixels * 2;
+        descriptor[d].SRCADDR.reg = (uint32_t)pixelPtr + bytes;
+        descriptor[d].BTCTRL.bit.SRCINC = 1;
+        descriptor[d].BTCNT.reg = bytes;
+        descriptor[d].DESCADDR.reg = (uint32_t)&descriptor[d + 1];
+        len -= pixels;
+      }
+      descriptor[d - 1].DESCADDR.reg = 0;
+    }
+    memcpy(dptr, &descriptor[0], sizeof(DmacDescriptor));
+#if defined(__SAMD51__)
+    if (connection == TFT_PARALLEL) {
+      // Switch WR pin to PWM or CCL
+      pinPeripheral(tft8._wr, wrPeripheral);
+    }
+#endif // end __SAMD51__
+
+    dma_busy = true;
+    dma.startJob();
+    if (connection == TFT_PARALLEL)
+      dma.trigger();
+    dmaSpin(); // Wait for completion
+      // Unfortunately blocking is necessary. An earlier version returned
+      // immediately and checked dma_busy on startWrite() instead, but it
+      // turns out to be MUCH slower on many graphics operations (as when
+      // drawing lines, pixel-by-pixel), perhaps because it's a volatile
+      // type and doesn't cache. Working on this.
+#if defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO)
+    if (connection == TFT_HARD_SPI) {
+      // SAMD51: SPI DMA seems to leave the SPI peripheral in a freaky
+      // state on completion. Workaround is to explicitly set it back...
+      // (5/17/2019: apparently SAMD21 too, in certain cases, observed
+      // with ST7789 display.)
+      hwspi._spi->setDataMode(hwspi._mode);
+    } else {
+      pinPeripheral(tft8._wr, PIO_OUTPUT); // Switch WR back to GPIO
+    }
+#endif // end __SAMD51__
+    return;
+  }
+#endif // end USE_SPI_DMA
+#endif // end !ESP32
+
+  // All other cases (non-DMA hard SPI, bitbang SPI, parallel)...
+
+  if (connection == TFT_HARD_SPI) {
+#if defined(ESP8266)
+    do {
+      uint32_t pixelsThisPass = len;
+      if (pixelsThisPass > 50000)
+        pixelsThisPass = 50000;
+      len -= pixelsThisPass;
+      yield(); // Periodic yield() on long fills
+      while (pixelsThisPass--) {
+        hwspi._spi->write(hi);
+        hwspi._spi->write(lo);
+      }
+    } while (len);
+#else // !ESP8266
+    while (len--) {
+#if defined(__AVR__)
+      AVR_WRITESPI(hi);
+      AVR_WRITESPI(lo);
+#elif defined(ESP32)
+      hwspi._spi->write(hi);
+      hwspi._spi->write(lo);
+#else
+      hwspi._spi->transfer(hi);
+      hwspi._spi->transfer(lo);
+#endif
+    }
+#endif // end !ESP8266
+  } else if (connection == TFT_SOFT_SPI) {
+#if defined(USE_FAST_PINIO)
+    softSPIWriteColor(color, len);
+#elif defined(ESP8266)
+    do {
+      uint32_t pixelsThisPass = len;
+      if (pixelsThisPass > 20000)
+        pixelsThisPass = 20000;
+      len -= pixelsThisPass;
+      yield(); // Periodic yield() on long fills
+      while (pixelsThisPass--) {
+        for (uint16_t bit = 0, x = color; bit < 16; bit++) {
+          if (x & 0x8000)
+            SPI_MOSI_HIGH();
+          else
+            SPI_MOSI_LOW();
+          SPI_SCK_HIGH();
+          SPI_SCK_LOW();
+          x <<= 1;
+        }
+      }
+    } while (len);
+#else // !USE_FAST_PINIO && !ESP8266
+    while (len--) {
+      for (uint16_t bit = 0, x = color; bit < 16; bit++) {
+        if (x & 0x8000)
+          SPI_MOSI_HIGH();
+        else
+          SPI_MOSI_LOW();
+        SPI_SCK_HIGH();
+        x <<= 1;
+        SPI_SCK_LOW();
+      }
+    }
+#endif     // end !USE_FAST_PINIO && !ESP8266
+  } else { // PARALLEL
+#if defined(USE_PIO_PARALLEL)
+    if ((tft8.dmaChan >= 0) && (len >= 16)) {
+      // DMA repeats one pixel, no buffer to fill. Wait for the channel
+      // (so the source pixel can be reused next time), not the bus.
+      tft8.pioColor = color;
+      pioPixels(&tft8.pioColor, len, false, false);
+      dmaSpin();
+    } else {
+      while (len--) {
+        pioWrite(color, true);
+      }
+    }
+    return;
+#endif
+#if defined(USE_FAST_PINIO) && !defined(__AVR__)
+    if (tft8.wide) {
+      // A 16-bit bus holds the whole color, so every fill is like the
+      // hi == lo case below: set the port once, then just strobe.
+      *(volatile uint16_t *)tft8.writePort = color;
+      while (len--) {
+        TFT_WR_STROBE();
+      }
+      return;
+    }
+#endif
+    if (hi == lo) {
+#if defined(USE_FAST_PINIO)
+      len *= 2;
+      *tft8.writePort = hi;
+      while (len--) {
+        TFT_WR_STROBE();
+      }
+#endif
+    } else {
+      while (len--) {
+#if defined(USE_FAST_PINIO)
+        *tft8.writePort = hi;
+        TFT_WR_STROBE();
+        *tft8.writePort = lo;
+#endif
+        TFT_WR_STROBE();
+      }
+    }
+  }
+}
+
+/*!
+    @brief  Draw a filled rectangle to the display. Not self-contained;
+            should follow startWrite(). Typically used by higher-level
+            graphics primitives; user code shouldn't need to call this and
+            is likely to use the self-contained fillRect() instead.
+            writeFillRect() performs its own edge clipping and rejection;
+            see writeFillRectPreclipped() for a more 'raw' implementation.
+    @param  x      Horizontal position of first corner.
+    @param  y      Vertical position of first corner.
+    @param  w      Rectangle width in pixels (positive = right of first
+                   corner, negative = left of first corner).
+    @param  h      Rectangle height in pixels (positive = below first
+                   corner, negative = above first corner).
+    @param  color  16-bit fill color in '565' RGB format.
+    @note   Clipping is to the display edges and any clip rect, after
+            translating by the drawing origin; see Adafruit_GFX::clipRect().
+*/
+void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                    uint16_t color) {
+  if (clipRect(&x, &y, &w, &h)) // Partly or fully visible?
+    writeFillRectPreclipped(x, y, w, h, color);
+}
+
+/*!
+    @brief  Draw a horizontal line on the display. Performs edge clipping
+            and rejection. Not self-contained; should follow startWrite().
+            Typically used by higher-level graphics primitives; user code
+            shouldn't need to call this and is likely to use the self-
+            contained drawFastHLine() instead.
+    @param  x      Horizontal position of first point.
+    @param  y      Vertical position of first point.
+    @param  w      Line width in pixels (positive = right of first point,
+                   negative = point of first corner).
+    @param  color  16-bit line color in '565' RGB format.
+*/
+void inline Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w,
+                                            uint16_t color) {
+  int16_t h = 1;
+  if (clipRect(&x, &y, &w, &h)) { // Partly or fully visible?
+    writeFillRectPreclipped(x, y, w, h, color);
+  }
+}
+
+/*!
+    @brief  Draw a vertical line on the display. Performs edge clipping and
+            rejection. Not self-contained; should follow startWrite().
+            Typically used by higher-level graphics primitives; user code
+            shouldn't need to call this and is likely to use the self-
+            contained drawFastVLine() instead.
+    @param  x      Horizontal position of first point.
+    @param  y      Vertical position of first point.
+    @param  h      Line height in pixels (positive = below first point,
+                   negative = above first point).
+    @param  color  16-bit line color in '565' RGB format.
+*/
+void inline Adafruit_SPITFT::writeFastVLine(int16_t x, int16_t y, int16_t h,
+                                            uint16_t color) {
+  int16_t w = 1;
+  if (clipRect(&x, &y, &w, &h)) { // Partly or fully visible?
+    writeFillRectPreclipped(x, y, w, h, color);
+  }
+}
+
+/*!
+    @brief  A lower-level version of writeFillRect(). This version requires
+            all inputs are in-bounds, that width and height are positive,
+            and no part extends offscreen. NO EDGE CLIPPING OR REJECTION IS
+            PERFORMED. If higher-level graphics primitives are written to
+            handle their own clipping earlier in the drawing process, this
+            can avoid unnecessary function calls and repeated clipping
+            operations in the lower-level functions.
+    @param  x      Horizontal position of first corner. MUST BE WITHIN
+                   SCREEN BOUNDS.
+    @param  y      Vertical position of first corner. MUST BE WITHIN SCREEN
+                   BOUNDS.
+    @param  w      Rectangle width in pixels. MUST BE POSITIVE AND NOT
+                   EXTEND OFF SCREEN.
+    @param  h      Rectangle height in pixels. MUST BE POSITIVE AND NOT
+                   EXTEND OFF SCREEN.
+    @param  color  16-bit fill color in '565' RGB format.
+    @note   This is a new function, no graphics primitives besides rects
+            and horizontal/vertical lines are written to best use this yet.
+*/
+inline void Adafruit_SPITFT::writeFillRectPreclipped(int16_t x, int16_t y,
+                                                     int16_t w, int16_t h,
+                                                     uint16_t color) {
+  if ((hwCaps & GFX_HW_FILL) && hwFillRect(x, y, w, h, color))
+    return;
+  writeAddrWindow(x, y, w, h);
+  writeColor(color, (uint32_t)w * h);
+}
+
+// -------------------------------------------------------------------------
+// Ever-so-slightly higher-level graphics operations. Similar to the 'write'
+// functions above, but these contain their own chip-select and SPI
+// transactions as needed (via startWrite(), endWrite()). They're typically
+// used solo -- as graphics primitives in themselves, not invoked by higher-
+// level primitives (which should use the functions above for better
+// performance).
+
+/*!
+    @brief  Draw a single pixel to the display at requested coordinates.
+            Self-contained and provides its own transaction as needed
+            (see writePixel(x,y,color) for a lower-level variant).
+            Edge clipping is performed here.
+    @param  x      Horizontal position (0 = left).
+    @param  y      Vertical position   (0 = top).
+    @param  color  16-bit pixel color in '565' RGB format.
+*/
+void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  // Clip first...
+  if (clipPixel(&x, &y)) {
+    // THEN set up transaction (if needed) and draw...
+    startWrite();
+    writeAddrWindow(x, y, 1, 1);
+    SPITFT_COUNT(pixels, 1);
+    SPITFT_COUNT(bytes, 2);
+    if (transport)
+      transport->pushColor(color, 1);
+    else
+      SPI_WRITE16(color);
+    endWrite();
+  }
+}
+
+/*!
+    @brief  Draw a filled rectangle to the display. Self-contained and
+            provides its own transaction as needed (see writeFillRect() or
+            writeFillRectPreclipped() for lower-level variants). Edge
+            clipping and rejection is performed here.
+    @param  x      Horizontal position of first corner.
+    @param  y      Vertical position of first corner.
+    @param  w      Rectangle width in pixels (positive = right of first
+                   corner, negative = left of first corner).
+    @param  h      Rectangle height in pixels (positive = below first
+                   corner, negative = above first corner).
+    @param  color  16-bit fill color in '565' RGB format.
+    @note   This repeats the writeFillRect() function, with the addition
+            of a transaction start/end. It's done this way (rather than
+            starting the transaction and calling writeFillRect() to handle
+            clipping and so forth) so that the transaction isn't performed
+            at all if the rectangle is rejected.
+*/
+void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                               uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_FILLRECT, (int32_t)w * h);
+  if (clipRect(&x, &y, &w, &h)) { // Partly or fully visible?
+    startWrite();
+    writeFillRectPreclipped(x, y, w, h, color);
+    endWrite();
+  }
+}
+
+/*!
+    @brief  Draw a horizontal line on the display. Self-contained and
+            provides its own transaction as needed (see writeFastHLine() for
+            a lower-level variant). Edge clipping and rejection is performed
+            here.
+    @param  x      Horizontal position of first point.
+    @param  y      Vertical position of first point.
+    @param  w      Line width in pixels (positive = right of first point,
+                   negative = point of first corner).
+    @param  color  16-bit line color in '565' RGB format.
+    @note   This repeats the writeFastHLine() function almost in its
+            entirety, with the addition of a transaction start/end. It's
+            done this way (rather than starting the transaction and calling
+            writeFastHLine() to handle clipping and so forth) so that the
+            transaction isn't performed at all if the line is rejected.
+*/
+void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                    uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_FASTHLINE, w);
+  int16_t h = 1;
+  if (clipRect(&x, &y, &w, &h)) { // Partly or fully visible?
+    startWrite();
+    writeFillRectPreclipped(x, y, w, h, color);
+    endWrite();
+  }
+}
+
+/*!
+    @brief  Draw a vertical line on the display. Self-contained and provides
+            its own transaction as needed (see writeFastHLine() for a lower-
+            level variant). Edge clipping and rejection is performed here.
+    @param  x      Horizontal position of first point.
+    @param  y      Vertical position of first point.
+    @param  h      Line height in pixels (positive = below first point,
+                   negative = above first point).
+    @param  color  16-bit line color in '565' RGB format.
+    @note   This repeats the writeFastVLine() function almost in its
+            entirety, with the addition of a transaction start/end. It's
+            done this way (rather than starting the transaction and calling
+            writeFastVLine() to handle clipping and so forth) so that the
+            transaction isn't performed at all if the line is rejected.
+*/
+void Adafruit_SPITFT::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                    uint16_t color) {
+  GFX_PROFILE_SCOPE(GFX_PROF_FASTVLINE, h);
+  int16_t w = 1;
+  if (clipRect(&x, &y, &w, &h)) { // Partly or fully visible?
+    startWrite();
+    writeFillRectPreclipped(x, y, w, h, color);
+    endWrite();
+  }
+}
+
+/*!
+    @brief  Draw a rectangle outline. Self-contained and provides its own
+            transaction as needed. A rect no more than 2 pixels across
+            either way is all edge and goes out as one fill; otherwise the
+            top and bottom are drawn first, then the sides only between
+            them, so no pixel is sent twice and each edge shares its
+            column or row range with the one before it (which
+            setAddrWindowMIPI() doesn't resend).
+    @param  x      Left edge.
+    @param  y      Top edge.
+    @param  w      Width in pixels.
+    @param  h      Height in pixels.
+    @param  color  16-bit outline color in '565' RGB format.
+*/
+void Adafruit_SPITFT::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                               uint16_t color) {
+  if ((w <= 0) || (h <= 0)) {
+    Adafruit_GFX::drawRect(x, y, w, h, color); // Odd cases as they were
+    return;
+  }
+  if (!clipOverlaps(x, y, x + w - 1, y + h - 1))
+    return;
+  startWrite();
+  if ((w <= 2) || (h <= 2)) {
+    writeFillRect(x, y, w, h, color);
+  } else {
+    writeFastHLine(x, y, w, color);                 // Top
+    writeFastHLine(x, y + h - 1, w, color);         // Bottom
+    writeFastVLine(x, y + 1, h - 2, color);         // Left
+    writeFastVLine(x + w - 1, y + 1, h - 2, color); // Right
+  }
+  endWrite();
+}
+
+/*!
+    @brief  Essentially writePixel() with a transaction around it. I don't
+            think this is in use by any of our code anymore (believe it was
+            for some older BMP-reading examples), but is kept here in case
+            any user code relies on it. Consider it DEPRECATED.
+    @param  color  16-bit pixel color in '565' RGB format.
+*/
+void Adafruit_SPITFT::pushColor(uint16_t color) {
+  SPITFT_COUNT(pixels, 1);
+  SPITFT_COUNT(bytes, 2);
+  startWrite();
+  if (transport)
+    transport->pushColor(color, 1);
+  else
+    SPI_WRITE16(color);
+  endWrite();
+}
+
+/*!
+    @brief  Draw a 16-bit image (565 RGB) at the specified (x,y) position.
+            For 16-bit display devices; no color reduction performed.
+            Adapted from https://github.com/PaulStoffregen/ILI9341_t3
+            by Marc MERLIN. See examples/pictureEmbed to use this.
+            5/6/2017: function name and arguments have changed for
+            compatibility with current GFX library and to avoid naming
+            problems in prior implementation.  Formerly drawBitmap() with
+            arguments in different order. Handles its own transaction and
+            edge clipping/rejection.
+    @param  x        Top left corner horizontal coordinate.
+    @param  y        Top left corner vertical coordinate.
+    @param  pcolors  Pointer to 16-bit array of pixel values.
+    @param  w        Width of bitmap in pixels.
+    @param  h        Height of bitmap in pixels.
+*/
+void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
+                                    int16_t w, int16_t h) {
+  GFX_PROFILE_SCOPE(GFX_PROF_RGBBITMAP, (int32_t)w * h);
+
+  int16_t bx = x + _originX, by = y + _originY, // Unclipped top-left
+      saveW = w; // Save original bitmap width value
+  if ((w <= 0) || (h <= 0) || !clipRect(&x, &y, &w, &h))
+    return; // Nothing visible after clipping
+
+  pcolors += (y - by) * saveW + (x - bx); // Offset ptr to clipped top-left
+  startWrite();
+  writeAddrWindow(x, y, w, h); // Clipped area
+  while (h--) {              // For each (clipped) scanline...
+    writePixels(pcolors, w); // Push one (clipped) row
+    pcolors += saveW;        // Advance pointer by one full (unclipped) line
+  }
+  endWrite();
+}
+
+/*!
+    @brief  Draw a RAM-resident image of 8 bits per channel (RGB888,
+            BGR888 or 8-bit grayscale), such as a camera frame. Same
+            result as Adafruit_GFX::drawRGB888Bitmap(), but the visible
+            part goes through a single setAddrWindow(), converted to 5-6-5
+            a chunk at a time into two stack buffers by gfxConvert565();
+            where writePixels() is DMA, each chunk converts while the last
+            one transfers.
+    @param  x       Top left corner horizontal coordinate.
+    @param  y       Top left corner vertical coordinate.
+    @param  bitmap  Image rows, w pixels each with no padding.
+    @param  w       Width of bitmap in pixels.
+    @param  h       Height of bitmap in pixels.
+    @param  format  GFX_RGB888 (default), GFX_BGR888 or GFX_GRAY8.
+    @param  dither  true (default) for ordered dithering, false to round
+                    to the nearest color.
+*/
+void Adafruit_SPITFT::drawRGB888Bitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                       int16_t w, int16_t h,
+                                       GFXrgbFormat format, bool dither) {
+  int16_t bx = x + _originX, by = y + _originY, bw = w; // Unclipped
+  if ((w <= 0) || (h <= 0) || !clipRect(&x, &y, &w, &h))
+    return; // Nothing visible after clipping
+  uint8_t bpp = (format == GFX_GRAY8) ? 1 : 3;
+  bool bigEndian = false;
+#if defined(SPITFT_PRESWAP)
+  bigEndian = true; // Convert straight to display order
 #endif
+  uint16_t buf[2][SPITFT_IMAGE_CHUNK];
+  uint8_t k = 0; // Buffer to fill next; the other may still be sending
+  startWrite();
+  writeAddrWindow(x, y, w, h);
+  for (int16_t j = 0; j < h; j++) {
+    const uint8_t *row =
+        &bitmap[((int32_t)(y - by + j) * bw + (x - bx)) * bpp];
+    for (int16_t i = 0; i < w; i += SPITFT_IMAGE_CHUNK) {
+      int16_t n = (w - i < SPITFT_IMAGE_CHUNK) ? w - i : SPITFT_IMAGE_CHUNK;
+      gfxConvert565(buf[k], &row[i * bpp], n, format, x - _originX + i,
+                    y - _originY + j, dither, bigEndian);
+      writePixels(buf[k], n, false, bigEndian);
+      k = 1 - k;
     }
-#endif // end !ESP8266
-  } else if (connection == TFT_SOFT_SPI) {
-#if defined(ESP8266)
-    do {
-      uint32_t pixelsThisPass = len;
-      if (pixelsThisPass > 20000)
-        pixelsThisPass = 20000;
-      len -= pixelsThisPass;
-      yield(); // Periodic yield() on long fills
-      while (pixelsThisPass--) {
-        for (uint16_t bit = 0, x = color; bit < 16; bit++) {
-          if (x & 0x8000)
-            SPI_MOSI_HIGH();
-          else
-            SPI_MOSI_LOW();
-          SPI_SCK_HIGH();
-          SPI_SCK_LOW();
-          x <<= 1;
-        }
-      }
-    } while (len);
-#else // !ESP8266
-    while (len--) {
-#if defined(__AVR__)
-      for (uint8_t bit = 0, x = hi; bit < 8; bit++) {
-        if (x & 0x80)
-          SPI_MOSI_HIGH();
-        else
-          SPI_MOSI_LOW();
-        SPI_SCK_HIGH();
-        SPI_SCK_LOW();
-        x <<= 1;
-      }
-      for (uint8_t bit = 0, x = lo; bit < 8; bit++) {
-        if (x & 0x80)
-          SPI_MOSI_HIGH();
-        else
-          SPI_MOSI_LOW();
-        SPI_SCK_HIGH();
-        SPI_SCK_LOW();
-        x <<= 1;
+  }
+  dmaWait();
+  endWrite();
+}
+
+/*!
+    @brief  Fill a rectangle with a linear gradient. Same result as
+            Adafruit_GFX::fillRectGradientStops(), but through a single
+            setAddrWindow(), each line of pixels computed into one of two
+            stack buffers while (with DMA) the other transfers. Vertical
+            gradients fill a buffer with each row's color; horizontal
+            ones compute the row once if it fits in both buffers, so that
+            a background costs little more than its bus time.
+    @param  x         Top left corner horizontal coordinate.
+    @param  y         Top left corner vertical coordinate.
+    @param  w         Width in pixels.
+    @param  h         Height in pixels.
+    @param  stops     RAM-resident colors and positions, pos ascending.
+    @param  nStops    Number of stops.
+    @param  vertical  true (default) for colors changing top to bottom,
+                      false for left to right.
+*/
+void Adafruit_SPITFT::fillRectGradientStops(int16_t x, int16_t y, int16_t w,
+                                            int16_t h,
+                                            const GFXgradientStop *stops,
+                                            uint8_t nStops, bool vertical) {
+  if ((w <= 0) || (h <= 0) || !nStops)
+    return; // Same rejections as the generic version, single stop or not
+  if (nStops == 1) {
+    fillRect(x, y, w, h, stops[0].color);
+    return;
+  }
+  int16_t bx = x + _originX, by = y + _originY, // Unclipped top-left
+      len = vertical ? h : w;                   // and gradient length
+  if (!clipRect(&x, &y, &w, &h))
+    return; // Nothing visible after clipping
+  bool bigEndian = false;
+#if defined(SPITFT_PRESWAP)
+  bigEndian = true; // Compute colors straight in display order
+#endif
+  uint16_t buf[2 * SPITFT_IMAGE_CHUNK];
+  uint8_t k = 0; // Half of buf to fill next; the other may still be sending
+  startWrite();
+  writeAddrWindow(x, y, w, h);
+  if (vertical) {
+    int16_t n = (w < SPITFT_IMAGE_CHUNK) ? w : SPITFT_IMAGE_CHUNK;
+    for (int16_t j = 0; j < h; j++) {
+      uint16_t *px = &buf[k * SPITFT_IMAGE_CHUNK], c;
+      gfxGradient565(&c, 1, stops, nStops, len, y - by + j, bigEndian);
+      gfxFill565(px, c, n);
+      for (int16_t i = 0; i < w; i += n)
+        writePixels(px, (w - i < n) ? w - i : n, false, bigEndian);
+      k = 1 - k;
+    }
+  } else if (w <= 2 * SPITFT_IMAGE_CHUNK) { // Every row the same
+    gfxGradient565(buf, w, stops, nStops, len, x - bx, bigEndian);
+    for (int16_t j = 0; j < h; j++)
+      writePixels(buf, w, false, bigEndian);
+  } else {
+    for (int16_t j = 0; j < h; j++) {
+      for (int16_t i = 0; i < w; i += SPITFT_IMAGE_CHUNK) {
+        int16_t n = (w - i < SPITFT_IMAGE_CHUNK) ? w - i : SPITFT_IMAGE_CHUNK;
+        uint16_t *px = &buf[k * SPITFT_IMAGE_CHUNK];
+        gfxGradient565(px, n, stops, nStops, len, x - bx + i, bigEndian);
+        writePixels(px, n, false, bigEndian);
+        k = 1 - k;
       }
-#else      // !__AVR__
-      for (uint16_t bit = 0, x = color; bit < 16; bit++) {
-        if (x & 0x8000)
-          SPI_MOSI_HIGH();
+    }
+  }
+  dmaWait();
+  endWrite();
+}
+
+/*!
+    @brief  Fill a rectangle with copies of a small image. Same result as
+            Adafruit_GFX::fillRectPattern(), but through a single
+            setAddrWindow(), each line copied run by run from the tile
+            into one of two stack buffers while (with DMA) the other
+            transfers.
+    @param  x        Top left corner horizontal coordinate.
+    @param  y        Top left corner vertical coordinate.
+    @param  w        Width in pixels.
+    @param  h        Height in pixels.
+    @param  pattern  RAM-resident 16-bit 5-6-5 tile, pw * ph pixels.
+    @param  pw       Width of tile in pixels.
+    @param  ph       Height of tile in pixels.
+*/
+void Adafruit_SPITFT::fillRectPattern(int16_t x, int16_t y, int16_t w,
+                                      int16_t h, const uint16_t *pattern,
+                                      int16_t pw, int16_t ph) {
+  if ((w <= 0) || (h <= 0) || (pw <= 0) || (ph <= 0) ||
+      !clipRect(&x, &y, &w, &h))
+    return; // Nothing visible after clipping
+  // Tile column and row of the clipped top-left, tiled from drawing (0,0)
+  int16_t i0 = (x - _originX) % pw, t = (y - _originY) % ph;
+  if (i0 < 0)
+    i0 += pw;
+  if (t < 0)
+    t += ph;
+  bool bigEndian = false;
+#if defined(SPITFT_PRESWAP)
+  bigEndian = true; // Swap pixels to display order while copying
+#endif
+  uint16_t buf[2 * SPITFT_IMAGE_CHUNK];
+  uint8_t k = 0; // Half of buf to fill next; the other may still be sending
+  startWrite();
+  writeAddrWindow(x, y, w, h);
+  for (int16_t j = 0; j < h; j++) {
+    const uint16_t *line = &pattern[(int32_t)t * pw];
+    for (int16_t i = 0, c = i0; i < w; i += SPITFT_IMAGE_CHUNK) {
+      int16_t n = (w - i < SPITFT_IMAGE_CHUNK) ? w - i : SPITFT_IMAGE_CHUNK;
+      uint16_t *px = &buf[k * SPITFT_IMAGE_CHUNK];
+      for (int16_t p = 0; p < n;) { // A run to the tile's right edge
+        int16_t run = (pw - c < n - p) ? pw - c : n - p;
+        if (bigEndian)
+          gfxSwap565(&px[p], &line[c], run);
         else
-          SPI_MOSI_LOW();
-        SPI_SCK_HIGH();
-        x <<= 1;
-        SPI_SCK_LOW();
+          memcpy(&px[p], &line[c], run * 2);
+        p += run;
+        if ((c += run) == pw)
+          c = 0;
       }
-#endif     // end !__AVR__
+      writePixels(px, n, false, bigEndian);
+      k = 1 - k;
     }
-#endif     // end !ESP8266
-  } else { // PARALLEL
-    if (hi == lo) {
-#if defined(__AVR__)
-      len *= 2;
-      *tft8.writePort = hi;
-      while (len--) {
-        TFT_WR_STROBE();
-      }
-#elif defined(USE_FAST_PINIO)
-      if (!tft8.wide) {
-        len *= 2;
-        *tft8.writePort = hi;
+    if (++t == ph)
+      t = 0;
+  }
+  dmaWait();
+  endWrite();
+}
+
+/*!
+    @brief  Draw a PROGMEM-resident 1-bit image, set bits in a foreground
+            color and unset bits transparent. Same result as
+            Adafruit_GFX::drawBitmap(), but each row's runs of set bits
+            are issued as spans (merged into rects where they line up)
+            instead of one address window per pixel.
+    @param  x       Top left corner horizontal coordinate.
+    @param  y       Top left corner vertical coordinate.
+    @param  bitmap  Byte array with monochrome bitmap.
+    @param  w       Width of bitmap in pixels.
+    @param  h       Height of bitmap in pixels.
+    @param  color   16-bit 5-6-5 Color to draw set bits with.
+*/
+void Adafruit_SPITFT::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                                 int16_t w, int16_t h, uint16_t color) {
+  monoRuns(x, y, bitmap, w, h, color, true);
+}
+
+/*!
+    @brief  Draw a PROGMEM-resident 1-bit image, set bits in a foreground
+            color and unset in a background color. Same result as
+            Adafruit_GFX::drawBitmap(), but the visible part is sent
+            through a single setAddrWindow(), each row expanded to color
+            in writeIndexed()'s working buffers (with DMA, while the prior
+            row transfers) rather than pixel by pixel.
+    @param  x       Top left corner horizontal coordinate.
+    @param  y       Top left corner vertical coordinate.
+    @param  bitmap  Byte array with monochrome bitmap.
+    @param  w       Width of bitmap in pixels.
+    @param  h       Height of bitmap in pixels.
+    @param  color   16-bit 5-6-5 Color to draw set bits with.
+    @param  bg      16-bit 5-6-5 Color to draw unset bits with.
+*/
+void Adafruit_SPITFT::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                                 int16_t w, int16_t h, uint16_t color,
+                                 uint16_t bg) {
+  int16_t bx = x + _originX, by = y + _originY, bw = w; // Unclipped
+  if ((w > 0) && (h > 0) && clipRect(&x, &y, &w, &h))
+    pushMono(x, y, w, h, bitmap, (bw + 7) / 8, x - bx, y - by, color, bg,
+             true);
+}
+
+/*!
+    @brief  Draw a RAM-resident 1-bit image, set bits in a foreground color
+            and unset bits transparent, issued as runs like the PROGMEM
+            version.
+    @param  x       Top left corner horizontal coordinate.
+    @param  y       Top left corner vertical coordinate.
+    @param  bitmap  Byte array with monochrome bitmap.
+    @param  w       Width of bitmap in pixels.
+    @param  h       Height of bitmap in pixels.
+    @param  color   16-bit 5-6-5 Color to draw set bits with.
+*/
+void Adafruit_SPITFT::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                 int16_t w, int16_t h, uint16_t color) {
+  monoRuns(x, y, bitmap, w, h, color, false);
+}
+
+/*!
+    @brief  Draw a RAM-resident 1-bit image, set bits in a foreground color
+            and unset in a background color, expanded a row at a time
+            like the PROGMEM version. A GFXcanvas1's buffer (at its
+            rotation-0 size) is in this format, though flushCanvas() is
+            simpler for pushing one whole.
+    @param  x       Top left corner horizontal coordinate.
+    @param  y       Top left corner vertical coordinate.
+    @param  bitmap  Byte array with monochrome bitmap.
+    @param  w       Width of bitmap in pixels.
+    @param  h       Height of bitmap in pixels.
+    @param  color   16-bit 5-6-5 Color to draw set bits with.
+    @param  bg      16-bit 5-6-5 Color to draw unset bits with.
+*/
+void Adafruit_SPITFT::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                 int16_t w, int16_t h, uint16_t color,
+                                 uint16_t bg) {
+  int16_t bx = x + _originX, by = y + _originY, bw = w; // Unclipped
+  if ((w > 0) && (h > 0) && clipRect(&x, &y, &w, &h))
+    pushMono(x, y, w, h, bitmap, (bw + 7) / 8, x - bx, y - by, color, bg,
+             false);
+}
+
+/*!
+    @brief  Draw a compressed sprite (see GFXspriteReader), same result
+            as Adafruit_GFX::drawSprite(). Consecutive opaque ops share an
+            address window -- one for the whole sprite if it has no
+            transparent pixels -- and each run is a single writeColor(),
+            each literal span a writePixels() from a small stack buffer.
+    @param  x       Top left corner horizontal coordinate.
+    @param  y       Top left corner vertical coordinate.
+    @param  sprite  Byte array made by the spriteconvert tool (PROGMEM).
+*/
+void Adafruit_SPITFT::drawSprite(int16_t x, int16_t y, const uint8_t sprite[]) {
+  int16_t w = GFXspriteReader::width(sprite),
+          h = GFXspriteReader::height(sprite);
+  int16_t bx = x + _originX, by = y + _originY, vw = w, vh = h; // Unclipped
+  if ((w <= 0) || (h <= 0) || !clipRect(&x, &y, &vw, &vh))
+    return;
+  // Visible sprite columns [c0, c1) and rows [r0, r1)
+  int16_t c0 = x - bx, r0 = y - by, c1 = c0 + vw, r1 = r0 + vh;
+
+  GFXspriteReader reader(sprite);
+  uint16_t span[SPITFT_SPAN_LEN];
+  int16_t i = 0, j = 0; // Sprite column & row of next op
+  // Pixels are numbered across the visible area, row by row; the address
+  // window expects pixel 'next' and ends before pixel 'end'
+  int32_t next = -1, end = 0;
+  startWrite();
+  while (j < r1) {
+    uint16_t n;
+    uint8_t op = reader.next(&n);
+    while (n && (j < r1)) { // Split op at row ends
+      int16_t k = (n < (uint16_t)(w - i)) ? n : w - i;
+      int16_t a = (i > c0) ? i : c0, b = (i + k < c1) ? i + k : c1; // Shown
+      if ((op == GFXSPRITE_SKIP) || (j < r0) || (a >= b)) {
+        if (op == GFXSPRITE_LITERAL)
+          reader.skip(k);
       } else {
-        *(volatile uint16_t *)tft8.writePort = color;
-      }
-      while (len--) {
-        TFT_WR_STROBE();
-      }
-#endif
-    } else {
-      while (len--) {
-#if defined(__AVR__)
-        *tft8.writePort = hi;
-        TFT_WR_STROBE();
-        *tft8.writePort = lo;
-#elif defined(USE_FAST_PINIO)
-        if (!tft8.wide) {
-          *tft8.writePort = hi;
-          TFT_WR_STROBE();
-          *tft8.writePort = lo;
+        int32_t pos = (int32_t)(j - r0) * vw + a - c0;
+        if ((pos != next) || (pos >= end)) {
+          if (a == c0) { // Window over the rest of the visible area
+            writeAddrWindow(x, y + j - r0, vw, r1 - j);
+            end = (int32_t)vw * vh;
+          } else { // Window over the rest of this row
+            writeAddrWindow(x + a - c0, y + j - r0, c1 - a, 1);
+            end = pos + c1 - a;
+          }
+        }
+        next = pos + b - a;
+        if (op == GFXSPRITE_RUN) {
+          writeColor(reader.runColor(), b - a);
         } else {
-          *(volatile uint16_t *)tft8.writePort = color;
+          reader.skip(a - i);
+          for (int16_t m = b - a; m;) {
+            uint16_t count = (m < SPITFT_SPAN_LEN) ? m : SPITFT_SPAN_LEN;
+            for (uint16_t p = 0; p < count; p++)
+              span[p] = reader.pixel();
+            writePixels(span, count);
+            m -= count;
+          }
+          reader.skip(i + k - b);
         }
-#endif
-        TFT_WR_STROBE();
+      }
+      n -= k;
+      if ((i += k) == w) {
+        i = 0;
+        j++;
       }
     }
   }
+  endWrite();
 }
 
 /*!
-    @brief  Draw a filled rectangle to the display. Not self-contained;
-            should follow startWrite(). Typically used by higher-level
-            graphics primitives; user code shouldn't need to call this and
-            is likely to use the self-contained fillRect() instead.
-            writeFillRect() performs its own edge clipping and rejection;
-            see writeFillRectPreclipped() for a more 'raw' implementation.
-    @param  x      Horizontal position of first corner.
-    @param  y      Vertical position of first corner.
-    @param  w      Rectangle width in pixels (positive = right of first
-                   corner, negative = left of first corner).
-    @param  h      Rectangle height in pixels (positive = below first
-                   corner, negative = above first corner).
-    @param  color  16-bit fill color in '565' RGB format.
-    @note   Written in this deep-nested way because C by definition will
-            optimize for the 'if' case, not the 'else' -- avoids branches
-            and rejects clipped rectangles at the least-work possibility.
+    @brief  Issue a 1-bit image's set bits, row by row, as runs through a
+            GFXspanList. Handles its own transaction; clipped by the
+            span functions.
+    @param  x       Top left corner horizontal coordinate.
+    @param  y       Top left corner vertical coordinate.
+    @param  bitmap  Byte array with monochrome bitmap.
+    @param  w       Width of bitmap in pixels.
+    @param  h       Height of bitmap in pixels.
+    @param  color   16-bit 5-6-5 Color to draw set bits with.
+    @param  pgm     true if bitmap is PROGMEM-resident.
 */
-void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
-                                    uint16_t color) {
-  if (w && h) {   // Nonzero width and height?
-    if (w < 0) {  // If negative width...
-      x += w + 1; //   Move X to left edge
-      w = -w;     //   Use positive width
-    }
-    if (x < _width) { // Not off right
-      if (h < 0) {    // If negative height...
-        y += h + 1;   //   Move Y to top edge
-        h = -h;       //   Use positive height
-      }
-      if (y < _height) { // Not off bottom
-        int16_t x2 = x + w - 1;
-        if (x2 >= 0) { // Not off left
-          int16_t y2 = y + h - 1;
-          if (y2 >= 0) { // Not off top
-            // Rectangle partly or fully overlaps screen
-            if (x < 0) {
-              x = 0;
-              w = x2 + 1;
-            } // Clip left
-            if (y < 0) {
-              y = 0;
-              h = y2 + 1;
-            } // Clip top
-            if (x2 >= _width) {
-              w = _width - x;
-            } // Clip right
-            if (y2 >= _height) {
-              h = _height - y;
-            } // Clip bottom
-            writeFillRectPreclipped(x, y, w, h, color);
-          }
+void Adafruit_SPITFT::monoRuns(int16_t x, int16_t y, const uint8_t *bitmap,
+                               int16_t w, int16_t h, uint16_t color,
+                               bool pgm) {
+  int16_t byteWidth = (w + 7) / 8, j0, j1; // Bitmap rows, visible rows
+  if (!clipRows(x, y, w, h, &j0, &j1))
+    return;
+  GFXspanList spans(this, color);
+  startWrite();
+  for (int16_t j = j0; j < j1; j++) {
+    const uint8_t *row = &bitmap[j * byteWidth];
+    int16_t start = -1; // First column of current run, -1 if none
+    uint8_t byte = 0;
+    for (int16_t i = 0; i < w; i++, byte <<= 1) {
+      if (!(i & 7)) {
+        byte = pgm ? pgm_read_byte(&row[i / 8]) : row[i / 8];
+        if (!byte && (start < 0)) { // Nothing in this byte, skip it
+          i += 7;
+          continue;
         }
       }
+      if (byte & 0x80) {
+        if (start < 0)
+          start = i;
+      } else if (start >= 0) {
+        spans.add(x + start, y + j, i - start, 1);
+        start = -1;
+      }
     }
+    if (start >= 0)
+      spans.add(x + start, y + j, w - start, 1);
   }
+  spans.flush();
+  endWrite();
 }
 
 /*!
-    @brief  Draw a horizontal line on the display. Performs edge clipping
-            and rejection. Not self-contained; should follow startWrite().
-            Typically used by higher-level graphics primitives; user code
-            shouldn't need to call this and is likely to use the self-
-            contained drawFastHLine() instead.
-    @param  x      Horizontal position of first point.
-    @param  y      Vertical position of first point.
-    @param  w      Line width in pixels (positive = right of first point,
-                   negative = point of first corner).
-    @param  color  16-bit line color in '565' RGB format.
+    @brief  Push a GFXcanvas16 to the display at the specified (x,y)
+            position. If the canvas has dirty-rectangle tracking enabled
+            (see GFXcanvas16::setDirtyTracking()), only the areas changed
+            since the last flush are issued, each with a single
+            setAddrWindow() and one writePixels() per scanline (or just one
+            if the area spans the canvas width); otherwise the whole canvas
+            is pushed, same as drawRGBBitmap(). Canvases constructed
+            big-endian are sent without any per-pixel swap, on DMA-capable
+            devices straight from the canvas buffer. Either way the
+            canvas' dirty list is cleared afterward. Canvas buffer is
+            pushed as-is (unrotated), the same as passing getBuffer() to
+            drawRGBBitmap(). Handles its own transaction and edge clipping;
+            (x,y) is a display position, unaffected by setOrigin() or any
+            clip rect.
+    @param  x       Top left corner horizontal coordinate of canvas.
+    @param  y       Top left corner vertical coordinate of canvas.
+    @param  canvas  Pointer to GFXcanvas16 to push.
 */
-void inline Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w,
-                                            uint16_t color) {
-  if ((y >= 0) && (y < _height) && w) { // Y on screen, nonzero width
-    if (w < 0) {                        // If negative width...
-      x += w + 1;                       //   Move X to left edge
-      w = -w;                           //   Use positive width
-    }
-    if (x < _width) { // Not off right
-      int16_t x2 = x + w - 1;
-      if (x2 >= 0) { // Not off left
-        // Line partly or fully overlaps screen
-        if (x < 0) {
-          x = 0;
-          w = x2 + 1;
-        } // Clip left
-        if (x2 >= _width) {
-          w = _width - x;
-        } // Clip right
-        writeFillRectPreclipped(x, y, w, 1, color);
+void Adafruit_SPITFT::flushCanvas(int16_t x, int16_t y, GFXcanvas16 *canvas) {
+  GFX_PROFILE_SCOPE(GFX_PROF_FLUSHCANVAS,
+                    (int32_t)canvas->width() * canvas->height());
+  uint16_t *buf = canvas->getBuffer();
+  if (!buf)
+    return;
+  tearSync();
+  // Canvas buffer is always laid out at its rotation-0 dimensions
+  int16_t cw = canvas->width(), ch = canvas->height();
+  if (canvas->getRotation() & 1) {
+    int16_t t = cw;
+    cw = ch;
+    ch = t;
+  }
+
+  bool bigEndian = canvas->getBigEndian();
+  bool tracking = canvas->getDirtyTracking();
+  int16_t rx, ry, rw, rh;
+  startWrite();
+  for (uint8_t i = 0;; i++) {
+    if (tracking) {
+      if (!canvas->getDirtyRect(i, &rx, &ry, &rw, &rh))
+        break;
+    } else if (i) {
+      break;
+    } else { // Untracked canvas, push the whole thing
+      rx = ry = 0;
+      rw = cw;
+      rh = ch;
+    }
+    int16_t dx = x + rx, dy = y + ry; // Rect position on display
+    if (!clipPush(&dx, &dy, &rx, &ry, &rw, &rh))
+      continue;
+    uint16_t *ptr = &buf[ry * cw + rx];
+    writeAddrWindow(dx, dy, rw, rh);
+    if (rw == cw) { // Full-width rows are contiguous, send in one go
+      writePixels(ptr, (uint32_t)rw * rh, true, bigEndian);
+    } else {
+      while (rh--) {
+        writePixels(ptr, rw, true, bigEndian);
+        ptr += cw;
       }
     }
   }
+  endWrite();
+  canvas->clearDirty();
 }
 
 /*!
-    @brief  Draw a vertical line on the display. Performs edge clipping and
-            rejection. Not self-contained; should follow startWrite().
-            Typically used by higher-level graphics primitives; user code
-            shouldn't need to call this and is likely to use the self-
-            contained drawFastVLine() instead.
-    @param  x      Horizontal position of first point.
-    @param  y      Vertical position of first point.
-    @param  h      Line height in pixels (positive = below first point,
-                   negative = above first point).
-    @param  color  16-bit line color in '565' RGB format.
+    @brief  Push a GFXcanvas8 to the display, each pixel value looked up in
+            the canvas's RGB565 palette as it's sent (see
+            GFXcanvas8::getPalette()). At half the RAM of a GFXcanvas16,
+            with DMA the next scanline is expanded while the prior one
+            transfers, so throughput is close to pushing a GFXcanvas16.
+            Changing palette entries and pushing again recolors the image
+            without redrawing it. Like the GFXcanvas16 version, position
+            is in display coordinates, unaffected by origin and clip rect.
+    @param  x       Top left corner horizontal coordinate of canvas.
+    @param  y       Top left corner vertical coordinate of canvas.
+    @param  canvas  Pointer to GFXcanvas8 to push.
 */
-void inline Adafruit_SPITFT::writeFastVLine(int16_t x, int16_t y, int16_t h,
-                                            uint16_t color) {
-  if ((x >= 0) && (x < _width) && h) { // X on screen, nonzero height
-    if (h < 0) {                       // If negative height...
-      y += h + 1;                      //   Move Y to top edge
-      h = -h;                          //   Use positive height
-    }
-    if (y < _height) { // Not off bottom
-      int16_t y2 = y + h - 1;
-      if (y2 >= 0) { // Not off top
-        // Line partly or fully overlaps screen
-        if (y < 0) {
-          y = 0;
-          h = y2 + 1;
-        } // Clip top
-        if (y2 >= _height) {
-          h = _height - y;
-        } // Clip bottom
-        writeFillRectPreclipped(x, y, 1, h, color);
-      }
+void Adafruit_SPITFT::flushCanvas(int16_t x, int16_t y, GFXcanvas8 *canvas) {
+  GFX_PROFILE_SCOPE(GFX_PROF_FLUSHCANVAS,
+                    (int32_t)canvas->width() * canvas->height());
+  uint8_t *buf = canvas->getBuffer();
+  uint16_t *palette = canvas->getPalette();
+  if (!buf || !palette)
+    return;
+  tearSync();
+  int16_t cw = canvas->width(), ch = canvas->height();
+  if (canvas->getRotation() & 1) { // Buffer is in rotation-0 layout
+    int16_t t = cw;
+    cw = ch;
+    ch = t;
+  }
+  int16_t rx = 0, ry = 0, rw = cw, rh = ch;
+  if (!clipPush(&x, &y, &rx, &ry, &rw, &rh))
+    return;
+  uint8_t *ptr = &buf[ry * cw + rx];
+  startWrite();
+  writeAddrWindow(x, y, rw, rh);
+  if (rw == cw) {
+    writeIndexed(ptr, (uint32_t)rw * rh, palette);
+  } else {
+    while (rh--) {
+      writeIndexed(ptr, rw, palette);
+      ptr += cw;
     }
   }
+  endWrite();
 }
 
 /*!
-    @brief  A lower-level version of writeFillRect(). This version requires
-            all inputs are in-bounds, that width and height are positive,
-            and no part extends offscreen. NO EDGE CLIPPING OR REJECTION IS
-            PERFORMED. If higher-level graphics primitives are written to
-            handle their own clipping earlier in the drawing process, this
-            can avoid unnecessary function calls and repeated clipping
-            operations in the lower-level functions.
-    @param  x      Horizontal position of first corner. MUST BE WITHIN
-                   SCREEN BOUNDS.
-    @param  y      Vertical position of first corner. MUST BE WITHIN SCREEN
-                   BOUNDS.
-    @param  w      Rectangle width in pixels. MUST BE POSITIVE AND NOT
-                   EXTEND OFF SCREEN.
-    @param  h      Rectangle height in pixels. MUST BE POSITIVE AND NOT
-                   EXTEND OFF SCREEN.
-    @param  color  16-bit fill color in '565' RGB format.
-    @note   This is a new function, no graphics primitives besides rects
-            and horizontal/vertical lines are written to best use this yet.
+    @brief  Push a GFXcanvas4 or GFXcanvas2 to the display, each pixel
+            looked up in the canvas's RGB565 palette as it's sent, the
+            same way as the GFXcanvas8 version. A full-screen 320x240
+            GFXcanvas4 is 37.5 KB, against 150 KB for a GFXcanvas16.
+    @param  x       Top left corner horizontal coordinate of canvas.
+    @param  y       Top left corner vertical coordinate of canvas.
+    @param  canvas  Pointer to GFXcanvas4 or GFXcanvas2 to push.
 */
-inline void Adafruit_SPITFT::writeFillRectPreclipped(int16_t x, int16_t y,
-                                                     int16_t w, int16_t h,
-                                                     uint16_t color) {
-  setAddrWindow(x, y, w, h);
-  writeColor(color, (uint32_t)w * h);
+void Adafruit_SPITFT::flushCanvas(int16_t x, int16_t y,
+                                  GFXcanvasPacked *canvas) {
+  GFX_PROFILE_SCOPE(GFX_PROF_FLUSHCANVAS,
+                    (int32_t)canvas->width() * canvas->height());
+  uint8_t *buf = canvas->getBuffer();
+  if (!buf)
+    return;
+  tearSync();
+  uint8_t depth = canvas->getDepth(), perByte = 8 / depth;
+  uint16_t rowBytes = canvas->getRowBytes();
+  int16_t cw = canvas->width(), ch = canvas->height();
+  if (canvas->getRotation() & 1) { // Buffer is in rotation-0 layout
+    int16_t t = cw;
+    cw = ch;
+    ch = t;
+  }
+  int16_t rx = 0, ry = 0, rw = cw, rh = ch;
+  if (!clipPush(&x, &y, &rx, &ry, &rw, &rh))
+    return;
+  uint8_t *ptr = &buf[ry * rowBytes + rx / perByte];
+  uint8_t skip = rx % perByte; // Pixels before rx in its byte
+  startWrite();
+  writeAddrWindow(x, y, rw, rh);
+  if ((rw * depth) == (rowBytes * 8)) { // Rows are contiguous, no padding
+    writeIndexed(ptr, (uint32_t)rw * rh, canvas->getPalette(), depth);
+  } else {
+    while (rh--) {
+      writeIndexed(ptr, rw, canvas->getPalette(), depth, skip);
+      ptr += rowBytes;
+    }
+  }
+  endWrite();
 }
 
-// -------------------------------------------------------------------------
-// Ever-so-slightly higher-level graphics operations. Similar to the 'write'
-// functions above, but these contain their own chip-select and SPI
-// transactions as needed (via startWrite(), endWrite()). They're typically
-// used solo -- as graphics primitives in themselves, not invoked by higher-
-// level primitives (which should use the functions above for better
-// performance).
+/*!
+    @brief  Push a GFXcanvas1 to the display in two colors, the same way
+            as an opaque drawBitmap(). Like the other flushCanvas()
+            versions, position is in display coordinates, unaffected by
+            origin and clip rect, and the buffer is sent unrotated.
+    @param  x       Top left corner horizontal coordinate of canvas.
+    @param  y       Top left corner vertical coordinate of canvas.
+    @param  canvas  Pointer to GFXcanvas1 to push.
+    @param  color   16-bit 5-6-5 Color to show set pixels in.
+    @param  bg      16-bit 5-6-5 Color to show unset pixels in.
+*/
+void Adafruit_SPITFT::flushCanvas(int16_t x, int16_t y, GFXcanvas1 *canvas,
+                                  uint16_t color, uint16_t bg) {
+  GFX_PROFILE_SCOPE(GFX_PROF_FLUSHCANVAS,
+                    (int32_t)canvas->width() * canvas->height());
+  uint8_t *buf = canvas->getBuffer();
+  if (!buf)
+    return;
+  tearSync();
+  int16_t cw = canvas->width(), ch = canvas->height();
+  if (canvas->getRotation() & 1) { // Buffer is in rotation-0 layout
+    int16_t t = cw;
+    cw = ch;
+    ch = t;
+  }
+  int16_t rx = 0, ry = 0, rw = cw, rh = ch;
+  if (clipPush(&x, &y, &rx, &ry, &rw, &rh))
+    pushMono(x, y, rw, rh, buf, (cw + 7) / 8, rx, ry, color, bg, false);
+}
+
+// Little-endian fields of a BMP header
+static inline uint16_t bmpRead16(const uint8_t *p) {
+  return p[0] | (p[1] << 8);
+}
+static inline uint32_t bmpRead32(const uint8_t *p) {
+  return bmpRead16(p) | ((uint32_t)bmpRead16(&p[2]) << 16);
+}
+
+// Read and discard len bytes of an image through buf, size bytes long
+static bool imageSkip(SPITFTimageReader reader, void *context, uint8_t *buf,
+                      uint32_t size, uint32_t len) {
+  while (len) {
+    uint32_t n = (len < size) ? len : size;
+    if (reader(context, buf, n) != n)
+      return false;
+    len -= n;
+  }
+  return true;
+}
+
+/*!
+    @brief   Draw an image streamed from any source -- a file on SD or QSPI
+             flash, a network connection -- using a constant, small amount
+             of RAM however large the image. Data is read in chunks of up
+             to SPITFT_IMAGE_CHUNK pixels, alternating between two stack
+             buffers, and each chunk is sent with writePixels() as soon as
+             it's converted; where that's DMA (SAMD), the next chunk is read
+             while the last one transfers. Top-down images (raw, and BMPs
+             with negative height) go through a single setAddrWindow();
+             bottom-up BMPs, the usual kind, need one per row. Clipped like
+             drawRGBBitmap(), but data is read from start to end
+             regardless, so rows and columns out of view still take the
+             time to read.
+    @param   x        Top left corner horizontal coordinate.
+    @param   y        Top left corner vertical coordinate.
+    @param   reader   Function called to read each chunk of data.
+    @param   context  Passed through to reader, e.g. a File pointer.
+    @param   format   SPITFT_BMP (default) to parse a .bmp file, dimensions
+                      and all: uncompressed 24-bit, or 16-bit 5-6-5
+                      (BI_BITFIELDS) or 5-5-5. SPITFT_RGB565 or
+                      SPITFT_RGB565_BE for headerless rows of pixels, top
+                      row first.
+    @param   w        Width of a raw image in pixels; ignored for BMP.
+    @param   h        Height of a raw image in pixels; ignored for BMP.
+    @return  true on success; false if the BMP header is missing or
+             describes another kind of BMP (nothing is drawn) or the data
+             ended early (the image is partly drawn).
+*/
+bool Adafruit_SPITFT::drawImage(int16_t x, int16_t y, SPITFTimageReader reader,
+                                void *context, SPITFTimageFormat format,
+                                int16_t w, int16_t h) {
+  uint16_t buf[2][SPITFT_IMAGE_CHUNK];
+  uint8_t *bytes = (uint8_t *)buf; // Both buffers, while parsing a header
+  uint8_t bpp = 2;                 // Bytes per pixel in the data
+  bool bottomUp = false, rgb555 = false;
+
+  if (format == SPITFT_BMP) {
+    if ((reader(context, bytes, 54) != 54) || (bytes[0] != 'B') ||
+        (bytes[1] != 'M'))
+      return false;
+    uint32_t offset = bmpRead32(&bytes[10]), pos = 54;
+    int32_t bw = (int32_t)bmpRead32(&bytes[18]),
+            bh = (int32_t)bmpRead32(&bytes[22]);
+    uint16_t bits = bmpRead16(&bytes[28]);
+    uint32_t compression = bmpRead32(&bytes[30]);
+    if (compression == 3) { // BI_BITFIELDS: 16-bit with color masks
+      if ((bits != 16) || (reader(context, bytes, 12) != 12))
+        return false;
+      pos += 12;
+      uint32_t r = bmpRead32(bytes), g = bmpRead32(&bytes[4]),
+               b = bmpRead32(&bytes[8]);
+      if ((r == 0x7C00) && (g == 0x03E0) && (b == 0x001F))
+        rgb555 = true;
+      else if ((r != 0xF800) || (g != 0x07E0) || (b != 0x001F))
+        return false;
+    } else if ((compression == 0) && ((bits == 16) || (bits == 24))) {
+      rgb555 = (bits == 16); // BI_RGB 16-bit is always 5-5-5
+    } else {
+      return false;
+    }
+    if ((bw <= 0) || (bw > 32767) || !bh || (bh < -32767) || (bh > 32767) ||
+        (offset < pos) ||
+        !imageSkip(reader, context, bytes, sizeof buf, offset - pos))
+      return false;
+    w = bw;
+    bottomUp = (bh > 0);
+    h = bottomUp ? bh : -bh;
+    bpp = bits / 8;
+  } else if ((w <= 0) || (h <= 0)) {
+    return false;
+  }
+  uint32_t rowBytes = (uint32_t)w * bpp, // Pixel data per row
+      pad = (format == SPITFT_BMP) ? (-rowBytes & 3) : 0; // BMP rows: 4n
+  bool bigEndian = (format == SPITFT_RGB565_BE), swap = false;
+#if defined(SPITFT_PRESWAP)
+  // Put pixels in display order while converting, so DMA sends straight
+  // from the buffer and needn't be waited for
+  swap = !bigEndian;
+  bigEndian = true;
+#endif
+
+  // Visible part: display position, size, and image column/row of its
+  // top left pixel
+  int16_t bx = x + _originX, by = y + _originY, vw = w, vh = h;
+  if (!clipRect(&x, &y, &vw, &vh))
+    return true; // Nothing to show
+  int16_t i0 = x - bx, j0 = y - by;
+
+  // Pixels per read, however many bytes each takes fitting in one buffer
+  int16_t chunk = SPITFT_IMAGE_CHUNK * 2 / bpp;
+  uint8_t k = 0; // Buffer to fill next; the other may still be sending
+  bool ok = true;
+  startWrite();
+  if (!bottomUp)
+    writeAddrWindow(x, y, vw, vh);
+  for (int16_t r = 0; ok && (r < h); r++) {
+    int16_t j = bottomUp ? h - 1 - r : r; // Image row
+    if ((j < j0) || (j >= j0 + vh)) {     // Out of view, read past it
+      if (!bottomUp && (j >= j0))
+        break; // All visible rows are done
+      ok = imageSkip(reader, context, (uint8_t *)buf[k], sizeof buf[k],
+                     rowBytes + pad);
+      continue;
+    }
+    bool windowed = !bottomUp; // Address window covers this row yet?
+    for (int16_t i = 0; ok && (i < w); i += chunk) {
+      int16_t n = (w - i < chunk) ? w - i : chunk;
+      uint16_t *px = buf[k];
+      uint8_t *b = (uint8_t *)px;
+      if (reader(context, b, n * bpp) != (uint32_t)n * bpp) {
+        ok = false;
+        break;
+      }
+      int16_t from = (i0 > i) ? i0 - i : 0, // Visible part of chunk
+          to = (i0 + vw < i + n) ? i0 + vw - i : n;
+      if (from >= to)
+        continue;
+      if ((bpp == 3) || rgb555 || swap) { // Convert in place, in order
+        for (int16_t p = from; p < to; p++) {
+          uint16_t c;
+          if (bpp == 3) { // 24-bit BGR
+            uint8_t *s = &b[p * 3];
+            c = ((s[2] & 0xF8) << 8) | ((s[1] & 0xFC) << 3) | (s[0] >> 3);
+          } else {
+            c = px[p];
+            if (rgb555) // Widen green to 6 bits
+              c = ((c << 1) & 0xFFC0) | ((c >> 4) & 0x20) | (c & 0x1F);
+          }
+          px[p] = swap ? __builtin_bswap16(c) : c;
+        }
+      }
+      if (!windowed) { // Prior row must finish before changing window
+        dmaWait();
+        writeAddrWindow(x, y + j - j0, vw, 1);
+        windowed = true;
+      }
+      writePixels(&px[from], to - from, false, bigEndian);
+      k = 1 - k;
+    }
+    if (ok && pad)
+      ok = imageSkip(reader, context, (uint8_t *)buf[k], sizeof buf[k], pad);
+  }
+  dmaWait();
+  endWrite();
+  return ok;
+}
+
+/*!
+    @brief   Clip an area of a canvas being pushed against the display
+             edges, moving its position in the canvas to match.
+    @param   dx  Pointer to display column of the area's left edge.
+    @param   dy  Pointer to display row of the area's top edge.
+    @param   rx  Pointer to canvas column of the area's left edge.
+    @param   ry  Pointer to canvas row of the area's top edge.
+    @param   rw  Pointer to width of area.
+    @param   rh  Pointer to height of area.
+    @return  true if any of the area is on the display.
+*/
+bool Adafruit_SPITFT::clipPush(int16_t *dx, int16_t *dy, int16_t *rx,
+                               int16_t *ry, int16_t *rw, int16_t *rh) const {
+  if (*dx < 0) {
+    *rw += *dx;
+    *rx -= *dx;
+    *dx = 0;
+  }
+  if (*dy < 0) {
+    *rh += *dy;
+    *ry -= *dy;
+    *dy = 0;
+  }
+  if ((*dx + *rw) > _width)
+    *rw = _width - *dx;
+  if ((*dy + *rh) > _height)
+    *rh = _height - *dy;
+  return (*rw > 0) && (*rh > 0);
+}
 
 /*!
-    @brief  Draw a single pixel to the display at requested coordinates.
-            Self-contained and provides its own transaction as needed
-            (see writePixel(x,y,color) for a lower-level variant).
-            Edge clipping is performed here.
-    @param  x      Horizontal position (0 = left).
-    @param  y      Vertical position   (0 = top).
-    @param  color  16-bit pixel color in '565' RGB format.
+    @brief  Send an area of a 1-bit image, already clipped, in two colors
+            through one address window. Handles its own transaction.
+    @param  dx         Display column of the area's left edge.
+    @param  dy         Display row of the area's top edge.
+    @param  w          Width of area, > 0.
+    @param  h          Height of area, > 0.
+    @param  bitmap     Byte array with monochrome bitmap.
+    @param  byteWidth  Bytes per bitmap row.
+    @param  i0         Bitmap column of the area's left edge.
+    @param  j0         Bitmap row of the area's top edge.
+    @param  color      16-bit 5-6-5 Color to draw set bits with.
+    @param  bg         16-bit 5-6-5 Color to draw unset bits with.
+    @param  pgm        true if bitmap is PROGMEM-resident.
 */
-void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
-  // Clip first...
-  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
-    // THEN set up transaction (if needed) and draw...
-    startWrite();
-    setAddrWindow(x, y, 1, 1);
-    SPI_WRITE16(color);
+void Adafruit_SPITFT::pushMono(int16_t dx, int16_t dy, int16_t w, int16_t h,
+                               const uint8_t *bitmap, int16_t byteWidth,
+                               int16_t i0, int16_t j0, uint16_t color,
+                               uint16_t bg, bool pgm) {
+  const uint8_t *row = &bitmap[j0 * byteWidth + i0 / 8];
+  uint8_t skip = i0 & 7; // Bits before i0 in its byte
+  startWrite();
+  writeAddrWindow(dx, dy, w, h);
+#if defined(SPITFT_PGM_SEPARATE)
+  if (pgm) { // Can't be read like RAM, one pixel at a time instead
+    SPITFT_COUNT(pixels, (uint32_t)w * h);
+    SPITFT_COUNT(bytes, (uint32_t)w * h * 2);
+    while (h--) {
+      for (int16_t i = skip; i < skip + w; i++) {
+        uint16_t c = (pgm_read_byte(&row[i / 8]) & (0x80 >> (i & 7))) ? color
+                                                                       : bg;
+        if (transport)
+          transport->pushColor(c, 1);
+        else
+          SPI_WRITE16(c);
+      }
+      row += byteWidth;
+    }
     endWrite();
+    return;
+  }
+#endif
+  uint16_t palette[2] = {bg, color};
+  if (!skip && (w == byteWidth * 8)) { // Rows are contiguous, no padding
+    writeIndexed(row, (uint32_t)w * h, palette, 1);
+  } else {
+    while (h--) {
+      writeIndexed(row, w, palette, 1, skip);
+      row += byteWidth;
+    }
   }
+  endWrite();
 }
 
 /*!
-    @brief  Draw a filled rectangle to the display. Self-contained and
-            provides its own transaction as needed (see writeFillRect() or
-            writeFillRectPreclipped() for lower-level variants). Edge
-            clipping and rejection is performed here.
-    @param  x      Horizontal position of first corner.
-    @param  y      Vertical position of first corner.
-    @param  w      Rectangle width in pixels (positive = right of first
-                   corner, negative = left of first corner).
-    @param  h      Rectangle height in pixels (positive = below first
-                   corner, negative = above first corner).
-    @param  color  16-bit fill color in '565' RGB format.
-    @note   This repeats the writeFillRect() function almost in its entirety,
-            with the addition of a transaction start/end. It's done this way
-            (rather than starting the transaction and calling writeFillRect()
-            to handle clipping and so forth) so that the transaction isn't
-            performed at all if the rectangle is rejected. It's really not
-            that much code.
+    @brief  Enable or disable opaque rendering of custom (GFXfont) fonts.
+            By default custom fonts are drawn transparently and the text
+            background color is ignored (see notes in
+            Adafruit_GFX::drawChar()). When enabled and the background
+            color differs from the text color, each character's full cell
+            (its advance width by the font's full height, plus any part of
+            the glyph overhanging that) is rasterized in small spans and
+            sent with a single setAddrWindow(), replacing prior contents
+            without a separate fillRect() and the flicker that brings.
+            Glyphs overhanging their neighbors' cells (italics, some
+            kerned pairs) will have the overlap overwritten by the
+            following character's background.
+    @param  opaque  true to draw custom-font backgrounds, false for the
+                    default transparent behavior.
 */
-void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
-                               uint16_t color) {
-  if (w && h) {   // Nonzero width and height?
-    if (w < 0) {  // If negative width...
-      x += w + 1; //   Move X to left edge
-      w = -w;     //   Use positive width
-    }
-    if (x < _width) { // Not off right
-      if (h < 0) {    // If negative height...
-        y += h + 1;   //   Move Y to top edge
-        h = -h;       //   Use positive height
-      }
-      if (y < _height) { // Not off bottom
-        int16_t x2 = x + w - 1;
-        if (x2 >= 0) { // Not off left
-          int16_t y2 = y + h - 1;
-          if (y2 >= 0) { // Not off top
-            // Rectangle partly or fully overlaps screen
-            if (x < 0) {
-              x = 0;
-              w = x2 + 1;
-            } // Clip left
-            if (y < 0) {
-              y = 0;
-              h = y2 + 1;
-            } // Clip top
-            if (x2 >= _width) {
-              w = _width - x;
-            } // Clip right
-            if (y2 >= _height) {
-              h = _height - y;
-            } // Clip bottom
-            startWrite();
-            writeFillRectPreclipped(x, y, w, h, color);
-            endWrite();
-          }
-        }
-      }
-    }
+void Adafruit_SPITFT::setFontOpaque(bool opaque) { fontOpaque = opaque; }
+
+/*!
+    @brief  Cache opaque text cells (see setFontOpaque()), so characters
+            drawn again in the same font, colors and size are sent from
+            RAM with one writePixels() instead of being rasterized.
+    @param  cache  Cache to use, or NULL for none (the default). The cache
+                   must outlive its use by the display.
+*/
+void Adafruit_SPITFT::setGlyphCache(Adafruit_SPITFT_GlyphCache *cache) {
+  glyphCache = cache;
+}
+
+/*!
+    @brief  Create a glyph cache. If its RAM can't be allocated, it simply
+            never holds anything.
+    @param  bytes    Size of the pixel arena, 2 bytes per cached pixel. A
+                     cell larger than this is never cached.
+    @param  entries  Most cells held at once.
+*/
+Adafruit_SPITFT_GlyphCache::Adafruit_SPITFT_GlyphCache(uint32_t bytes,
+                                                       uint8_t entries)
+    : arena((uint16_t *)malloc(bytes)),
+      entry((Entry *)malloc(entries * sizeof(Entry))), pixels(0), hits(0),
+      misses(0), clock(0), maxCount(0), count(0) {
+  if (arena && entry) {
+    pixels = bytes / 2;
+    maxCount = entries;
   }
 }
 
 /*!
-    @brief  Draw a horizontal line on the display. Self-contained and
-            provides its own transaction as needed (see writeFastHLine() for
-            a lower-level variant). Edge clipping and rejection is performed
-            here.
-    @param  x      Horizontal position of first point.
-    @param  y      Vertical position of first point.
-    @param  w      Line width in pixels (positive = right of first point,
-                   negative = point of first corner).
-    @param  color  16-bit line color in '565' RGB format.
-    @note   This repeats the writeFastHLine() function almost in its
-            entirety, with the addition of a transaction start/end. It's
-            done this way (rather than starting the transaction and calling
-            writeFastHLine() to handle clipping and so forth) so that the
-            transaction isn't performed at all if the line is rejected.
+    @brief  Free a glyph cache. Detach it (setGlyphCache(NULL)) from any
+            display using it first.
 */
-void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w,
-                                    uint16_t color) {
-  if ((y >= 0) && (y < _height) && w) { // Y on screen, nonzero width
-    if (w < 0) {                        // If negative width...
-      x += w + 1;                       //   Move X to left edge
-      w = -w;                           //   Use positive width
-    }
-    if (x < _width) { // Not off right
-      int16_t x2 = x + w - 1;
-      if (x2 >= 0) { // Not off left
-        // Line partly or fully overlaps screen
-        if (x < 0) {
-          x = 0;
-          w = x2 + 1;
-        } // Clip left
-        if (x2 >= _width) {
-          w = _width - x;
-        } // Clip right
-        startWrite();
-        writeFillRectPreclipped(x, y, w, 1, color);
-        endWrite();
-      }
+Adafruit_SPITFT_GlyphCache::~Adafruit_SPITFT_GlyphCache(void) {
+  free(arena);
+  free(entry);
+}
+
+/*!
+    @brief  Empty the cache and zero its hit and miss counts.
+*/
+void Adafruit_SPITFT_GlyphCache::clear(void) {
+  count = 0;
+  hits = misses = 0;
+}
+
+/*!
+    @brief   Look up a cell. Used by drawChar().
+    @param   font    Font, NULL for classic.
+    @param   c       Character.
+    @param   color   16-bit 5-6-5 text color.
+    @param   bg      16-bit 5-6-5 background color.
+    @param   size_x  Horizontal magnification.
+    @param   size_y  Vertical magnification.
+    @return  The cell's pixels, row-major, or NULL if not cached.
+*/
+const uint16_t *Adafruit_SPITFT_GlyphCache::find(const GFXfont *font,
+                                                 uint32_t c, uint16_t color,
+                                                 uint16_t bg, uint8_t size_x,
+                                                 uint8_t size_y) {
+  clock++;
+  for (uint8_t i = 0; i < count; i++) {
+    Entry *e = &entry[i];
+    if ((e->c == c) && (e->font == font) && (e->color == color) &&
+        (e->bg == bg) && (e->size_x == size_x) && (e->size_y == size_y)) {
+      e->used = clock;
+      hits++;
+      return &arena[e->offset];
     }
   }
+  return NULL;
 }
 
 /*!
-    @brief  Draw a vertical line on the display. Self-contained and provides
-            its own transaction as needed (see writeFastHLine() for a lower-
-            level variant). Edge clipping and rejection is performed here.
-    @param  x      Horizontal position of first point.
-    @param  y      Vertical position of first point.
-    @param  h      Line height in pixels (positive = below first point,
-                   negative = above first point).
-    @param  color  16-bit line color in '565' RGB format.
-    @note   This repeats the writeFastVLine() function almost in its
-            entirety, with the addition of a transaction start/end. It's
-            done this way (rather than starting the transaction and calling
-            writeFastVLine() to handle clipping and so forth) so that the
-            transaction isn't performed at all if the line is rejected.
+    @brief   Make room for a cell not found by find(), evicting the least
+             recently used ones as needed. Used by drawChar(), which then
+             renders into it.
+    @param   font    Font, NULL for classic.
+    @param   c       Character.
+    @param   color   16-bit 5-6-5 text color.
+    @param   bg      16-bit 5-6-5 background color.
+    @param   size_x  Horizontal magnification.
+    @param   size_y  Vertical magnification.
+    @param   len     Pixels in the cell.
+    @return  Where to put the cell's pixels, or NULL if it's too big.
 */
-void Adafruit_SPITFT::drawFastVLine(int16_t x, int16_t y, int16_t h,
-                                    uint16_t color) {
-  if ((x >= 0) && (x < _width) && h) { // X on screen, nonzero height
-    if (h < 0) {                       // If negative height...
-      y += h + 1;                      //   Move Y to top edge
-      h = -h;                          //   Use positive height
-    }
-    if (y < _height) { // Not off bottom
-      int16_t y2 = y + h - 1;
-      if (y2 >= 0) { // Not off top
-        // Line partly or fully overlaps screen
-        if (y < 0) {
-          y = 0;
-          h = y2 + 1;
-        } // Clip top
-        if (y2 >= _height) {
-          h = _height - y;
-        } // Clip bottom
-        startWrite();
-        writeFillRectPreclipped(x, y, 1, h, color);
-        endWrite();
-      }
+uint16_t *Adafruit_SPITFT_GlyphCache::add(const GFXfont *font, uint32_t c,
+                                          uint16_t color, uint16_t bg,
+                                          uint8_t size_x, uint8_t size_y,
+                                          uint32_t len) {
+  if (!maxCount || (len > pixels))
+    return NULL;
+  misses++;
+  uint32_t end;
+  uint8_t i;
+  for (;;) {
+    end = count ? entry[count - 1].offset + entry[count - 1].len : 0;
+    if ((count < maxCount) && (pixels - end >= len))
+      break;
+    // Evict the least recently used cell and close the gap it leaves
+    uint8_t lru = 0;
+    for (i = 1; i < count; i++) {
+      if ((uint16_t)(clock - entry[i].used) >
+          (uint16_t)(clock - entry[lru].used))
+        lru = i;
     }
+    uint32_t gap = entry[lru].len, from = entry[lru].offset + gap;
+    memmove(&arena[entry[lru].offset], &arena[from],
+            (end - from) * sizeof(uint16_t));
+    for (i = lru + 1; i < count; i++) {
+      entry[i].offset -= gap;
+      entry[i - 1] = entry[i];
+    }
+    count--;
   }
+  Entry *e = &entry[count++];
+  e->font = font;
+  e->c = c;
+  e->color = color;
+  e->bg = bg;
+  e->size_x = size_x;
+  e->size_y = size_y;
+  e->used = clock;
+  e->offset = end;
+  e->len = len;
+  return &arena[end];
 }
 
+#if ARDUINO >= 100
 /*!
-    @brief  Essentially writePixel() with a transaction around it. I don't
-            think this is in use by any of our code anymore (believe it was
-            for some older BMP-reading examples), but is kept here in case
-            any user code relies on it. Consider it DEPRECATED.
-    @param  color  16-bit pixel color in '565' RGB format.
+    @brief   Print a run of characters, used by print() for strings and
+             numbers. Same as writing each character in turn, but inside
+             one startWrite() / endWrite(), so the whole run shares one
+             transaction instead of one per character.
+    @param   buffer  Characters to write.
+    @param   size    Number of characters.
+    @return  Number of characters written.
 */
-void Adafruit_SPITFT::pushColor(uint16_t color) {
+size_t Adafruit_SPITFT::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
   startWrite();
-  SPI_WRITE16(color);
+  while (size--)
+    n += write(*buffer++);
   endWrite();
+  return n;
 }
+#endif
 
 /*!
-    @brief  Draw a 16-bit image (565 RGB) at the specified (x,y) position.
-            For 16-bit display devices; no color reduction performed.
-            Adapted from https://github.com/PaulStoffregen/ILI9341_t3
-            by Marc MERLIN. See examples/pictureEmbed to use this.
-            5/6/2017: function name and arguments have changed for
-            compatibility with current GFX library and to avoid naming
-            problems in prior implementation.  Formerly drawBitmap() with
-            arguments in different order. Handles its own transaction and
-            edge clipping/rejection.
-    @param  x        Top left corner horizontal coordinate.
-    @param  y        Top left corner vertical coordinate.
-    @param  pcolors  Pointer to 16-bit array of pixel values.
-    @param  w        Width of bitmap in pixels.
-    @param  h        Height of bitmap in pixels.
+    @brief  Draw a single character. Opaque text (background color differs
+            from text color) in the classic built-in font, or in a custom
+            font with setFontOpaque() enabled, is streamed as one address
+            window covering the character cell. Anything else is handled by
+            Adafruit_GFX::drawChar().
+    @param  x       Horizontal position of text cursor (left edge).
+    @param  y       Vertical position of text cursor (top edge for the
+                    classic font, baseline for custom fonts).
+    @param  c       Character to draw, already filtered by write() to
+                    exclude newlines.
+    @param  color   16-bit 5-6-5 text color.
+    @param  bg      16-bit 5-6-5 background color.
+    @param  size_x  Horizontal magnification (1 = normal).
+    @param  size_y  Vertical magnification (1 = normal).
 */
-void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
-                                    int16_t w, int16_t h) {
+void Adafruit_SPITFT::drawChar(int16_t x, int16_t y, unsigned char c,
+                               uint16_t color, uint16_t bg, uint8_t size_x,
+                               uint8_t size_y) {
+  if (opaqueText(color, bg, size_x, size_y)) {
+    GFX_PROFILE_SCOPE(GFX_PROF_CHAR, gfxFont ? 0 : 48 * size_x * size_y);
+    drawCell(x, y, c, color, bg, size_x, size_y);
+  } else { // Generic drawChar() times itself
+    Adafruit_GFX::drawChar(x, y, c, color, bg, size_x, size_y);
+  }
+}
+
+/*!
+    @brief  Draw a single character of any font, including those above
+            0xFF in an extended (Unicode) font, opaque as drawChar() does.
+    @param  x       Horizontal position of text cursor (left edge).
+    @param  y       Vertical position of text cursor (top edge for the
+                    classic font, baseline for custom fonts).
+    @param  c       Character to draw, a Unicode codepoint for extended
+                    fonts.
+    @param  color   16-bit 5-6-5 text color.
+    @param  bg      16-bit 5-6-5 background color.
+    @param  size_x  Horizontal magnification (1 = normal).
+    @param  size_y  Vertical magnification (1 = normal).
+*/
+void Adafruit_SPITFT::drawGlyph(int16_t x, int16_t y, uint32_t c,
+                                uint16_t color, uint16_t bg, uint8_t size_x,
+                                uint8_t size_y) {
+  if ((c > 0xFF) && gfxFont && opaqueText(color, bg, size_x, size_y))
+    drawCell(x, y, c, color, bg, size_x, size_y);
+  else
+    Adafruit_GFX::drawGlyph(x, y, c, color, bg, size_x, size_y);
+}
+
+/*!
+    @brief   Check whether text in these colors and sizes is drawn opaque,
+             one address window per character cell, with drawCell().
+    @param   color   16-bit 5-6-5 text color.
+    @param   bg      16-bit 5-6-5 background color.
+    @param   size_x  Horizontal magnification.
+    @param   size_y  Vertical magnification.
+    @return  true if opaque.
+*/
+bool Adafruit_SPITFT::opaqueText(uint16_t color, uint16_t bg, uint8_t size_x,
+                                 uint8_t size_y) const {
+  return (bg != color) && (!gfxFont || fontOpaque) && size_x && size_y;
+}
+
+/*!
+    @brief  Draw a character's whole cell, glyph and background, as one
+            address window, turned by any text orientation (see
+            setTextOrientation()). Used by drawChar() and drawGlyph().
+    @param  x       Horizontal position of text cursor.
+    @param  y       Vertical position of text cursor.
+    @param  c       Character to draw; skipped if the font lacks it.
+    @param  color   16-bit 5-6-5 text color.
+    @param  bg      16-bit 5-6-5 background color.
+    @param  size_x  Horizontal magnification, nonzero.
+    @param  size_y  Vertical magnification, nonzero.
+*/
+void Adafruit_SPITFT::drawCell(int16_t x, int16_t y, uint32_t c,
+                               uint16_t color, uint16_t bg, uint8_t size_x,
+                               uint8_t size_y) {
+
+  // Cell edges in font pixels relative to cursor, and for custom fonts
+  // the glyph bitmap's position within that
+  int16_t left = 0, right = 6, top = 0, bottom = 8, xo = 0, yo = 0;
+  int16_t gw = 5, gh = 8;
+  uint8_t *bitmap = NULL, cols[5], rleBits[32]; // Decoded RLE row
+  uint8_t format = GFXFONT_BITMAP, bpp = 1;
+  uint16_t pal[16]; // Anti-aliased: blended color per coverage
+  if (!gfxFont) { // Classic font, 5x8 glyph in a 6x8 cell
+    getClassicGlyph((uint8_t)c, cols);
+  } else { // Custom font
+    int32_t index = gfxGlyphIndex(gfxFont, c);
+    if ((index < 0) || !(bitmap = glyphBitmap(index)))
+      return; // Not in this font, or read failed
+    GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, index);
+    gw = pgm_read_byte(&glyph->width);
+    gh = pgm_read_byte(&glyph->height);
+    xo = (int8_t)pgm_read_byte(&glyph->xOffset);
+    yo = (int8_t)pgm_read_byte(&glyph->yOffset);
+    format = pgm_read_byte(&gfxFont->format);
+    if ((format == GFXFONT_AA2) || (format == GFXFONT_AA4)) {
+      bpp = (format == GFXFONT_AA2) ? 2 : 4;
+      uint8_t maxv = (1 << bpp) - 1;
+      for (uint8_t v = 0; v <= maxv; v++)
+        pal[v] = blend565(color, bg, v * 255 / maxv);
+    }
+    int16_t xa = pgm_read_byte(&glyph->xAdvance);
+    if (gfxFont != cellFont)
+      fontCellBounds();
+    // Advance box across the font's full height, widened to enclose any
+    // overhanging glyph ink
+    left = (xo < 0) ? xo : 0;
+    right = (xo + gw > xa) ? xo + gw : xa;
+    if (tabularDigit(c)) { // All of the tabular cell the glyph is centered in
+      int16_t pad = (digitAdvance - xa) / 2;
+      if (-pad < left)
+        left = -pad;
+      if (digitAdvance - pad > right)
+        right = digitAdvance - pad;
+    }
+    top = cellTop;
+    bottom = cellBottom;
+  }
+
+  // Cell's screen rect, turned by any text orientation
+  int16_t cw = (right - left) * size_x, ch = (bottom - top) * size_y,
+          x0 = left * size_x, y0 = top * size_y, w = cw, h = ch;
+  if ((cw <= 0) || (ch <= 0))
+    return;
+  turnTextRect(x, y, &x0, &y0, &w, &h);
+  uint8_t turn = textOrientation;
+  if (turn && (format == GFXFONT_RLE)) {
+    // Run-length rows only decode top to bottom, so a turned glyph is
+    // drawn over its filled cell instead
+    startWrite();
+    writeFillRect(x0, y0, w, h, bg);
+    writeGlyph(x, y, c, color, color, size_x, size_y);
+    endWrite();
+    return;
+  }
+  // Clipped screen rect of cell, right & bottom exclusive
+  int16_t cx0 = x0, cy0 = y0, cx1 = w, cy1 = h;
+  if (!clipRect(&cx0, &cy0, &cx1, &cy1))
+    return;
+  cx1 += cx0;
+  cy1 += cy0;
+  x0 += _originX; // Cell origin on screen
+  y0 += _originY;
+
+  // A cell wholly on screen can come from, or go into, the glyph cache.
+  // Classic characters are keyed with the CP437 setting that picks them,
+  // and turned cells (sent in a different order) by orientation.
+  uint32_t len = (uint32_t)(cx1 - cx0) * (cy1 - cy0), key = c, i = 0;
+  uint16_t *cell = NULL;
+  bool bigEndian = false;
+#if defined(SPITFT_PRESWAP)
+  bigEndian = true; // Cached in display order, for DMA straight from RAM
+#endif
+  if (glyphCache && (cx0 == x0) && (cy0 == y0) && (cx1 - cx0 == w) &&
+      (cy1 - cy0 == h)) {
+    const GFXfont *font = gfxFont;
+    if (!font && _cp437)
+      key |= 0x100;
+    else if (tabularDigit(c))
+      key |= 0x80000000; // Wider cell than the proportional digit's
+    key |= (uint32_t)turn << 29;
+    const uint16_t *hit =
+        glyphCache->find(font, key, color, bg, size_x, size_y);
+    if (hit) {
+      startWrite();
+      writeAddrWindow(cx0, cy0, cx1 - cx0, cy1 - cy0);
+      writePixels((uint16_t *)hit, len, true, bigEndian);
+      endWrite();
+      return;
+    }
+    cell = glyphCache->add(font, key, color, bg, size_x, size_y, len);
+  }
+
+  // The window is sent row by row. Along a row the glyph is walked
+  // forward or back, by columns or (turned a quarter) by rows, and the
+  // position in it found afresh at the start of each row. ga is the
+  // glyph coordinate walked along the row, gsub the sub-pixel step
+  // within a magnified pixel there, gb the other coordinate.
+  bool vert = turn & 1, back = (turn == 1) || (turn == 2);
+  uint8_t gsize = vert ? size_y : size_x;
+  uint16_t span[SPITFT_SPAN_LEN], n = 0;
+  GFXrleReader reader(bitmap);
+  int16_t rleRows = 0; // # of glyph rows decoded so far
 
-  int16_t x2, y2;                 // Lower-right coord
-  if ((x >= _width) ||            // Off-edge right
-      (y >= _height) ||           // " top
-      ((x2 = (x + w - 1)) < 0) || // " left
-      ((y2 = (y + h - 1)) < 0))
-    return; // " bottom
-
-  int16_t bx1 = 0, by1 = 0, // Clipped top-left within bitmap
-      saveW = w;            // Save original bitmap width value
-  if (x < 0) {              // Clip left
-    w += x;
-    bx1 = -x;
-    x = 0;
-  }
-  if (y < 0) { // Clip top
-    h += y;
-    by1 = -y;
-    y = 0;
-  }
-  if (x2 >= _width)
-    w = _width - x; // Clip right
-  if (y2 >= _height)
-    h = _height - y; // Clip bottom
-
-  pcolors += by1 * saveW + bx1; // Offset bitmap ptr to clipped top-left
   startWrite();
-  setAddrWindow(x, y, w, h); // Clipped area
-  while (h--) {              // For each (clipped) scanline...
-    writePixels(pcolors, w); // Push one (clipped) row
-    pcolors += saveW;        // Advance pointer by one full (unclipped) line
+  writeAddrWindow(cx0, cy0, cx1 - cx0, cy1 - cy0);
+  for (int16_t row = cy0; row < cy1; row++) {
+    // Unturned cell pixel at the row's first column
+    int16_t dx = cx0 - x0, dy = row - y0, fu, fv;
+    switch (turn) {
+    case 0:
+      fu = dx;
+      fv = dy;
+      break;
+    case 1:
+      fu = dy;
+      fv = ch - 1 - dx;
+      break;
+    case 2:
+      fu = cw - 1 - dx;
+      fv = ch - 1 - dy;
+      break;
+    default:
+      fu = cw - 1 - dy;
+      fv = dx;
+      break;
+    }
+    int16_t gx = fu / size_x + left - xo, gy = fv / size_y + top - yo;
+    int16_t ga = vert ? gy : gx, gb = vert ? gx : gy;
+    uint8_t gsub = vert ? fv % size_y : fu % size_x;
+    // RLE rows decode in order, including any clipped off the top
+    if ((format == GFXFONT_RLE) && (gy >= 0) && (gy < gh)) {
+      while (rleRows <= gy) {
+        reader.readRow(rleBits, gw);
+        rleRows++;
+      }
+    }
+    for (int16_t col = cx0; col < cx1; col++) {
+      uint16_t pc = bg;
+      if (vert) {
+        gx = gb;
+        gy = ga;
+      } else {
+        gx = ga;
+        gy = gb;
+      }
+      if ((gx >= 0) && (gx < gw) && (gy >= 0) && (gy < gh)) {
+        if (!bitmap) { // Classic: column-major, LSB on top
+          if ((cols[gx] >> gy) & 1)
+            pc = color;
+        } else if (format == GFXFONT_RLE) {
+          if (rleBits[gx >> 3] & (0x80 >> (gx & 7)))
+            pc = color;
+        } else if (bpp > 1) { // Anti-aliased
+          uint32_t b = ((uint32_t)gy * gw + gx) * bpp; // Bit index
+          uint8_t v = pgm_read_byte(&bitmap[b >> 3]);
+          pc = pal[(v >> (8 - bpp - (b & 7))) & ((1 << bpp) - 1)];
+        } else {
+          uint16_t b = gy * gw + gx;
+          if (pgm_read_byte(&bitmap[b >> 3]) & (0x80 >> (b & 7)))
+            pc = color;
+        }
+      }
+      if (cell) { // Whole cell rendered to cache, sent at the end
+        cell[i++] = bigEndian ? __builtin_bswap16(pc) : pc;
+      } else {
+        span[n++] = pc;
+        if (n == SPITFT_SPAN_LEN) { // Rows are contiguous in the window,
+          writePixels(span, n);     // so spans may straddle them
+          n = 0;
+        }
+      }
+      if (back) {
+        if (!gsub--) {
+          gsub = gsize - 1;
+          ga--;
+        }
+      } else if (++gsub == gsize) {
+        gsub = 0;
+        ga++;
+      }
+    }
   }
+  if (cell)
+    writePixels(cell, len, true, bigEndian);
+  else if (n)
+    writePixels(span, n);
   endWrite();
 }
 
+/*!
+    @brief  Scan the current custom font for the topmost and bottommost
+            pixel rows of any glyph, giving the vertical extent of an
+            opaque character cell. Result is cached until the font changes.
+*/
+void Adafruit_SPITFT::fontCellBounds(void) {
+  int16_t top = 0, bottom = 0;
+  for (uint16_t i = 0, n = gfxGlyphCount(gfxFont); i < n; i++) {
+    GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, i);
+    int16_t yo = (int8_t)pgm_read_byte(&glyph->yOffset),
+            h = pgm_read_byte(&glyph->height);
+    if (h) {
+      if (yo < top)
+        top = yo;
+      if (yo + h > bottom)
+        bottom = yo + h;
+    }
+  }
+  cellFont = gfxFont;
+  cellTop = top;
+  cellBottom = bottom;
+}
+
 // -------------------------------------------------------------------------
 // Miscellaneous class member functions that don't draw anything.
 
@@ -1837,27 +3771,21 @@ data
 */
 void Adafruit_SPITFT::sendCommand(uint8_t commandByte, uint8_t *dataBytes,
                                   uint8_t numDataBytes) {
-  SPI_BEGIN_TRANSACTION();
-  if (_cs >= 0)
-    SPI_CS_LOW();
+  winValid = false;
+  startWrite();
 
   SPI_DC_LOW();          // Command mode
   spiWrite(commandByte); // Send the command byte
 
   SPI_DC_HIGH();
+  // On a 16-bit bus, spiWrite() puts each byte on d0-d7 with its own
+  // strobe, which is how such panels take command parameters.
   for (int i = 0; i < numDataBytes; i++) {
-    if ((connection == TFT_PARALLEL) && tft8.wide) {
-      SPI_WRITE16(*(uint16_t *)dataBytes);
-      dataBytes += 2;
-    } else {
-      spiWrite(*dataBytes); // Send the data bytes
-      dataBytes++;
-    }
+    spiWrite(*dataBytes); // Send the data bytes
+    dataBytes++;
   }
 
-  if (_cs >= 0)
-    SPI_CS_HIGH();
-  SPI_END_TRANSACTION();
+  endWrite();
 }
 
 /*!
@@ -1869,26 +3797,18 @@ void Adafruit_SPITFT::sendCommand(uint8_t commandByte, uint8_t *dataBytes,
  */
 void Adafruit_SPITFT::sendCommand(uint8_t commandByte, const uint8_t *dataBytes,
                                   uint8_t numDataBytes) {
-  SPI_BEGIN_TRANSACTION();
-  if (_cs >= 0)
-    SPI_CS_LOW();
+  winValid = false;
+  startWrite();
 
   SPI_DC_LOW();          // Command mode
   spiWrite(commandByte); // Send the command byte
 
   SPI_DC_HIGH();
   for (int i = 0; i < numDataBytes; i++) {
-    if ((connection == TFT_PARALLEL) && tft8.wide) {
-      SPI_WRITE16(*(uint16_t *)dataBytes);
-      dataBytes += 2;
-    } else {
-      spiWrite(pgm_read_byte(dataBytes++));
-    }
+    spiWrite(pgm_read_byte(dataBytes++)); // One strobe each, as above
   }
 
-  if (_cs >= 0)
-    SPI_CS_HIGH();
-  SPI_END_TRANSACTION();
+  endWrite();
 }
 
 /*!
@@ -1905,9 +3825,9 @@ void Adafruit_SPITFT::sendCommand(uint8_t commandByte, const uint8_t *dataBytes,
 void Adafruit_SPITFT::sendCommand16(uint16_t commandWord,
                                     const uint8_t *dataBytes,
                                     uint8_t numDataBytes) {
-  SPI_BEGIN_TRANSACTION();
-  if (_cs >= 0)
-    SPI_CS_LOW();
+  winValid = false;
+  startWrite();
+  SPITFT_COUNT(bytes, numDataBytes ? numDataBytes * 4 : 2);
 
   if (numDataBytes == 0) {
     SPI_DC_LOW();             // Command mode
@@ -1922,9 +3842,7 @@ void Adafruit_SPITFT::sendCommand16(uint16_t commandWord,
     SPI_WRITE16((uint16_t)pgm_read_byte(dataBytes++));
   }
 
-  if (_cs >= 0)
-    SPI_CS_HIGH();
-  SPI_END_TRANSACTION();
+  endWrite();
 }
 
 /*!
@@ -1940,6 +3858,7 @@ void Adafruit_SPITFT::sendCommand16(uint16_t commandWord,
 /**************************************************************************/
 uint8_t Adafruit_SPITFT::readcommand8(uint8_t commandByte, uint8_t index) {
   uint8_t result;
+  winValid = false;
   startWrite();
   SPI_DC_LOW(); // Command mode
   spiWrite(commandByte);
@@ -1958,11 +3877,13 @@ uint8_t Adafruit_SPITFT::readcommand8(uint8_t commandByte, uint8_t index) {
  @return  Unsigned 16-bit data.
  */
 uint16_t Adafruit_SPITFT::readcommand16(uint16_t addr) {
+  winValid = false;
 #if defined(USE_FAST_PINIO) // NOT SUPPORTED without USE_FAST_PINIO
   uint16_t result = 0;
   if ((connection == TFT_PARALLEL) && tft8.wide) {
     startWrite();
-    SPI_DC_LOW(); // Command mode
+    SPITFT_COUNT(bytes, 4); // Word out, word back
+    SPI_DC_LOW();           // Command mode
     SPI_WRITE16(addr);
     SPI_DC_HIGH(); // Data mode
     TFT_RD_LOW();  // Read line LOW
@@ -2044,6 +3965,7 @@ inline void Adafruit_SPITFT::SPI_END_TRANSACTION(void) {
     @param  b  8-bit value to write.
 */
 void Adafruit_SPITFT::spiWrite(uint8_t b) {
+  SPITFT_COUNT(bytes, 1);
   if (connection == TFT_HARD_SPI) {
 #if defined(__AVR__)
     AVR_WRITESPI(b);
@@ -2070,6 +3992,9 @@ void Adafruit_SPITFT::spiWrite(uint8_t b) {
       *tft8.writePort = b;
     else
       *(volatile uint16_t *)tft8.writePort = b;
+#elif defined(USE_PIO_PARALLEL)
+    pioWrite(b, false);
+    return;
 #endif
     TFT_WR_STROBE();
   }
@@ -2084,6 +4009,7 @@ void Adafruit_SPITFT::spiWrite(uint8_t b) {
     @param  cmd  8-bit command to write.
 */
 void Adafruit_SPITFT::writeCommand(uint8_t cmd) {
+  winValid = false;
   SPI_DC_LOW();
   spiWrite(cmd);
   SPI_DC_HIGH();
@@ -2100,6 +4026,7 @@ void Adafruit_SPITFT::writeCommand(uint8_t cmd) {
              not supported by the MCU architecture).
 */
 uint8_t Adafruit_SPITFT::spiRead(void) {
+  SPITFT_COUNT(bytes, 1);
   uint8_t b = 0;
   uint16_t w = 0;
   if (connection == TFT_HARD_SPI) {
@@ -2163,10 +4090,16 @@ uint8_t Adafruit_SPITFT::spiRead(void) {
     @param  w  16-bit value to write.
 */
 void Adafruit_SPITFT::write16(uint16_t w) {
+  SPITFT_COUNT(bytes, 2);
   if (connection == TFT_PARALLEL) {
 #if defined(USE_FAST_PINIO)
     if (tft8.wide)
       *(volatile uint16_t *)tft8.writePort = w;
+#elif defined(USE_PIO_PARALLEL)
+    if (tft8.wide) {
+      pioWrite(w, true);
+      return;
+    }
 #endif
     TFT_WR_STROBE();
   }
@@ -2181,6 +4114,7 @@ void Adafruit_SPITFT::write16(uint16_t w) {
     @param  cmd  16-bit command to write.
 */
 void Adafruit_SPITFT::writeCommand16(uint16_t cmd) {
+  winValid = false;
   SPI_DC_LOW();
   write16(cmd);
   SPI_DC_HIGH();
@@ -2195,6 +4129,7 @@ void Adafruit_SPITFT::writeCommand16(uint16_t cmd) {
              not supported by the MCU architecture).
 */
 uint16_t Adafruit_SPITFT::read16(void) {
+  SPITFT_COUNT(bytes, 2);
   uint16_t w = 0;
   if (connection == TFT_PARALLEL) {
     if (tft8._rd >= 0) {
@@ -2220,6 +4155,314 @@ uint16_t Adafruit_SPITFT::read16(void) {
   return w;
 }
 
+#if defined(USE_FAST_PINIO)
+// Bitbang SPI for bulk pixel writes. SPI_MOSI_HIGH() and friends reload
+// their registers and masks through swspi on every edge; these copy them
+// into locals once per call (SOFTSPI_PINS) and unroll each byte. Edges
+// are the same as theirs: MOSI set up, then SCK pulsed high.
+#if defined(HAS_PORT_SET_CLR)
+#if defined(KINETISK) // Bit-band registers: write 1 to set/clear
+#define SOFTSPI_PINS                                                           \
+  PORTreg_t mosiSet = swspi.mosiPortSet, mosiClr = swspi.mosiPortClr;          \
+  PORTreg_t sckSet = swspi.sckPortSet, sckClr = swspi.sckPortClr;              \
+  const ADAGFX_PORT_t mosiMask = 1, sckMask = 1
+#else // !KINETISK
+#define SOFTSPI_PINS                                                           \
+  PORTreg_t mosiSet = swspi.mosiPortSet, mosiClr = swspi.mosiPortClr;          \
+  PORTreg_t sckSet = swspi.sckPortSet, sckClr = swspi.sckPortClr;              \
+  const ADAGFX_PORT_t mosiMask = swspi.mosiPinMask, sckMask = swspi.sckPinMask
+#endif // end !KINETISK
+#define SOFTSPI_MOSI(bit) (*((bit) ? mosiSet : mosiClr) = mosiMask)
+#if defined(__IMXRT1052__) || defined(__IMXRT1062__) // Teensy 4.x
+// Same settling delay after each SCK edge as SPI_SCK_HIGH()/LOW()
+#define SOFTSPI_CLOCK()                                                        \
+  do {                                                                         \
+    *sckSet = sckMask;                                                         \
+    for (volatile uint8_t i = 0; i < 1; i++)                                   \
+      ;                                                                        \
+    *sckClr = sckMask;                                                         \
+    for (volatile uint8_t i = 0; i < 1; i++)                                   \
+      ;                                                                        \
+  } while (0)
+#else
+#define SOFTSPI_CLOCK()                                                        \
+  do {                                                                         \
+    *sckSet = sckMask;                                                         \
+    *sckClr = sckMask;                                                         \
+  } while (0)
+#endif
+#else // !HAS_PORT_SET_CLR
+#define SOFTSPI_PINS                                                           \
+  PORTreg_t mosiPort = swspi.mosiPort, sckPort = swspi.sckPort;                \
+  const ADAGFX_PORT_t mosiHi = swspi.mosiPinMaskSet,                           \
+                      mosiLo = swspi.mosiPinMaskClr,                           \
+                      sckHi = swspi.sckPinMaskSet, sckLo = swspi.sckPinMaskClr
+#define SOFTSPI_MOSI(bit)                                                      \
+  do {                                                                         \
+    if (bit)                                                                   \
+      *mosiPort |= mosiHi;                                                     \
+    else                                                                       \
+      *mosiPort &= mosiLo;                                                     \
+  } while (0)
+#define SOFTSPI_CLOCK()                                                        \
+  do {                                                                         \
+    *sckPort |= sckHi;                                                         \
+    *sckPort &= sckLo;                                                         \
+  } while (0)
+#endif // end !HAS_PORT_SET_CLR
+
+// One bit, MOSI always driven
+#define SOFTSPI_BIT(b, m)                                                      \
+  do {                                                                         \
+    SOFTSPI_MOSI((b) & (m));                                                   \
+    SOFTSPI_CLOCK();                                                           \
+  } while (0)
+// One bit, MOSI driven only where t (the bits that differ from the bit
+// before) says it changes
+#define SOFTSPI_BIT_T(b, t, m)                                                 \
+  do {                                                                         \
+    if ((t) & (m))                                                             \
+      SOFTSPI_MOSI((b) & (m));                                                 \
+    SOFTSPI_CLOCK();                                                           \
+  } while (0)
+#define SOFTSPI_BYTE(b)                                                        \
+  do {                                                                         \
+    SOFTSPI_BIT(b, 0x80);                                                      \
+    SOFTSPI_BIT(b, 0x40);                                                      \
+    SOFTSPI_BIT(b, 0x20);                                                      \
+    SOFTSPI_BIT(b, 0x10);                                                      \
+    SOFTSPI_BIT(b, 0x08);                                                      \
+    SOFTSPI_BIT(b, 0x04);                                                      \
+    SOFTSPI_BIT(b, 0x02);                                                      \
+    SOFTSPI_BIT(b, 0x01);                                                      \
+  } while (0)
+#define SOFTSPI_BYTE_T(b, t)                                                   \
+  do {                                                                         \
+    SOFTSPI_BIT_T(b, t, 0x80);                                                 \
+    SOFTSPI_BIT_T(b, t, 0x40);                                                 \
+    SOFTSPI_BIT_T(b, t, 0x20);                                                 \
+    SOFTSPI_BIT_T(b, t, 0x10);                                                 \
+    SOFTSPI_BIT_T(b, t, 0x08);                                                 \
+    SOFTSPI_BIT_T(b, t, 0x04);                                                 \
+    SOFTSPI_BIT_T(b, t, 0x02);                                                 \
+    SOFTSPI_BIT_T(b, t, 0x01);                                                 \
+  } while (0)
+
+/*!
+    @brief  Issue a series of pixels from memory over bitbang SPI. Not
+            self-contained; should follow startWrite() and setAddrWindow()
+            calls. Used by writePixels().
+    @param  colors     Array of 16-bit pixel values in '565' RGB format.
+    @param  len        Number of elements in 'colors' array.
+    @param  bigEndian  If true, colors are big-endian (display order).
+*/
+void Adafruit_SPITFT::softSPIWritePixels(const uint16_t *colors,
+                                         uint32_t len, bool bigEndian) {
+  SOFTSPI_PINS;
+  // Bytes in the order they're sent, whichever order they're stored in
+  const uint8_t *p = (const uint8_t *)colors;
+  uint8_t first = bigEndian ? 0 : 1;
+  while (len--) {
+    uint8_t hi = p[first], lo = p[first ^ 1];
+    SOFTSPI_BYTE(hi);
+    SOFTSPI_BYTE(lo);
+    p += 2;
+  }
+}
+
+/*!
+    @brief  Issue a series of pixels, all the same color, over bitbang
+            SPI. Not self-contained; should follow startWrite() and
+            setAddrWindow() calls. Used by writeColor().
+    @param  color  16-bit pixel color in '565' RGB format.
+    @param  len    Number of pixels to draw.
+*/
+void Adafruit_SPITFT::softSPIWriteColor(uint16_t color, uint32_t len) {
+  SOFTSPI_PINS;
+  uint8_t hi = color >> 8, lo = color;
+  // The same 16 bits repeat, so which bits differ from the one before
+  // (the bit before each pixel's first is the prior pixel's last) is
+  // known up front, and MOSI is only driven where it changes. Start with
+  // it at the last bit's level, as if a pixel had just been sent.
+  uint8_t tHi = hi ^ ((hi >> 1) | (lo << 7)),
+          tLo = lo ^ ((lo >> 1) | (hi << 7));
+  SOFTSPI_MOSI(lo & 1);
+  if (!tHi && !tLo) { // All bits the same (black, white): just clock
+    len *= 2;
+    while (len--) {
+      SOFTSPI_CLOCK();
+      SOFTSPI_CLOCK();
+      SOFTSPI_CLOCK();
+      SOFTSPI_CLOCK();
+      SOFTSPI_CLOCK();
+      SOFTSPI_CLOCK();
+      SOFTSPI_CLOCK();
+      SOFTSPI_CLOCK();
+    }
+  } else if (hi == lo) { // Both bytes the same: one pattern per byte
+    len *= 2;
+    while (len--)
+      SOFTSPI_BYTE_T(hi, tHi);
+  } else {
+    while (len--) {
+      SOFTSPI_BYTE_T(hi, tHi);
+      SOFTSPI_BYTE_T(lo, tLo);
+    }
+  }
+}
+#endif // end USE_FAST_PINIO
+
+#if defined(USE_PIO_PARALLEL)
+// The state machine puts each FIFO byte (or word) on the data pins with
+// WR high, then takes WR low and high again to latch it, WR idling high
+// whenever the FIFO is empty. It shifts left, so the top of each 32-bit
+// FIFO entry goes first: 16-bit DMA writes, which the bus replicates into
+// both halves, issue native pixels high byte first.
+
+/*!
+    @brief  Claim a PIO state machine and DMA channel for the parallel
+            interface and start the state machine. Leaves tft8.pio NULL
+            (and the interface inert) if no state machine or program
+            space is free; tft8.dmaChan is -1 if no DMA channel is, and
+            bulk writes then go through the FIFO a pixel at a time.
+*/
+void Adafruit_SPITFT::pioBegin(void) {
+  uint8_t const bits = tft8.wide ? 16 : 8;
+  uint16_t const side0 = pio_encode_sideset(1, 0),
+                 side1 = pio_encode_sideset(1, 1);
+  uint16_t program[] = {
+      (uint16_t)(pio_encode_out(pio_pins, bits) | side1), // Data, WR high
+      (uint16_t)(pio_encode_nop() | side0),               // WR low
+      (uint16_t)(pio_encode_nop() | side1)};              // WR high, latch
+  pio_program_t prog = {program, 3, -1};
+  PIO pio = pio0;
+  int sm = -1;
+  if (pio_can_add_program(pio, &prog))
+    sm = pio_claim_unused_sm(pio, false);
+  if (sm < 0) {
+    pio = pio1;
+    if (pio_can_add_program(pio, &prog))
+      sm = pio_claim_unused_sm(pio, false);
+  }
+  if (sm < 0)
+    return;
+  uint offset = pio_add_program(pio, &prog);
+
+  for (uint8_t i = 0; i < bits; i++)
+    pio_gpio_init(pio, tft8._d0 + i);
+  pio_gpio_init(pio, tft8._wr);
+  pio_sm_set_pins_with_mask(pio, sm, 1u << tft8._wr, 1u << tft8._wr);
+  pio_sm_set_consecutive_pindirs(pio, sm, tft8._d0, bits, true);
+  pio_sm_set_consecutive_pindirs(pio, sm, tft8._wr, 1, true);
+
+  pio_sm_config c = pio_get_default_sm_config();
+  sm_config_set_wrap(&c, offset, offset + 2);
+  sm_config_set_sideset(&c, 1, false, false);
+  sm_config_set_sideset_pins(&c, tft8._wr);
+  sm_config_set_out_pins(&c, tft8._d0, bits);
+  sm_config_set_out_shift(&c, false, true, bits); // Left, autopull
+  sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+  // Three state machine cycles per write
+  float div = (float)clock_get_hz(clk_sys) * SPITFT_PIO_WR_NS / 3.0e9f;
+  sm_config_set_clkdiv(&c, (div < 1.0f) ? 1.0f : div);
+  pio_sm_init(pio, sm, offset, &c);
+  // Start with an empty OSR, so the first write pulls (see pioThreshold())
+  pio_sm_exec(pio, sm, pio_encode_mov(pio_osr, pio_null) | side1);
+  pio_sm_exec(pio, sm, pio_encode_out(pio_null, 32) | side1);
+  pio_sm_set_enabled(pio, sm, true);
+
+  tft8.pio = pio;
+  tft8.sm = sm;
+  tft8.pioBits = bits;
+  tft8.dmaChan = dma_claim_unused_channel(false);
+}
+
+/*!
+    @brief  Set how many bits the state machine pulls from each FIFO entry:
+            8 for single bytes on an 8-bit bus, 16 for pixels. Drains the
+            bus first if this is a change.
+    @param  bits  8 or 16.
+*/
+void Adafruit_SPITFT::pioThreshold(uint8_t bits) {
+  if (tft8.pioBits != bits) {
+    pioWait();
+    hw_write_masked(&tft8.pio->sm[tft8.sm].shiftctrl,
+                    (uint32_t)bits << PIO_SM0_SHIFTCTRL_PULL_THRESH_LSB,
+                    PIO_SM0_SHIFTCTRL_PULL_THRESH_BITS);
+    // Any bits left in the OSR were counted against the old threshold;
+    // discard them so the next write starts with a fresh pull.
+    uint16_t const side1 = pio_encode_sideset(1, 1);
+    pio_sm_exec(tft8.pio, tft8.sm, pio_encode_mov(pio_osr, pio_null) | side1);
+    pio_sm_exec(tft8.pio, tft8.sm, pio_encode_out(pio_null, 32) | side1);
+    tft8.pioBits = bits;
+  }
+}
+
+/*!
+    @brief  Queue one byte or one 16-bit value for the parallel interface.
+            A 16-bit value is two writes on an 8-bit bus, high byte first;
+            on a 16-bit bus either is one write.
+    @param  w     Byte (in bits 7-0) or 16-bit value.
+    @param  word  true if w is a 16-bit value.
+*/
+void Adafruit_SPITFT::pioWrite(uint16_t w, bool word) {
+  if (!tft8.pio)
+    return;
+  if (tft8.dmaChan >= 0)
+    dmaSpin(); // Don't interleave
+  if (tft8.wide) {
+    pio_sm_put_blocking(tft8.pio, tft8.sm, (uint32_t)w << 16);
+  } else {
+    pioThreshold(8);
+    if (word)
+      pio_sm_put_blocking(tft8.pio, tft8.sm, (uint32_t)(w >> 8) << 24);
+    pio_sm_put_blocking(tft8.pio, tft8.sm, (uint32_t)w << 24);
+  }
+}
+
+/*!
+    @brief  Start a DMA transfer of pixels to the parallel interface.
+            Returns once the transfer is started; the caller waits for
+            the channel or the bus as needed.
+    @param  src   Pixels, or one pixel if inc is false.
+    @param  len   Number of pixels to issue.
+    @param  inc   true to step through src, false to repeat *src.
+    @param  swap  true if src pixels are big-endian.
+*/
+void Adafruit_SPITFT::pioPixels(const uint16_t *src, uint32_t len, bool inc,
+                                bool swap) {
+  pioThreshold(16);
+  dmaSpin();
+  dma_channel_config c = dma_channel_get_default_config(tft8.dmaChan);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, inc);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, pio_get_dreq(tft8.pio, tft8.sm, true));
+  channel_config_set_bswap(&c, swap);
+  dma_channel_configure(tft8.dmaChan, &c, &tft8.pio->txf[tft8.sm], src, len,
+                        true);
+}
+
+/*!
+    @brief  Wait until everything queued for the parallel interface (DMA
+            and FIFO) is out on the bus and the state machine is idle with
+            WR high, so control lines can change. Does nothing for other
+            connection types.
+*/
+void Adafruit_SPITFT::pioWait(void) {
+  if ((connection != TFT_PARALLEL) || !tft8.pio)
+    return;
+  if (tft8.dmaChan >= 0)
+    dmaSpin();
+  // The stall flag is set each cycle the state machine waits on an empty
+  // FIFO; clear it, then wait for it to come back.
+  uint32_t const stall = 1u << (PIO_FDEBUG_TXSTALL_LSB + tft8.sm);
+  tft8.pio->fdebug = stall;
+  while (!(tft8.pio->fdebug & stall))
+    ;
+}
+#endif // end USE_PIO_PARALLEL
+
 /*!
     @brief  Set the software (bitbang) SPI MOSI line HIGH.
 */
@@ -2380,6 +4623,9 @@ void Adafruit_SPITFT::SPI_WRITE16(uint16_t w) {
     } else {
       *(volatile uint16_t *)tft8.writePort = w;
     }
+#elif defined(USE_PIO_PARALLEL)
+    pioWrite(w, true);
+    return;
 #endif
     TFT_WR_STROBE();
   }
@@ -2396,6 +4642,7 @@ void Adafruit_SPITFT::SPI_WRITE16(uint16_t w) {
     @param  l  32-bit value to write.
 */
 void Adafruit_SPITFT::SPI_WRITE32(uint32_t l) {
+  SPITFT_COUNT(bytes, 4);
   if (connection == TFT_HARD_SPI) {
 #if defined(__AVR__)
     AVR_WRITESPI(l >> 24);
@@ -2443,6 +4690,10 @@ void Adafruit_SPITFT::SPI_WRITE32(uint32_t l) {
       TFT_WR_STROBE();
       *(volatile uint16_t *)tft8.writePort = l;
     }
+#elif defined(USE_PIO_PARALLEL)
+    pioWrite(l >> 16, true);
+    pioWrite(l, true);
+    return;
 #endif
     TFT_WR_STROBE();
   }
@@ -90,17 +90,272 @@ typedef volatile ADAGFX_PORT_t *PORTreg_t; ///< PORT register type
 #include <Adafruit_ZeroDMA.h>
 #endif
 
+#if defined(ARDUINO_NRF52_ADAFRUIT) && defined(NRF52840_XXAA)
+// nRF52840 keeps a persistent SPIM3 DMA pool, allocated once in initSPI():
+// this many scanlines (display's major axis) of fill color, plus one more
+// scanline for byte-swapping writePixels() data. 0 disables the pool and
+// reverts to a temporary buffer per writeColor() call.
+#ifndef SPITFT_NRF_FILL_LINES
+#define SPITFT_NRF_FILL_LINES 2 ///< Scanlines of cached fill color
+#endif
+#define SPITFT_FILL_POOL ///< writeColor() may use a persistent pool
+#elif defined(ESP32)
+// ESP32 stages writeColor() pixels in a persistent, DMA-capable buffer of
+// this many scanlines (display's major axis), allocated once in initSPI()
+// and refilled only when the color changes. 0 disables it and reverts to
+// a small static buffer sent 32 pixels at a time.
+#ifndef SPITFT_ESP32_FILL_LINES
+#define SPITFT_ESP32_FILL_LINES 2 ///< Scanlines of cached fill color
+#endif
+#define SPITFT_FILL_POOL ///< writeColor() may use a persistent pool
+#endif
+
+#if defined(ARDUINO_ARCH_RP2040)
+// RP2040 has no fast PORT access; instead a PIO state machine runs the
+// parallel interface, one write strobe per byte (or word on a 16-bit bus)
+// at this minimum write cycle, with DMA feeding writePixels() and
+// writeColor(). Data pins must be consecutive GPIOs starting at d0.
+#include <hardware/pio.h>
+#ifndef SPITFT_PIO_WR_NS
+#define SPITFT_PIO_WR_NS 66 ///< Parallel write cycle in nanoseconds
+#endif
+#define USE_PIO_PARALLEL ///< Parallel interface through PIO (and DMA)
+#endif
+
+// On these platforms writePixels() can ship big-endian pixel data straight
+// from the caller's buffer, so offscreen buffers headed for the display
+// (bands, tiles) are best allocated as big-endian canvases and sent as-is.
+// Elsewhere the per-pixel write swaps anyway.
+#if defined(USE_SPI_DMA) &&                                                    \
+    (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO) ||                      \
+     (defined(ARDUINO_NRF52_ADAFRUIT) && defined(NRF52840_XXAA)))
+#define SPITFT_PRESWAP ///< Prefer big-endian buffers for writePixels()
+#endif
+
+// Opaque text is rasterized into a stack buffer this many pixels long
+// and pushed with writePixels() as it fills. Larger is fewer calls.
+#ifndef SPITFT_SPAN_LEN
+#define SPITFT_SPAN_LEN 32 ///< Pixels per text span push
+#endif
+
+// Default size of an Adafruit_SPITFT_GlyphCache: pixel arena bytes and
+// most glyphs held
+#ifndef SPITFT_GLYPH_CACHE
+#define SPITFT_GLYPH_CACHE 4096 ///< Bytes of cached glyph pixels
+#endif
+#ifndef SPITFT_GLYPH_ENTRIES
+#define SPITFT_GLYPH_ENTRIES 24 ///< Glyphs cached at most
+#endif
+
 // This is kind of a kludge. Needed a way to disambiguate the software SPI
 // and parallel constructors via their argument lists. Originally tried a
 // bool as the first argument to the parallel constructor (specifying 8-bit
 // vs 16-bit interface) but the compiler regards this as equivalent to an
 // integer and thus still ambiguous. SO...the parallel constructor requires
 // an enumerated type as the first argument: tft8 (for 8-bit parallel) or
-// tft16 (for 16-bit)...even though 16-bit isn't fully implemented or tested
-// and might never be, still needed that disambiguation from soft SPI.
+// tft16 (for 16-bit), which also serves to disambiguate it from soft SPI.
+// Longest wait for a tearing-effect pulse while the panel's refresh
+// period is unknown (see Adafruit_SPITFT::setTearPin()), in microseconds
+#ifndef SPITFT_TE_TIMEOUT
+#define SPITFT_TE_TIMEOUT 50000 ///< 20 Hz, slower than panels refresh
+#endif
+
 /*! For first arg to parallel constructor */
 enum tftBusWidth { tft8bitbus, tft16bitbus };
 
+// drawImage() reads and pushes images through two stack buffers of this
+// many pixels each, one filling while the other is sent. At least 33, to
+// hold a BMP header.
+#ifndef SPITFT_IMAGE_CHUNK
+#define SPITFT_IMAGE_CHUNK 64 ///< Pixels per drawImage() read
+#endif
+
+/*!
+  @brief   Source of image data for Adafruit_SPITFT::drawImage(): copy the
+           next len bytes of the image to dest. For a file (SD, SdFat,
+           a QSPI flash filesystem), something like:
+
+               uint32_t readFile(void *f, uint8_t *dest, uint32_t len) {
+                 return ((File *)f)->read(dest, len);
+               }
+
+  @param   context  Whatever was passed to drawImage(), e.g. a File.
+  @param   dest     Where to put the data.
+  @param   len      Number of bytes wanted.
+  @return  Number of bytes copied, less than len only at the end of the
+           data or on error.
+*/
+typedef uint32_t (*SPITFTimageReader)(void *context, uint8_t *dest,
+                                      uint32_t len);
+
+/*! Image data formats drawImage() can stream */
+enum SPITFTimageFormat {
+  SPITFT_BMP,      ///< Uncompressed BMP, 24-bit or 16-bit (5-6-5 or 5-5-5)
+  SPITFT_RGB565,   ///< Raw rows of 16-bit 5-6-5 pixels, little-endian
+  SPITFT_RGB565_BE ///< Raw rows of 16-bit 5-6-5 pixels, big-endian
+};
+
+/*! Pixel formats readRect() can expect from the display's RAMRD */
+enum SPITFTreadFormat {
+  SPITFT_READ_RGB666, ///< 3 bytes per pixel, 6 bits each at top (most SPI)
+  SPITFT_READ_RGB565  ///< 2 bytes per pixel, big-endian 5-6-5
+};
+
+// Define SPITFT_STATS for the whole build (a compiler flag such as
+// -DSPITFT_STATS, not a #define in the sketch, since the library's own
+// source must see it too) to have each display count its bus traffic;
+// see Adafruit_SPITFT::getStats(). Off by default: counting costs a few
+// instructions per call.
+#if defined(SPITFT_STATS)
+#define SPITFT_COUNT(field, n) (stats.field += (n)) ///< Add to a stat
+#else
+#define SPITFT_COUNT(field, n) ///< Stats are compiled out
+#endif
+
+/*! Bus traffic counted by an Adafruit_SPITFT built with SPITFT_STATS */
+typedef struct {
+  uint32_t transactions;  ///< Times the display was selected
+  uint32_t addrWindows;   ///< Address windows set by the library
+  uint32_t pixels;        ///< Pixels from memory (writePixels() & co.)
+  uint32_t fillPixels;    ///< Pixels of one color (writeColor())
+  uint32_t bytes;         ///< Bytes over the bus, written or read
+  uint32_t dmaWaitMicros; ///< Time spent waiting for DMA to finish
+} SPITFTstats;
+
+class Adafruit_SPITFT;
+
+/*!
+  @brief  A bus transport for an Adafruit_SPITFT's bulk pixel traffic:
+          subclass this to get pixels to the panel some other way than
+          the library's built-in per-platform code (a different DMA
+          engine, a shared-bus scheduler, a queue to another core...)
+          without touching Adafruit_SPITFT. Install with setTransport().
+
+          Once installed, writePixels(), writeColor(), writeIndexed() and
+          single-pixel writes hand their pixels to pushPixels() and
+          pushColor(), and the library's own primitives offer each
+          address window to addrWindow() first. Commands and other
+          byte-level writes still go out through the built-in path, so a
+          transport that returns before its data is out must finish it
+          in wait(), which endWrite() and dmaWait() call. A transport
+          carries its own buffers and state, so none of it is compiled
+          into displays that don't use one.
+*/
+class Adafruit_SPITFT_Transport {
+public:
+  virtual ~Adafruit_SPITFT_Transport(void) {}
+
+  /*!
+    @brief   Called by setTransport() on installation, after the display's
+             own begin().
+    @param   tft  Display the transport now serves.
+    @return  true on success, false to refuse (e.g. allocation failed),
+             in which case the display keeps its current transport.
+  */
+  virtual bool begin(Adafruit_SPITFT *tft);
+
+  /*!
+    @brief   Offered each address window the library sets, inside
+             startWrite(), before the pixels for it are pushed.
+    @param   x  Left edge of window.
+    @param   y  Top edge of window.
+    @param   w  Width of window.
+    @param   h  Height of window.
+    @return  true if the transport has taken care of the window itself
+             (e.g. queued it with the pixels that follow, to issue later
+             with the display's setAddrWindow()); false, the default, to
+             have the display's setAddrWindow() issue it right away.
+  */
+  virtual bool addrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+  /*!
+    @brief  Issue pixels to the current address window. Same contract as
+            Adafruit_SPITFT::writePixels().
+    @param  colors     Pixels, 16-bit '565' RGB.
+    @param  len        Number of pixels.
+    @param  block      If false, may return before the pixels are out, as
+                       long as wait() finishes them; colors must stay
+                       untouched until then.
+    @param  bigEndian  If true, colors are already in display byte order.
+  */
+  virtual void pushPixels(uint16_t *colors, uint32_t len, bool block,
+                          bool bigEndian) = 0;
+
+  /*!
+    @brief  Issue one color a number of times to the current address
+            window. Same contract as Adafruit_SPITFT::writeColor().
+    @param  color  16-bit '565' RGB color.
+    @param  len    Number of pixels.
+  */
+  virtual void pushColor(uint16_t color, uint32_t len) = 0;
+
+  /*!
+    @brief  Wait for everything pushed so far to be out on the bus.
+  */
+  virtual void wait(void) {}
+};
+
+/*!
+  @brief  RAM cache of opaque text cells, fully rendered as 16-bit pixels,
+          for labels and digits that are redrawn over and over. Each entry
+          is one character in one font, colors and magnification, the
+          whole cell drawChar() would send in its address window; a cached
+          cell goes out with one writePixels() instead of being rasterized
+          again. Cells are packed into a fixed arena, the least recently
+          used evicted (and the rest compacted) to make room.
+
+          Install with Adafruit_SPITFT::setGlyphCache(); one cache may
+          serve several displays. Only opaque text (see setFontOpaque())
+          is cached, and only cells drawn wholly on screen. Call clear()
+          if a font is unloaded and another may take its address.
+*/
+class Adafruit_SPITFT_GlyphCache {
+public:
+  Adafruit_SPITFT_GlyphCache(uint32_t bytes = SPITFT_GLYPH_CACHE,
+                             uint8_t entries = SPITFT_GLYPH_ENTRIES);
+  ~Adafruit_SPITFT_GlyphCache(void);
+  void clear(void);
+
+  const uint16_t *find(const GFXfont *font, uint32_t c, uint16_t color,
+                       uint16_t bg, uint8_t size_x, uint8_t size_y);
+  uint16_t *add(const GFXfont *font, uint32_t c, uint16_t color,
+                uint16_t bg, uint8_t size_x, uint8_t size_y, uint32_t len);
+
+  /*!
+    @brief   Get how many cells were found in the cache.
+    @return  Hits since creation or clear().
+  */
+  uint32_t getHits(void) const { return hits; }
+  /*!
+    @brief   Get how many cells were rendered and added to the cache.
+    @return  Misses since creation or clear().
+  */
+  uint32_t getMisses(void) const { return misses; }
+
+private:
+  /// One cached cell; key fields, then where its pixels are
+  typedef struct {
+    const GFXfont *font; ///< Font, NULL for classic
+    uint32_t c;          ///< Character, with CP437 or tabular flag bit
+    uint16_t color;      ///< Text color
+    uint16_t bg;         ///< Background color
+    uint8_t size_x;      ///< Horizontal magnification
+    uint8_t size_y;      ///< Vertical magnification
+    uint16_t used;       ///< clock when last drawn, for LRU
+    uint32_t offset;     ///< Start in arena, pixels
+    uint32_t len;        ///< Pixels
+  } Entry;
+
+  uint16_t *arena;  ///< Cell pixels, packed in entry order
+  Entry *entry;     ///< Cached cells, in arena order
+  uint32_t pixels;  ///< Arena size in pixels
+  uint32_t hits;    ///< find() successes
+  uint32_t misses;  ///< add() calls
+  uint16_t clock;   ///< Counts lookups, for LRU
+  uint8_t maxCount; ///< Entries allocated
+  uint8_t count;    ///< Entries in use
+};
+
 // CLASS DEFINITION --------------------------------------------------------
 
 /*!
@@ -147,9 +402,8 @@ public:
 
   // Parallel constructor: expects width & height (rotation 0), flag
   // indicating whether 16-bit (true) or 8-bit (false) interface, 3 signal
-  // pins (d0, wr, dc), 3 optional pins (cs, rst, rd). 16-bit parallel
-  // isn't even fully implemented but the 'wide' flag was added as a
-  // required argument to avoid ambiguity with other constructors.
+  // pins (d0, wr, dc), 3 optional pins (cs, rst, rd). The bus width is
+  // a required argument to avoid ambiguity with other constructors.
   Adafruit_SPITFT(uint16_t w, uint16_t h, tftBusWidth busWidth, int8_t d0,
                   int8_t wr, int8_t dc, int8_t cs = -1, int8_t rst = -1,
                   int8_t rd = -1);
@@ -178,6 +432,17 @@ public:
   */
   virtual void setAddrWindow(uint16_t x, uint16_t y, uint16_t w,
                              uint16_t h) = 0;
+  // MIPI DCS (CASET/RASET/RAMWR) window that a subclass' setAddrWindow()
+  // can call. Resends only the column or row range that changed since
+  // the previous call, for consecutive pixels in a row or column.
+  void setAddrWindowMIPI(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+  /*!
+    @brief  Forget the window last set with setAddrWindowMIPI(), so the
+            next call sends it in full. Commands sent through this class
+            do this already; call it after talking to the display any
+            other way (e.g. pin-level resets or raw SPI writes).
+  */
+  void invalidateAddrWindow(void) { winValid = false; }
 
   // Remaining functions do not need to be declared in subclasses
   // unless they wish to provide hardware-specific optimizations.
@@ -194,6 +459,30 @@ public:
   void startWrite(void);
   // Chip deselect and/or hardware SPI transaction end as needed:
   void endWrite(void);
+  // Hold the display selected, in one transaction, across a whole frame:
+  void startFrame(void);
+  void endFrame(void);
+  // Tearing-effect sync, with the panel's TE output wired to a pin: wait
+  // for the scan to restart at the top before pushing a frame
+  bool setTearPin(int8_t pin, bool teon = true);
+  bool waitForTear(void);
+  /*!
+    @brief  Have startFrame() and flushCanvas() (and Adafruit_BandRenderer
+            frames) wait for the panel's tearing-effect pulse, pacing
+            animation to its refresh rate. Needs setTearPin().
+    @param  sync  true to wait, false (the default) not to.
+  */
+  void setTearSync(bool sync) { teSync = sync; }
+  /*!
+    @brief   Get whether frames wait for the tearing-effect pulse.
+    @return  true if setTearSync() is on and there's a working TE pin.
+  */
+  bool getTearSync(void) const { return teSync && (tePin >= 0); }
+  /*!
+    @brief   Get the panel's refresh period, as measured by setTearPin().
+    @return  Microseconds between tearing-effect pulses, 0 if unknown.
+  */
+  uint32_t getTearPeriod(void) const { return tePeriod; }
   void sendCommand(uint8_t commandByte, uint8_t *dataBytes,
                    uint8_t numDataBytes);
   void sendCommand(uint8_t commandByte, const uint8_t *dataBytes = NULL,
@@ -213,6 +502,9 @@ public:
   void writePixels(uint16_t *colors, uint32_t len, bool block = true,
                    bool bigEndian = false);
   void writeColor(uint16_t color, uint32_t len);
+  void writeIndexed(const uint8_t *indices, uint32_t len,
+                    const uint16_t *palette, uint8_t depth = 8,
+                    uint8_t skip = 0);
   void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                      uint16_t color);
   void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
@@ -227,6 +519,40 @@ public:
   // Another new function, companion to the new non-blocking
   // writePixels() variant.
   void dmaWait(void);
+  // Check, without waiting, whether that transfer is still going
+  bool dmaBusy(void);
+  // Sets the address window through the transport, if one is installed
+  // and takes it, else with setAddrWindow(). Library primitives use this.
+  void writeAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    SPITFT_COUNT(addrWindows, 1);
+    if (!transport || !transport->addrWindow(x, y, w, h))
+      setAddrWindow(x, y, w, h);
+  }
+  // Bulk pixel traffic goes through a transport if one is installed
+  // (NULL reverts to the built-in code for this platform).
+  bool setTransport(Adafruit_SPITFT_Transport *t);
+  /*!
+    @brief   Get the installed transport.
+    @return  Transport set with setTransport(), or NULL if none.
+  */
+  Adafruit_SPITFT_Transport *getTransport(void) const { return transport; }
+#if defined(SPITFT_STATS)
+  /*!
+    @brief   Get the bus traffic counted since the display was created or
+             resetStats() was last called, e.g. to see what a screen
+             costs: reset, draw it, read the counts. Pixels are counted
+             where the library hands them over (so a transport's or DMA
+             engine's work is included), bytes as 2 per pixel plus every
+             command, parameter and read byte. DMA waits are the time
+             spent spinning on SAMD and RP2040 DMA transfers, in micros().
+    @return  The counters.
+  */
+  const SPITFTstats &getStats(void) const { return stats; }
+  /*!
+    @brief  Zero the counters getStats() reports.
+  */
+  void resetStats(void) { stats = SPITFTstats(); }
+#endif
 
   // These functions are similar to the 'write' functions above, but with
   // a chip-select and/or SPI transaction built-in. They're typically used
@@ -236,6 +562,7 @@ public:
   void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
   // A single-pixel push encapsulated in a transaction. I don't think
   // this is used anymore (BMP demos might've used it?) but is provided
   // for backward compatibility, consider it deprecated:
@@ -244,6 +571,82 @@ public:
   using Adafruit_GFX::drawRGBBitmap; // Check base class first
   void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w,
                      int16_t h);
+  // 8-bit-per-channel images, converted to 565 (dithered by default) a
+  // chunk at a time while the last chunk is sent:
+  void drawRGB888Bitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                        int16_t h, GFXrgbFormat format = GFX_RGB888,
+                        bool dither = true);
+  // Backgrounds generated a line at a time into two small buffers, each
+  // while the last one is sent:
+  void fillRectGradientStops(int16_t x, int16_t y, int16_t w, int16_t h,
+                             const GFXgradientStop *stops, uint8_t nStops,
+                             bool vertical = true);
+  void fillRectPattern(int16_t x, int16_t y, int16_t w, int16_t h,
+                       const uint16_t *pattern, int16_t pw, int16_t ph);
+  // 1-bit bitmaps: with a bg color, expanded to color a row at a time
+  // and pushed through one address window; without, set bits are issued
+  // as solid runs rather than pixel by pixel:
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color, uint16_t bg);
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                  uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                  uint16_t color, uint16_t bg);
+  // Compressed sprite: runs become writeColor(), literals writePixels()
+  void drawSprite(int16_t x, int16_t y, const uint8_t sprite[]);
+  // Push only the changed areas of a dirty-tracking canvas (or the whole
+  // canvas if not tracking), then mark it clean:
+  void flushCanvas(int16_t x, int16_t y, GFXcanvas16 *canvas);
+  // Push a palette-indexed canvas (GFXcanvas8, GFXcanvas4 or GFXcanvas2),
+  // expanding each pixel through the canvas's RGB565 palette on the way out:
+  void flushCanvas(int16_t x, int16_t y, GFXcanvas8 *canvas);
+  void flushCanvas(int16_t x, int16_t y, GFXcanvasPacked *canvas);
+  // Push a GFXcanvas1, set bits in color and unset in bg:
+  void flushCanvas(int16_t x, int16_t y, GFXcanvas1 *canvas, uint16_t color,
+                   uint16_t bg);
+  // Stream an image from a reader callback through a small buffer, for
+  // images too big to hold in memory (files on SD or QSPI flash):
+  bool drawImage(int16_t x, int16_t y, SPITFTimageReader reader,
+                 void *context, SPITFTimageFormat format = SPITFT_BMP,
+                 int16_t w = 0, int16_t h = 0);
+
+  // Pixel readback through RAMRD, e.g. to save and restore what's under a
+  // popup. Panel must be wired for reads (MISO, or parallel RD pin):
+  bool readRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t *buf);
+  uint16_t readPixel(int16_t x, int16_t y);
+  void setReadFormat(SPITFTreadFormat format, uint32_t freq = 0);
+  // On-screen copy (and so scroll()): the 2D engine's if the display has
+  // one (see Adafruit_GFX::hwCopyRect()), else through readback
+  void copyRect(int16_t sx, int16_t sy, int16_t w, int16_t h, int16_t dx,
+                int16_t dy);
+
+  // Opaque text (classic font with a background color, or custom fonts
+  // with setFontOpaque(true)) is pushed one character cell per address
+  // window, foreground and background together:
+  using Adafruit_GFX::drawChar; // Check base class first
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                uint16_t bg, uint8_t size_x, uint8_t size_y);
+  void drawGlyph(int16_t x, int16_t y, uint32_t c, uint16_t color,
+                 uint16_t bg, uint8_t size_x, uint8_t size_y);
+  void setFontOpaque(bool opaque);
+  /*!
+    @brief   Get whether custom fonts are drawn opaque.
+    @return  The setFontOpaque() setting.
+  */
+  bool getFontOpaque(void) const { return fontOpaque; }
+  void setGlyphCache(Adafruit_SPITFT_GlyphCache *cache);
+  /*!
+    @brief   Get the opaque text cache in use.
+    @return  Cache set with setGlyphCache(), or NULL if none.
+  */
+  Adafruit_SPITFT_GlyphCache *getGlyphCache(void) const { return glyphCache; }
+#if ARDUINO >= 100
+  // Strings and numbers from print() go out in one transaction:
+  using Adafruit_GFX::write;
+  size_t write(const uint8_t *buffer, size_t size);
+#endif
 
   void invertDisplay(bool i);
   uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
@@ -291,6 +694,9 @@ public:
     *csPort |= csPinMaskSet;
 #endif // end !HAS_PORT_SET_CLR
 #else  // !USE_FAST_PINIO
+#if defined(USE_PIO_PARALLEL)
+    pioWait(); // Queued parallel writes must finish first
+#endif
     digitalWrite(_cs, HIGH);
 #endif // end !USE_FAST_PINIO
   }
@@ -332,6 +738,9 @@ public:
     *dcPort |= dcPinMaskSet;
 #endif // end !HAS_PORT_SET_CLR
 #else  // !USE_FAST_PINIO
+#if defined(USE_PIO_PARALLEL)
+    pioWait(); // Queued parallel writes must finish first
+#endif
     digitalWrite(_dc, HIGH);
 #endif // end !USE_FAST_PINIO
   }
@@ -351,6 +760,9 @@ public:
     *dcPort &= dcPinMaskClr;
 #endif // end !HAS_PORT_SET_CLR
 #else  // !USE_FAST_PINIO
+#if defined(USE_PIO_PARALLEL)
+    pioWait(); // Queued parallel writes must finish first
+#endif
     digitalWrite(_dc, LOW);
 #endif // end !USE_FAST_PINIO
   }
@@ -371,6 +783,44 @@ protected:
   inline void TFT_WR_STROBE(void); // Parallel interface write strobe
   inline void TFT_RD_HIGH(void);   // Parallel interface read high
   inline void TFT_RD_LOW(void);    // Parallel interface read low
+  void fontCellBounds(void);       // Cache current font's cell height
+  void drawCell(int16_t x, int16_t y, uint32_t c, uint16_t color,
+                uint16_t bg, uint8_t size_x, uint8_t size_y); // Opaque char
+  bool opaqueText(uint16_t color, uint16_t bg, uint8_t size_x,
+                  uint8_t size_y) const; // If drawCell() is to be used
+  void mipiWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                  uint8_t memCmd); // CASET/RASET as needed, then memCmd
+  bool canRead(void) const;        // If the interface can read pixels
+  inline void dmaSpin(void);       // Wait out a SAMD or RP2040 DMA job
+  void tearSync(void); // waitForTear() if synced and not yet selected
+  // RAMRD stream, as raw bytes or as pixels converted to native 565
+  void readBytes(uint8_t *dst, uint32_t len);
+  void readPixels(uint16_t *dst, uint32_t len);
+  void readArea(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t *buf,
+                int16_t stride); // RAMRD of a clipped rect
+  bool clipPush(int16_t *dx, int16_t *dy, int16_t *rx, int16_t *ry,
+                int16_t *rw, int16_t *rh) const; // Clip canvas area pushed
+  void pushMono(int16_t dx, int16_t dy, int16_t w, int16_t h,
+                const uint8_t *bitmap, int16_t byteWidth, int16_t i0,
+                int16_t j0, uint16_t color, uint16_t bg, bool pgm);
+  void monoRuns(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w,
+                int16_t h, uint16_t color, bool pgm);
+#if defined(SPITFT_FILL_POOL)
+  uint32_t fillPool(uint16_t color, uint32_t len); // Ready fillBuf pixels
+#endif
+#if defined(USE_FAST_PINIO)
+  // Bitbang SPI bulk writes, pin registers cached for the whole call
+  void softSPIWritePixels(const uint16_t *colors, uint32_t len, bool bigEndian);
+  void softSPIWriteColor(uint16_t color, uint32_t len);
+#endif
+#if defined(USE_PIO_PARALLEL)
+  // PIO parallel interface: set up, CPU writes, DMA writes, drain
+  void pioBegin(void);
+  void pioThreshold(uint8_t bits);
+  void pioWrite(uint16_t w, bool word);
+  void pioPixels(const uint16_t *src, uint32_t len, bool inc, bool swap);
+  void pioWait(void);
+#endif
 
   // CLASS INSTANCE VARIABLES --------------------------------------------
 
@@ -471,6 +921,13 @@ protected:
       ADAGFX_PORT_t rdPinMaskClr; ///< Bitmask for read strobe CLEAR (AND)
 #endif                         // end HAS_PORT_SET_CLR
 #endif                         // end USE_FAST_PINIO
+#if defined(USE_PIO_PARALLEL)
+      PIO pio;                 ///< PIO block running the bus, NULL if none
+      uint16_t pioColor;       ///< writeColor() DMA source pixel
+      uint8_t sm;              ///< State machine # within pio
+      uint8_t pioBits;         ///< Bits per FIFO pull, 8 or 16
+      int8_t dmaChan;          ///< DMA channel feeding sm, -1 if none
+#endif
       int8_t _d0;              ///< Data pin 0 #
       int8_t _wr;              ///< Write strobe pin #
       int8_t _rd;              ///< Read strobe pin # (or -1)
@@ -489,7 +946,16 @@ protected:
   uint16_t maxFillLen;               ///< Max pixels per DMA xfer
   uint16_t lastFillColor = 0;        ///< Last color used w/fill
   uint32_t lastFillLen = 0;          ///< # of pixels w/last fill
-  uint8_t onePixelBuf;               ///< For hi==lo fill
+  uint16_t onePixelBuf;              ///< For hi==lo or 16-bit bus fill
+#elif defined(SPITFT_FILL_POOL)
+  uint16_t *fillBuf = NULL;   ///< Persistent pool, fill color (swapped)
+  uint16_t maxFillLen = 0;    ///< Pixels in fillBuf
+  uint16_t lastFillColor = 0; ///< Last color used w/fill
+  uint32_t lastFillLen = 0;   ///< # of valid pixels in fillBuf
+#if defined(ARDUINO_NRF52_ADAFRUIT)
+  uint16_t *pixelBuf = NULL; ///< Swap buffer for writePixels(), in pool
+  uint16_t maxPixelLen = 0;  ///< Pixels in pixelBuf
+#endif
 #endif
 #if defined(USE_FAST_PINIO)
 #if defined(HAS_PORT_SET_CLR)
@@ -508,12 +974,35 @@ protected:
   int8_t _rst;             ///< Reset pin # (or -1)
   int8_t _cs;              ///< Chip select pin # (or -1)
   int8_t _dc;              ///< Data/command pin #
+  uint8_t writeDepth = 0;  ///< startWrite() nesting, bus held while >0
+  int8_t tePin = -1;       ///< Tearing-effect input pin # (or -1)
+  bool teSync = false;     ///< If set, frames wait for tearing effect
+  uint32_t tePeriod = 0;   ///< Refresh period in micros, 0 = unknown
+#if defined(SPITFT_STATS)
+  SPITFTstats stats = SPITFTstats(); ///< Counters for getStats()
+#endif
+
+  Adafruit_SPITFT_Transport *transport = NULL; ///< Bulk pixel transport
+
+  uint32_t winCol = 0;   ///< Last CASET from setAddrWindowMIPI()
+  uint32_t winRow = 0;   ///< Last RASET from setAddrWindowMIPI()
+  bool winValid = false; ///< If set, winCol and winRow are on display
+  uint32_t readFreq = 0; ///< readRect() SPI bitrate, 0 = same as writes
+
+  SPITFTreadFormat readFormat = SPITFT_READ_RGB666; ///< RAMRD pixel format
 
   int16_t _xstart = 0;          ///< Internal framebuffer X offset
   int16_t _ystart = 0;          ///< Internal framebuffer Y offset
   uint8_t invertOnCommand = 0;  ///< Command to enable invert mode
   uint8_t invertOffCommand = 0; ///< Command to disable invert mode
 
+  GFXfont *cellFont = NULL; ///< Font whose cell extents are cached
+  int16_t cellTop = 0;      ///< Top of font cell, rel. to baseline
+  int16_t cellBottom = 0;   ///< Bottom of font cell (exclusive)
+  bool fontOpaque = false;  ///< If set, custom fonts draw background
+
+  Adafruit_SPITFT_GlyphCache *glyphCache = NULL; ///< Opaque cells cache
+
   uint32_t _freq = 0; ///< Dummy var to keep subclasses happy
 };
 
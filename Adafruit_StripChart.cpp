@@ -0,0 +1,208 @@
+/*!
+ * @file Adafruit_StripChart.cpp
+ *
+ * Part of Adafruit's GFX graphics library. Scrolling strip chart using
+ * panel hardware scroll or a ring-buffered canvas. See
+ * Adafruit_StripChart.h for usage.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_StripChart.h"
+
+// MIPI DCS commands shared by most TFT controllers
+#define STRIP_VSCRDEF 0x33  ///< Vertical scrolling definition
+#define STRIP_VSCRSADD 0x37 ///< Vertical scrolling start address
+
+/*!
+    @brief  Constructor. Nothing is drawn or allocated until begin().
+    @param  tft  Display the chart is on.
+    @param  x    Left edge of chart, in display coordinates at the
+                 rotation begin() is called with (the display's clip rect
+                 and origin don't apply).
+    @param  y    Top edge of chart.
+    @param  w    Width of chart in pixels, one sample per column.
+    @param  h    Height of chart in pixels.
+*/
+Adafruit_StripChart::Adafruit_StripChart(Adafruit_SPITFT *tft, int16_t x,
+                                         int16_t y, int16_t w, int16_t h)
+    : _tft(tft), _canvas(NULL), _x(x), _y(y), _w(w), _h(h), _head(0),
+      _last(-1), _top(0), _trace(0xFFFF), _background(0),
+      _mode(STRIP_CANVAS) {}
+
+/*!
+    @brief  Destructor, frees the canvas if one was allocated. Hardware
+            scroll, if used, is left as it is; clear() the chart first to
+            put the screen back in place.
+*/
+Adafruit_StripChart::~Adafruit_StripChart(void) { delete _canvas; }
+
+/*!
+    @brief   Set up scrolling or allocate the ring buffer, then clear the
+             chart to the background color. Call after the display's
+             begin() and setRotation().
+    @param   mode  STRIP_SCROLL or STRIP_SCROLL_REVERSE to use the panel's
+                   vertical scroll if the chart's placement allows it (see
+                   class notes), else (and by default) STRIP_CANVAS.
+    @return  true on success, false if the chart is off screen or the
+             canvas couldn't be allocated.
+*/
+bool Adafruit_StripChart::begin(stripChartMode mode) {
+  // Trim chart to the screen
+  if (_x < 0) {
+    _w += _x;
+    _x = 0;
+  }
+  if (_y < 0) {
+    _h += _y;
+    _y = 0;
+  }
+  if (_x + _w > _tft->width())
+    _w = _tft->width() - _x;
+  if (_y + _h > _tft->height())
+    _h = _tft->height() - _y;
+  if ((_w <= 0) || (_h <= 0))
+    return false;
+
+  if ((mode != STRIP_CANVAS) &&
+      (!(_tft->getRotation() & 1) || _y || (_h != _tft->height())))
+    mode = STRIP_CANVAS; // Panel rows don't run across the chart
+  _mode = mode;
+
+  if (_mode == STRIP_CANVAS) {
+    if (!_canvas) {
+#if defined(SPITFT_PRESWAP)
+      _canvas = new GFXcanvas16(_w, _h, true);
+#else
+      _canvas = new GFXcanvas16(_w, _h);
+#endif
+    }
+    if (!_canvas || !_canvas->getBuffer()) {
+      delete _canvas;
+      _canvas = NULL;
+      return false;
+    }
+  } else {
+    // Panel rows run across the screen, so the screen width is the frame
+    // memory height. The chart's columns are the scrolling area, with
+    // fixed areas either side.
+    uint16_t rows = _tft->width();
+    _top = (_mode == STRIP_SCROLL) ? _x : rows - _x - _w;
+    uint16_t bottom = rows - _top - _w;
+    uint8_t def[] = {(uint8_t)(_top >> 8), (uint8_t)_top, (uint8_t)(_w >> 8),
+                     (uint8_t)_w, (uint8_t)(bottom >> 8), (uint8_t)bottom};
+    _tft->sendCommand(STRIP_VSCRDEF, def, sizeof def);
+  }
+  clear();
+  return true;
+}
+
+/*!
+    @brief  Fill the chart with the background color, forget the prior
+            sample and, with hardware scroll, put the scroll back to 0.
+*/
+void Adafruit_StripChart::clear(void) {
+  _head = 0;
+  _last = -1;
+  if (_mode == STRIP_CANVAS) {
+    if (_canvas) {
+      _canvas->fillScreen(_background);
+      pushCanvas();
+    }
+  } else {
+    _tft->startWrite();
+    _tft->writeAddrWindow(_x, _y, _w, _h);
+    _tft->writeColor(_background, (uint32_t)_w * _h);
+    _tft->endWrite();
+    setScroll();
+  }
+}
+
+/*!
+    @brief  Add a sample at the right edge of the chart, moving the rest
+            one column left. The trace is drawn as a vertical span from
+            the previous sample's row to this one.
+    @param  y  Row within the chart, 0 at top; clipped to the chart.
+*/
+void Adafruit_StripChart::addSample(int16_t y) {
+  if (y < 0)
+    y = 0;
+  else if (y >= _h)
+    y = _h - 1;
+  int16_t lo = y, hi = y; // Trace rows in the new column
+  if (_last >= 0) {
+    if (y > _last)
+      lo = _last + 1;
+    else if (y < _last)
+      hi = _last - 1;
+  }
+  _last = y;
+
+  if (_mode == STRIP_CANVAS) {
+    if (!_canvas)
+      return;
+    _head = (_head + 1) % _w; // Overwrite the oldest column
+    _canvas->drawFastVLine(_head, 0, _h, _background);
+    _canvas->drawFastVLine(_head, lo, hi - lo + 1, _trace);
+    pushCanvas();
+    return;
+  }
+
+  // _head is the scroll offset. The column about to enter at the right is
+  // the oldest, currently at the left edge; where that is in (unscrolled)
+  // display coordinates depends on which way panel rows run.
+  int16_t col;
+  if (_mode == STRIP_SCROLL) {
+    col = _head;
+    _head = (_head + 1) % _w;
+  } else {
+    _head = (_head ? _head : _w) - 1;
+    col = _w - 1 - _head;
+  }
+  _tft->startWrite();
+  _tft->writeAddrWindow(_x + col, _y, 1, _h);
+  _tft->writeColor(_background, lo);
+  _tft->writeColor(_trace, hi - lo + 1);
+  _tft->writeColor(_background, _h - 1 - hi);
+  _tft->endWrite();
+  setScroll();
+}
+
+/*!
+    @brief  Send the scroll offset in _head to the panel.
+*/
+void Adafruit_StripChart::setScroll(void) {
+  uint16_t start = _top + _head;
+  uint8_t addr[] = {(uint8_t)(start >> 8), (uint8_t)start};
+  _tft->sendCommand(STRIP_VSCRSADD, addr, sizeof addr);
+}
+
+/*!
+    @brief  Push the canvas to the chart area, oldest column (the one
+            after _head) at the left.
+*/
+void Adafruit_StripChart::pushCanvas(void) {
+  uint16_t *buf = _canvas->getBuffer();
+  bool bigEndian = _canvas->getBigEndian();
+  int16_t split = _head + 1; // Ring column at the left edge of the chart
+  if (split == _w)
+    split = 0;
+  _tft->startWrite();
+  for (uint8_t piece = 0; piece < 2; piece++) {
+    int16_t c0 = piece ? 0 : split, n = piece ? split : _w - split;
+    if (n <= 0)
+      continue;
+    _tft->writeAddrWindow(_x + (piece ? _w - split : 0), _y, n, _h);
+    for (int16_t row = 0; row < _h; row++)
+      _tft->writePixels(&buf[row * _w + c0], n, true, bigEndian);
+  }
+  _tft->endWrite();
+}
+
+#endif // end __AVR_ATtiny85__
@@ -0,0 +1,105 @@
+/*!
+ * @file Adafruit_StripChart.h
+ *
+ * Part of Adafruit's GFX graphics library. Scrolling strip chart for
+ * Adafruit_SPITFT displays: each new sample draws one column, using the
+ * panel's hardware vertical scroll where possible and a ring-buffered
+ * GFXcanvas16 otherwise.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_STRIPCHART_H_
+#define _ADAFRUIT_STRIPCHART_H_
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_SPITFT.h"
+
+/// How an Adafruit_StripChart moves its trace along each sample
+enum stripChartMode {
+  STRIP_CANVAS,        ///< Ring-buffered canvas, pushed each sample
+  STRIP_SCROLL,        ///< Panel scroll, panel rows increasing rightward
+  STRIP_SCROLL_REVERSE ///< Panel scroll, panel rows increasing leftward
+};
+
+/*!
+  @brief  A rectangle of the screen in which samples enter at the right
+          edge and older ones move left, oscilloscope-style. Typical use:
+
+              Adafruit_StripChart chart(&tft, 0, 0, 320, 240);
+              chart.begin(STRIP_SCROLL);   // After tft.setRotation()
+              ...
+              chart.addSample(120 - reading / 8); // Row within chart
+
+          Each sample is one column of the chart: background plus a
+          vertical span from the previous sample's row to this one.
+
+          With STRIP_SCROLL (or STRIP_SCROLL_REVERSE, if the trace moves
+          the wrong way), the chart uses the MIPI-standard vertical scroll
+          commands most TFT controllers have (ILI9341, ST7789, HX8357,
+          ...) and each sample sends just the new column and a scroll
+          offset. Panels scroll along their native rows, which lie across
+          the screen only with the display in a landscape rotation (1 or
+          3), and whole rows move, so this also requires the chart to be
+          the full height of the screen, in a panel whose frame memory is
+          the size of the screen. If any of that isn't so, begin() falls
+          back to STRIP_CANVAS.
+
+          STRIP_CANVAS works with any display, rotation and chart area.
+          Columns are drawn into a w x h GFXcanvas16 used as a ring, its
+          oldest column overwritten each sample, and the chart is pushed
+          from the wrap point onward in two pieces, so drawing still costs
+          one column but the transfer is the whole chart.
+*/
+class Adafruit_StripChart {
+public:
+  Adafruit_StripChart(Adafruit_SPITFT *tft, int16_t x, int16_t y, int16_t w,
+                      int16_t h);
+  ~Adafruit_StripChart(void);
+  bool begin(stripChartMode mode = STRIP_CANVAS);
+  void clear(void);
+  void addSample(int16_t y);
+
+  /*!
+    @brief  Set the trace and background colors, applied from the next
+            sample or clear() on.
+    @param  trace       16-bit color of the trace.
+    @param  background  16-bit color of the rest of the chart.
+  */
+  void setColors(uint16_t trace, uint16_t background) {
+    _trace = trace;
+    _background = background;
+  }
+
+  /*!
+    @brief   Get the way the chart is scrolling, which may differ from
+             what was asked of begin().
+    @return  STRIP_CANVAS, STRIP_SCROLL or STRIP_SCROLL_REVERSE.
+  */
+  stripChartMode getMode(void) const { return _mode; }
+
+private:
+  void setScroll(void);
+  void pushCanvas(void);
+
+  Adafruit_SPITFT *_tft; ///< Display the chart is on
+  GFXcanvas16 *_canvas;  ///< Ring buffer, STRIP_CANVAS only
+  int16_t _x;            ///< Left edge of chart on screen
+  int16_t _y;            ///< Top edge of chart on screen
+  int16_t _w;            ///< Width of chart, in columns (samples)
+  int16_t _h;            ///< Height of chart in rows
+  int16_t _head;         ///< Newest canvas column, or scroll offset
+  int16_t _last;         ///< Row of most recent sample, -1 if none
+  uint16_t _top;         ///< First panel row of the scrolling area
+  uint16_t _trace;       ///< Trace color
+  uint16_t _background;  ///< Background color
+  stripChartMode _mode;  ///< Scrolling method in use
+};
+
+#endif // end __AVR_ATtiny85__
+#endif // end _ADAFRUIT_STRIPCHART_H_
@@ -0,0 +1,437 @@
+/*!
+ * @file Adafruit_TextField.cpp
+ *
+ * Part of Adafruit's GFX graphics library. Text field redrawing only the
+ * characters that changed since its last update. See Adafruit_TextField.h
+ * for usage.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_TextField.h"
+
+/*!
+    @brief  Constructor for a field on an Adafruit_SPITFT display, drawn
+            one address window per character with custom fonts too.
+            Nothing is drawn or allocated until begin().
+    @param  tft       Display the field is on.
+    @param  x         Text cursor X: the left edge, center or right edge
+                      of the text by setAlign() (left by default).
+    @param  y         Text cursor Y: top edge for the classic font,
+                      baseline for custom fonts, as with setCursor().
+    @param  maxChars  Most bytes of text the field shows; more printed
+                      before an update() are dropped.
+*/
+Adafruit_TextField::Adafruit_TextField(Adafruit_SPITFT *tft, int16_t x,
+                                       int16_t y, uint8_t maxChars) {
+  init(tft, x, y, maxChars);
+  _tft = tft;
+}
+
+/*!
+    @brief  Constructor for a field on any other Adafruit_GFX target. With
+            custom fonts each changed character's cell is filled with the
+            background, then the glyph drawn over it. Nothing is drawn or
+            allocated until begin().
+    @param  gfx       Display or canvas the field is on.
+    @param  x         Text cursor X: the left edge, center or right edge
+                      of the text by setAlign() (left by default).
+    @param  y         Text cursor Y: top edge for the classic font,
+                      baseline for custom fonts, as with setCursor().
+    @param  maxChars  Most bytes of text the field shows; more printed
+                      before an update() are dropped.
+*/
+Adafruit_TextField::Adafruit_TextField(Adafruit_GFX *gfx, int16_t x,
+                                       int16_t y, uint8_t maxChars) {
+  init(gfx, x, y, maxChars);
+}
+
+/*!
+    @brief  Destructor, frees the buffers. What's drawn stays on screen.
+*/
+Adafruit_TextField::~Adafruit_TextField(void) { free(_cells); }
+
+/*!
+    @brief  Member setup shared by the constructors.
+    @param  gfx       Display or canvas the field is on.
+    @param  x         Text cursor X.
+    @param  y         Text cursor Y.
+    @param  maxChars  Most bytes of text.
+*/
+void Adafruit_TextField::init(Adafruit_GFX *gfx, int16_t x, int16_t y,
+                              uint8_t maxChars) {
+  _gfx = gfx;
+  _tft = NULL;
+  _font = NULL;
+  _cells = _shown = _next = NULL;
+  _text = NULL;
+  _x = x;
+  _y = y;
+  _top = 0;
+  _bottom = 8;
+  _shownY = _shownH = 0;
+  _color = 0xFFFF;
+  _bg = 0x0000;
+  _max = maxChars;
+  _len = _shownCount = _drawn = 0;
+  _size_x = _size_y = 1;
+  _digitAdvance = 0;
+  _align = TEXT_LEFT;
+  _tabular = false;
+  _full = true;
+}
+
+/*!
+    @brief   Allocate the field's buffers. Nothing is drawn until the first
+             update().
+    @return  true on success, false if maxChars is 0 or the buffers
+             couldn't be allocated.
+*/
+bool Adafruit_TextField::begin(void) {
+  if (!_max)
+    return false;
+  if (!_cells) {
+    _cells = (Cell *)malloc(_max * (2 * sizeof(Cell) + 1));
+    if (!_cells)
+      return false;
+    _shown = _cells;
+    _next = &_cells[_max];
+    _text = (char *)&_cells[2 * _max];
+  }
+  _len = _shownCount = 0;
+  _full = true;
+  return true;
+}
+
+/*!
+    @brief  Set the font of the field's text. The cells of a custom font
+            are the height of its tallest glyphs, as for opaque text on an
+            Adafruit_SPITFT.
+    @param  f  The font, or NULL (the default) for the classic 6x8 font.
+*/
+void Adafruit_TextField::setFont(const GFXfont *f) {
+  _font = f;
+  _top = 0;
+  _bottom = 8;
+  if (f) {
+    _bottom = 0;
+    for (uint16_t i = 0, n = gfxGlyphCount(f); i < n; i++) {
+      GFXglyph *glyph = pgm_read_glyph_ptr(f, i);
+      int16_t yo = (int8_t)pgm_read_byte(&glyph->yOffset),
+              h = pgm_read_byte(&glyph->height);
+      if (h) {
+        if (yo < _top)
+          _top = yo;
+        if (yo + h > _bottom)
+          _bottom = yo + h;
+      }
+    }
+  }
+  _digitAdvance = (_tabular && f) ? gfxDigitAdvance(f) : 0;
+  _full = true;
+}
+
+/*!
+    @brief  Set text magnification, as Adafruit_GFX::setTextSize() does.
+    @param  size_x  Horizontal magnification, at least 1.
+    @param  size_y  Vertical magnification, at least 1.
+*/
+void Adafruit_TextField::setTextSize(uint8_t size_x, uint8_t size_y) {
+  _size_x = (size_x > 0) ? size_x : 1;
+  _size_y = (size_y > 0) ? size_y : 1;
+  _full = true;
+}
+
+/*!
+    @brief  Set the text and background colors.
+    @param  color  16-bit text color.
+    @param  bg     16-bit background color, filling each character's cell
+                   and what's left when text gets shorter.
+*/
+void Adafruit_TextField::setColors(uint16_t color, uint16_t bg) {
+  _color = color;
+  _bg = bg;
+  _full = true;
+}
+
+/*!
+    @brief  Set how text is placed about the field's X coordinate.
+    @param  align  TEXT_LEFT (x is the left edge), TEXT_CENTER or
+                   TEXT_RIGHT (x is the right edge).
+*/
+void Adafruit_TextField::setAlign(textAlign align) {
+  _align = align;
+  _full = true;
+}
+
+/*!
+    @brief  Move the field.
+    @param  x  Text cursor X, by the alignment.
+    @param  y  Text cursor Y: top edge for the classic font, baseline for
+               custom fonts.
+*/
+void Adafruit_TextField::setPosition(int16_t x, int16_t y) {
+  _x = x;
+  _y = y;
+  _full = true;
+}
+
+/*!
+    @brief  Set digits of custom fonts in equal cells, as
+            Adafruit_GFX::setTabularDigits() does.
+    @param  tabular  true for tabular digits, false (the default) for the
+                     font's own widths.
+*/
+void Adafruit_TextField::setTabularDigits(bool tabular) {
+  _tabular = tabular;
+  _digitAdvance = (tabular && _font) ? gfxDigitAdvance(_font) : 0;
+  _full = true;
+}
+
+/*!
+    @brief  Replace the text and update() the screen.
+    @param  text  NUL-terminated text, UTF-8 for an extended font.
+*/
+void Adafruit_TextField::setText(const char *text) {
+  _len = 0;
+  print(text);
+  update();
+}
+
+/*!
+    @brief  Show the text printed since the last update(), drawing only
+            what differs from the screen. With nothing printed, the field
+            is emptied.
+*/
+void Adafruit_TextField::update(void) {
+  if (!_cells)
+    return;
+  uint8_t count = layout(_next), i, j;
+  _len = 0;
+
+  // Displays draw characters in their own font, so lend them this one
+  const GFXfont *saved = _gfx->getFont();
+  bool tabular = _gfx->getTabularDigits();
+  uint8_t turn = _gfx->getTextOrientation(); // Laid out upright
+  if (saved != _font)
+    _gfx->setFont(_font);
+  _gfx->setTabularDigits(_tabular);
+  _gfx->setTextOrientation(0);
+  bool opaque = _tft && _tft->getFontOpaque();
+  if (_tft)
+    _tft->setFontOpaque(true);
+  _gfx->startWrite();
+
+  if (_full) { // Settings changed; clear the old text's cells
+    clear();
+    _full = false;
+  }
+
+  // A new character just like the one last drawn in its place is kept
+  for (i = j = 0; i < count; i++) {
+    while ((j < _shownCount) && (_shown[j].x < _next[i].x))
+      j++;
+    _next[i].keep = (j < _shownCount) && (_shown[j].x == _next[i].x) &&
+                    (_shown[j].c == _next[i].c);
+    if (_next[i].keep)
+      _shown[j].keep = true;
+  }
+  // ...unless a cell being drawn or erased overlaps it
+  bool grown;
+  do {
+    grown = false;
+    for (i = 0; i < count; i++) {
+      if (!_next[i].keep)
+        continue;
+      bool hit = false;
+      for (j = 0; (j < count) && !hit; j++)
+        hit = !_next[j].keep && (_next[j].left < _next[i].right) &&
+              (_next[i].left < _next[j].right);
+      for (j = 0; (j < _shownCount) && !hit; j++)
+        hit = !_shown[j].keep && (_shown[j].left < _next[i].right) &&
+              (_next[i].left < _shown[j].right);
+      if (hit) {
+        _next[i].keep = false;
+        grown = true;
+      }
+    }
+  } while (grown);
+
+  // Erase what's left of old characters, then draw the new ones
+  for (j = 0; j < _shownCount; j++)
+    if (!_shown[j].keep)
+      fillUncovered(_shown[j].left, _shown[j].right, _next, count);
+  for (i = _drawn = 0; i < count; i++) {
+    if (!_next[i].keep) {
+      drawCell(&_next[i]);
+      _drawn++;
+    }
+    _next[i].keep = false; // Reset for matching at the next update()
+  }
+
+  _gfx->endWrite();
+  if (_tft)
+    _tft->setFontOpaque(opaque);
+  if (saved != _font)
+    _gfx->setFont(saved);
+  _gfx->setTabularDigits(tabular);
+  _gfx->setTextOrientation(turn);
+  Cell *c = _shown;
+  _shown = _next;
+  _next = c;
+  _shownCount = count;
+  _shownY = cellY();
+  _shownH = cellH();
+}
+
+/*!
+    @brief  Draw the whole field at the next update(), e.g. after the
+            screen was cleared or drawn over.
+*/
+void Adafruit_TextField::redraw(void) { _full = true; }
+
+/*!
+    @brief  Erase the field's text from the screen, filling with the
+            background color. The next update() draws all its text.
+*/
+void Adafruit_TextField::clear(void) {
+  if (_shownCount) {
+    int16_t left = _shown[0].left, right = _shown[0].right;
+    for (uint8_t j = 1; j < _shownCount; j++) {
+      if (_shown[j].left < left)
+        left = _shown[j].left;
+      if (_shown[j].right > right)
+        right = _shown[j].right;
+    }
+    _gfx->fillRect(left, _shownY, right - left, _shownH, _bg);
+  }
+  _shownCount = 0;
+}
+
+/*!
+    @brief   Put a character in the text for the next update().
+    @param   c  Byte of text; newlines and carriage returns are ignored.
+    @return  1 if taken, 0 if the field is full or begin() hasn't
+             succeeded.
+*/
+size_t Adafruit_TextField::write(uint8_t c) {
+  if (!_text || (_len >= _max))
+    return 0;
+  if ((c != '\n') && (c != '\r'))
+    _text[_len++] = c;
+  return 1;
+}
+
+/*!
+    @brief   Lay out the printed text: where each character goes, and the
+             columns of its cell, as for opaque text on an Adafruit_SPITFT
+             (its advance, widened to take in any overhanging ink).
+    @param   cells  Set to the characters, left to right.
+    @return  Number of characters; any the font lacks are left out.
+*/
+uint8_t Adafruit_TextField::layout(Cell *cells) {
+  GFXtextDecoder text(_font);
+  uint8_t count = 0;
+  int16_t x = 0;
+  int32_t prev = -1; // Glyph index, for kerning
+  uint32_t c;
+  for (uint8_t n = 0; n < _len; n++) {
+    if (!text.decode(_text[n], &c))
+      continue; // Partway into a UTF-8 sequence
+    Cell *cell = &cells[count];
+    int16_t left = 0, right = 6, advance = 6, pad = 0;
+    if (_font) {
+      int32_t i = gfxGlyphIndex(_font, c);
+      if (i < 0)
+        continue;
+      GFXglyph *glyph = pgm_read_glyph_ptr(_font, i);
+      int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset),
+              gw = pgm_read_byte(&glyph->width);
+      advance = pgm_read_byte(&glyph->xAdvance);
+      if (_digitAdvance && (c >= '0') && (c <= '9')) {
+        // Tabular: glyph centered in the cell, not kerned
+        pad = (_digitAdvance - advance) / 2;
+        advance = _digitAdvance;
+        prev = -1;
+      } else {
+        x += gfxKernAdjust(_font, prev, i) * _size_x;
+        prev = i;
+      }
+      left = (pad + xo < 0) ? pad + xo : 0;
+      right = (pad + xo + gw > advance) ? pad + xo + gw : advance;
+    }
+    cell->c = c;
+    cell->x = x + pad * _size_x;
+    cell->left = x + left * _size_x;
+    cell->right = x + right * _size_x;
+    cell->keep = false;
+    x += advance * _size_x;
+    count++;
+  }
+  int16_t shift = (_align == TEXT_RIGHT)    ? _x - x
+                  : (_align == TEXT_CENTER) ? _x - x / 2
+                                            : _x;
+  for (uint8_t i = 0; i < count; i++) {
+    cells[i].x += shift;
+    cells[i].left += shift;
+    cells[i].right += shift;
+  }
+  return count;
+}
+
+/*!
+    @brief  Fill columns of the field with the background, except those
+            in cells about to be drawn (which paint their own).
+    @param  left   First column.
+    @param  right  Column past the last.
+    @param  cells  Characters being laid out.
+    @param  count  Number of characters.
+*/
+void Adafruit_TextField::fillUncovered(int16_t left, int16_t right,
+                                       const Cell *cells, uint8_t count) {
+  while (left < right) {
+    int16_t end = right;
+    bool covered = false;
+    for (uint8_t i = 0; (i < count) && !covered; i++) {
+      if (cells[i].keep)
+        continue;
+      if ((cells[i].left <= left) && (cells[i].right > left)) {
+        left = cells[i].right; // Skip the cell, and look again from there
+        covered = true;
+      } else if ((cells[i].left > left) && (cells[i].left < end)) {
+        end = cells[i].left;
+      }
+    }
+    if (!covered) {
+      _gfx->fillRect(left, cellY(), end - left, cellH(), _bg);
+      left = end;
+    }
+  }
+}
+
+/*!
+    @brief  Draw one character's whole cell, glyph and background.
+    @param  cell  The character.
+*/
+void Adafruit_TextField::drawCell(const Cell *cell) {
+  int16_t y = _y;
+  if (!_font) { // Classic font cells are always opaque
+    _gfx->drawChar(cell->x, y, cell->c, _color, _bg, _size_x, _size_y);
+  } else {
+    // An Adafruit_SPITFT sends the cell in one window; elsewhere fill it
+    // then draw the glyph (anti-aliased ones blended with the background)
+    if (!_tft || (_color == _bg))
+      _gfx->fillRect(cell->left, cellY(), cell->right - cell->left, cellH(),
+                     _bg);
+    if (_color != _bg)
+      _gfx->drawGlyph(cell->x, y, cell->c, _color, _bg, _size_x, _size_y);
+  }
+}
+
+#endif // end __AVR_ATtiny85__
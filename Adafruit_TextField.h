@@ -0,0 +1,128 @@
+/*!
+ * @file Adafruit_TextField.h
+ *
+ * Part of Adafruit's GFX graphics library. A one-line text field, such as
+ * a numeric readout, that remembers what it last drew and on each update
+ * redraws only the characters that changed.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_TEXTFIELD_H_
+#define _ADAFRUIT_TEXTFIELD_H_
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_SPITFT.h"
+#include "Adafruit_TextLayout.h"
+
+/*!
+  @brief  A line of text at a fixed spot on a display or canvas, drawn
+          opaque and updated in place. Typical use:
+
+              Adafruit_TextField rpm(&tft, 310, 40, 8);
+              rpm.begin();
+              rpm.setFont(&FreeSans12pt7b);
+              rpm.setAlign(TEXT_RIGHT);     // x is the right edge
+              rpm.setColors(ILI9341_WHITE, ILI9341_BLACK);
+              ...
+              rpm.print(reading, 1);        // Any Print output
+              rpm.update();                 // Draw just what changed
+
+          Text printed to the field is collected until update(), which
+          lays it out and compares it with what's on screen, character by
+          character by position: a character at the same place as last
+          time, the same as before, is left alone. Only changed characters
+          are drawn, each as an opaque cell (on an Adafruit_SPITFT one
+          address window, through its setFontOpaque() span renderer), and
+          only the parts of old characters no new one covers are filled
+          with the background. Characters that shift because a
+          proportional font's widths changed are redrawn where they land,
+          and with right alignment the unchanged tail of a number, such as
+          its decimals, stays put. Glyphs overhanging their neighbors are
+          handled by redrawing the neighbors too. With
+          setTabularDigits(), digits of a proportional font get equal
+          cells, so numbers keep their width and a changed digit is
+          redrawn in exactly the cell of the old one.
+
+          Changing the font, size, colors, alignment or position redraws
+          the field in full at the next update().
+*/
+class Adafruit_TextField : public Print {
+public:
+  Adafruit_TextField(Adafruit_SPITFT *tft, int16_t x, int16_t y,
+                     uint8_t maxChars);
+  Adafruit_TextField(Adafruit_GFX *gfx, int16_t x, int16_t y,
+                     uint8_t maxChars);
+  ~Adafruit_TextField(void);
+  bool begin(void);
+  void setFont(const GFXfont *f = NULL);
+  void setTextSize(uint8_t size_x, uint8_t size_y);
+  void setColors(uint16_t color, uint16_t bg);
+  void setAlign(textAlign align);
+  void setPosition(int16_t x, int16_t y);
+  void setTabularDigits(bool tabular);
+  void setText(const char *text);
+  void update(void);
+  void redraw(void);
+  void clear(void);
+  using Print::write;
+  size_t write(uint8_t c);
+
+  /*!
+    @brief   Get how many characters the last update() drew, for tuning.
+    @return  Characters drawn; the rest were already on screen.
+  */
+  uint8_t getDrawn(void) const { return _drawn; }
+
+private:
+  /// A character as laid out, with the screen columns its cell covers
+  typedef struct {
+    uint32_t c;    ///< Character, a codepoint for extended fonts
+    int16_t x;     ///< Where the glyph is drawn from
+    int16_t left;  ///< Left edge of cell
+    int16_t right; ///< Right edge of cell (exclusive)
+    bool keep;     ///< Unchanged on screen, not to be drawn
+  } Cell;
+
+  void init(Adafruit_GFX *gfx, int16_t x, int16_t y, uint8_t maxChars);
+  uint8_t layout(Cell *cells);
+  void fillUncovered(int16_t left, int16_t right, const Cell *cells,
+                     uint8_t count);
+  void drawCell(const Cell *cell);
+  int16_t cellY(void) const { return _y + _top * _size_y; }
+  int16_t cellH(void) const { return (_bottom - _top) * _size_y; }
+
+  Adafruit_GFX *_gfx;    ///< Display or canvas drawn on
+  Adafruit_SPITFT *_tft; ///< _gfx if it's a display, for opaque cells
+  const GFXfont *_font;  ///< Font, NULL for the classic font
+  Cell *_cells;          ///< Both cell buffers, as allocated
+  Cell *_shown;          ///< Characters on screen
+  Cell *_next;           ///< Characters being laid out
+  char *_text;           ///< Text printed since the last update()
+  int16_t _x;            ///< Anchor, by the alignment
+  int16_t _y;            ///< Cursor Y: top (classic font) or baseline
+  int16_t _top;          ///< Top of cells, in font pixels from _y
+  int16_t _bottom;       ///< Bottom of cells (exclusive)
+  int16_t _shownY;       ///< Top of the cells on screen
+  int16_t _shownH;       ///< Height of the cells on screen
+  uint16_t _color;       ///< Text color
+  uint16_t _bg;          ///< Background color
+  uint8_t _max;          ///< Most bytes of text
+  uint8_t _len;          ///< Bytes in _text
+  uint8_t _shownCount;   ///< Cells in _shown
+  uint8_t _drawn;        ///< Characters drawn by the last update()
+  uint8_t _size_x;       ///< Horizontal magnification
+  uint8_t _size_y;       ///< Vertical magnification
+  uint8_t _digitAdvance; ///< Tabular digit cell width, 0 if off
+  textAlign _align;      ///< How text is placed about _x
+  bool _tabular;         ///< Digits in equal cells
+  bool _full;            ///< Next update() redraws everything
+};
+
+#endif // end __AVR_ATtiny85__
+#endif // end _ADAFRUIT_TEXTFIELD_H_
@@ -0,0 +1,497 @@
+/*!
+ * @file Adafruit_TextLayout.cpp
+ *
+ * Part of Adafruit's GFX graphics library. Text wrapped, aligned and
+ * ellipsized into a box, with line breaks kept between draws. See
+ * Adafruit_TextLayout.h for usage.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_TextLayout.h"
+
+/*!
+    @brief  Constructor. Starts with no text, in the classic font at size 1,
+            left-aligned, wrapping, with ellipsis.
+    @param  gfx  Display or canvas to draw on.
+    @param  x    Left edge of the box.
+    @param  y    Top edge of the box.
+    @param  w    Width of the box in pixels.
+    @param  h    Height of the box in pixels; as many lines are used as fit
+                 entirely (up to TEXTLAYOUT_LINES).
+*/
+Adafruit_TextLayout::Adafruit_TextLayout(Adafruit_GFX *gfx, int16_t x,
+                                         int16_t y, int16_t w, int16_t h)
+    : _gfx(gfx), _text(NULL), _font(NULL), _hash(0), _x(x), _y(y), _w(w),
+      _h(h), _ascent(0), _size_x(1), _size_y(1), _lines(0), _maxLines(0),
+      _digitAdvance(0), _align(TEXT_LEFT), _wrap(true), _ellipsis(true),
+      _tabular(false), _truncated(false), _dirty(true) {}
+
+/*!
+    @brief  Set the text to lay out. The line breaks are only found again
+            if the text differs from last time, so this can be called
+            before every draw().
+    @param  text  NUL-terminated text, UTF-8 for an extended font. Not
+                  copied; the layout reads it again in draw().
+*/
+void Adafruit_TextLayout::setText(const char *text) {
+  uint32_t hash = 2166136261UL; // FNV-1a
+  if (text)
+    for (const char *s = text; *s; s++)
+      hash = (hash ^ (uint8_t)*s) * 16777619UL;
+  if (hash != _hash)
+    _dirty = true;
+  _text = text;
+  _hash = hash;
+}
+
+/*!
+    @brief  Move or resize the box. Moving it keeps the line breaks; a new
+            size finds them again.
+    @param  x  Left edge of the box.
+    @param  y  Top edge of the box.
+    @param  w  Width of the box in pixels.
+    @param  h  Height of the box in pixels.
+*/
+void Adafruit_TextLayout::setBox(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if ((w != _w) || (h != _h))
+    _dirty = true;
+  _x = x;
+  _y = y;
+  _w = w;
+  _h = h;
+}
+
+/*!
+    @brief  Set the font text is measured and drawn in.
+    @param  f  The font, or NULL (the default) for the classic 6x8 font.
+*/
+void Adafruit_TextLayout::setFont(const GFXfont *f) {
+  if (f == _font)
+    return;
+  _font = f;
+  _ascent = 0;
+  if (f) { // Lines are placed by the tallest glyph, like a text cell
+    uint16_t n = gfxGlyphCount(f);
+    for (uint16_t i = 0; i < n; i++) {
+      int8_t yo = pgm_read_byte(&pgm_read_glyph_ptr(f, i)->yOffset);
+      if (-yo > _ascent)
+        _ascent = -yo;
+    }
+  }
+  _digitAdvance = (_tabular && f) ? gfxDigitAdvance(f) : 0;
+  _dirty = true;
+}
+
+/*!
+    @brief  Set text magnification, as Adafruit_GFX::setTextSize() does.
+    @param  size_x  Horizontal magnification, at least 1.
+    @param  size_y  Vertical magnification, at least 1.
+*/
+void Adafruit_TextLayout::setTextSize(uint8_t size_x, uint8_t size_y) {
+  size_x = (size_x > 0) ? size_x : 1;
+  size_y = (size_y > 0) ? size_y : 1;
+  if ((size_x != _size_x) || (size_y != _size_y))
+    _dirty = true;
+  _size_x = size_x;
+  _size_y = size_y;
+}
+
+/*!
+    @brief  Set where lines go across the box. Doesn't change the breaks.
+    @param  align  TEXT_LEFT, TEXT_CENTER or TEXT_RIGHT.
+*/
+void Adafruit_TextLayout::setAlign(textAlign align) { _align = align; }
+
+/*!
+    @brief  Set whether lines wrap at the right edge of the box.
+    @param  wrap  true (the default) to break lines at spaces, or within
+                  words too long for a line; false to break them only at
+                  newlines, cutting lines too wide for the box.
+*/
+void Adafruit_TextLayout::setWrap(bool wrap) {
+  if (wrap != _wrap)
+    _dirty = true;
+  _wrap = wrap;
+}
+
+/*!
+    @brief  Set whether cut text ends in "...".
+    @param  ellipsis  true (the default) to end a line that's cut, or the
+                      last line when there's more text than fits, with
+                      "..."; false to just stop.
+*/
+void Adafruit_TextLayout::setEllipsis(bool ellipsis) {
+  if (ellipsis != _ellipsis)
+    _dirty = true;
+  _ellipsis = ellipsis;
+}
+
+/*!
+    @brief  Set digits of custom fonts in equal cells, as
+            Adafruit_GFX::setTabularDigits() does, so numbers in the text
+            line up and keep their width as they change.
+    @param  tabular  true for tabular digits, false (the default) for the
+                     font's own widths.
+*/
+void Adafruit_TextLayout::setTabularDigits(bool tabular) {
+  if (tabular != _tabular)
+    _dirty = true;
+  _tabular = tabular;
+  _digitAdvance = (tabular && _font) ? gfxDigitAdvance(_font) : 0;
+}
+
+/*!
+    @brief  Draw the text, finding its line breaks first if they've
+            changed.
+    @param  color  16-bit text color.
+    @param  bg     16-bit background color, drawn behind each character
+                   as print() would; the same as color for transparent
+                   text.
+*/
+void Adafruit_TextLayout::draw(uint16_t color, uint16_t bg) {
+  if (_dirty)
+    layout();
+  if (!_lines)
+    return;
+  // Displays draw characters in their own font, so lend them this one
+  const GFXfont *saved = _gfx->getFont();
+  bool tabular = _gfx->getTabularDigits();
+  uint8_t turn = _gfx->getTextOrientation(); // Laid out upright
+  if (saved != _font)
+    _gfx->setFont(_font);
+  _gfx->setTabularDigits(_tabular);
+  _gfx->setTextOrientation(0);
+  _gfx->startWrite();
+  int16_t y = _y + (_font ? _ascent * _size_y : 0);
+  for (uint8_t i = 0; i < _lines; i++, y += lineHeight()) {
+    const Line *l = &_line[i];
+    GFXtextDecoder text(_font);
+    int16_t x = lineX(l);
+    int32_t prev = -1;
+    uint32_t c;
+    for (uint16_t n = 0; n < l->len; n++)
+      if (text.decode(_text[l->start + n], &c) && (c != '\r'))
+        x = drawChar(x, y, c, &prev, color, bg);
+    if (l->ellipsis)
+      for (uint8_t n = 0; n < 3; n++)
+        x = drawChar(x, y, '.', &prev, color, bg);
+  }
+  _gfx->endWrite();
+  if (saved != _font)
+    _gfx->setFont(saved);
+  _gfx->setTabularDigits(tabular);
+  _gfx->setTextOrientation(turn);
+}
+
+/*!
+    @brief   Get how many lines the text takes.
+    @return  Lines drawn, 0 if there's no text or the box is too short
+             for a line.
+*/
+uint8_t Adafruit_TextLayout::getLineCount(void) {
+  if (_dirty)
+    layout();
+  return _lines;
+}
+
+/*!
+    @brief   Get where a line is drawn, e.g. to clear it before the text
+             changes. The width is the line's advance (where the next
+             character would go); glyphs can overhang it slightly.
+    @param   line  Line number, 0 at the top.
+    @param   x     Set to the left edge of the line.
+    @param   y     Set to the top edge of the line.
+    @param   w     Set to the width of the line.
+    @param   h     Set to the height of the line.
+    @return  true if the line exists, else false and nothing is set.
+*/
+bool Adafruit_TextLayout::getLineBounds(uint8_t line, int16_t *x, int16_t *y,
+                                        uint16_t *w, uint16_t *h) {
+  if (_dirty)
+    layout();
+  if (line >= _lines)
+    return false;
+  *x = lineX(&_line[line]);
+  *y = _y + line * lineHeight();
+  *w = _line[line].width * _size_x;
+  *h = lineHeight();
+  return true;
+}
+
+/*!
+    @brief   Check whether any of the text was left out or cut short.
+    @return  true if the text didn't all fit in the box.
+*/
+bool Adafruit_TextLayout::isTruncated(void) {
+  if (_dirty)
+    layout();
+  return _truncated;
+}
+
+/*!
+    @brief  Find the line breaks, in one pass over the text. Each line is
+            extended a character at a time; one that won't fit breaks at
+            the last space (trailing spaces aren't part of either line),
+            or right there if the line has no space.
+*/
+void Adafruit_TextLayout::layout(void) {
+  _dirty = false;
+  _lines = 0;
+  _truncated = false;
+  uint16_t lines = ((_h > 0) && lineHeight()) ? _h / lineHeight() : 0;
+  _maxLines = (lines < TEXTLAYOUT_LINES) ? lines : TEXTLAYOUT_LINES;
+  if (!_text || !_maxLines || (_w <= 0))
+    return;
+
+  int16_t limit = _w / _size_x; // Box width in font pixels
+  GFXtextDecoder text(_font);
+  uint32_t c;
+  uint16_t pos, start = 0, first = 0; // Text offsets of line, character
+  uint16_t end = 0, breakAt = 0, rest = 0; // Ends of line, break; after it
+  int16_t width = 0, endWidth = 0, breakWidth = 0;
+  int32_t prev = -1; // Glyph index, for kerning
+  bool skip = false; // Line was cut; ignore the rest of it
+
+  for (pos = 0; _text[pos] && (pos < 0xFFFF); pos++) {
+    if (!text.decode(_text[pos], &c))
+      continue; // Partway into a UTF-8 sequence
+    if (c == '\n') {
+      if (!skip && !breakLine(start, end - start, endWidth, _text[pos + 1]))
+        return;
+      start = end = breakAt = pos + 1;
+      width = endWidth = 0;
+      prev = -1;
+      skip = false;
+    } else if ((c != '\r') && !skip) {
+      int16_t a = advance(c, &prev);
+      if (c == ' ') { // A place to break, if the next word won't fit
+        if (breakAt != end) {
+          breakAt = end;
+          breakWidth = endWidth;
+        }
+        rest = pos + 1;
+        width += a;
+      } else {
+        while ((width + a > limit) && (first > start)) {
+          if (!_wrap) {
+            cutLine(start);
+            if (_lines == _maxLines)
+              return;
+            skip = true;
+            break;
+          }
+          if (breakAt > start) { // Word goes on the next line
+            if (!breakLine(start, breakAt - start, breakWidth, true))
+              return;
+            start = rest;
+          } else { // Word's too long for a line; break it
+            if (!breakLine(start, first - start, width, true))
+              return;
+            start = first;
+          }
+          breakAt = start;
+          prev = -1;
+          width = measure(start, first, &prev);
+          a = advance(c, &prev);
+        }
+        width += a;
+        end = pos + 1;
+        endWidth = width;
+      }
+    }
+    first = pos + 1; // Next character starts here
+  }
+  if (!skip && (pos > start))
+    breakLine(start, end - start, endWidth, (pos == 0xFFFF));
+}
+
+/*!
+    @brief   Add a line to the layout, or if it's the last that fits and
+             text follows it, a cut line with an ellipsis instead.
+    @param   start  Text offset of the line.
+    @param   len    Bytes in the line.
+    @param   width  Width of the line in font pixels.
+    @param   more   Text follows the line.
+    @return  true if there's room for another line.
+*/
+bool Adafruit_TextLayout::breakLine(uint16_t start, uint16_t len,
+                                    int16_t width, bool more) {
+  if (more && (_lines + 1 == _maxLines)) {
+    _truncated = true;
+    if (_ellipsis) {
+      cutLine(start);
+      return false;
+    }
+  }
+  Line *l = &_line[_lines++];
+  l->start = start;
+  l->len = len;
+  l->width = width;
+  l->ellipsis = false;
+  return _lines < _maxLines;
+}
+
+/*!
+    @brief  Add a line holding as much of the text from start as fits in
+            the box, with an ellipsis if that's on.
+    @param  start  Text offset to start at.
+*/
+void Adafruit_TextLayout::cutLine(uint16_t start) {
+  int16_t limit = _w / _size_x, dots = 0;
+  int32_t prev = -1;
+  if (_ellipsis)
+    for (uint8_t n = 0; n < 3; n++)
+      dots += advance('.', &prev);
+  Line *l = &_line[_lines++];
+  l->start = start;
+  l->width = fit(start, limit - dots, &l->len, &prev);
+  l->ellipsis = _ellipsis;
+  if (_ellipsis)
+    for (uint8_t n = 0; n < 3; n++)
+      l->width += advance('.', &prev);
+  _truncated = true;
+}
+
+/*!
+    @brief   Measure the longest start of a line that fits a width,
+             leaving off any spaces at its end.
+    @param   start  Text offset of the line.
+    @param   limit  Width available, in font pixels.
+    @param   len    Set to the bytes that fit.
+    @param   prev   Set to the glyph index of the last character that fits,
+                    for kerning what follows; left alone if none does.
+    @return  Width in font pixels of the part that fits.
+*/
+int16_t Adafruit_TextLayout::fit(uint16_t start, int16_t limit, uint16_t *len,
+                                 int32_t *prev) {
+  GFXtextDecoder text(_font);
+  uint32_t c;
+  int32_t p = -1;
+  int16_t width = 0, fits = 0;
+  *len = 0;
+  for (uint16_t pos = start; _text[pos] && (pos < 0xFFFF); pos++) {
+    if (!text.decode(_text[pos], &c) || (c == '\r'))
+      continue;
+    if (c == '\n')
+      break;
+    width += advance(c, &p);
+    if (width > limit)
+      break;
+    if (c != ' ') {
+      *len = pos + 1 - start;
+      fits = width;
+      *prev = p;
+    }
+  }
+  return fits;
+}
+
+/*!
+    @brief   Measure part of the text, kerned as drawn.
+    @param   from  Text offset of the first character.
+    @param   to    Text offset just past the last.
+    @param   prev  Glyph index of the character before, -1 for none;
+                   updated.
+    @return  Width in font pixels.
+*/
+int16_t Adafruit_TextLayout::measure(uint16_t from, uint16_t to,
+                                     int32_t *prev) {
+  GFXtextDecoder text(_font);
+  uint32_t c;
+  int16_t width = 0;
+  for (uint16_t pos = from; pos < to; pos++)
+    if (text.decode(_text[pos], &c) && (c != '\r'))
+      width += advance(c, prev);
+  return width;
+}
+
+/*!
+    @brief   Get how far a character moves the cursor, as print() would.
+    @param   c     The character, a Unicode codepoint for extended fonts.
+    @param   prev  Glyph index of the character before, -1 for none, for
+                   kerning; updated.
+    @return  Advance in font pixels, 0 for a character the font lacks.
+*/
+int16_t Adafruit_TextLayout::advance(uint32_t c, int32_t *prev) {
+  if (!_font)
+    return 6;
+  int32_t i = gfxGlyphIndex(_font, c);
+  if (i < 0)
+    return 0;
+  if (_digitAdvance && (c >= '0') && (c <= '9')) { // Tabular, unkerned
+    *prev = -1;
+    return _digitAdvance;
+  }
+  int16_t a = gfxKernAdjust(_font, *prev, i) +
+              (uint8_t)pgm_read_byte(&pgm_read_glyph_ptr(_font, i)->xAdvance);
+  *prev = i;
+  return a;
+}
+
+/*!
+    @brief   Draw one character through the display's text hooks.
+    @param   x      Cursor position before the character.
+    @param   y      Top of the line (classic font) or baseline.
+    @param   c      The character, a Unicode codepoint for extended fonts.
+    @param   prev   Glyph index of the character before, for kerning;
+                    updated.
+    @param   color  16-bit text color.
+    @param   bg     16-bit background color.
+    @return  Cursor position after the character.
+*/
+int16_t Adafruit_TextLayout::drawChar(int16_t x, int16_t y, uint32_t c,
+                                      int32_t *prev, uint16_t color,
+                                      uint16_t bg) {
+  if (!_font) {
+    _gfx->drawChar(x, y, c, color, bg, _size_x, _size_y);
+    return x + 6 * _size_x;
+  }
+  int32_t i = gfxGlyphIndex(_font, c);
+  if (i < 0)
+    return x;
+  GFXglyph *glyph = pgm_read_glyph_ptr(_font, i);
+  uint8_t xa = pgm_read_byte(&glyph->xAdvance);
+  int16_t pad = 0;
+  if (_digitAdvance && (c >= '0') && (c <= '9')) { // Centered in its cell
+    pad = (_digitAdvance - xa) / 2 * (int16_t)_size_x;
+    xa = _digitAdvance;
+    *prev = -1;
+  } else {
+    x += gfxKernAdjust(_font, *prev, i) * (int16_t)_size_x;
+    *prev = i;
+  }
+  // Blank glyphs (spaces) matter only to opaque renderers, as in write()
+  if ((pgm_read_byte(&glyph->width) && pgm_read_byte(&glyph->height)) ||
+      (bg != color))
+    _gfx->drawGlyph(x + pad, y, c, color, bg, _size_x, _size_y);
+  return x + xa * (int16_t)_size_x;
+}
+
+/*!
+    @brief   Get where a line starts across the box, by the alignment.
+    @param   l  The line.
+    @return  X coordinate of the line's left edge.
+*/
+int16_t Adafruit_TextLayout::lineX(const Line *l) const {
+  int16_t space = _w - l->width * _size_x;
+  if ((space <= 0) || (_align == TEXT_LEFT))
+    return _x;
+  return _x + ((_align == TEXT_CENTER) ? space / 2 : space);
+}
+
+/*!
+    @brief   Get the distance from one line to the next.
+    @return  The font's line spacing times the text size, in pixels.
+*/
+uint16_t Adafruit_TextLayout::lineHeight(void) const {
+  return (_font ? (uint8_t)pgm_read_byte(&_font->yAdvance) : 8) * _size_y;
+}
+
+#endif // end __AVR_ATtiny85__
@@ -0,0 +1,130 @@
+/*!
+ * @file Adafruit_TextLayout.h
+ *
+ * Part of Adafruit's GFX graphics library. Word-wraps text into a box,
+ * aligns each line left, center or right and ends text that doesn't fit
+ * with an ellipsis, remembering where the lines break so redrawing the
+ * same text costs only the drawing.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_TEXTLAYOUT_H_
+#define _ADAFRUIT_TEXTLAYOUT_H_
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_GFX.h"
+
+#ifndef TEXTLAYOUT_LINES
+#define TEXTLAYOUT_LINES 8 ///< Most lines a layout breaks text into
+#endif
+
+/// How an Adafruit_TextLayout places each line across its box
+typedef enum {
+  TEXT_LEFT,   ///< Flush with the left edge
+  TEXT_CENTER, ///< Centered
+  TEXT_RIGHT,  ///< Flush with the right edge
+} textAlign;
+
+/*!
+  @brief  Text laid out in a box on a display or canvas. Typical use:
+
+              Adafruit_TextLayout label(&tft, 10, 40, 220, 60);
+              label.setFont(&FreeSans9pt7b);
+              label.setAlign(TEXT_CENTER);
+              ...
+              label.setText(message);
+              label.draw(ILI9341_WHITE, ILI9341_BLACK);
+
+          Lines break at spaces (within a word only if it's wider than the
+          box) and at newlines. With wrap off they break only at newlines
+          and lines too wide are cut. When there is more text than lines
+          fit in the box, the last line is cut, by default with "..." on
+          the end.
+
+          Line breaks are found in one pass over the text, measuring each
+          character as it's reached, and kept until the text (by content,
+          not just pointer), box size, font, size or options change, so a
+          label redrawn each frame is measured once. Lines are drawn
+          character by character through the display's drawChar() and
+          drawGlyph(), which is where displays do fast text (opaque cells
+          in one window on an Adafruit_SPITFT). The display's own font,
+          cursor and text settings are left as they were.
+
+          The text isn't copied: keep it in place while the layout is in
+          use, and call setText() again after changing it.
+*/
+class Adafruit_TextLayout {
+public:
+  Adafruit_TextLayout(Adafruit_GFX *gfx, int16_t x, int16_t y, int16_t w,
+                      int16_t h);
+  void setText(const char *text);
+  void setBox(int16_t x, int16_t y, int16_t w, int16_t h);
+  void setFont(const GFXfont *f = NULL);
+  void setTextSize(uint8_t size_x, uint8_t size_y);
+  void setAlign(textAlign align);
+  void setWrap(bool wrap);
+  void setEllipsis(bool ellipsis);
+  void setTabularDigits(bool tabular);
+  void draw(uint16_t color, uint16_t bg);
+  uint8_t getLineCount(void);
+  bool getLineBounds(uint8_t line, int16_t *x, int16_t *y, uint16_t *w,
+                     uint16_t *h);
+  bool isTruncated(void);
+
+  /*!
+    @brief  Draw the text transparently, over whatever is in the box.
+    @param  color  16-bit text color.
+  */
+  void draw(uint16_t color) { draw(color, color); }
+
+private:
+  /// A line of the layout
+  typedef struct {
+    uint16_t start; ///< Byte offset of the line in the text
+    uint16_t len;   ///< Bytes of text in the line
+    int16_t width;  ///< Width in font pixels (unscaled), with any "..."
+    bool ellipsis;  ///< Line ends with "..."
+  } Line;
+
+  void layout(void);
+  bool breakLine(uint16_t start, uint16_t len, int16_t width, bool more);
+  void cutLine(uint16_t start);
+  int16_t fit(uint16_t start, int16_t limit, uint16_t *len, int32_t *prev);
+  int16_t measure(uint16_t from, uint16_t to, int32_t *prev);
+  int16_t advance(uint32_t c, int32_t *prev);
+  int16_t drawChar(int16_t x, int16_t y, uint32_t c, int32_t *prev,
+                   uint16_t color, uint16_t bg);
+  int16_t lineX(const Line *l) const;
+  uint16_t lineHeight(void) const;
+
+  Adafruit_GFX *_gfx;           ///< Display or canvas drawn on
+  const char *_text;            ///< Text laid out, not a copy
+  const GFXfont *_font;         ///< Font, NULL for the classic font
+  Line _line[TEXTLAYOUT_LINES]; ///< Where the lines break
+  uint32_t _hash;               ///< Hash of the text, to spot changes
+  int16_t _x;                   ///< Left edge of the box
+  int16_t _y;                   ///< Top edge of the box
+  int16_t _w;                   ///< Width of the box
+  int16_t _h;                   ///< Height of the box
+  int16_t _ascent;              ///< Font's height above the baseline
+  uint8_t _size_x;              ///< Horizontal magnification
+  uint8_t _size_y;              ///< Vertical magnification
+  uint8_t _lines;               ///< Lines in use in _line
+  uint8_t _maxLines;            ///< Lines that fit the box
+  uint8_t _digitAdvance;        ///< Tabular digit cell width, 0 if off
+  textAlign _align;             ///< Line placement
+  bool _wrap;                   ///< Break lines at spaces
+  bool _ellipsis;               ///< End cut text with "..."
+  bool _tabular;                ///< Digits in equal cells
+  bool _truncated;              ///< Some text didn't fit
+  bool _dirty;                  ///< Line breaks must be found again
+};
+
+#endif // end __AVR_ATtiny85__
+#endif // end _ADAFRUIT_TEXTLAYOUT_H_
@@ -0,0 +1,195 @@
+/*!
+ * @file Adafruit_TileRenderer.cpp
+ *
+ * Part of Adafruit's GFX graphics library. Tiled (binned) compositor for
+ * display lists. See Adafruit_TileRenderer.h for usage.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_TileRenderer.h"
+
+/*!
+    @brief  Constructor. Buffers are not allocated until begin().
+    @param  tft          Display the tiles will be pushed to.
+    @param  tileWidth    Tile width in pixels.
+    @param  tileHeight   Tile height in pixels. Each tile buffer needs
+                         tileWidth * tileHeight * 2 bytes.
+    @param  maxCommands  Capacity of the display list, in commands (12
+                         bytes each including binning).
+    @param  numTiles     Number of tile buffers, 1 or 2 (default). 2
+                         overlaps drawing with transfer where DMA allows.
+*/
+Adafruit_TileRenderer::Adafruit_TileRenderer(Adafruit_SPITFT *tft,
+                                             uint16_t tileWidth,
+                                             uint16_t tileHeight,
+                                             uint16_t maxCommands,
+                                             uint8_t numTiles)
+    : Adafruit_DisplayList(tft, maxCommands), _tft(tft), _bin(NULL),
+      _tileWidth(tileWidth ? tileWidth : 1),
+      _tileHeight(tileHeight ? tileHeight : 1), _background(0),
+      _numTiles((numTiles > 1) ? 2 : 1), _direct(false) {
+  _tile[0] = _tile[1] = NULL;
+}
+
+/*!
+    @brief  Destructor, frees tile and binning buffers.
+*/
+Adafruit_TileRenderer::~Adafruit_TileRenderer(void) {
+  delete _tile[0];
+  delete _tile[1];
+  free(_bin);
+}
+
+/*!
+    @brief   Allocate the display list, tile and binning buffers. Call
+             after the display's begin() and setRotation().
+    @return  true on success, false if anything couldn't be allocated.
+             Primitives then go straight to the display.
+*/
+bool Adafruit_TileRenderer::begin(void) {
+  _direct = false;
+  for (uint8_t i = 0; i < _numTiles; i++) {
+    if (!_tile[i]) {
+#if defined(SPITFT_PRESWAP)
+      _tile[i] = new GFXcanvas16(_tileWidth, _tileHeight, true);
+#else
+      _tile[i] = new GFXcanvas16(_tileWidth, _tileHeight);
+#endif
+    }
+  }
+  if (!_bin)
+    _bin = (uint16_t *)malloc(_max * sizeof(uint16_t));
+  bool ok = _bin;
+  for (uint8_t i = 0; i < _numTiles; i++)
+    ok = ok && _tile[i] && _tile[i]->getBuffer();
+  if (!Adafruit_DisplayList::begin() || !ok) {
+    free(_list); // Keep rendering from ever using a partial setup
+    _list = NULL;
+    return false;
+  }
+  return true;
+}
+
+/*!
+    @brief  Composite and push the recorded frame, then empty the list.
+            After an overflow earlier in the frame, the rest of the frame
+            is issued directly instead.
+*/
+void Adafruit_TileRenderer::flush(void) {
+  if (_direct) {
+    _direct = false;
+    Adafruit_DisplayList::flush();
+  } else if (_count) {
+    renderTiles();
+    _count = 0;
+  }
+}
+
+/*!
+    @brief  List is full mid-frame. The first time, push what's recorded
+            as tiles (tiles repaint every pixel, so they can only go out
+            once per frame); after that, issue commands directly.
+*/
+void Adafruit_TileRenderer::overflow(void) {
+  if (_direct) {
+    Adafruit_DisplayList::flush();
+  } else {
+    renderTiles();
+    _count = 0;
+    _direct = true;
+  }
+}
+
+/*!
+    @brief  Replay the list into each tile of the screen in turn and push
+            it to the display.
+*/
+void Adafruit_TileRenderer::renderTiles(void) {
+  if (!_bin || !_tile[0] || !_tile[_numTiles - 1])
+    return; // Not set up by this class's begin()
+  compact();
+  uint8_t idx = 0;
+  _tft->startWrite();
+  for (int16_t ty = 0; ty < _height; ty += _tileHeight) {
+    int16_t th = _height - ty;
+    if (th > (int16_t)_tileHeight)
+      th = _tileHeight;
+    int16_t ty2 = ty + th - 1;
+    // Bin: commands overlapping this row of tiles, in drawing order
+    uint16_t n = 0;
+    for (uint16_t i = 0; i < _count; i++) {
+      if ((_list[i].y <= ty2) && (_list[i].y + _list[i].h > ty))
+        _bin[n++] = i;
+    }
+    for (int16_t tx = 0; tx < _width; tx += _tileWidth) {
+      int16_t tw = _width - tx;
+      if (tw > (int16_t)_tileWidth)
+        tw = _tileWidth;
+      int16_t tx2 = tx + tw - 1;
+      GFXcanvas16 *tile = _tile[idx];
+      if (_numTiles == 1)
+        _tft->dmaWait(); // Sole buffer may still be in flight
+      // Anything before the last command covering the whole tile is
+      // hidden by it, so replay starts there (or with a cleared tile).
+      uint16_t first = 0;
+      bool covered = false;
+      for (uint16_t k = n; k--;) {
+        DLcommand *c = &_list[_bin[k]];
+        if ((c->x <= tx) && (c->y <= ty) && (c->x + c->w > tx2) &&
+            (c->y + c->h > ty2)) {
+          first = k;
+          covered = true;
+          break;
+        }
+      }
+      if (!covered)
+        tile->fillScreen(_background);
+      for (uint16_t k = first; k < n; k++) {
+        DLcommand *c = &_list[_bin[k]];
+        if ((c->x > tx2) || (c->x + c->w <= tx))
+          continue; // Same row of tiles, different column
+        if ((c->w == 1) && (c->h == 1))
+          tile->drawPixel(c->x - tx, c->y - ty, c->color);
+        else
+          tile->fillRect(c->x - tx, c->y - ty, c->w, c->h, c->color);
+      }
+      pushTile(tile, tx, ty, tw, th);
+      idx = (idx + 1) % _numTiles;
+    }
+  }
+  _tft->dmaWait();
+  _tft->endWrite();
+}
+
+/*!
+    @brief  Issue one finished tile. Returns as soon as the transfer is
+            under way where DMA permits.
+    @param  tile  Tile canvas; row 0, column 0 is screen pixel (x,y).
+    @param  x     Screen column of tile's left edge.
+    @param  y     Screen row of tile's top edge.
+    @param  w     Columns of the tile on screen (less than the tile width
+                  on the right edge of the screen).
+    @param  h     Rows of the tile on screen.
+*/
+void Adafruit_TileRenderer::pushTile(GFXcanvas16 *tile, int16_t x, int16_t y,
+                                     int16_t w, int16_t h) {
+  uint16_t *buf = tile->getBuffer();
+  bool bigEndian = tile->getBigEndian();
+  _tft->dmaWait(); // Prior tile must finish before addressing this one
+  _tft->writeAddrWindow(x, y, w, h);
+  if (w == (int16_t)_tileWidth) {
+    _tft->writePixels(buf, (uint32_t)w * h, false, bigEndian);
+  } else { // Partial tile, rows aren't contiguous in the buffer
+    for (int16_t row = 0; row < h; row++)
+      _tft->writePixels(&buf[row * _tileWidth], w, false, bigEndian);
+  }
+}
+
+#endif // end __AVR_ATtiny85__
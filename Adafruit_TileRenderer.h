@@ -0,0 +1,83 @@
+/*!
+ * @file Adafruit_TileRenderer.h
+ *
+ * Part of Adafruit's GFX graphics library. Composites a full frame
+ * recorded by Adafruit_DisplayList one small tile at a time, so large
+ * screens get flicker-free frames without a full-screen framebuffer.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_TILERENDERER_H_
+#define _ADAFRUIT_TILERENDERER_H_
+
+#if !defined(__AVR_ATtiny85__) // Not for ATtiny, at all
+
+#include "Adafruit_DisplayList.h"
+#include "Adafruit_SPITFT.h"
+
+/*!
+  @brief  A display list that, instead of issuing its commands straight
+          to the display, replays them into a small GFXcanvas16 tile for
+          each tile-sized area of the screen and pushes each finished
+          tile with one address window. Every screen pixel is written
+          exactly once per frame, so nothing is seen half-drawn. Typical
+          use:
+
+              Adafruit_TileRenderer tiles(&tft, 80, 64, 1024);
+              tiles.begin();            // After tft.setRotation()
+              tiles.fillScreen(BLACK);  // Draw the frame as usual...
+              tiles.fillCircle(240, 160, 100, RED);
+              tiles.print("Hello");
+              tiles.flush();            // ...then composite and push it
+
+          Commands are binned by tile row, then tested per tile against
+          their bounding boxes, so each tile only replays what touches
+          it, starting from the last command that covers it entirely.
+          Pixels no command touches get the background color.
+
+          If the frame needs more commands than the list holds, what has
+          been recorded is composited and pushed at that point, and the
+          remainder of the frame is drawn directly (still correct, just
+          not flicker-free). Size maxCommands for the busiest frame.
+
+          With two tile buffers (the default) and DMA, the next tile is
+          drawn while the prior one transfers.
+*/
+class Adafruit_TileRenderer : public Adafruit_DisplayList {
+public:
+  Adafruit_TileRenderer(Adafruit_SPITFT *tft, uint16_t tileWidth,
+                        uint16_t tileHeight, uint16_t maxCommands = 512,
+                        uint8_t numTiles = 2);
+  ~Adafruit_TileRenderer(void);
+  bool begin(void);
+  void flush(void);
+
+  /*!
+    @brief  Set the color of pixels no recorded command touches.
+    @param  color  16-bit color, default is 0 (black).
+  */
+  void setBackground(uint16_t color) { _background = color; }
+
+protected:
+  void overflow(void);
+  void renderTiles(void);
+  void pushTile(GFXcanvas16 *tile, int16_t x, int16_t y, int16_t w,
+                int16_t h);
+
+  Adafruit_SPITFT *_tft;   ///< Display tiles are pushed to
+  GFXcanvas16 *_tile[2];   ///< Tile buffers
+  uint16_t *_bin;          ///< Indices of commands in current tile row
+  uint16_t _tileWidth;     ///< Tile width in pixels
+  uint16_t _tileHeight;    ///< Tile height in pixels
+  uint16_t _background;    ///< Color of untouched pixels
+  uint8_t _numTiles;       ///< # of tile buffers, 1 or 2
+  bool _direct;            ///< true once an overflow went out as tiles
+};
+
+#endif // end __AVR_ATtiny85__
+#endif // end _ADAFRUIT_TILERENDERER_H_
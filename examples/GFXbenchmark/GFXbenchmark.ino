@@ -0,0 +1,454 @@
+/***************************************************
+  Reproducible benchmark suite for Adafruit_GFX targets.
+
+  Runs the same set of primitive tests as the mock_ili9341 example against
+  any Adafruit_GFX subclass -- a GFXcanvas1/8/16 needs no display hardware
+  at all -- and prints one CSV line per primitive:
+
+    target,primitive,reps,usec,pixels,pixels_per_sec,bus_bytes
+
+  usec is the fastest of BENCH_REPS runs. pixels and bus_bytes come from a
+  counting pass over the same drawing calls, so they are identical on every
+  board and target of the same size: pixels is the number of on-screen
+  pixels the primitive writes, bus_bytes is the SPI traffic the generic
+  Adafruit_SPITFT path would generate for it (an address window of
+  BENCH_WINDOW_BYTES per rectangle or single pixel, plus 2 bytes per pixel).
+  Comparing bus_bytes against pixels*2 shows how much of a primitive's cost
+  is addressing overhead rather than pixel data.
+
+  Lines starting with '#' are comments for human readers.
+
+  The canvas targets also build for the desktop (see the host folder),
+  where usec is measured on the host CPU, and where if BENCH_SNAPSHOTS is
+  set in the environment each primitive's final frame is saved as a
+  PBM/PGM/PPM image in the directory it names, so renderings can be
+  compared byte for byte before and after a change.
+
+  Adafruit invests time and resources providing this open source code,
+  please support Adafruit and open-source hardware by purchasing
+  products from Adafruit!
+
+  BSD license, all text above must be included in any redistribution.
+ ****************************************************/
+
+#include "Adafruit_GFX.h"
+
+// Target to benchmark: 1, 8 or 16 for a GFXcanvas1/8/16 of BENCH_WIDTH x
+// BENCH_HEIGHT, or 9341 for an Adafruit ILI9341 display on hardware SPI.
+#ifndef BENCH_TARGET
+#define BENCH_TARGET 16
+#endif
+#ifndef BENCH_REPS
+#define BENCH_REPS 3 // Runs per primitive; the fastest is reported
+#endif
+// Bytes per address window: CASET + 4 args, PASET + 4 args, RAMWR.
+#define BENCH_WINDOW_BYTES 11
+
+#if BENCH_TARGET == 9341
+#include "SPI.h"
+#include "Adafruit_ILI9341.h"
+#define TFT_DC 9
+#define TFT_CS 10
+#define BENCH_WIDTH ILI9341_TFTWIDTH
+#define BENCH_HEIGHT ILI9341_TFTHEIGHT
+#define BENCH_NAME "Adafruit_ILI9341"
+Adafruit_ILI9341 target(TFT_CS, TFT_DC);
+#else
+// Canvas size; keep it within the board's RAM (a 128x128 GFXcanvas16
+// needs 32 KB, a GFXcanvas1 of the same size only 2 KB).
+#ifndef BENCH_WIDTH
+#define BENCH_WIDTH 128
+#endif
+#ifndef BENCH_HEIGHT
+#define BENCH_HEIGHT 128
+#endif
+#if BENCH_TARGET == 1
+#define BENCH_NAME "GFXcanvas1"
+GFXcanvas1 target(BENCH_WIDTH, BENCH_HEIGHT);
+#elif BENCH_TARGET == 8
+#define BENCH_NAME "GFXcanvas8"
+GFXcanvas8 target(BENCH_WIDTH, BENCH_HEIGHT);
+#else
+#define BENCH_NAME "GFXcanvas16"
+GFXcanvas16 target(BENCH_WIDTH, BENCH_HEIGHT);
+#endif
+#endif
+
+#define BLACK 0x0000
+#define BLUE 0x001F
+#define RED 0xF800
+#define GREEN 0x07E0
+#define CYAN 0x07FF
+#define MAGENTA 0xF81F
+#define YELLOW 0xFFE0
+#define WHITE 0xFFFF
+
+// Pack 8-bit R,G,B into 5-6-5 format (Adafruit_GFX itself has no color565)
+static uint16_t rgb(uint8_t r, uint8_t g, uint8_t b) {
+  return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+// Stand-in display that draws nothing, only tallying the pixels and bus
+// bytes Adafruit_SPITFT would send for each call. Overrides the same
+// functions Adafruit_SPITFT does, with the same clipping, so primitives
+// decompose into exactly the writes a real display would receive.
+class BusCounter : public Adafruit_GFX {
+public:
+  BusCounter(int16_t w, int16_t h) : Adafruit_GFX(w, h) {}
+  void drawPixel(int16_t x, int16_t y, uint16_t color) { rect(x, y, 1, 1); }
+  void writePixel(int16_t x, int16_t y, uint16_t color) { rect(x, y, 1, 1); }
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color) {
+    rect(x, y, w, h);
+  }
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    rect(x, y, w, 1);
+  }
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    rect(x, y, 1, h);
+  }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    rect(x, y, w, h);
+  }
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    rect(x, y, w, 1);
+  }
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    rect(x, y, 1, h);
+  }
+
+  bool counting = false; // Only tally while a test's timer is running
+  uint32_t pixels = 0;   // On-screen pixels written
+  uint32_t bytes = 0;    // Modeled SPI bytes
+
+private:
+  void rect(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (!counting)
+      return;
+    if (w < 0) { // Negative extents are flipped, as in Adafruit_SPITFT
+      x += w + 1;
+      w = -w;
+    }
+    if (h < 0) {
+      y += h + 1;
+      h = -h;
+    }
+    int32_t x2 = (int32_t)x + w, y2 = (int32_t)y + h;
+    if (x < 0)
+      x = 0;
+    if (y < 0)
+      y = 0;
+    if (x2 > _width)
+      x2 = _width;
+    if (y2 > _height)
+      y2 = _height;
+    if ((x2 <= x) || (y2 <= y))
+      return;
+    uint32_t n = (uint32_t)(x2 - x) * (y2 - y);
+    pixels += n;
+    bytes += BENCH_WINDOW_BYTES + n * 2;
+  }
+};
+
+BusCounter counter(BENCH_WIDTH, BENCH_HEIGHT);
+
+void testFillScreen(Adafruit_GFX &g);
+void testText(Adafruit_GFX &g);
+void testLines(Adafruit_GFX &g);
+void testFastLines(Adafruit_GFX &g);
+void testRects(Adafruit_GFX &g);
+void testFilledRects(Adafruit_GFX &g);
+void testFilledCircles(Adafruit_GFX &g);
+void testCircles(Adafruit_GFX &g);
+void testTriangles(Adafruit_GFX &g);
+void testFilledTriangles(Adafruit_GFX &g);
+void testRoundRects(Adafruit_GFX &g);
+void testFilledRoundRects(Adafruit_GFX &g);
+
+#if defined(GFX_HOST) && (BENCH_TARGET != 9341)
+#include <stdio.h>
+
+// Save the target canvas as a netpbm image named for the primitive:
+// binary PBM for GFXcanvas1, PGM of the raw bytes for GFXcanvas8, PPM
+// for GFXcanvas16. Nothing is saved unless BENCH_SNAPSHOTS names a
+// directory.
+static void snapshot(const __FlashStringHelper *name) {
+  const char *dir = getenv("BENCH_SNAPSHOTS");
+  if (!dir)
+    return;
+  char path[256];
+  snprintf(path, sizeof path, "%s/%s_%s.%s", dir, BENCH_NAME,
+           (const char *)name,
+           (BENCH_TARGET == 1) ? "pbm" : (BENCH_TARGET == 8) ? "pgm" : "ppm");
+  FILE *f = fopen(path, "wb");
+  if (!f)
+    return;
+  int16_t w = target.width(), h = target.height();
+#if BENCH_TARGET == 1
+  // Buffer rows are already PBM rows, but PBM's 1 is black
+  fprintf(f, "P4\n%d %d\n", w, h);
+  const uint8_t *buf = target.getBuffer();
+  for (uint32_t i = 0, n = (uint32_t)((w + 7) / 8) * h; i < n; i++)
+    fputc(~buf[i], f);
+#elif BENCH_TARGET == 8
+  fprintf(f, "P5\n%d %d\n255\n", w, h);
+  fwrite(target.getBuffer(), 1, (size_t)w * h, f);
+#else
+  fprintf(f, "P6\n%d %d\n255\n", w, h);
+  for (int16_t y = 0; y < h; y++) {
+    for (int16_t x = 0; x < w; x++) { // 5-6-5 widened to 8 bits a channel
+      uint16_t c = target.getPixel(x, y);
+      fputc(((c >> 8) & 0xF8) | (c >> 13), f);
+      fputc(((c >> 3) & 0xFC) | ((c >> 9) & 0x03), f);
+      fputc(((c << 3) & 0xF8) | ((c >> 2) & 0x07), f);
+    }
+  }
+#endif
+  fclose(f);
+}
+#else
+static void snapshot(const __FlashStringHelper *name) {}
+#endif
+
+// Tests bracket the part of their drawing that counts toward the result
+// with timerStart()/timerStop(); setup such as clearing the screen falls
+// outside and is neither timed nor tallied.
+static unsigned long elapsed, started;
+
+static void timerStart(void) {
+  counter.counting = true;
+  started = micros();
+}
+
+static void timerStop(void) {
+  elapsed += micros() - started;
+  counter.counting = false;
+}
+
+// Run one test on the counter, then BENCH_REPS times on the target, and
+// print its CSV line.
+static void bench(const __FlashStringHelper *name,
+                  void (*test)(Adafruit_GFX &)) {
+  counter.pixels = counter.bytes = 0;
+  test(counter);
+
+  unsigned long best = 0;
+  for (uint8_t rep = 0; rep < BENCH_REPS; rep++) {
+    elapsed = 0;
+    test(target);
+    if (!rep || (elapsed < best))
+      best = elapsed;
+    yield();
+  }
+  snapshot(name);
+
+  Serial.print(F(BENCH_NAME ","));
+  Serial.print(name);
+  Serial.print(',');
+  Serial.print(BENCH_REPS);
+  Serial.print(',');
+  Serial.print(best);
+  Serial.print(',');
+  Serial.print(counter.pixels);
+  Serial.print(',');
+  // Pixels per second; 0 if the primitive ran below timer resolution
+  Serial.print(best ? (float)counter.pixels * 1000000.0 / best : 0.0, 0);
+  Serial.print(',');
+  Serial.println(counter.bytes);
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10);
+
+#if BENCH_TARGET == 9341
+  target.begin();
+#endif
+
+  Serial.print(F("# GFXbenchmark " BENCH_NAME " "));
+  Serial.print(target.width());
+  Serial.print('x');
+  Serial.println(target.height());
+  Serial.println(F("target,primitive,reps,usec,pixels,pixels_per_sec,"
+                   "bus_bytes"));
+
+  bench(F("fill_screen"), testFillScreen);
+  bench(F("text"), testText);
+  bench(F("lines"), testLines);
+  bench(F("hv_lines"), testFastLines);
+  bench(F("rects"), testRects);
+  bench(F("filled_rects"), testFilledRects);
+  bench(F("filled_circles"), testFilledCircles);
+  bench(F("circles"), testCircles);
+  bench(F("triangles"), testTriangles);
+  bench(F("filled_triangles"), testFilledTriangles);
+  bench(F("round_rects"), testRoundRects);
+  bench(F("filled_round_rects"), testFilledRoundRects);
+
+  Serial.println(F("# done"));
+}
+
+void loop() {}
+
+void testFillScreen(Adafruit_GFX &g) {
+  timerStart();
+  g.fillScreen(BLACK);
+  g.fillScreen(RED);
+  g.fillScreen(GREEN);
+  g.fillScreen(BLUE);
+  g.fillScreen(BLACK);
+  timerStop();
+}
+
+void testText(Adafruit_GFX &g) {
+  g.fillScreen(BLACK);
+  timerStart();
+  g.setCursor(0, 0);
+  g.setTextColor(WHITE);
+  g.setTextSize(1);
+  g.println("Hello World!");
+  g.setTextColor(YELLOW);
+  g.setTextSize(2);
+  g.println(1234.56);
+  g.setTextColor(RED);
+  g.setTextSize(3);
+  g.println(0xDEADBEEF, HEX);
+  g.println();
+  g.setTextColor(GREEN);
+  g.setTextSize(5);
+  g.println("Groop");
+  g.setTextSize(2);
+  g.println("I implore thee,");
+  g.setTextSize(1);
+  g.println("my foonting turlingdromes.");
+  g.println("And hooptiously drangle me");
+  g.println("with crinkly bindlewurdles,");
+  g.println("Or I will rend thee");
+  g.println("in the gobberwarts");
+  g.println("with my blurglecruncheon,");
+  g.println("see if I don't!");
+  timerStop();
+}
+
+// Fan of lines from one corner to the far edges
+static void lineFan(Adafruit_GFX &g, int x1, int y1, int x2, int y2) {
+  int w = g.width(), h = g.height(), x, y;
+  g.fillScreen(BLACK);
+  timerStart();
+  for (x = 0; x < w; x += 6)
+    g.drawLine(x1, y1, x, y2, CYAN);
+  for (y = 0; y < h; y += 6)
+    g.drawLine(x1, y1, x2, y, CYAN);
+  timerStop();
+}
+
+void testLines(Adafruit_GFX &g) {
+  int w = g.width(), h = g.height();
+  lineFan(g, 0, 0, w - 1, h - 1);
+  lineFan(g, w - 1, 0, 0, h - 1);
+  lineFan(g, 0, h - 1, w - 1, 0);
+  lineFan(g, w - 1, h - 1, 0, 0);
+}
+
+void testFastLines(Adafruit_GFX &g) {
+  int x, y, w = g.width(), h = g.height();
+  g.fillScreen(BLACK);
+  timerStart();
+  for (y = 0; y < h; y += 5)
+    g.drawFastHLine(0, y, w, RED);
+  for (x = 0; x < w; x += 5)
+    g.drawFastVLine(x, 0, h, BLUE);
+  timerStop();
+}
+
+void testRects(Adafruit_GFX &g) {
+  int n = min(g.width(), g.height()), i, i2, cx = g.width() / 2,
+      cy = g.height() / 2;
+  g.fillScreen(BLACK);
+  timerStart();
+  for (i = 2; i < n; i += 6) {
+    i2 = i / 2;
+    g.drawRect(cx - i2, cy - i2, i, i, GREEN);
+  }
+  timerStop();
+}
+
+void testFilledRects(Adafruit_GFX &g) {
+  int n = min(g.width(), g.height()), i, i2, cx = g.width() / 2 - 1,
+      cy = g.height() / 2 - 1;
+  g.fillScreen(BLACK);
+  for (i = n; i > 0; i -= 6) {
+    i2 = i / 2;
+    timerStart();
+    g.fillRect(cx - i2, cy - i2, i, i, YELLOW);
+    timerStop();
+    // Outlines are not included in results
+    g.drawRect(cx - i2, cy - i2, i, i, MAGENTA);
+  }
+}
+
+void testFilledCircles(Adafruit_GFX &g) {
+  int x, y, w = g.width(), h = g.height();
+  g.fillScreen(BLACK);
+  timerStart();
+  for (x = 10; x < w; x += 20)
+    for (y = 10; y < h; y += 20)
+      g.fillCircle(x, y, 10, MAGENTA);
+  timerStop();
+}
+
+void testCircles(Adafruit_GFX &g) {
+  int x, y, w = g.width() + 10, h = g.height() + 10;
+  g.fillScreen(BLACK);
+  timerStart();
+  for (x = 0; x < w; x += 20)
+    for (y = 0; y < h; y += 20)
+      g.drawCircle(x, y, 10, WHITE);
+  timerStop();
+}
+
+void testTriangles(Adafruit_GFX &g) {
+  int i, cx = g.width() / 2 - 1, cy = g.height() / 2 - 1, n = min(cx, cy);
+  g.fillScreen(BLACK);
+  timerStart();
+  for (i = 0; i < n; i += 5)
+    g.drawTriangle(cx, cy - i, cx - i, cy + i, cx + i, cy + i, rgb(i, i, i));
+  timerStop();
+}
+
+void testFilledTriangles(Adafruit_GFX &g) {
+  int i, cx = g.width() / 2 - 1, cy = g.height() / 2 - 1;
+  g.fillScreen(BLACK);
+  for (i = min(cx, cy); i > 10; i -= 5) {
+    timerStart();
+    g.fillTriangle(cx, cy - i, cx - i, cy + i, cx + i, cy + i,
+                   rgb(0, i * 10, i * 10));
+    timerStop();
+    g.drawTriangle(cx, cy - i, cx - i, cy + i, cx + i, cy + i,
+                   rgb(i * 10, i * 10, 0));
+  }
+}
+
+void testRoundRects(Adafruit_GFX &g) {
+  int w = min(g.width(), g.height()), i, i2, cx = g.width() / 2 - 1,
+      cy = g.height() / 2 - 1;
+  g.fillScreen(BLACK);
+  timerStart();
+  for (i = 0; i < w; i += 6) {
+    i2 = i / 2;
+    g.drawRoundRect(cx - i2, cy - i2, i, i, i / 8, rgb(i, 0, 0));
+  }
+  timerStop();
+}
+
+void testFilledRoundRects(Adafruit_GFX &g) {
+  int i, i2, cx = g.width() / 2 - 1, cy = g.height() / 2 - 1;
+  g.fillScreen(BLACK);
+  timerStart();
+  for (i = min(g.width(), g.height()); i > 20; i -= 6) {
+    i2 = i / 2;
+    g.fillRoundRect(cx - i2, cy - i2, i, i, i / 8, rgb(0, i, 0));
+  }
+  timerStop();
+}
@@ -8,11 +8,54 @@ fonts to be used with the Adafruit_GFX Arduino library.
 For UNIX-like systems.  Outputs to stdout; redirect to header file, e.g.:
   ./fontconvert ~/Library/Fonts/FreeSans.ttf 18 > FreeSans18pt7b.h
 
-REQUIRES FREETYPE LIBRARY.  www.freetype.org
+Add -rle before the filename to emit run-length encoded glyph bitmaps
+(GFXFONT_RLE), typically much smaller for larger point sizes; table
+names then get an "RLE" suffix so both variants can coexist, e.g.:
+  ./fontconvert -rle ~/Library/Fonts/FreeSans.ttf 24 > FreeSans24pt7bRLE.h
+
+Or -aa2 / -aa4 for anti-aliased glyphs (GFXFONT_AA2 / GFXFONT_AA4) with
+2 or 4 bits of coverage per pixel, blended against the text background
+color when drawn; table names get an "AA2" or "AA4" suffix.
+
+Without other options this extracts the printable 7-bit ASCII chars of
+a font (or the given first to last).  For international text, -u and/or
+-t choose any set of Unicode characters instead, making an extended font
+(with a GFXrange table) that's printed as UTF-8.  -u takes a list of
+codepoints and ranges, -t a UTF-8 text file whose characters are all
+included (e.g. a sketch's translated strings, so only the glyphs it can
+show take up flash); either may be repeated.  Characters the font lacks
+are skipped.  Table names get a "U" in place of the 7/8 bits, e.g.:
+  ./fontconvert -u 0x20-0x7E,0x410-0x44F FreeSans.ttf 9 > FreeSans9ptU.h
+
+Add -k to include the font's kerning pairs (from its 'kern' table; GPOS
+kerning isn't read by FreeType's FT_Get_Kerning) so printed text gets the
+designer's spacing; adds about 4 bytes per pair plus 2 per glyph.
+
+Add -b file to also write the font as a binary file, for loading at run
+time with Adafruit_FontFile from a filesystem or memory-mapped external
+flash instead of compiling it in.  Format (all little-endian, sections
+4-byte aligned, struct layouts as on 32-bit Arduino targets):
+  20-byte header: "GFXF", version 1, format, first, last, yAdvance, 0,
+    uint16 glyph count, uint16 range count, uint16 kerning pair count,
+    uint32 bitmap bytes
+  GFXrange table (extended fonts), 8 bytes per range
+  GFXglyph table, 8 bytes per glyph (7 + 1 pad)
+  If kerning pairs: uint16 kernIndex table (padded to 4 bytes), then
+    GFXkernPair table, 4 bytes per pair (3 + 1 pad)
+  Glyph bitmaps
+
+Or convert several fonts (sizes, styles...) in one run with -p name, each
+as "fontfile size" following the options, into one header holding a
+font pack: one shared bitmap table, "nameBitmaps", in which glyphs that
+come out identical (punctuation across sizes, the same shapes in
+different styles, Latin-lookalike Cyrillic...) are stored once.  The
+fonts keep their usual names, e.g.:
+  ./fontconvert -p FreeSansPack FreeSans.ttf 9 FreeSans.ttf 12 \
+    FreeSansBold.ttf 9 > FreeSansPack.h
+As bitmap offsets are 16 bits, a pack's bitmaps must fit in 64K.  The
+options apply to all the fonts; -b and first/last chars aren't allowed.
 
-Currently this only extracts the printable 7-bit ASCII chars of a font.
-Will eventually extend with some int'l chars a la ftGFX, not there yet.
-Keep 7-bit fonts around as an option in that case, more compact.
+REQUIRES FREETYPE LIBRARY.  www.freetype.org
 
 See notes at end for glyph nomenclature & other tidbits.
 */
@@ -22,80 +65,201 @@ See notes at end for glyph nomenclature & other tidbits.
 #include <ft2build.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include FT_GLYPH_H
 #include FT_TRUETYPE_DRIVER_H
 #include "../gfxfont.h" // Adafruit_GFX font structures
 
 #define DPI 141 // Approximate res. of Adafruit 2.8" TFT
 
-// Accumulate bits for output, with periodic hexadecimal byte write
+#define MAX_CODEPOINT 0x10FFFF
+
+static uint8_t *bits = NULL; // Copy of bitmap bytes output, for -b
+static int bitsLen = 0, bitsAllocated = 0;
+
+static uint8_t wanted[(MAX_CODEPOINT + 8) / 8]; // Bit per codepoint for -u/-t
+
+// Mark codepoint for output
+void want(long c) {
+  if ((c >= 0) && (c <= MAX_CODEPOINT))
+    wanted[c >> 3] |= 0x80 >> (c & 7);
+}
+
+// Mark each codepoint and range in a list such as "0x20-0x7E,0x20AC"
+int wantList(const char *list) {
+  char *end;
+  while (*list) {
+    long a = strtol(list, &end, 0), b = a;
+    if (end == list)
+      return 0;
+    if (*end == '-') {
+      list = end + 1;
+      b = strtol(list, &end, 0);
+      if (end == list)
+        return 0;
+    }
+    for (; a <= b; a++)
+      want(a);
+    if (*end == ',')
+      end++;
+    else if (*end)
+      return 0;
+    list = end;
+  }
+  return 1;
+}
+
+// Mark every character in a UTF-8 text file (not line breaks & such)
+int wantText(const char *filename) {
+  FILE *fp = fopen(filename, "rb");
+  long code = 0;
+  int b, need = 0;
+  if (!fp)
+    return 0;
+  while ((b = fgetc(fp)) != EOF) {
+    if (b < 0x80) {
+      need = 0;
+      if (b >= ' ')
+        want(b);
+    } else if (b < 0xC0) { // Continuation byte
+      if (need) {
+        code = (code << 6) | (b & 0x3F);
+        if (!--need)
+          want(code);
+      }
+    } else if (b < 0xF8) { // Lead byte
+      need = (b >= 0xF0) ? 3 : (b >= 0xE0) ? 2 : 1;
+      code = b & (0x3F >> need);
+    }
+  }
+  fclose(fp);
+  return 1;
+}
+
+// Accumulate bits for output (bitmap bytes are printed once all glyphs
+// are done, see printBitmaps())
 void enbit(uint8_t value) {
-  static uint8_t row = 0, sum = 0, bit = 0x80, firstCall = 1;
+  static uint8_t sum = 0, bit = 0x80;
   if (value)
-    sum |= bit;          // Set bit if needed
-  if (!(bit >>= 1)) {    // Advance to next bit, end of byte reached?
-    if (!firstCall) {    // Format output table nicely
-      if (++row >= 12) { // Last entry on line?
-        printf(",\n  "); //   Newline format output
-        row = 0;         //   Reset row counter
-      } else {           // Not end of line
-        printf(", ");    //   Simple comma delim
+    sum |= bit;       // Set bit if needed
+  if (!(bit >>= 1)) { // Advance to next bit, end of byte reached?
+    if (bitsLen == bitsAllocated) {
+      bitsAllocated = bitsAllocated ? bitsAllocated * 2 : 4096;
+      if (!(bits = realloc(bits, bitsAllocated))) {
+        fprintf(stderr, "Malloc error\n");
+        exit(1);
       }
     }
-    printf("0x%02X", sum); // Write byte value
-    sum = 0;               // Clear for next byte
-    bit = 0x80;            // Reset bit counter
-    firstCall = 0;         // Formatting flag
+    bits[bitsLen++] = sum;
+    sum = 0;    // Clear for next byte
+    bit = 0x80; // Reset bit counter
   }
 }
 
-int main(int argc, char *argv[]) {
-  int i, j, err, size, first = ' ', last = '~', bitmapOffset = 0, x, y, byte;
-  char *fontName, c, *ptr;
-  FT_Library library;
-  FT_Face face;
-  FT_Glyph glyph;
-  FT_Bitmap *bitmap;
-  FT_BitmapGlyphRec *g;
-  GFXglyph *table;
-  uint8_t bit;
+// Binary file output (-b), little-endian
+void put8(FILE *fp, int v) { fputc(v & 0xFF, fp); }
 
-  // Parse command line.  Valid syntaxes are:
-  //   fontconvert [filename] [size]
-  //   fontconvert [filename] [size] [last char]
-  //   fontconvert [filename] [size] [first char] [last char]
-  // Unless overridden, default first and last chars are
-  // ' ' (space) and '~', respectively
+void put16(FILE *fp, int v) {
+  put8(fp, v);
+  put8(fp, v >> 8);
+}
 
-  if (argc < 3) {
-    fprintf(stderr, "Usage: %s fontfile size [first] [last]\n", argv[0]);
-    return 1;
-  }
+void put32(FILE *fp, long v) {
+  put16(fp, v);
+  put16(fp, v >> 16);
+}
 
-  size = atoi(argv[2]);
+// Accumulate one 4-bit value for output (via enbit())
+void ennibble(uint8_t value) {
+  for (uint8_t bit = 0x08; bit; bit >>= 1)
+    enbit(value & bit);
+}
 
-  if (argc == 4) {
-    last = atoi(argv[3]);
-  } else if (argc == 5) {
-    first = atoi(argv[3]);
-    last = atoi(argv[4]);
-  }
+// Output one GFXFONT_RLE run length; returns # of nibbles written
+int enrun(int len) {
+  int n = 1;
+  for (; len >= 15; len -= 15, n++) // 15 means 'add 15, keep reading'
+    ennibble(15);
+  ennibble(len);
+  return n;
+}
 
-  if (last < first) {
-    i = first;
-    first = last;
-    last = i;
+// Glyph bitmaps already output in a pack (-p), for sharing identical ones
+static struct {
+  int offset, len;
+  uint32_t hash;
+} *pool = NULL;
+static int poolCount = 0, poolAllocated = 0, sharedBytes = 0;
+
+// Share the glyph bitmap just output (bits[offset] to the end) with an
+// identical earlier one if there is one; returns the offset to use
+int shareBitmap(int offset) {
+  int i, len = bitsLen - offset;
+  uint32_t hash = 2166136261u; // FNV-1a
+  if (!len)
+    return offset;
+  for (i = offset; i < bitsLen; i++)
+    hash = (hash ^ bits[i]) * 16777619u;
+  for (i = 0; i < poolCount; i++) {
+    if ((pool[i].hash == hash) && (pool[i].len == len) &&
+        !memcmp(&bits[pool[i].offset], &bits[offset], len)) {
+      bitsLen = offset; // Drop the copy
+      sharedBytes += len;
+      return pool[i].offset;
+    }
   }
+  if (poolCount == poolAllocated) {
+    poolAllocated = poolAllocated ? poolAllocated * 2 : 1024;
+    if (!(pool = realloc(pool, poolAllocated * sizeof(*pool)))) {
+      fprintf(stderr, "Malloc error\n");
+      exit(1);
+    }
+  }
+  pool[poolCount].offset = offset;
+  pool[poolCount].len = len;
+  pool[poolCount++].hash = hash;
+  return offset;
+}
+
+// Output options, apply to every font converted
+static int rle = 0, bpp = 1; // bpp > 1 for anti-aliased output
+static int extended = 0, kern = 0, pack = 0;
+
+// One converted font, its bitmaps in bits[]
+typedef struct {
+  char *name;             // Table name prefix, e.g. FreeSans9pt7b
+  long *codes;            // Characters output, ascending
+  GFXglyph *table;        // Glyph for each of codes[]
+  uint16_t *kernIndex;    // Index of each glyph's first kerning pair
+  GFXkernPair *kernPairs; // Kerning pairs, 0 if none
+  int first, last, count, ranges, pairs, yAdvance, bytes;
+} Font;
+
+// Render a font's glyphs into bits[]; returns 0 on success
+int convert(FT_Library library, Font *font, const char *filename,
+            int size) {
+  int i, j, err, x, y, byte, skipped = 0, bitmapOffset, start;
+  int first = font->first, last = font->last, count = 0, ranges = 0;
+  long *codes;
+  char *fontName, c;
+  const char *ptr;
+  FT_Face face;
+  FT_Glyph glyph;
+  FT_Bitmap *bitmap;
+  FT_BitmapGlyphRec *g;
+  GFXglyph *table;
+  uint8_t bit;
 
-  ptr = strrchr(argv[1], '/'); // Find last slash in filename
+  ptr = strrchr(filename, '/'); // Find last slash in filename
   if (ptr)
     ptr++; // First character of filename (path stripped)
   else
-    ptr = argv[1]; // No path; font in local dir.
+    ptr = filename; // No path; font in local dir.
 
-  // Allocate space for font name and glyph table
-  if ((!(fontName = malloc(strlen(ptr) + 20))) ||
-      (!(table = (GFXglyph *)malloc((last - first + 1) * sizeof(GFXglyph))))) {
+  // Allocate space for font name (the glyph table comes once the font is
+  // loaded and the character count is known)
+  if (!(fontName = malloc(strlen(ptr) + 20))) {
     fprintf(stderr, "Malloc error\n");
     return 1;
   }
@@ -103,65 +267,89 @@ int main(int argc, char *argv[]) {
   // Derive font table names from filename.  Period (filename
   // extension) is truncated and replaced with the font size & bits.
   strcpy(fontName, ptr);
-  ptr = strrchr(fontName, '.'); // Find last period (file ext)
-  if (!ptr)
-    ptr = &fontName[strlen(fontName)]; // If none, append
+  char *ext = strrchr(fontName, '.'); // Find last period (file ext)
+  if (!ext)
+    ext = &fontName[strlen(fontName)]; // If none, append
   // Insert font size and 7/8 bit.  fontName was alloc'd w/extra
   // space to allow this, we're not sprintfing into Forbidden Zone.
-  sprintf(ptr, "%dpt%db", size, (last > 127) ? 8 : 7);
+  if (extended)
+    sprintf(ext, "%dptU", size);
+  else
+    sprintf(ext, "%dpt%db", size, (last > 127) ? 8 : 7);
+  strcat(ext, rle ? "RLE" : (bpp == 2) ? "AA2" : (bpp == 4) ? "AA4" : "");
   // Space and punctuation chars in name replaced w/ underscores.
   for (i = 0; (c = fontName[i]); i++) {
     if (isspace(c) || ispunct(c))
       fontName[i] = '_';
   }
 
-  // Init FreeType lib, load font
-  if ((err = FT_Init_FreeType(&library))) {
-    fprintf(stderr, "FreeType init error: %d", err);
-    return err;
-  }
-
-  // Use TrueType engine version 35, without subpixel rendering.
-  // This improves clarity of fonts since this library does not
-  // support rendering multiple levels of gray in a glyph.
-  // See https://github.com/adafruit/Adafruit-GFX-Library/issues/103
-  FT_UInt interpreter_version = TT_INTERPRETER_VERSION_35;
-  FT_Property_Set(library, "truetype", "interpreter-version",
-                  &interpreter_version);
-
-  if ((err = FT_New_Face(library, argv[1], 0, &face))) {
+  if ((err = FT_New_Face(library, filename, 0, &face))) {
     fprintf(stderr, "Font load error: %d", err);
-    FT_Done_FreeType(library);
     return err;
   }
 
   // << 6 because '26dot6' fixed-point format
   FT_Set_Char_Size(face, size << 6, 0, DPI, 0);
 
-  // Currently all symbols from 'first' to 'last' are processed.
-  // Fonts may contain WAY more glyphs than that, but this code
-  // will need to handle encoding stuff to deal with extracting
-  // the right symbols, and that's not done yet.
-  // fprintf(stderr, "%ld glyphs\n", face->num_glyphs);
-
-  printf("const uint8_t %sBitmaps[] PROGMEM = {\n  ", fontName);
+  // All symbols from 'first' to 'last' are processed, or for an
+  // extended font those requested that the font has (FreeType selects
+  // the face's Unicode charmap, if any, by default).  Each run of
+  // consecutive codepoints becomes one GFXrange.
+  if (!(codes = malloc(((extended ? MAX_CODEPOINT : last - first) + 1) *
+                       sizeof(long)))) {
+    fprintf(stderr, "Malloc error\n");
+    return 1;
+  }
+  if (extended) {
+    for (i = 0; i <= MAX_CODEPOINT; i++) {
+      if (wanted[i >> 3] & (0x80 >> (i & 7))) {
+        if (FT_Get_Char_Index(face, i)) {
+          if (!count || (codes[count - 1] != i - 1))
+            ranges++;
+          codes[count++] = i;
+        } else {
+          skipped++;
+        }
+      }
+    }
+    if (skipped)
+      fprintf(stderr, "%d characters not in font, skipped\n", skipped);
+    if (!count) {
+      fprintf(stderr, "No characters to output\n");
+      return 1;
+    }
+    first = last = 0;
+  } else {
+    for (i = first; i <= last; i++)
+      codes[count++] = i;
+  }
+  if (!(table = (GFXglyph *)malloc(count * sizeof(GFXglyph)))) {
+    fprintf(stderr, "Malloc error\n");
+    return 1;
+  }
 
-  // Process glyphs and output huge bitmap data array
-  for (i = first, j = 0; i <= last; i++, j++) {
+  // Process glyphs into bitmap data array
+  for (j = 0; j < count; j++) {
+    i = codes[j];
     // MONO renderer provides clean image with perfect crop
-    // (no wasted pixels) via bitmap struct.
-    if ((err = FT_Load_Char(face, i, FT_LOAD_TARGET_MONO))) {
-      fprintf(stderr, "Error %d loading char '%c'\n", err, i);
+    // (no wasted pixels) via bitmap struct.  NORMAL renderer
+    // (8-bit grayscale) likewise, used for anti-aliased output.
+    if ((err = FT_Load_Char(face, i,
+                            (bpp > 1) ? FT_LOAD_TARGET_NORMAL
+                                      : FT_LOAD_TARGET_MONO))) {
+      fprintf(stderr, "Error %d loading char 0x%02X\n", err, i);
       continue;
     }
 
-    if ((err = FT_Render_Glyph(face->glyph, FT_RENDER_MODE_MONO))) {
-      fprintf(stderr, "Error %d rendering char '%c'\n", err, i);
+    if ((err = FT_Render_Glyph(face->glyph, (bpp > 1)
+                                                ? FT_RENDER_MODE_NORMAL
+                                                : FT_RENDER_MODE_MONO))) {
+      fprintf(stderr, "Error %d rendering char 0x%02X\n", err, i);
       continue;
     }
 
     if ((err = FT_Get_Glyph(face->glyph, &glyph))) {
-      fprintf(stderr, "Error %d getting glyph '%c'\n", err, i);
+      fprintf(stderr, "Error %d getting glyph 0x%02X\n", err, i);
       continue;
     }
 
@@ -172,72 +360,447 @@ int main(int argc, char *argv[]) {
     // reduce flash space requirements.  Glyph bitmaps are
     // fully bit-packed; no per-scanline pad, though end of
     // each character may be padded to next byte boundary
-    // when needed.  16-bit offset means 64K max for bitmaps,
-    // code currently doesn't check for overflow.  (Doesn't
-    // check that size & offsets are within bounds either for
-    // that matter...please convert fonts responsibly.)
-    table[j].bitmapOffset = bitmapOffset;
+    // when needed.  16-bit offset means 64K max for bitmaps
+    // (of a whole pack, with -p); past that, convert fewer
+    // characters (or split them between fonts or packs).
+    // (Doesn't check that size & offsets are within
+    // bounds...please convert fonts responsibly.)
+    start = bitmapOffset = bitsLen;
+    if (bitmapOffset > 0xFFFF) {
+      fprintf(stderr, "Bitmaps exceed 64K at char 0x%02X\n", i);
+      return 1;
+    }
     table[j].width = bitmap->width;
     table[j].height = bitmap->rows;
     table[j].xAdvance = face->glyph->advance.x >> 6;
     table[j].xOffset = g->left;
     table[j].yOffset = 1 - g->top;
 
-    for (y = 0; y < bitmap->rows; y++) {
-      for (x = 0; x < bitmap->width; x++) {
-        byte = x / 8;
-        bit = 0x80 >> (x & 7);
-        enbit(bitmap->buffer[y * bitmap->pitch + byte] & bit);
+    if (bpp > 1) {
+      // Coverage values, bit-packed like 1-bit glyphs (MSB first, rows
+      // not padded), 8-bit gray scaled & rounded down to 2 or 4 bits.
+      int levels = (1 << bpp) - 1;
+      for (y = 0; y < bitmap->rows; y++) {
+        for (x = 0; x < bitmap->width; x++) {
+          int v = (bitmap->buffer[y * bitmap->pitch + x] * levels + 127) / 255;
+          for (bit = 1 << (bpp - 1); bit; bit >>= 1)
+            enbit(v & bit);
+        }
+      }
+      int n = (bitmap->width * bitmap->rows * bpp) & 7;
+      if (n) { // Pad to byte boundary
+        n = 8 - n;
+        while (n--)
+          enbit(0);
+      }
+    } else if (rle) {
+      // Alternating clear/set runs, starting with clear, flowing from
+      // each row into the next.  Final run is always written, even if
+      // clear, so a decoder never reads past the glyph.
+      int run = 0, nibbles = 0, pixels = bitmap->width * bitmap->rows;
+      uint8_t set = 0;
+      for (y = 0; y < bitmap->rows; y++) {
+        for (x = 0; x < bitmap->width; x++) {
+          byte = x / 8;
+          bit = 0x80 >> (x & 7);
+          if (!(bitmap->buffer[y * bitmap->pitch + byte] & bit) != !set) {
+            nibbles += enrun(run); // Color changed, end prior run
+            run = 0;
+            set = !set;
+          }
+          run++;
+        }
+      }
+      if (pixels) {
+        nibbles += enrun(run);
+        if (nibbles & 1) // Pad to byte boundary
+          ennibble(0);
+      }
+    } else {
+      for (y = 0; y < bitmap->rows; y++) {
+        for (x = 0; x < bitmap->width; x++) {
+          byte = x / 8;
+          bit = 0x80 >> (x & 7);
+          enbit(bitmap->buffer[y * bitmap->pitch + byte] & bit);
+        }
       }
-    }
 
-    // Pad end of char bitmap to next byte boundary if needed
-    int n = (bitmap->width * bitmap->rows) & 7;
-    if (n) {     // Pixel count not an even multiple of 8?
-      n = 8 - n; // # bits to next multiple
-      while (n--)
-        enbit(0);
+      // Pad end of char bitmap to next byte boundary if needed
+      int n = (bitmap->width * bitmap->rows) & 7;
+      if (n) {     // Pixel count not an even multiple of 8?
+        n = 8 - n; // # bits to next multiple
+        while (n--)
+          enbit(0);
+      }
     }
-    bitmapOffset += (bitmap->width * bitmap->rows + 7) / 8;
+    font->bytes += bitsLen - start;
+    if (pack) // Identical glyphs across the pack share one bitmap
+      bitmapOffset = shareBitmap(start);
+    table[j].bitmapOffset = bitmapOffset;
 
     FT_Done_Glyph(glyph);
   }
 
+  // Kerning pairs: grouped by left glyph, each group sorted by right
+  // glyph (as glyphs are in codepoint order), and the index of each
+  // group's first pair.  Pixel-rounded; pairs rounding to 0 are left
+  // out.
+  font->pairs = 0;
+  font->kernIndex = NULL;
+  font->kernPairs = NULL;
+  if (kern && !FT_HAS_KERNING(face)) {
+    fprintf(stderr, "Font has no kerning table, -k ignored\n");
+  } else if (kern) {
+    FT_UInt *ftIndex = malloc(count * sizeof(FT_UInt));
+    int k, allocated = 0, pairs = 0;
+    uint16_t *kernIndex = malloc((count + 1) * sizeof(uint16_t));
+    GFXkernPair *kernPairs = NULL;
+    FT_Vector delta;
+    if (!ftIndex || !kernIndex) {
+      fprintf(stderr, "Malloc error\n");
+      return 1;
+    }
+    for (j = 0; j < count; j++)
+      ftIndex[j] = FT_Get_Char_Index(face, codes[j]);
+    for (j = 0; j < count; j++) {
+      kernIndex[j] = pairs;
+      for (k = 0; k < count; k++) {
+        if (FT_Get_Kerning(face, ftIndex[j], ftIndex[k], FT_KERNING_DEFAULT,
+                           &delta))
+          continue;
+        int adjust = (delta.x + 32) >> 6; // 26.6 fixed point to pixels
+        if (!adjust)
+          continue;
+        if (pairs >= 0xFFFF) {
+          fprintf(stderr, "Too many kerning pairs\n");
+          return 1;
+        }
+        if (pairs == allocated) {
+          allocated = allocated ? allocated * 2 : 256;
+          if (!(kernPairs = realloc(kernPairs,
+                                    allocated * sizeof(GFXkernPair)))) {
+            fprintf(stderr, "Malloc error\n");
+            return 1;
+          }
+        }
+        kernPairs[pairs].right = k;
+        kernPairs[pairs++].adjust =
+            (adjust < -128) ? -128 : (adjust > 127) ? 127 : adjust;
+      }
+    }
+    kernIndex[count] = pairs;
+    if (!pairs) {
+      fprintf(stderr, "No kerning pairs for these characters\n");
+    } else {
+      font->pairs = pairs;
+      font->kernIndex = kernIndex;
+      font->kernPairs = kernPairs;
+    }
+    free(ftIndex);
+  }
+
+  if (face->size->metrics.height == 0) {
+    // No face height info, assume fixed width and get from a glyph.
+    font->yAdvance = table[0].height;
+  } else {
+    font->yAdvance = face->size->metrics.height >> 6;
+  }
+  FT_Done_Face(face);
+
+  font->name = fontName;
+  font->codes = codes;
+  font->table = table;
+  font->first = first;
+  font->last = last;
+  font->count = count;
+  font->ranges = ranges;
+  return 0;
+}
+
+// Output the bitmap data array (of one font, or shared by a pack)
+void printBitmaps(const char *name) {
+  printf("const uint8_t %sBitmaps[] PROGMEM = {\n  ", name);
+  for (int i = 0; i < bitsLen; i++) // Format output table nicely
+    printf("%s0x%02X", !i ? "" : (i % 12) ? ", " : ",\n  ", bits[i]);
   printf(" };\n\n"); // End bitmap array
+}
+
+// Output a font's tables and GFXfont, bitmaps being in bitmapName
+void printFont(const Font *font, const char *bitmapName) {
+  const char *fontName = font->name, *ptr;
+  const GFXglyph *table = font->table;
+  const long *codes = font->codes;
+  int i, j, k, count = font->count;
 
   // Output glyph attributes table (one per character)
   printf("const GFXglyph %sGlyphs[] PROGMEM = {\n", fontName);
-  for (i = first, j = 0; i <= last; i++, j++) {
+  for (j = 0; j < count; j++) {
+    i = codes[j];
     printf("  { %5d, %3d, %3d, %3d, %4d, %4d }", table[j].bitmapOffset,
            table[j].width, table[j].height, table[j].xAdvance, table[j].xOffset,
            table[j].yOffset);
-    if (i < last) {
-      printf(",   // 0x%02X", i);
-      if ((i >= ' ') && (i <= '~')) {
-        printf(" '%c'", i);
+    printf((j < count - 1) ? ",   // 0x%02X" : " }; // 0x%02X", i);
+    if ((i >= ' ') && (i <= '~'))
+      printf(" '%c'", i);
+    putchar('\n');
+  }
+  putchar('\n');
+
+  // Output codepoint runs (extended font)
+  if (extended) {
+    printf("const GFXrange %sRanges[] PROGMEM = {\n", fontName);
+    for (i = j = 0; j < count; j++) {
+      if ((j == count - 1) || (codes[j + 1] != codes[j] + 1)) { // Run end
+        printf("  { 0x%06lX, %5d, %5d }%s\n", codes[i], j - i + 1, i,
+               (j < count - 1) ? "," : " };");
+        i = j + 1;
       }
-      putchar('\n');
     }
+    putchar('\n');
+  }
+
+  // Output kerning pairs
+  if (font->pairs) {
+    printf("const uint16_t %sKernIndex[] PROGMEM = {\n  ", fontName);
+    for (j = 0; j <= count; j++)
+      printf("%5d%s", font->kernIndex[j],
+             (j == count) ? " };\n\n" : (j % 12 == 11) ? ",\n  " : ",");
+    printf("const GFXkernPair %sKernPairs[] PROGMEM = {\n", fontName);
+    for (j = k = 0; k < font->pairs; k++) {
+      while (font->kernIndex[j + 1] <= k) // Left glyph of pair k
+        j++;
+      printf("  { %5d, %4d }%s // 0x%02lX 0x%02lX\n", font->kernPairs[k].right,
+             font->kernPairs[k].adjust, (k < font->pairs - 1) ? ",  " : " };",
+             codes[j], codes[font->kernPairs[k].right]);
+    }
+    putchar('\n');
   }
-  printf(" }; // 0x%02X", last);
-  if ((last >= ' ') && (last <= '~'))
-    printf(" '%c'", last);
-  printf("\n\n");
 
   // Output font structure
   printf("const GFXfont %s PROGMEM = {\n", fontName);
-  printf("  (uint8_t  *)%sBitmaps,\n", fontName);
+  printf("  (uint8_t  *)%sBitmaps,\n", bitmapName);
   printf("  (GFXglyph *)%sGlyphs,\n", fontName);
-  if (face->size->metrics.height == 0) {
-    // No face height info, assume fixed width and get from a glyph.
-    printf("  0x%02X, 0x%02X, %d };\n\n", first, last, table[0].height);
+  printf("  0x%02X, 0x%02X, %d", font->first, font->last, font->yAdvance);
+  ptr = rle          ? ", GFXFONT_RLE"
+        : (bpp == 2) ? ", GFXFONT_AA2"
+        : (bpp == 4) ? ", GFXFONT_AA4"
+                     : "";
+  if (extended || font->pairs) { // Format is needed before range table
+    printf("%s,\n  ", *ptr ? ptr : ", GFXFONT_BITMAP");
+    if (extended)
+      printf("(GFXrange *)%sRanges, %d", fontName, font->ranges);
+    else
+      printf("NULL, 0");
+    if (font->pairs)
+      printf(",\n  (uint16_t *)%sKernIndex, (GFXkernPair *)%sKernPairs",
+             fontName, fontName);
+    printf(" };\n\n");
   } else {
-    printf("  0x%02X, 0x%02X, %ld };\n\n", first, last,
-           face->size->metrics.height >> 6);
+    printf("%s };\n\n", ptr);
   }
-  printf("// Approx. %d bytes\n", bitmapOffset + (last - first + 1) * 7 + 7);
   // Size estimate is based on AVR struct and pointer sizes;
   // actual size may vary.
+  i = count * 7 + 7 + font->ranges * 8 +
+      (font->pairs ? (count + 1) * 2 + font->pairs * 4 : 0);
+  if (pack)
+    printf("// Approx. %d bytes, plus shared bitmaps\n\n", i);
+  else
+    printf("// Approx. %d bytes\n", i + font->bytes);
+}
+
+// Write a font as a binary file (-b) for Adafruit_FontFile
+int writeBinary(const Font *font, const char *binName) {
+  const GFXglyph *table = font->table;
+  const long *codes = font->codes;
+  int i, j, count = font->count;
+  FILE *fp = fopen(binName, "wb");
+  if (!fp) {
+    fprintf(stderr, "Can't write %s\n", binName);
+    return 1;
+  }
+  fwrite("GFXF", 1, 4, fp);
+  put8(fp, 1); // Version
+  put8(fp, rle          ? GFXFONT_RLE
+           : (bpp == 2) ? GFXFONT_AA2
+           : (bpp == 4) ? GFXFONT_AA4
+                        : GFXFONT_BITMAP);
+  put8(fp, font->first);
+  put8(fp, font->last);
+  put8(fp, font->yAdvance);
+  put8(fp, 0);
+  put16(fp, count);
+  put16(fp, font->ranges);
+  put16(fp, font->pairs);
+  put32(fp, bitsLen);
+  for (i = j = 0; extended && (j < count); j++) {
+    if ((j == count - 1) || (codes[j + 1] != codes[j] + 1)) { // Run end
+      put32(fp, codes[i]);
+      put16(fp, j - i + 1);
+      put16(fp, i);
+      i = j + 1;
+    }
+  }
+  for (j = 0; j < count; j++) {
+    put16(fp, table[j].bitmapOffset);
+    put8(fp, table[j].width);
+    put8(fp, table[j].height);
+    put8(fp, table[j].xAdvance);
+    put8(fp, table[j].xOffset);
+    put8(fp, table[j].yOffset);
+    put8(fp, 0);
+  }
+  if (font->pairs) {
+    for (j = 0; j <= count; j++)
+      put16(fp, font->kernIndex[j]);
+    if (!(count & 1)) // count + 1 entries; pad to 4 bytes
+      put16(fp, 0);
+    for (j = 0; j < font->pairs; j++) {
+      put16(fp, font->kernPairs[j].right);
+      put8(fp, font->kernPairs[j].adjust);
+      put8(fp, 0);
+    }
+  }
+  fwrite(bits, 1, bitsLen, fp);
+  fclose(fp);
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  int i, err, nFonts, first = ' ', last = '~';
+  char *binName = NULL, *packName = NULL; // -b file, -p name
+  FT_Library library;
+  Font *fonts;
+
+  // Parse command line.  Valid syntaxes are:
+  //   fontconvert [options] [filename] [size]
+  //   fontconvert [options] [filename] [size] [last char]
+  //   fontconvert [options] [filename] [size] [first char] [last char]
+  //   fontconvert -p name [options] [filename] [size] [filename] [size]...
+  // Unless overridden, default first and last chars are
+  // ' ' (space) and '~', respectively.  Options:
+  //   -rle  Run-length encode glyph bitmaps
+  //   -aa2  Anti-aliased, 2 bits/pixel
+  //   -aa4  Anti-aliased, 4 bits/pixel
+  //   -u list  Unicode characters, e.g. 0x20-0x7E,0xA0-0xFF,0x20AC
+  //   -t file  Unicode characters of a UTF-8 text file
+  //   -k    Kerning pairs
+  //   -b file  Also write binary font file
+  //   -p name  Pack of fonts sharing one bitmap table
+  // -u and -t (repeatable, combined) make an extended font; first and
+  // last chars don't apply then.
+
+  char *progName = argv[0];
+  while ((argc > 1) && (argv[1][0] == '-')) {
+    if (!strcmp(argv[1], "-rle")) {
+      rle = 1;
+    } else if (!strcmp(argv[1], "-aa2")) {
+      bpp = 2;
+    } else if (!strcmp(argv[1], "-aa4")) {
+      bpp = 4;
+    } else if (!strcmp(argv[1], "-k")) {
+      kern = 1;
+    } else if (!strcmp(argv[1], "-b") && (argc > 2)) {
+      binName = argv[2];
+      argc--;
+      argv++;
+    } else if (!strcmp(argv[1], "-p") && (argc > 2)) {
+      packName = argv[2];
+      pack = 1;
+      argc--;
+      argv++;
+    } else if (!strcmp(argv[1], "-u") && (argc > 2)) {
+      if (!wantList(argv[2])) {
+        fprintf(stderr, "Bad character list %s\n", argv[2]);
+        return 1;
+      }
+      extended = 1;
+      argc--;
+      argv++;
+    } else if (!strcmp(argv[1], "-t") && (argc > 2)) {
+      if (!wantText(argv[2])) {
+        fprintf(stderr, "Can't read %s\n", argv[2]);
+        return 1;
+      }
+      extended = 1;
+      argc--;
+      argv++;
+    } else {
+      fprintf(stderr, "Unknown option %s\n", argv[1]);
+      return 1;
+    }
+    argc--;
+    argv++;
+  }
+
+  if ((argc < 3) || (rle && (bpp > 1)) ||
+      (pack ? (binName || !(argc & 1)) : (extended && (argc > 3)))) {
+    fprintf(stderr,
+            "Usage: %s [-rle | -aa2 | -aa4] [-k] [-b file] fontfile size "
+            "[first] [last]\n"
+            "       %s [-rle | -aa2 | -aa4] [-k] [-b file] "
+            "{-u list | -t file}... fontfile size\n"
+            "       %s -p name [-rle | -aa2 | -aa4] [-k] "
+            "[{-u list | -t file}...] {fontfile size}...\n",
+            progName, progName, progName);
+    return 1;
+  }
+
+  if (pack) {
+    nFonts = (argc - 1) / 2;
+  } else {
+    nFonts = 1;
+    if (argc == 4) {
+      last = atoi(argv[3]);
+    } else if (argc == 5) {
+      first = atoi(argv[3]);
+      last = atoi(argv[4]);
+    }
+    if (last < first) {
+      i = first;
+      first = last;
+      last = i;
+    }
+  }
+  if (!(fonts = calloc(nFonts, sizeof(Font)))) {
+    fprintf(stderr, "Malloc error\n");
+    return 1;
+  }
+
+  // Init FreeType lib, load font
+  if ((err = FT_Init_FreeType(&library))) {
+    fprintf(stderr, "FreeType init error: %d", err);
+    return err;
+  }
+
+  // Use TrueType engine version 35, without subpixel rendering.
+  // This improves clarity of fonts since this library does not
+  // support rendering multiple levels of gray in a glyph.
+  // See https://github.com/adafruit/Adafruit-GFX-Library/issues/103
+  FT_UInt interpreter_version = TT_INTERPRETER_VERSION_35;
+  FT_Property_Set(library, "truetype", "interpreter-version",
+                  &interpreter_version);
+
+  for (i = 0; i < nFonts; i++) {
+    fonts[i].first = first;
+    fonts[i].last = last;
+    if ((err = convert(library, &fonts[i], argv[1 + i * 2],
+                       atoi(argv[2 + i * 2])))) {
+      FT_Done_FreeType(library);
+      return err;
+    }
+  }
+
+  // Fonts of a pack follow the one bitmap table they all use
+  printBitmaps(pack ? packName : fonts[0].name);
+  for (i = 0; i < nFonts; i++)
+    printFont(&fonts[i], pack ? packName : fonts[i].name);
+  if (pack) {
+    printf("// %sBitmaps: %d bytes for %d fonts, %d saved by sharing\n",
+           packName, bitsLen, nFonts, sharedBytes);
+  }
+
+  if (binName && writeBinary(&fonts[0], binName))
+    return 1;
 
   FT_Done_FreeType(library);
 
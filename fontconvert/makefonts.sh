@@ -7,6 +7,9 @@
 # sizes: 9, 12, 18 and 24 point.  No real error checking or anything,
 # this just powers through all the combinations, calling the fontconvert
 # utility and redirecting the output to a .h file for each combo.
+# With -p, writes a pack per font and style instead (e.g.
+# FreeSansBoldPack.h holding all four sizes, with identical glyph bitmaps
+# shared), converted in one fontconvert run each.
 
 # Adafruit_GFX repository does not include the source outline fonts
 # (huge zipfile, different license) but they're easily acquired:
@@ -24,15 +27,25 @@ do
 	for index in ${!styles[*]}
 	do
 		st=${styles[$index]}
-		for si in ${sizes[*]}
-		do
-			infile=$inpath$f$st".ttf"
-			if [ -f $infile ] # Does source combination exist?
+		infile=$inpath$f$st".ttf"
+		if [ -f $infile ] # Does source combination exist?
+		  then
+			if [ "$1" = "-p" ]
 			  then
-				outfile=$outpath$f$st$si"pt7b.h"
-#				printf "%s %s %s > %s\n" $convert $infile $si $outfile
-				$convert $infile $si > $outfile
+				args=()
+				for si in ${sizes[*]}
+				do
+					args+=($infile $si)
+				done
+				$convert -p $f$st"Pack" ${args[*]} > $outpath$f$st"Pack.h"
+			  else
+				for si in ${sizes[*]}
+				do
+					outfile=$outpath$f$st$si"pt7b.h"
+#					printf "%s %s %s > %s\n" $convert $infile $si $outfile
+					$convert $infile $si > $outfile
+				done
 			fi
-		done
+		fi
 	done
 done
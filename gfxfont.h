@@ -17,13 +17,47 @@ typedef struct {
   int8_t yOffset;        ///< Y dist from cursor pos to UL corner
 } GFXglyph;
 
-/// Data stored for FONT AS A WHOLE
+// Glyph bitmap encodings (GFXfont->format). Fonts converted before this
+// field existed leave it unset, i.e. zero, the original packed format.
+#define GFXFONT_BITMAP 0 ///< Bit-packed 1bpp, row-major, MSB first
+#define GFXFONT_RLE 1    ///< Run lengths (4 bits each) of clear/set pixels
+#define GFXFONT_AA2 2    ///< Anti-aliased, 2 bits coverage/pixel, packed
+#define GFXFONT_AA4 3    ///< Anti-aliased, 4 bits coverage/pixel, packed
+
+/// A run of consecutive codepoints in an extended font, whose glyphs are
+/// likewise consecutive in the glyph array
+typedef struct {
+  uint32_t first; ///< First Unicode codepoint of the run
+  uint16_t count; ///< Number of codepoints (and glyphs) in the run
+  uint16_t glyph; ///< Index in GFXfont->glyph of the run's first glyph
+} GFXrange;
+
+/// One kerning pair: spacing between a left glyph (whose run of pairs in
+/// GFXfont->kern this is in) and the glyph following it
+typedef struct {
+  uint16_t right; ///< Index in GFXfont->glyph of the right-hand glyph
+  int8_t adjust;  ///< Pixels added to the left glyph's xAdvance
+} GFXkernPair;
+
+/// Data stored for FONT AS A WHOLE. A font covers either the characters
+/// first to last or, for an extended font (range set; first and last
+/// are then unused), any set of Unicode codepoints, listed as runs in
+/// ascending order so only glyphs it actually has take up flash. Text in
+/// an extended font is printed as UTF-8. Optional kerning pairs are
+/// grouped by left glyph and sorted by right glyph within each group, so
+/// finding a pair only looks through the few pairs of one glyph.
 typedef struct {
-  uint8_t *bitmap;  ///< Glyph bitmaps, concatenated
-  GFXglyph *glyph;  ///< Glyph array
-  uint8_t first;    ///< ASCII extents (first char)
-  uint8_t last;     ///< ASCII extents (last char)
-  uint8_t yAdvance; ///< Newline distance (y axis)
+  uint8_t *bitmap;     ///< Glyph bitmaps, concatenated
+  GFXglyph *glyph;     ///< Glyph array
+  uint8_t first;       ///< ASCII extents (first char)
+  uint8_t last;        ///< ASCII extents (last char)
+  uint8_t yAdvance;    ///< Newline distance (y axis)
+  uint8_t format;      ///< Bitmap encoding, GFXFONT_BITMAP etc. (see above)
+  GFXrange *range;     ///< Extended fonts: codepoint runs, else NULL
+  uint16_t ranges;     ///< Number of runs in range
+  uint16_t *kernIndex; ///< Per glyph, its first pair in kern (plus one
+                       ///< more entry, the end), or NULL if no kerning
+  GFXkernPair *kern;   ///< Kerning pairs
 } GFXfont;
 
 #endif // _GFXFONT_H_
@@ -0,0 +1,223 @@
+/*!
+ * @file Arduino.cpp
+ *
+ * Desktop implementation of the Arduino core subset in Arduino.h and
+ * Print.h: timing from the system's monotonic clock, Serial on stdout,
+ * Print's number formatting (as the Arduino core does it). main() is
+ * in main.cpp, linked only with sketches.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Arduino.h"
+#include <stdio.h>
+#include <time.h>
+
+HostSerial Serial;
+
+static uint64_t nowMicros(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static const uint64_t startMicros = nowMicros(); // micros() 0
+
+/*!
+    @brief   Microseconds since the program started, wrapping as on a
+             board (every 71 minutes or so with a 32-bit long).
+    @return  Elapsed time.
+*/
+unsigned long micros(void) {
+  return (unsigned long)(uint32_t)(nowMicros() - startMicros);
+}
+
+/*!
+    @brief   Milliseconds since the program started.
+    @return  Elapsed time.
+*/
+unsigned long millis(void) {
+  return (unsigned long)(uint32_t)((nowMicros() - startMicros) / 1000);
+}
+
+/*!
+    @brief  Sleep.
+    @param  ms  Time in milliseconds.
+*/
+void delay(unsigned long ms) {
+  struct timespec ts = {(time_t)(ms / 1000), (long)(ms % 1000) * 1000000};
+  nanosleep(&ts, NULL);
+}
+
+/*!
+    @brief  Spin, as delayMicroseconds() does on a board, for short
+            timings that a sleep would overshoot.
+    @param  us  Time in microseconds.
+*/
+void delayMicroseconds(unsigned int us) {
+  uint64_t end = nowMicros() + us;
+  while (nowMicros() < end)
+    ;
+}
+
+/*!
+    @brief  Nothing to yield to.
+*/
+void yield(void) {}
+
+String::String(const char *str) {
+  _len = str ? strlen(str) : 0;
+  _buf = (char *)malloc(_len + 1);
+  memcpy(_buf, str ? str : "", _len + 1);
+}
+
+String::String(const String &str) : String(str._buf) {}
+
+String::~String(void) { free(_buf); }
+
+String &String::operator=(const String &str) {
+  if (this != &str) {
+    char *buf = (char *)malloc(str._len + 1);
+    memcpy(buf, str._buf, str._len + 1);
+    free(_buf);
+    _buf = buf;
+    _len = str._len;
+  }
+  return *this;
+}
+
+size_t HostSerial::write(uint8_t c) {
+  return (fputc(c, stdout) == EOF) ? 0 : 1;
+}
+
+size_t HostSerial::write(const uint8_t *buffer, size_t size) {
+  return fwrite(buffer, 1, size, stdout);
+}
+
+// Print --------------------------------------------------------------------
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while (size--) {
+    if (!write(*buffer++))
+      break;
+    n++;
+  }
+  return n;
+}
+
+size_t Print::print(const __FlashStringHelper *str) {
+  return write(reinterpret_cast<const char *>(str));
+}
+
+size_t Print::print(const String &str) {
+  return write(str.c_str(), str.length());
+}
+
+size_t Print::print(const char str[]) { return write(str); }
+
+size_t Print::print(char c) { return write((uint8_t)c); }
+
+size_t Print::print(unsigned char n, int base) {
+  return print((unsigned long)n, base);
+}
+
+size_t Print::print(int n, int base) { return print((long)n, base); }
+
+size_t Print::print(unsigned int n, int base) {
+  return print((unsigned long)n, base);
+}
+
+size_t Print::print(long n, int base) {
+  if (base == 0)
+    return write((uint8_t)n);
+  if ((base == 10) && (n < 0))
+    return print('-') + printNumber(-(unsigned long)n, 10);
+  return printNumber(n, base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+  if (base == 0)
+    return write((uint8_t)n);
+  return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) { return printFloat(n, digits); }
+
+size_t Print::println(const __FlashStringHelper *str) {
+  return print(str) + println();
+}
+
+size_t Print::println(const String &str) { return print(str) + println(); }
+
+size_t Print::println(const char str[]) { return print(str) + println(); }
+
+size_t Print::println(char c) { return print(c) + println(); }
+
+size_t Print::println(unsigned char n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(int n, int base) { return print(n, base) + println(); }
+
+size_t Print::println(unsigned int n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(long n, int base) { return print(n, base) + println(); }
+
+size_t Print::println(unsigned long n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(double n, int digits) {
+  return print(n, digits) + println();
+}
+
+size_t Print::println(void) { return write("\r\n"); }
+
+size_t Print::printNumber(unsigned long n, uint8_t base) {
+  char buf[8 * sizeof(long) + 1], *str = &buf[sizeof buf - 1];
+  *str = 0;
+  if (base < 2)
+    base = 10;
+  do {
+    char c = n % base;
+    n /= base;
+    *--str = c < 10 ? c + '0' : c + 'A' - 10;
+  } while (n);
+  return write(str);
+}
+
+size_t Print::printFloat(double n, uint8_t digits) {
+  if (isnan(n))
+    return print("nan");
+  if (isinf(n))
+    return print("inf");
+  double most = (double)(unsigned long)-1; // Whole part prints as a long
+  if ((n > most) || (n < -most))
+    return print("ovf");
+
+  size_t len = 0;
+  if (n < 0.0) {
+    len += print('-');
+    n = -n;
+  }
+  double rounding = 0.5; // Round correctly so that print(1.999, 2) is "2.00"
+  for (uint8_t i = 0; i < digits; i++)
+    rounding /= 10.0;
+  n += rounding;
+
+  unsigned long whole = (unsigned long)n;
+  double rest = n - (double)whole;
+  len += print(whole);
+  if (digits)
+    len += print('.');
+  while (digits--) {
+    rest *= 10.0;
+    unsigned int d = (unsigned int)rest;
+    len += print(d);
+    rest -= d;
+  }
+  return len;
+}
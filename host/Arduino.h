@@ -0,0 +1,103 @@
+/*!
+ * @file Arduino.h
+ *
+ * Just enough of the Arduino core for Adafruit_GFX's canvases, fonts and
+ * the GFXbenchmark sketch to build and run on a desktop (Linux, macOS)
+ * with a regular C++ compiler. See Makefile in this folder. Not used, and
+ * not seen, by Arduino builds: the host folder is only on the include
+ * path of the host build.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _GFX_HOST_ARDUINO_H
+#define _GFX_HOST_ARDUINO_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef GFX_HOST
+#define GFX_HOST ///< Building for the desktop, not a board
+#endif
+
+// Program memory is ordinary memory here. Reads are by exact width: the
+// library's own fallback reads a dword as unsigned long, 64 bits on most
+// desktops.
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(void *const *)(addr))
+
+class __FlashStringHelper;
+/// Flash string literal, for Print; an ordinary string here
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#ifndef min
+#define min(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+unsigned long micros(void);
+unsigned long millis(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield(void);
+
+// Pins do nothing; digitalRead() reads LOW
+inline void pinMode(uint8_t pin, uint8_t mode) {}
+inline void digitalWrite(uint8_t pin, uint8_t val) {}
+inline int digitalRead(uint8_t pin) { return LOW; }
+
+/// Minimal Arduino String, enough to hand text to Print and
+/// getTextBounds(); owns a copy of its characters.
+class String {
+public:
+  String(const char *str = "");
+  String(const String &str);
+  ~String(void);
+  String &operator=(const String &str);
+  unsigned int length(void) const { return _len; } ///< Length in chars
+  const char *c_str(void) const { return _buf; }   ///< The characters
+
+private:
+  char *_buf;
+  unsigned int _len;
+};
+
+#include "Print.h"
+
+/// Serial port: output goes to stdout, and nothing is ever received.
+class HostSerial : public Print {
+public:
+  void begin(unsigned long baud) {}
+  void end(void) {}
+  int available(void) { return 0; }      ///< Never any input
+  int read(void) { return -1; }          ///< Never any input
+  operator bool(void) { return true; }   ///< Always connected
+  size_t write(uint8_t c);
+  size_t write(const uint8_t *buffer, size_t size);
+  using Print::write;
+};
+
+extern HostSerial Serial;
+
+// A sketch's own functions. main() runs setup() then loop() once.
+void setup(void);
+void loop(void);
+
+#endif // _GFX_HOST_ARDUINO_H
@@ -0,0 +1,67 @@
+/*!
+ * @file Print.h
+ *
+ * Desktop stand-in for the Arduino core's Print class (see Arduino.h in
+ * this folder), with the same print()/println() overloads so Adafruit_GFX
+ * and sketches print text and numbers as they do on a board.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _GFX_HOST_PRINT_H
+#define _GFX_HOST_PRINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class __FlashStringHelper;
+class String;
+
+/// Base for anything characters can be written to
+class Print {
+public:
+  virtual ~Print(void) {}
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  size_t write(const char *str) {
+    return str ? write((const uint8_t *)str, strlen(str)) : 0;
+  }
+  size_t write(const char *buffer, size_t size) {
+    return write((const uint8_t *)buffer, size);
+  }
+
+  size_t print(const __FlashStringHelper *str);
+  size_t print(const String &str);
+  size_t print(const char str[]);
+  size_t print(char c);
+  size_t print(unsigned char n, int base = DEC);
+  size_t print(int n, int base = DEC);
+  size_t print(unsigned int n, int base = DEC);
+  size_t print(long n, int base = DEC);
+  size_t print(unsigned long n, int base = DEC);
+  size_t print(double n, int digits = 2);
+
+  size_t println(const __FlashStringHelper *str);
+  size_t println(const String &str);
+  size_t println(const char str[]);
+  size_t println(char c);
+  size_t println(unsigned char n, int base = DEC);
+  size_t println(int n, int base = DEC);
+  size_t println(unsigned int n, int base = DEC);
+  size_t println(long n, int base = DEC);
+  size_t println(unsigned long n, int base = DEC);
+  size_t println(double n, int digits = 2);
+  size_t println(void);
+
+private:
+  size_t printNumber(unsigned long n, uint8_t base);
+  size_t printFloat(double n, uint8_t digits);
+};
+
+#endif // _GFX_HOST_PRINT_H
@@ -0,0 +1,23 @@
+/*!
+ * @file main.cpp
+ *
+ * main() for a sketch built on the desktop (see Arduino.h). Kept out of
+ * the library so host programs with their own main() can link to it.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Arduino.h"
+#include <stdio.h>
+
+/*!
+    @brief   Run the sketch linked with this: setup(), then loop() once so
+             the program ends rather than spinning forever.
+    @return  0
+*/
+int main(void) {
+  setup();
+  loop();
+  fflush(stdout);
+  return 0;
+}
@@ -0,0 +1,197 @@
+/*
+BMP image to Adafruit_GFX compressed sprite converter.
+
+NOT AN ARDUINO SKETCH.  This is a command-line tool for preprocessing
+images to be drawn with Adafruit_GFX::drawSprite().
+
+For UNIX-like systems.  Outputs to stdout; redirect to header file, e.g.:
+  ./spriteconvert icons/battery.bmp > battery.h
+
+Input is an uncompressed 24- or 32-bit BMP.  Pixels with alpha below 128
+(32-bit images that have an alpha channel) are transparent, as are pixels
+of a key color given with -t before the filename, e.g.:
+  ./spriteconvert -t FF00FF icons/battery.bmp > battery.h
+
+The table is named after the file, here "battery".  Format is described
+with GFXspriteReader in Adafruit_GFX.h: runs of one color, transparent
+runs and literal spans of 16-bit pixels, in one PROGMEM byte array.
+*/
+#ifndef ARDUINO
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GFXSPRITE_LITERAL 0x00 // Same values as Adafruit_GFX.h
+#define GFXSPRITE_RUN 0x40
+#define GFXSPRITE_SKIP 0x80
+#define GFXSPRITE_REPEAT 0xC0
+#define MAX_OP 319 // Most pixels per op
+
+static long outBytes = 0;
+
+// Write one byte of the output table, 12 per line
+static void enbyte(uint8_t b) {
+  if (outBytes)
+    printf((outBytes % 12) ? ", " : ",\n  ");
+  printf("0x%02X", b);
+  outBytes++;
+}
+
+static void enword(uint16_t w) {
+  enbyte(w & 0xFF);
+  enbyte(w >> 8);
+}
+
+// Write an op byte (and extra length byte if needed) for n pixels
+static void enop(uint8_t type, int n) {
+  if (n <= 63) {
+    enbyte(type | (n - 1));
+  } else {
+    enbyte(type | 63);
+    enbyte(n - 64);
+  }
+}
+
+static uint32_t le32(const uint8_t *p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+int main(int argc, char *argv[]) {
+  long key = -1; // Transparent key color (24-bit RGB), -1 if none
+  char *fileName, *ptr, name[256];
+  FILE *fp;
+  uint8_t hdr[54], *row;
+  int32_t w, h, bits, x, y, i, n, stride, hasAlpha = 0;
+  uint32_t offset;
+  uint16_t *pixels, run = 0;
+  uint8_t *clear; // 1 for each transparent pixel
+  int haveRun = 0;
+
+  // Parse command line. Valid syntaxes are:
+  //   spriteconvert [-t RRGGBB] filename
+  if ((argc >= 3) && !strcmp(argv[1], "-t")) {
+    key = strtol(argv[2], NULL, 16);
+    argv += 2;
+    argc -= 2;
+  }
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s [-t RRGGBB] bmpfile\n", argv[0]);
+    return 1;
+  }
+  fileName = argv[1];
+
+  if (!(fp = fopen(fileName, "rb")) || (fread(hdr, 1, 54, fp) != 54) ||
+      (hdr[0] != 'B') || (hdr[1] != 'M')) {
+    fprintf(stderr, "%s: not a BMP file\n", fileName);
+    return 1;
+  }
+  offset = le32(&hdr[10]);
+  w = (int32_t)le32(&hdr[18]);
+  h = (int32_t)le32(&hdr[22]);
+  bits = hdr[28] | (hdr[29] << 8);
+  if (((bits != 24) && (bits != 32)) ||
+      ((le32(&hdr[30]) != 0) && (le32(&hdr[30]) != 3)) || (w <= 0) ||
+      (w > 32767) || !h || (h < -32767) || (h > 32767)) {
+    fprintf(stderr, "%s: must be uncompressed 24- or 32-bit BMP\n",
+            fileName);
+    return 1;
+  }
+
+  // Read image top row first, reducing to 5-6-5 and transparency
+  int bottomUp = (h > 0);
+  if (!bottomUp)
+    h = -h;
+  stride = ((w * (bits / 8)) + 3) & ~3;
+  pixels = malloc(w * h * sizeof(uint16_t));
+  clear = malloc(w * h);
+  row = malloc(stride * h);
+  if (!pixels || !clear || !row || fseek(fp, offset, SEEK_SET) ||
+      (fread(row, 1, stride * h, fp) != (size_t)(stride * h))) {
+    fprintf(stderr, "%s: can't read image data\n", fileName);
+    return 1;
+  }
+  fclose(fp);
+  if (bits == 32) { // Alpha channel, unless it's all zero
+    for (y = 0; (y < h) && !hasAlpha; y++)
+      for (x = 0; x < w; x++)
+        if (row[y * stride + x * 4 + 3]) {
+          hasAlpha = 1;
+          break;
+        }
+  }
+  for (y = 0; y < h; y++) {
+    uint8_t *p = &row[(bottomUp ? h - 1 - y : y) * stride];
+    for (x = 0; x < w; x++, p += bits / 8) {
+      long rgb = (p[2] << 16) | (p[1] << 8) | p[0];
+      i = y * w + x;
+      pixels[i] = ((p[2] & 0xF8) << 8) | ((p[1] & 0xFC) << 3) | (p[0] >> 3);
+      clear[i] = (hasAlpha && (p[3] < 128)) || (rgb == key);
+    }
+  }
+
+  // Table name from file name, minus path and extension
+  ptr = strrchr(fileName, '/');
+  strncpy(name, ptr ? ptr + 1 : fileName, sizeof name - 1);
+  name[sizeof name - 1] = 0;
+  if ((ptr = strrchr(name, '.')))
+    *ptr = 0;
+  for (ptr = name; *ptr; ptr++)
+    if (!isalnum((unsigned char)*ptr))
+      *ptr = '_';
+  if (isdigit((unsigned char)name[0]))
+    name[0] = '_';
+
+  printf("const uint8_t %s[] PROGMEM = {\n  ", name);
+  enword(w);
+  enword(h);
+
+  // Greedy encoding: transparent pixels as skips, two or more of a color
+  // as a run, anything else gathered into literals until a run of three
+  // (worth breaking a literal for) or a transparent pixel comes along.
+  // Ops may continue from one row onto the next.
+  long total = (long)w * h, pos = 0;
+  while (pos < total) {
+    for (n = 1; (pos + n < total) && (n < MAX_OP) &&
+                (clear[pos + n] == clear[pos]) &&
+                (clear[pos] || (pixels[pos + n] == pixels[pos]));
+         n++)
+      ;
+    if (clear[pos]) {
+      enop(GFXSPRITE_SKIP, n);
+    } else if ((n >= 2) || (haveRun && (pixels[pos] == run))) {
+      if (haveRun && (pixels[pos] == run)) {
+        enop(GFXSPRITE_REPEAT, n);
+      } else {
+        enop(GFXSPRITE_RUN, n);
+        enword(pixels[pos]);
+      }
+      run = pixels[pos];
+      haveRun = 1;
+    } else {
+      long end = pos + 1; // Literal covers [pos, end)
+      while ((end < total) && (end - pos < MAX_OP) && !clear[end] &&
+             !((end + 2 < total) && !clear[end + 1] && !clear[end + 2] &&
+               (pixels[end + 1] == pixels[end]) &&
+               (pixels[end + 2] == pixels[end])))
+        end++;
+      n = end - pos;
+      enop(GFXSPRITE_LITERAL, n);
+      for (i = 0; i < n; i++)
+        enword(pixels[pos + i]);
+    }
+    pos += n;
+  }
+  printf(" };\n\n");
+  printf("// %s: %dx%d, %ld bytes (uncompressed RGB565: %ld)\n", name, w, h,
+         outBytes, total * 2);
+
+  free(pixels);
+  free(clear);
+  free(row);
+  return 0;
+}
+
+#endif /* !ARDUINO */